@@ -0,0 +1,107 @@
+/*
+ * Finding the sorting permutation of a large array: std::sort on an index
+ * array with a comparator that indirects through it, against ds::argsort().
+ */
+#include "libds/argsort.hpp"
+#include "libds/vec.hpp"
+
+#include "perf.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief `count` pseudo-random keys.
+ */
+template <class T>
+ds::vec<T>
+random_keys(std::size_t count)
+{
+    ds::vec<T> keys(count, T{});
+    std::uint64_t rng = 88172645463325252ULL;
+    for (T& key : keys) {
+        rng ^= rng << 13U;
+        rng ^= rng >> 7U;
+        rng ^= rng << 17U;
+        key = static_cast<T>(rng >> 11U);
+    }
+    return keys;
+}
+
+/**
+ * @brief Sort an index array with `std::sort`, comparing through it.
+ */
+template <class T>
+void
+std_sort_indices(benchmark::State& state)
+{
+    auto count = static_cast<std::size_t>(state.range(0));
+    const auto keys = random_keys<T>(count);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        std::vector<std::uint32_t> idx(count);
+        std::iota(idx.begin(), idx.end(), 0U);
+        std::sort(idx.begin(), idx.end(), [&](std::uint32_t lhs, std::uint32_t rhs) {
+            return keys[lhs] < keys[rhs];
+        });
+        benchmark::DoNotOptimize(idx.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(count) * state.iterations());
+}
+
+/**
+ * @brief Radix sort (key, index) pairs with ds::argsort().
+ */
+template <class T>
+void
+argsort(benchmark::State& state)
+{
+    auto count = static_cast<std::size_t>(state.range(0));
+    const auto keys = random_keys<T>(count);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        auto idx = ds::argsort(keys);
+        benchmark::DoNotOptimize(idx.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(count) * state.iterations());
+}
+
+/**
+ * @brief Sort (key, index) pairs with a custom comparator, through ds::argsort().
+ */
+template <class T>
+void
+argsort_comparator(benchmark::State& state)
+{
+    auto count = static_cast<std::size_t>(state.range(0));
+    const auto keys = random_keys<T>(count);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        auto idx = ds::argsort(keys, [](T lhs, T rhs) { return lhs < rhs; });
+        benchmark::DoNotOptimize(idx.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(count) * state.iterations());
+}
+
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+BENCHMARK_TEMPLATE(std_sort_indices, std::uint32_t)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(argsort, std::uint32_t)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(argsort_comparator, std::uint32_t)->Range(1 << 10, 1 << 22);
+
+BENCHMARK_TEMPLATE(std_sort_indices, double)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(argsort, double)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(argsort_comparator, double)->Range(1 << 10, 1 << 22);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
@@ -0,0 +1,134 @@
+/*
+ * Huge copies and fills, with and without non-temporal stores: the bandwidth
+ * they reach, and how much they slow down a cache-sensitive task running next
+ * to them.
+ */
+#include "libds/bulk.hpp"
+#include "libds/vec.hpp"
+
+#include "perf.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Stream (or never stream) bulk copies while in scope.
+ */
+class stream_mode {
+    std::size_t threshold_ = ds::stream_threshold();
+
+ public:
+    explicit stream_mode(bool stream)
+    {
+        ds::set_stream_threshold(stream ? 0 : std::numeric_limits<std::size_t>::max());
+    }
+
+    stream_mode(const stream_mode&) = delete;
+    stream_mode(stream_mode&&) = delete;
+    stream_mode& operator=(const stream_mode&) = delete;
+    stream_mode& operator=(stream_mode&&) = delete;
+
+    ~stream_mode() { ds::set_stream_threshold(threshold_); }
+};
+
+/**
+ * @brief Copy `state.range(0)` bytes between two buffers.
+ */
+template <bool Stream>
+void
+copy_bytes(benchmark::State& state)
+{
+    auto bytes = static_cast<std::size_t>(state.range(0));
+    std::vector<char> src(bytes, 1);
+    std::vector<char> dest(bytes, 0);
+    const stream_mode mode(Stream);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        ds::bulk_copy(dest.data(), src.data(), bytes);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytes) * state.iterations());
+}
+
+/**
+ * @brief Make a vector of `state.range(0)` bytes of floats.
+ */
+template <bool Stream>
+void
+fill_vec(benchmark::State& state)
+{
+    auto count = static_cast<std::size_t>(state.range(0)) / sizeof(float);
+    const stream_mode mode(Stream);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        ds::vec<float> arr(count, 1.0F);
+        benchmark::DoNotOptimize(arr.data());
+    }
+    state.SetBytesProcessed(
+        static_cast<std::int64_t>(count * sizeof(float)) * state.iterations()
+    );
+}
+
+/**
+ * @brief Random lookups in a 1 MiB table (which fits in L2), while another
+ * thread keeps copying `state.range(0)` bytes.
+ */
+template <bool Stream>
+void
+hot_lookups(benchmark::State& state)
+{
+    constexpr std::size_t TABLE = (1U << 20U) / sizeof(std::uint32_t);
+    constexpr std::size_t LOOKUPS = 1U << 16U;
+
+    auto bytes = static_cast<std::size_t>(state.range(0));
+    std::vector<std::uint32_t> table(TABLE);
+    for (std::size_t i = 0; i < TABLE; i++)
+        table[i] = static_cast<std::uint32_t>(i * 2654435761U);
+
+    std::vector<char> src(bytes, 1);
+    std::vector<char> dest(bytes, 0);
+    const stream_mode mode(Stream);
+
+    std::atomic<bool> done{false};
+    std::thread copier([&] {
+        while (!done.load(std::memory_order_relaxed))
+            ds::bulk_copy(dest.data(), src.data(), bytes, 1);
+    });
+
+    std::uint32_t idx = 0;
+    record_perf perf(state);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < LOOKUPS; i++)
+            idx = table[(idx ^ static_cast<std::uint32_t>(i)) % TABLE];
+        benchmark::DoNotOptimize(idx);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(LOOKUPS) * state.iterations());
+
+    done = true;
+    copier.join();
+}
+
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+BENCHMARK_TEMPLATE(copy_bytes, false)->Range(1 << 20, 1 << 28);
+BENCHMARK_TEMPLATE(copy_bytes, true)->Range(1 << 20, 1 << 28);
+
+BENCHMARK_TEMPLATE(fill_vec, false)->Range(1 << 20, 1 << 28);
+BENCHMARK_TEMPLATE(fill_vec, true)->Range(1 << 20, 1 << 28);
+
+BENCHMARK_TEMPLATE(hot_lookups, false)->Arg(1 << 26)->UseRealTime();
+BENCHMARK_TEMPLATE(hot_lookups, true)->Arg(1 << 26)->UseRealTime();
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
@@ -0,0 +1,69 @@
+/*
+ * Large tables with a mostly empty vector member: scanning them is bound by
+ * memory bandwidth, so the size of the vector header decides the speed.
+ */
+#include "libds/compact_vec.hpp"
+#include "libds/vec.hpp"
+
+#include "perf.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+namespace {
+
+using id = std::uint32_t;
+
+/**
+ * @brief A table row: a key and a list of (usually no) IDs.
+ */
+template <class C>
+struct row {
+    id key = 0;
+    C ids{};
+};
+
+// Without an allocation while empty, like the compact vectors
+template <>
+struct row<ds::vec<id>> {
+    id key = 0;
+    ds::vec<id> ids = ds::vec<id>(0);
+};
+
+/**
+ * @brief Sum the IDs in `state.range(0)` rows, of which one in 16 has any.
+ */
+template <class C>
+void
+sparse_table(benchmark::State& state)
+{
+    auto count = static_cast<std::size_t>(state.range(0));
+
+    std::vector<row<C>> table(count);
+    for (std::size_t i = 0; i < count; i += 16)
+        table[i].ids.insert(0, static_cast<id>(i));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        id sum = 0;
+        for (const row<C>& entry : table) {
+            for (const id elem : entry.ids)
+                sum += elem;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(count) * state.iterations());
+    state.counters["bytes_per_row"] = sizeof(row<C>);
+}
+
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+BENCHMARK_TEMPLATE(sparse_table, ds::vec<id>)->Range(1 << 12, 1 << 22);
+BENCHMARK_TEMPLATE(sparse_table, ds::compact_vec32<id>)->Range(1 << 12, 1 << 22);
+BENCHMARK_TEMPLATE(sparse_table, ds::compact_vec<id>)->Range(1 << 12, 1 << 22);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
@@ -0,0 +1,134 @@
+/*
+ * Editing workloads on large sequences: insertions and erasures around a
+ * cursor that wanders through the buffer (like an editor or a streaming
+ * patcher), and insertions at random positions (like an ordered ID list).
+ */
+#include "libds/devec.hpp"
+#include "libds/gap_vec.hpp"
+#include "libds/tiered_vec.hpp"
+#include "libds/vec.hpp"
+
+#include "perf.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Insert or erase one element at @p pos.
+ */
+template <class C>
+void
+edit(C& buf, std::size_t pos, bool insert)
+{
+    if (insert)
+        buf.insert(pos, 'b');
+    else
+        buf.erase(pos);
+}
+
+void
+edit(std::vector<char>& buf, std::size_t pos, bool insert)
+{
+    auto it = buf.begin() + static_cast<std::ptrdiff_t>(pos);
+    if (insert)
+        buf.insert(it, 'b');
+    else
+        buf.erase(it);
+}
+
+template <class C>
+void
+insert_at(C& cont, std::size_t pos, std::uint32_t val)
+{
+    cont.insert(pos, val);
+}
+
+void
+insert_at(std::vector<std::uint32_t>& cont, std::size_t pos, std::uint32_t val)
+{
+    cont.insert(cont.begin() + static_cast<std::ptrdiff_t>(pos), val);
+}
+
+/**
+ * @brief Make EDITS edits near a cursor in a buffer of `state.range(0)` bytes.
+ *
+ * The cursor takes small random steps, and each edit is an insertion or an
+ * erasure at the cursor, so the buffer stays around the same size.
+ */
+template <class C>
+void
+local_edits(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+
+    constexpr std::size_t EDITS = 1024;
+    constexpr std::size_t MAX_STEP = 64;
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        C buf(size, 'a');
+        std::size_t cursor = size / 2;
+        std::uint32_t rng = 12345;
+        state.ResumeTiming();
+
+        for (std::size_t i = 0; i < EDITS; i++) {
+            rng = rng * 1664525U + 1013904223U;
+            std::size_t step = (rng >> 8) % (2 * MAX_STEP + 1);
+            cursor = cursor + step < MAX_STEP ? 0 : cursor + step - MAX_STEP;
+            if (cursor >= buf.size())
+                cursor = buf.size() - 1;
+
+            edit(buf, cursor, ((rng >> 28) & 1U) != 0);
+        }
+        benchmark::DoNotOptimize(buf[cursor]);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(EDITS) * state.iterations());
+}
+
+/**
+ * @brief Insert INSERTS IDs at random positions into `state.range(0)` IDs.
+ */
+template <class C>
+void
+random_inserts(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+
+    constexpr std::size_t INSERTS = 256;
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        C ids(size, 0);
+        std::uint32_t rng = 12345;
+        state.ResumeTiming();
+
+        for (std::size_t i = 0; i < INSERTS; i++) {
+            rng = rng * 1664525U + 1013904223U;
+            insert_at(ids, rng % (ids.size() + 1), rng);
+        }
+        benchmark::DoNotOptimize(ids[0]);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(INSERTS) * state.iterations());
+}
+
+} // namespace
+
+using id = std::uint32_t;
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+BENCHMARK_TEMPLATE(local_edits, std::vector<char>)->Range(1 << 12, 1 << 22);
+BENCHMARK_TEMPLATE(local_edits, ds::devec<char>)->Range(1 << 12, 1 << 22);
+BENCHMARK_TEMPLATE(local_edits, ds::gap_vec<char>)->Range(1 << 12, 1 << 22);
+
+BENCHMARK_TEMPLATE(random_inserts, std::vector<id>)->Range(1 << 12, 1 << 22);
+BENCHMARK_TEMPLATE(random_inserts, ds::vec<id>)->Range(1 << 12, 1 << 22);
+BENCHMARK_TEMPLATE(random_inserts, ds::tiered_vec<id>)->Range(1 << 12, 1 << 22);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
@@ -0,0 +1,108 @@
+/*
+ * Reordering a large array by a random permutation: a plain indexed loop
+ * against ds::gather() (prefetching, AVX2 gathers, threads), and
+ * ds::apply_permutation() in place.
+ */
+#include "libds/gather.hpp"
+#include "libds/vec.hpp"
+
+#include "perf.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief `count` values and a random permutation of their indices.
+ */
+struct input {
+    ds::vec<std::uint32_t> values;
+    ds::vec<std::uint32_t> perm;
+
+    explicit input(std::size_t count) : values(count, 0), perm(count, 0)
+    {
+        std::uint32_t rng = 12345;
+        for (std::size_t i = 0; i < count; i++) {
+            values[i] = static_cast<std::uint32_t>(i) * 2654435761U;
+            perm[i] = static_cast<std::uint32_t>(i);
+        }
+        for (std::size_t i = count; i > 1; i--) {
+            rng = rng * 1664525U + 1013904223U;
+            std::swap(perm[i - 1], perm[rng % i]);
+        }
+    }
+};
+
+/**
+ * @brief Gather `state.range(0)` elements with an indexed loop.
+ */
+void
+gather_loop(benchmark::State& state)
+{
+    auto count = static_cast<std::size_t>(state.range(0));
+    const input in(count);
+    ds::vec<std::uint32_t> out(count, 0);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; i++)
+            out[i] = in.values[in.perm[i]];
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(count) * state.iterations());
+}
+
+/**
+ * @brief Gather `state.range(0)` elements with ds::gather() on `state.range(1)`
+ * threads (0 for one per hardware thread).
+ */
+void
+gather(benchmark::State& state)
+{
+    auto count = static_cast<std::size_t>(state.range(0));
+    auto threads = static_cast<std::size_t>(state.range(1));
+    if (threads == 0)
+        threads = std::max(1U, std::thread::hardware_concurrency());
+
+    const input in(count);
+    ds::vec<std::uint32_t> out(count, 0);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        ds::gather(in.values, in.perm, out, threads);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(count) * state.iterations());
+}
+
+/**
+ * @brief Permute `state.range(0)` elements in place.
+ */
+void
+apply_permutation(benchmark::State& state)
+{
+    auto count = static_cast<std::size_t>(state.range(0));
+    input in(count);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        ds::apply_permutation(in.values, in.perm);
+        benchmark::DoNotOptimize(in.values.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(count) * state.iterations());
+}
+
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+BENCHMARK(gather_loop)->Range(1 << 12, 1 << 24);
+BENCHMARK(gather)->ArgsProduct({benchmark::CreateRange(1 << 12, 1 << 24, 8), {1, 0}});
+BENCHMARK(apply_permutation)->Range(1 << 12, 1 << 24);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
@@ -0,0 +1,118 @@
+/*
+ * Hashing keys of a few bytes up to whole buffers: `std::hash` of a string
+ * view and element-by-element combining against ds::hash_bytes() and
+ * `std::hash<ds::vec>`.
+ */
+#include "libds/hash.hpp"
+#include "libds/vec.hpp"
+
+#include "perf.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+namespace {
+
+/**
+ * @brief `state.range(0)` bytes of ids.
+ */
+ds::vec<std::uint32_t>
+ids(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0)) / sizeof(std::uint32_t);
+    ds::vec<std::uint32_t> out(count, 0);
+    std::uint32_t rng = 12345;
+    for (std::uint32_t& id : out) {
+        rng = rng * 1664525U + 1013904223U;
+        id = rng;
+    }
+    return out;
+}
+
+/**
+ * @brief `std::hash<std::string_view>` of `state.range(0)` bytes.
+ */
+void
+std_hash(benchmark::State& state)
+{
+    const auto key = ids(state);
+    const std::string_view bytes(
+        reinterpret_cast<const char*>(key.data()), // NOLINT
+        key.size() * sizeof(std::uint32_t)
+    );
+
+    record_perf perf(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::hash<std::string_view>{}(bytes));
+    state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+
+/**
+ * @brief Combining `std::hash` of each id of `state.range(0)` bytes, the way
+ * `boost::hash_combine` does.
+ */
+void
+combine_hash(benchmark::State& state)
+{
+    const auto key = ids(state);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        std::size_t seed = 0;
+        for (std::uint32_t id : key) {
+            seed ^= std::hash<std::uint32_t>{}(id) + 0x9e3779b9 + (seed << 6)
+                  + (seed >> 2);
+        }
+        benchmark::DoNotOptimize(seed);
+    }
+    state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+
+/**
+ * @brief `std::hash<ds::vec>`, so ds::hash_bytes(), of `state.range(0)` bytes.
+ */
+void
+vec_hash(benchmark::State& state)
+{
+    const auto key = ids(state);
+
+    record_perf perf(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(std::hash<ds::vec<std::uint32_t>>{}(key));
+    state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+
+/**
+ * @brief ds::hasher fed `state.range(0)` bytes in 100-byte pieces.
+ */
+void
+streaming_hash(benchmark::State& state)
+{
+    const auto key = ids(state);
+    const auto* bytes = reinterpret_cast<const unsigned char*>(key.data()); // NOLINT
+    const std::size_t len = key.size() * sizeof(std::uint32_t);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        ds::hasher hash;
+        for (std::size_t at = 0; at < len; at += 100)
+            hash.update(bytes + at, std::min<std::size_t>(100, len - at));
+        benchmark::DoNotOptimize(hash.digest());
+    }
+    state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+BENCHMARK(std_hash)->Arg(16)->Arg(256)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(combine_hash)->Arg(16)->Arg(256)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(vec_hash)->Arg(16)->Arg(256)->Arg(4096)->Arg(1 << 20);
+BENCHMARK(streaming_hash)->Arg(4096)->Arg(1 << 20);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
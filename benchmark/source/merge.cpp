@@ -0,0 +1,101 @@
+/*
+ * Merging many sorted runs of 32-bit keys into one: a binary heap of run heads
+ * (`std::priority_queue`) against ds::merge_k()'s loser tree.
+ */
+#include "libds/merge.hpp"
+#include "libds/vec.hpp"
+
+#include "perf.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t COUNT = 1 << 20;
+
+/**
+ * @brief @p runs sorted runs of random keys, COUNT keys in all.
+ */
+std::vector<ds::vec<std::uint32_t>>
+random_runs(std::size_t runs)
+{
+    std::vector<ds::vec<std::uint32_t>> out;
+    std::uint32_t rng = 12345;
+    for (std::size_t run = 0; run < runs; run++) {
+        ds::vec<std::uint32_t> keys(COUNT / runs, 0);
+        for (std::uint32_t& key : keys) {
+            rng = rng * 1664525U + 1013904223U;
+            key = rng;
+        }
+        std::sort(keys.begin(), keys.end());
+        out.push_back(std::move(keys));
+    }
+    return out;
+}
+
+/**
+ * @brief Merge `state.range(0)` runs with a binary heap of their heads.
+ */
+void
+heap_merge(benchmark::State& state)
+{
+    const auto runs = random_runs(static_cast<std::size_t>(state.range(0)));
+    std::vector<std::uint32_t> out(COUNT);
+
+    using head = std::pair<std::uint32_t, std::size_t>;
+    record_perf perf(state);
+    for (auto _ : state) {
+        std::vector<std::size_t> pos(runs.size(), 0);
+        std::priority_queue<head, std::vector<head>, std::greater<>> heap;
+        for (std::size_t run = 0; run < runs.size(); run++)
+            heap.emplace(runs[run][0], run);
+
+        std::size_t at = 0;
+        while (!heap.empty()) {
+            const auto [key, run] = heap.top();
+            heap.pop();
+            out[at++] = key;
+            if (++pos[run] < runs[run].size())
+                heap.emplace(runs[run][pos[run]], run);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(COUNT) * state.iterations());
+}
+
+/**
+ * @brief Merge `state.range(0)` runs with ds::merge_k().
+ */
+void
+merge_k(benchmark::State& state)
+{
+    const auto runs = random_runs(static_cast<std::size_t>(state.range(0)));
+    const std::vector<ds::span<const std::uint32_t>> views(runs.begin(), runs.end());
+    ds::vec<std::uint32_t> out(COUNT);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        ds::merge_k(
+            ds::span<const ds::span<const std::uint32_t>>(views.data(), views.size()),
+            out
+        );
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(COUNT) * state.iterations());
+}
+
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+BENCHMARK(heap_merge)->Arg(8)->Arg(256);
+BENCHMARK(merge_k)->Arg(8)->Arg(256);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
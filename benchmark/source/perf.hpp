@@ -0,0 +1,46 @@
+#ifndef LIBDS_BENCHMARK_PERF_HPP
+#define LIBDS_BENCHMARK_PERF_HPP
+
+#include "libds/perf_scope.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+/**
+ * @brief Record hardware counters for a benchmark's timing loop.
+ *
+ * Construct right before the `for (auto _ : state)` loop. When it goes out of
+ * scope, every available event is added to the benchmark's counters (and so to
+ * its JSON output) as a per-iteration average. Events that perf cannot record
+ * on this machine are simply left out.
+ */
+class record_perf {
+    benchmark::State& state_;
+    ds::perf_scope scope_;
+
+ public:
+    explicit record_perf(benchmark::State& state) noexcept : state_(state) {}
+
+    record_perf(const record_perf&) = delete;
+    record_perf(record_perf&&) = delete;
+    record_perf& operator=(const record_perf&) = delete;
+    record_perf& operator=(record_perf&&) = delete;
+
+    ~record_perf()
+    {
+        auto counts = scope_.read();
+        for (std::size_t i = 0; i < ds::PERF_EVENT_COUNT; i++) {
+            if (!counts.valid[i])
+                continue;
+
+            state_.counters[ds::perf_event_name(static_cast<ds::perf_event>(i))] =
+                benchmark::Counter(
+                    static_cast<double>(counts.values[i]),
+                    benchmark::Counter::kAvgIterations
+                );
+        }
+    }
+};
+
+#endif // LIBDS_BENCHMARK_PERF_HPP
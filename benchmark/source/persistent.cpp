@@ -0,0 +1,85 @@
+/*
+ * Version histories: keeping every version of a large array around (for undo
+ * or auditing) while making small edits, by copying a ds::vec per version or
+ * by deriving each version from the last one with ds::persistent_vec.
+ */
+#include "libds/persistent_vec.hpp"
+#include "libds/vec.hpp"
+
+#include "perf.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+namespace {
+
+using elem = std::uint64_t;
+
+constexpr std::size_t VERSIONS = 64;
+constexpr std::size_t EDITS_PER_VERSION = 4;
+
+/**
+ * @brief Derive the next version from the last one in @p history.
+ */
+void
+next_version(std::vector<ds::vec<elem>>& history, std::uint32_t& rng)
+{
+    ds::vec<elem> next(history.back());
+    for (std::size_t i = 0; i < EDITS_PER_VERSION; i++) {
+        rng = rng * 1664525U + 1013904223U;
+        next[rng % next.size()] = rng;
+    }
+    history.push_back(std::move(next));
+}
+
+void
+next_version(std::vector<ds::persistent_vec<elem>>& history, std::uint32_t& rng)
+{
+    auto next = history.back().transient();
+    for (std::size_t i = 0; i < EDITS_PER_VERSION; i++) {
+        rng = rng * 1664525U + 1013904223U;
+        next.set(rng % next.size(), rng);
+    }
+    history.push_back(next.persistent());
+}
+
+/**
+ * @brief Keep VERSIONS versions of `state.range(0)` elements, each with a few
+ * edits over the previous one.
+ */
+template <class C>
+void
+versions(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<C> history;
+        history.reserve(VERSIONS + 1);
+        history.emplace_back(ds::vec<elem>(size, 0));
+        std::uint32_t rng = 12345;
+        state.ResumeTiming();
+
+        for (std::size_t i = 0; i < VERSIONS; i++)
+            next_version(history, rng);
+        benchmark::DoNotOptimize(history.back()[0]);
+
+        state.PauseTiming();
+        history.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(VERSIONS) * state.iterations());
+}
+
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+BENCHMARK_TEMPLATE(versions, ds::vec<elem>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(versions, ds::persistent_vec<elem>)->Range(1 << 10, 1 << 20);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
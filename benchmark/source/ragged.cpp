@@ -0,0 +1,144 @@
+/*
+ * Many short rows (adjacency lists, tokenized documents): building them and
+ * scanning them, as a vector of vectors and as one ds::ragged_vec.
+ */
+#include "libds/ragged_vec.hpp"
+#include "libds/vec.hpp"
+
+#include "perf.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using id = std::uint32_t;
+
+constexpr std::size_t MAX_ROW = 16;
+
+/**
+ * @brief Append a row of @p count copies of @p val.
+ */
+void
+push_row(std::vector<std::vector<id>>& rows, std::size_t count, id val)
+{
+    rows.emplace_back(count, val);
+}
+
+void
+push_row(ds::vec<ds::vec<id>>& rows, std::size_t count, id val)
+{
+    rows.emplace(rows.size(), count, val);
+}
+
+void
+push_row(ds::ragged_vec<id>& rows, std::size_t count, id val)
+{
+    const id row[MAX_ROW] = {};
+    auto view = rows.push_row(ds::span<const id>(row, count));
+    for (id& elem : view)
+        elem = val;
+}
+
+/**
+ * @brief Fill @p rows with `state.range(0)` rows of 0 to MAX_ROW - 1 IDs.
+ */
+template <class C>
+void
+fill(C& rows, std::size_t count, std::uint32_t rng)
+{
+    for (std::size_t i = 0; i < count; i++) {
+        rng = rng * 1664525U + 1013904223U;
+        push_row(rows, (rng >> 8) % MAX_ROW, rng);
+    }
+}
+
+/**
+ * @brief Build `state.range(0)` rows.
+ */
+template <class C>
+void
+build(benchmark::State& state)
+{
+    auto count = static_cast<std::size_t>(state.range(0));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        C rows;
+        fill(rows, count, 12345);
+        benchmark::DoNotOptimize(rows[count - 1]);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(count) * state.iterations());
+}
+
+/**
+ * @brief Build `state.range(0)` rows as one part per hardware thread, and join
+ * them.
+ */
+void
+build_parallel(benchmark::State& state)
+{
+    auto count = static_cast<std::size_t>(state.range(0));
+    const std::size_t threads = std::max(1U, std::thread::hardware_concurrency());
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        std::vector<ds::ragged_vec<id>> parts(threads);
+        std::vector<std::thread> workers;
+        for (std::size_t i = 0; i < threads; i++) {
+            workers.emplace_back([&parts, i, count, threads]() {
+                fill(parts[i], count / threads, static_cast<std::uint32_t>(i));
+            });
+        }
+        for (std::thread& worker : workers)
+            worker.join();
+
+        auto rows = ds::ragged_vec<id>::join(
+            ds::span<const ds::ragged_vec<id>>(parts.data(), parts.size()), threads
+        );
+        benchmark::DoNotOptimize(rows.values().data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(count) * state.iterations());
+}
+
+/**
+ * @brief Sum all IDs in `state.range(0)` rows, row by row.
+ */
+template <class C>
+void
+scan(benchmark::State& state)
+{
+    auto count = static_cast<std::size_t>(state.range(0));
+    C rows;
+    fill(rows, count, 12345);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        id sum = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            for (const id elem : rows[i])
+                sum += elem;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(count) * state.iterations());
+}
+
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+BENCHMARK_TEMPLATE(build, std::vector<std::vector<id>>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(build, ds::vec<ds::vec<id>>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(build, ds::ragged_vec<id>)->Range(1 << 10, 1 << 20);
+BENCHMARK(build_parallel)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_TEMPLATE(scan, std::vector<std::vector<id>>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(scan, ds::vec<ds::vec<id>>)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(scan, ds::ragged_vec<id>)->Range(1 << 10, 1 << 20);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
@@ -0,0 +1,460 @@
+/*
+ * libds_replay: replay a ds::traced_vec trace against several containers and
+ * growth policies, and report the time and allocations each one needs.
+ *
+ * Usage: libds_replay <trace-file> [repetitions]
+ */
+#include "libds/trace.hpp"
+#include "libds/vec.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief An element of @p N bytes, standing in for the traced type.
+ */
+template <std::size_t N>
+struct blob {
+    unsigned char bytes[N] = {};
+};
+
+/**
+ * @brief A replayed vector, type-erased over the container and element size.
+ */
+class target {
+ public:
+    target() = default;
+    target(const target&) = delete;
+    target(target&&) = delete;
+    target& operator=(const target&) = delete;
+    target& operator=(target&&) = delete;
+    virtual ~target() = default;
+
+    [[nodiscard]] virtual std::unique_ptr<target> clone() const = 0;
+    [[nodiscard]] virtual std::unique_ptr<target> take() = 0;
+    virtual void assign(const target& other) = 0;
+    virtual void move_assign(target& other) = 0;
+    virtual void insert(std::size_t pos, std::size_t count) = 0;
+    virtual void erase(std::size_t pos, std::size_t count) = 0;
+    virtual void resize(std::size_t size) = 0;
+    virtual void reserve(std::size_t cap) = 0;
+    virtual void shrink() = 0;
+    virtual void clear() = 0;
+
+    [[nodiscard]] virtual std::size_t capacity() const = 0;
+    [[nodiscard]] virtual std::size_t element_size() const = 0;
+};
+
+/**
+ * @brief Growth policies emulated on top of ds::vec by reserving ahead of
+ * inserts, so the vector's own growth never kicks in.
+ */
+enum class growth { NATIVE, DOUBLE, EXACT };
+
+/**
+ * @brief Replays onto a ds::vec with a given growth policy.
+ */
+template <std::size_t N, growth Growth>
+class vec_target final : public target {
+    ds::vec<blob<N>> vec_;
+
+    void
+    grow_(std::size_t needed)
+    {
+        if constexpr (Growth == growth::DOUBLE) {
+            if (needed > vec_.capacity()) {
+                std::size_t cap = vec_.capacity() < 1 ? 1 : vec_.capacity();
+                while (cap < needed)
+                    cap *= 2;
+                vec_.reserve(cap);
+            }
+        } else if constexpr (Growth == growth::EXACT) {
+            vec_.reserve(needed);
+        }
+    }
+
+ public:
+    explicit vec_target(std::size_t cap) : vec_(cap) {}
+
+    explicit vec_target(ds::vec<blob<N>> vec) : vec_(std::move(vec)) {}
+
+    [[nodiscard]] std::unique_ptr<target>
+    clone() const override
+    {
+        return std::make_unique<vec_target>(vec_);
+    }
+
+    [[nodiscard]] std::unique_ptr<target>
+    take() override
+    {
+        return std::make_unique<vec_target>(std::move(vec_));
+    }
+
+    void
+    assign(const target& other) override
+    {
+        vec_ = static_cast<const vec_target&>(other).vec_;
+    }
+
+    void
+    move_assign(target& other) override
+    {
+        vec_ = std::move(static_cast<vec_target&>(other).vec_);
+    }
+
+    void
+    insert(std::size_t pos, std::size_t count) override
+    {
+        grow_(vec_.size() + count);
+        vec_.insert(pos, count, blob<N>());
+    }
+
+    void
+    erase(std::size_t pos, std::size_t count) override
+    {
+        vec_.erase(pos, count);
+    }
+
+    void
+    resize(std::size_t size) override
+    {
+        grow_(size);
+        vec_.resize(size);
+    }
+
+    void
+    reserve(std::size_t cap) override
+    {
+        vec_.reserve(cap);
+    }
+
+    void
+    shrink() override
+    {
+        vec_.shrink_to_fit();
+    }
+
+    void
+    clear() override
+    {
+        vec_.clear();
+    }
+
+    [[nodiscard]] std::size_t
+    capacity() const override
+    {
+        return vec_.capacity();
+    }
+
+    [[nodiscard]] std::size_t
+    element_size() const override
+    {
+        return N;
+    }
+};
+
+/**
+ * @brief Replays onto a std::vector.
+ */
+template <std::size_t N>
+class std_target final : public target {
+    std::vector<blob<N>> vec_;
+
+ public:
+    explicit std_target(std::size_t cap) { vec_.reserve(cap); }
+
+    explicit std_target(std::vector<blob<N>> vec) : vec_(std::move(vec)) {}
+
+    [[nodiscard]] std::unique_ptr<target>
+    clone() const override
+    {
+        return std::make_unique<std_target>(vec_);
+    }
+
+    [[nodiscard]] std::unique_ptr<target>
+    take() override
+    {
+        return std::make_unique<std_target>(std::move(vec_));
+    }
+
+    void
+    assign(const target& other) override
+    {
+        vec_ = static_cast<const std_target&>(other).vec_;
+    }
+
+    void
+    move_assign(target& other) override
+    {
+        vec_ = std::move(static_cast<std_target&>(other).vec_);
+    }
+
+    void
+    insert(std::size_t pos, std::size_t count) override
+    {
+        auto where = vec_.begin() + static_cast<std::ptrdiff_t>(pos);
+        vec_.insert(where, count, blob<N>());
+    }
+
+    void
+    erase(std::size_t pos, std::size_t count) override
+    {
+        auto where = vec_.begin() + static_cast<std::ptrdiff_t>(pos);
+        vec_.erase(where, where + static_cast<std::ptrdiff_t>(count));
+    }
+
+    void
+    resize(std::size_t size) override
+    {
+        vec_.resize(size);
+    }
+
+    void
+    reserve(std::size_t cap) override
+    {
+        vec_.reserve(cap);
+    }
+
+    void
+    shrink() override
+    {
+        vec_.shrink_to_fit();
+    }
+
+    void
+    clear() override
+    {
+        vec_.clear();
+    }
+
+    [[nodiscard]] std::size_t
+    capacity() const override
+    {
+        return vec_.capacity();
+    }
+
+    [[nodiscard]] std::size_t
+    element_size() const override
+    {
+        return N;
+    }
+};
+
+using factory = std::unique_ptr<target> (*)(std::size_t cap, std::size_t elem_size);
+
+/**
+ * @brief Create @p Target<N> for the smallest bucket N >= @p elem_size.
+ */
+template <template <std::size_t> class Target>
+std::unique_ptr<target>
+make_target(std::size_t cap, std::size_t elem_size)
+{
+    if (elem_size <= 1)
+        return std::make_unique<Target<1>>(cap);
+    if (elem_size <= 2)
+        return std::make_unique<Target<2>>(cap);
+    if (elem_size <= 4)
+        return std::make_unique<Target<4>>(cap);
+    if (elem_size <= 8)
+        return std::make_unique<Target<8>>(cap);
+    if (elem_size <= 16)
+        return std::make_unique<Target<16>>(cap);
+    if (elem_size <= 32)
+        return std::make_unique<Target<32>>(cap);
+    if (elem_size <= 64)
+        return std::make_unique<Target<64>>(cap);
+    if (elem_size <= 128)
+        return std::make_unique<Target<128>>(cap);
+    return std::make_unique<Target<256>>(cap);
+}
+
+template <std::size_t N>
+using native_vec = vec_target<N, growth::NATIVE>;
+
+template <std::size_t N>
+using double_vec = vec_target<N, growth::DOUBLE>;
+
+template <std::size_t N>
+using exact_vec = vec_target<N, growth::EXACT>;
+
+struct contender {
+    const char* name;
+    factory make;
+};
+
+constexpr contender CONTENDERS[] = {
+    {"ds::vec (1.5x)", &make_target<native_vec>},
+    {"ds::vec (2x)", &make_target<double_vec>},
+    {"ds::vec (exact)", &make_target<exact_vec>},
+    {"std::vector", &make_target<std_target>},
+};
+
+struct result {
+    double seconds = 0;
+    std::uint64_t allocations = 0;
+    std::uint64_t peak_bytes = 0;
+};
+
+/**
+ * @brief Replay @p trace once.
+ *
+ * When @p count is set, also count capacity changes (each one is an
+ * allocation or reallocation) and the peak of the total allocated bytes;
+ * this bookkeeping is kept out of timed runs.
+ */
+result
+replay(const std::vector<ds::trace_record>& trace, factory make, bool count)
+{
+    std::unordered_map<std::uint64_t, std::unique_ptr<target>> live;
+    std::unordered_map<std::uint64_t, std::size_t> held;
+    result res;
+    std::uint64_t bytes = 0;
+
+    // Bring the bytes held by vector @p id up to date
+    auto update = [&](std::uint64_t id, bool allocates) {
+        auto it = live.find(id);
+        std::size_t now = it == live.end() ? 0 : it->second->capacity()
+                                                     * it->second->element_size();
+        std::size_t& prev = held[id];
+        if (allocates && now != prev && now != 0)
+            res.allocations++;
+
+        bytes = bytes + now - prev;
+        prev = now;
+        if (bytes > res.peak_bytes)
+            res.peak_bytes = bytes;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& rec : trace) {
+        switch (rec.op) {
+            case ds::trace_op::create:
+                live[rec.id] = make(rec.arg0, rec.arg1);
+                break;
+            case ds::trace_op::destroy:
+                live.erase(rec.id);
+                break;
+            case ds::trace_op::copy:
+                live[rec.id] = live.at(rec.arg0)->clone();
+                break;
+            case ds::trace_op::move:
+                live[rec.id] = live.at(rec.arg0)->take();
+                break;
+            case ds::trace_op::assign:
+                live.at(rec.id)->assign(*live.at(rec.arg0));
+                break;
+            case ds::trace_op::move_assign:
+                live.at(rec.id)->move_assign(*live.at(rec.arg0));
+                break;
+            case ds::trace_op::insert:
+                live.at(rec.id)->insert(rec.arg0, rec.arg1);
+                break;
+            case ds::trace_op::reserve:
+                live.at(rec.id)->reserve(rec.arg0);
+                break;
+            case ds::trace_op::shrink:
+                live.at(rec.id)->shrink();
+                break;
+            case ds::trace_op::clear:
+                live.at(rec.id)->clear();
+                break;
+            case ds::trace_op::resize:
+                live.at(rec.id)->resize(rec.arg0);
+                break;
+            case ds::trace_op::erase:
+                live.at(rec.id)->erase(rec.arg0, rec.arg1);
+                break;
+        }
+
+        if (!count)
+            continue;
+
+        // Moves hand a buffer over rather than allocating one
+        bool moves =
+            rec.op == ds::trace_op::move || rec.op == ds::trace_op::move_assign;
+        if (moves)
+            update(rec.arg0, /*allocates=*/false);
+        update(rec.id, /*allocates=*/!moves);
+        if (rec.op == ds::trace_op::destroy)
+            held.erase(rec.id);
+    }
+    res.seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return res;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <trace-file> [repetitions]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<ds::trace_record> trace;
+    try {
+        std::ifstream file(argv[1], std::ios::binary);
+        if (!file) {
+            std::fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+            return EXIT_FAILURE;
+        }
+
+        ds::trace_reader reader(file);
+        ds::trace_record rec;
+        while (reader.next(rec))
+            trace.push_back(rec);
+    } catch (const std::exception& err) {
+        std::fprintf(stderr, "%s: %s\n", argv[0], err.what());
+        return EXIT_FAILURE;
+    }
+
+    int reps = argc > 2 ? std::atoi(argv[2]) : 5;
+    if (reps < 1)
+        reps = 1;
+
+    std::printf("%zu operations, best of %d runs\n\n", trace.size(), reps);
+    std::printf(
+        "%-18s %12s %12s %14s\n", "container", "time (ms)", "allocations",
+        "peak bytes"
+    );
+
+    for (const auto& cont : CONTENDERS) {
+        try {
+            auto counted = replay(trace, cont.make, /*count=*/true);
+
+            double best = -1;
+            for (int i = 0; i < reps; i++) {
+                double secs = replay(trace, cont.make, /*count=*/false).seconds;
+                if (best < 0 || secs < best)
+                    best = secs;
+            }
+
+            std::printf(
+                "%-18s %12.3f %12llu %14llu\n", cont.name, best * 1000,
+                static_cast<unsigned long long>(counted.allocations),
+                static_cast<unsigned long long>(counted.peak_bytes)
+            );
+        } catch (const std::exception& err) {
+            std::fprintf(stderr, "%s: %s: %s\n", argv[0], cont.name, err.what());
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
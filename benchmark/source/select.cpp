@@ -0,0 +1,148 @@
+/*
+ * Picking the best few of a million scores: `std::partial_sort` and
+ * `std::nth_element` against ds::top_k(), ds::partial_sort() and
+ * ds::nth_element().
+ */
+#include "libds/select.hpp"
+#include "libds/vec.hpp"
+
+#include "perf.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t COUNT = 1 << 20;
+
+/**
+ * @brief COUNT random scores.
+ */
+ds::vec<float>
+scores()
+{
+    ds::vec<float> out(COUNT, 0.0F);
+    std::uint32_t rng = 12345;
+    for (float& score : out) {
+        rng = rng * 1664525U + 1013904223U;
+        score = static_cast<float>(rng >> 8) / static_cast<float>(1 << 24);
+    }
+    return out;
+}
+
+/**
+ * @brief `std::partial_sort` for the `state.range(0)` highest scores.
+ */
+void
+std_partial_sort(benchmark::State& state)
+{
+    const auto input = scores();
+    const auto k = static_cast<std::size_t>(state.range(0));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<float> v(input.begin(), input.end());
+        state.ResumeTiming();
+
+        const auto mid = v.begin() + static_cast<std::ptrdiff_t>(k);
+        std::partial_sort(v.begin(), mid, v.end(), std::greater<>{});
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(COUNT) * state.iterations());
+}
+
+/**
+ * @brief ds::partial_sort() for the `state.range(0)` highest scores.
+ */
+void
+partial_sort(benchmark::State& state)
+{
+    const auto input = scores();
+    const auto k = static_cast<std::size_t>(state.range(0));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        ds::vec<float> v = input;
+        state.ResumeTiming();
+
+        ds::partial_sort(v, k, std::greater<>{});
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(COUNT) * state.iterations());
+}
+
+/**
+ * @brief ds::top_k() for the `state.range(0)` highest scores, which leaves the
+ * scores alone.
+ */
+void
+top_k(benchmark::State& state)
+{
+    const auto input = scores();
+    const auto k = static_cast<std::size_t>(state.range(0));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        auto top = ds::top_k(input, k);
+        benchmark::DoNotOptimize(top.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(COUNT) * state.iterations());
+}
+
+/**
+ * @brief `std::nth_element` for the median.
+ */
+void
+std_nth_element(benchmark::State& state)
+{
+    const auto input = scores();
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<float> v(input.begin(), input.end());
+        state.ResumeTiming();
+
+        std::nth_element(v.begin(), v.begin() + COUNT / 2, v.end());
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(COUNT) * state.iterations());
+}
+
+/**
+ * @brief ds::nth_element() for the median.
+ */
+void
+nth_element(benchmark::State& state)
+{
+    const auto input = scores();
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        ds::vec<float> v = input;
+        state.ResumeTiming();
+
+        ds::nth_element(v, COUNT / 2);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(COUNT) * state.iterations());
+}
+
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+BENCHMARK(std_partial_sort)->Arg(100)->Arg(10000);
+BENCHMARK(partial_sort)->Arg(100)->Arg(10000);
+BENCHMARK(top_k)->Arg(100)->Arg(10000);
+BENCHMARK(std_nth_element);
+BENCHMARK(nth_element);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
@@ -0,0 +1,138 @@
+/*
+ * Intersecting sorted posting lists of 32-bit document ids, of similar and of
+ * very different lengths: `std::set_intersection` against
+ * ds::set_intersection() and ds::intersection_size().
+ */
+#include "libds/set_ops.hpp"
+#include "libds/vec.hpp"
+
+#include "perf.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t COUNT = 1 << 20;
+
+/**
+ * @brief A sorted list of about @p n distinct ids out of [0, 4 * COUNT).
+ */
+ds::vec<std::uint32_t>
+posting_list(std::size_t n, std::uint32_t seed)
+{
+    const auto spread = static_cast<std::uint32_t>(4 * COUNT / n);
+    ds::vec<std::uint32_t> out(n + n / 8);
+    std::uint32_t rng = seed;
+    for (std::uint32_t id = 0; id < 4 * COUNT; id++) {
+        rng = rng * 1664525U + 1013904223U;
+        if ((rng >> 8) % spread == 0)
+            out.insert(out.size(), id);
+    }
+    return out;
+}
+
+/**
+ * @brief `std::set_intersection` of a list of COUNT ids and one of
+ * `COUNT / state.range(0)` ids.
+ */
+void
+std_intersection(benchmark::State& state)
+{
+    const auto a = posting_list(COUNT, 1);
+    const auto ratio = static_cast<std::size_t>(state.range(0));
+    const auto b = posting_list(COUNT / ratio, 2);
+    std::vector<std::uint32_t> out;
+    out.reserve(b.size());
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        out.clear();
+        std::set_intersection(
+            a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out)
+        );
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(a.size() + b.size()) * state.iterations()
+    );
+}
+
+/**
+ * @brief ds::set_intersection() of a list of COUNT ids and one of
+ * `COUNT / state.range(0)` ids.
+ */
+void
+intersection(benchmark::State& state)
+{
+    const auto a = posting_list(COUNT, 1);
+    const auto ratio = static_cast<std::size_t>(state.range(0));
+    const auto b = posting_list(COUNT / ratio, 2);
+    ds::vec<std::uint32_t> out(b.size());
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        ds::set_intersection(a, b, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(a.size() + b.size()) * state.iterations()
+    );
+}
+
+/**
+ * @brief ds::intersection_size() of a list of COUNT ids and one of
+ * `COUNT / state.range(0)` ids.
+ */
+void
+intersection_size(benchmark::State& state)
+{
+    const auto a = posting_list(COUNT, 1);
+    const auto ratio = static_cast<std::size_t>(state.range(0));
+    const auto b = posting_list(COUNT / ratio, 2);
+
+    record_perf perf(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(ds::intersection_size(a, b));
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(a.size() + b.size()) * state.iterations()
+    );
+}
+
+/**
+ * @brief ds::set_intersection() of four lists, of COUNT down to COUNT / 8 ids.
+ */
+void
+multi_intersection(benchmark::State& state)
+{
+    const auto a = posting_list(COUNT, 1);
+    const auto b = posting_list(COUNT / 2, 2);
+    const auto c = posting_list(COUNT / 4, 3);
+    const auto d = posting_list(COUNT / 8, 4);
+    ds::vec<std::uint32_t> out(d.size());
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        ds::set_intersection({a, b, c, d}, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(a.size() + b.size() + c.size() + d.size())
+        * state.iterations()
+    );
+}
+
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+BENCHMARK(std_intersection)->Arg(1)->Arg(4)->Arg(1000);
+BENCHMARK(intersection)->Arg(1)->Arg(4)->Arg(1000);
+BENCHMARK(intersection_size)->Arg(1)->Arg(4)->Arg(1000);
+BENCHMARK(multi_intersection);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
@@ -0,0 +1,132 @@
+/*
+ * Deduplicating and partitioning large arrays in place, at low and high
+ * duplicate ratios: the standard algorithms against ds::unique() and
+ * ds::stable_partition().
+ */
+#include "libds/unique.hpp"
+#include "libds/vec.hpp"
+
+#include "perf.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t COUNT = 1 << 20;
+
+/**
+ * @brief COUNT values, `percent` percent of which repeat their predecessor.
+ */
+ds::vec<std::uint32_t>
+with_runs(std::int64_t percent)
+{
+    ds::vec<std::uint32_t> out(COUNT, 0);
+    std::uint32_t rng = 12345;
+    std::uint32_t val = 0;
+    for (std::uint32_t& elem : out) {
+        rng = rng * 1664525U + 1013904223U;
+        if ((rng >> 8) % 100 >= percent)
+            val = rng;
+        elem = val;
+    }
+    return out;
+}
+
+/**
+ * @brief `std::unique` and erase on a `std::vector`, with `state.range(0)`
+ * percent duplicates.
+ */
+void
+std_unique(benchmark::State& state)
+{
+    const auto input = with_runs(state.range(0));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<std::uint32_t> v(input.begin(), input.end());
+        state.ResumeTiming();
+
+        v.erase(std::unique(v.begin(), v.end()), v.end());
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(COUNT) * state.iterations());
+}
+
+/**
+ * @brief ds::unique(), with `state.range(0)` percent duplicates.
+ */
+void
+unique(benchmark::State& state)
+{
+    const auto input = with_runs(state.range(0));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        ds::vec<std::uint32_t> v = input;
+        state.ResumeTiming();
+
+        ds::unique(v);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(COUNT) * state.iterations());
+}
+
+/**
+ * @brief `std::stable_partition` on a `std::vector` by parity, with
+ * `state.range(0)` percent of the values repeated (so longer runs of one side).
+ */
+void
+std_stable_partition(benchmark::State& state)
+{
+    const auto input = with_runs(state.range(0));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<std::uint32_t> v(input.begin(), input.end());
+        state.ResumeTiming();
+
+        std::stable_partition(v.begin(), v.end(), [](std::uint32_t elem) {
+            return elem % 2 == 0;
+        });
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(COUNT) * state.iterations());
+}
+
+/**
+ * @brief ds::stable_partition() by parity.
+ */
+void
+stable_partition(benchmark::State& state)
+{
+    const auto input = with_runs(state.range(0));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        ds::vec<std::uint32_t> v = input;
+        state.ResumeTiming();
+
+        ds::stable_partition(v, [](std::uint32_t elem) { return elem % 2 == 0; });
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(COUNT) * state.iterations());
+}
+
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+BENCHMARK(std_unique)->Arg(5)->Arg(50)->Arg(95);
+BENCHMARK(unique)->Arg(5)->Arg(50)->Arg(95);
+BENCHMARK(std_stable_partition)->Arg(5)->Arg(95);
+BENCHMARK(stable_partition)->Arg(5)->Arg(95);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
@@ -0,0 +1,313 @@
+#include "libds/devec.hpp"
+#include "libds/vec.hpp"
+
+#include "perf.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief A trivially copyable element of @p N bytes.
+ */
+template <std::size_t N>
+struct trivial {
+    unsigned char bytes[N];
+
+    trivial() = default;
+
+    explicit trivial(unsigned char val) noexcept { std::memset(bytes, val, N); }
+
+    friend bool
+    operator!=(const trivial& lhs, const trivial& rhs) noexcept
+    {
+        return std::memcmp(lhs.bytes, rhs.bytes, N) != 0;
+    }
+
+    friend bool
+    operator==(const trivial& lhs, const trivial& rhs) noexcept
+    {
+        return !(lhs != rhs);
+    }
+};
+
+/**
+ * @brief An element of @p N bytes with user-provided copy and destruction.
+ *
+ * Owns no resources, so it is also safe to relocate bytewise.
+ */
+template <std::size_t N>
+struct nontrivial {
+    unsigned char bytes[N];
+
+    nontrivial() noexcept { std::memset(bytes, 0, N); }
+
+    explicit nontrivial(unsigned char val) noexcept { std::memset(bytes, val, N); }
+
+    nontrivial(const nontrivial& other) noexcept { std::memcpy(bytes, other.bytes, N); }
+
+    nontrivial&
+    operator=(const nontrivial& other) noexcept
+    {
+        std::memcpy(bytes, other.bytes, N);
+        return *this;
+    }
+
+    ~nontrivial() noexcept { benchmark::DoNotOptimize(bytes[0]); }
+
+    friend bool
+    operator!=(const nontrivial& lhs, const nontrivial& rhs) noexcept
+    {
+        return std::memcmp(lhs.bytes, rhs.bytes, N) != 0;
+    }
+
+    friend bool
+    operator==(const nontrivial& lhs, const nontrivial& rhs) noexcept
+    {
+        return !(lhs != rhs);
+    }
+};
+
+/**
+ * @brief Uniform access to the containers being compared.
+ */
+template <class C>
+struct ops;
+
+template <class T>
+struct ops<ds::vec<T>> {
+    static ds::vec<T>
+    empty()
+    {
+        return ds::vec<T>(0);
+    }
+
+    static ds::vec<T>
+    filled(std::size_t size, const T& elem)
+    {
+        return ds::vec<T>(size, elem);
+    }
+
+    static void
+    insert(ds::vec<T>& cont, std::size_t pos, const T& elem)
+    {
+        cont.insert(pos, elem);
+    }
+};
+
+template <class T>
+struct ops<ds::devec<T>> {
+    static ds::devec<T>
+    empty()
+    {
+        return ds::devec<T>(0);
+    }
+
+    static ds::devec<T>
+    filled(std::size_t size, const T& elem)
+    {
+        return ds::devec<T>(size, elem);
+    }
+
+    static void
+    insert(ds::devec<T>& cont, std::size_t pos, const T& elem)
+    {
+        cont.insert(pos, elem);
+    }
+};
+
+template <class T>
+struct ops<std::vector<T>> {
+    static std::vector<T>
+    empty()
+    {
+        return std::vector<T>();
+    }
+
+    static std::vector<T>
+    filled(std::size_t size, const T& elem)
+    {
+        return std::vector<T>(size, elem);
+    }
+
+    static void
+    insert(std::vector<T>& cont, std::size_t pos, const T& elem)
+    {
+        cont.insert(cont.begin() + static_cast<std::ptrdiff_t>(pos), elem);
+    }
+};
+
+template <class C>
+void
+set_processed(benchmark::State& state, std::size_t items_per_iter)
+{
+    auto items = static_cast<std::int64_t>(items_per_iter) * state.iterations();
+    state.SetItemsProcessed(items);
+    state.SetBytesProcessed(
+        items * static_cast<std::int64_t>(sizeof(typename C::value_type))
+    );
+}
+
+template <class C>
+void
+construct(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    typename C::value_type elem(1);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        auto cont = ops<C>::filled(size, elem);
+        benchmark::DoNotOptimize(cont.data());
+    }
+    set_processed<C>(state, size);
+}
+
+enum class where { FRONT, MIDDLE, BACK };
+
+template <class C, where Where>
+void
+insert(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    typename C::value_type elem(1);
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        auto cont = ops<C>::empty();
+        for (std::size_t i = 0; i < size; i++) {
+            std::size_t pos = Where == where::FRONT    ? 0
+                            : Where == where::MIDDLE ? cont.size() / 2
+                                                     : cont.size();
+            ops<C>::insert(cont, pos, elem);
+        }
+        benchmark::DoNotOptimize(cont.data());
+    }
+    set_processed<C>(state, size);
+}
+
+template <class C>
+void
+growth(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    typename C::value_type elem(1);
+
+    // Appends into a reserved container, to separate the cost of growing from
+    // the cost of inserting (see insert<C, where::BACK>).
+    record_perf perf(state);
+    for (auto _ : state) {
+        auto cont = ops<C>::empty();
+        cont.reserve(size);
+        for (std::size_t i = 0; i < size; i++)
+            ops<C>::insert(cont, cont.size(), elem);
+        benchmark::DoNotOptimize(cont.data());
+    }
+    set_processed<C>(state, size);
+}
+
+template <class C>
+void
+copy(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto orig = ops<C>::filled(size, typename C::value_type(1));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        C cont(orig);
+        benchmark::DoNotOptimize(cont.data());
+    }
+    set_processed<C>(state, size);
+}
+
+template <class C>
+void
+move(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto orig = ops<C>::filled(size, typename C::value_type(1));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        C cont(std::move(orig));
+        benchmark::DoNotOptimize(cont.data());
+        orig = std::move(cont);
+    }
+}
+
+template <class C>
+void
+equality(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto lhs = ops<C>::filled(size, typename C::value_type(1));
+    auto rhs = ops<C>::filled(size, typename C::value_type(1));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        bool res = lhs == rhs;
+        benchmark::DoNotOptimize(res);
+    }
+    set_processed<C>(state, size);
+}
+
+template <class C>
+void
+iteration(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto cont = ops<C>::filled(size, typename C::value_type(1));
+
+    record_perf perf(state);
+    for (auto _ : state) {
+        unsigned sum = 0;
+        for (const auto& elem : cont)
+            sum += elem.bytes[0];
+        benchmark::DoNotOptimize(sum);
+    }
+    set_processed<C>(state, size);
+}
+
+} // namespace
+
+// Register @p fn for ds::vec and std::vector of @p T, over @p lo..hi elements
+#define LIBDS_BENCH(fn, T, lo, hi)                                               \
+    BENCHMARK_TEMPLATE(fn, ds::vec<T>)->Range(lo, hi);                           \
+    BENCHMARK_TEMPLATE(fn, std::vector<T>)->Range(lo, hi)
+
+// Insertion is also compared against ds::devec, which shifts the smaller side
+#define LIBDS_BENCH_INSERT(T, where, lo, hi)                                     \
+    BENCHMARK_TEMPLATE(insert, ds::vec<T>, where)->Range(lo, hi);                \
+    BENCHMARK_TEMPLATE(insert, ds::devec<T>, where)->Range(lo, hi);              \
+    BENCHMARK_TEMPLATE(insert, std::vector<T>, where)->Range(lo, hi)
+
+// Register every benchmark for elements of type @p T
+#define LIBDS_BENCH_ALL(T)                                                       \
+    LIBDS_BENCH(construct, T, 1 << 6, 1 << 16);                                  \
+    LIBDS_BENCH_INSERT(T, where::FRONT, 1 << 6, 1 << 12);                        \
+    LIBDS_BENCH_INSERT(T, where::MIDDLE, 1 << 6, 1 << 12);                       \
+    LIBDS_BENCH_INSERT(T, where::BACK, 1 << 6, 1 << 16);                         \
+    LIBDS_BENCH(growth, T, 1 << 6, 1 << 16);                                     \
+    LIBDS_BENCH(copy, T, 1 << 6, 1 << 16);                                       \
+    LIBDS_BENCH(move, T, 1 << 6, 1 << 16);                                       \
+    LIBDS_BENCH(equality, T, 1 << 6, 1 << 16);                                   \
+    LIBDS_BENCH(iteration, T, 1 << 6, 1 << 16)
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+LIBDS_BENCH_ALL(trivial<1>);
+LIBDS_BENCH_ALL(trivial<8>);
+LIBDS_BENCH_ALL(trivial<64>);
+LIBDS_BENCH_ALL(trivial<256>);
+LIBDS_BENCH_ALL(nontrivial<1>);
+LIBDS_BENCH_ALL(nontrivial<8>);
+LIBDS_BENCH_ALL(nontrivial<64>);
+LIBDS_BENCH_ALL(nontrivial<256>);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
@@ -5,7 +5,8 @@ if(PROJECT_IS_TOP_LEVEL)
   )
 endif()
 
-# Project is configured with no languages, so tell GNUInstallDirs the lib dir
+# The library is header-only, so keep GNUInstallDirs from picking an
+# architecture-specific lib dir
 set(CMAKE_INSTALL_LIBDIR lib CACHE PATH "")
 
 include(CMakePackageConfigHelpers)
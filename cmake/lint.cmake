@@ -12,6 +12,7 @@ default(
     source/*.cpp source/*.hpp
     include/*.hpp
     test/*.cpp test/*.hpp
+    benchmark/*.cpp benchmark/*.hpp
     example/*.cpp example/*.hpp
 )
 default(FIX NO)
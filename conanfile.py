@@ -14,3 +14,4 @@ class Recipe(ConanFile):
 
     def build_requirements(self):
         self.test_requires("catch2/3.1.0")
+        self.test_requires("benchmark/1.7.1")
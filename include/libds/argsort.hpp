@@ -0,0 +1,313 @@
+/**
+ * @file argsort.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Sorting permutations of ds::vec elements.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_ARGSORT_HPP
+#define LIBDS_ARGSORT_HPP
+
+#include "libds/vec.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ds {
+
+namespace detail {
+
+/**
+ * @brief Whether keys of type @p K can be radix sorted: integers, and IEEE
+ * floating point numbers, of 1, 2, 4 or 8 bytes.
+ */
+template <class K>
+inline constexpr bool IS_RADIX_KEY =
+    (std::is_integral_v<K>
+     || (std::is_floating_point_v<K> && std::numeric_limits<K>::is_iec559))
+    && (sizeof(K) == 1 || sizeof(K) == 2 || sizeof(K) == 4 || sizeof(K) == 8);
+
+/**
+ * @brief The unsigned integer type with the same size as @p K.
+ */
+template <class K>
+using radix_bits_t = std::conditional_t<
+    sizeof(K) == 1, std::uint8_t,
+    std::conditional_t<
+        sizeof(K) == 2, std::uint16_t,
+        std::conditional_t<sizeof(K) == 4, std::uint32_t, std::uint64_t>>>;
+
+/**
+ * @brief Map @p key to an unsigned integer with the same order.
+ *
+ * Signed integers get their sign bit flipped. Negative floating point numbers
+ * get all bits flipped, positive ones just their sign bit, so NaNs end up at
+ * either end, by their sign. -0.0 compares equal to 0.0, so it is mapped to the
+ * same key to keep the sort stable.
+ *
+ * @tparam Descending Whether to reverse the order.
+ */
+template <bool Descending, class K>
+[[nodiscard]] inline radix_bits_t<K>
+radix_key(K key) noexcept
+{
+    using U = radix_bits_t<K>;
+    constexpr U SIGN = static_cast<U>(U{1} << (sizeof(U) * 8 - 1));
+
+    U bits = 0;
+    std::memcpy(&bits, &key, sizeof(K));
+    if constexpr (std::is_floating_point_v<K>) {
+        if ((bits & static_cast<U>(~SIGN)) == 0)
+            bits = 0;
+        bits = (bits & SIGN) != 0 ? static_cast<U>(~bits) : static_cast<U>(bits | SIGN);
+    } else if constexpr (std::is_signed_v<K>) {
+        bits = static_cast<U>(bits ^ SIGN);
+    }
+
+    if constexpr (Descending)
+        bits = static_cast<U>(~bits);
+    return bits;
+}
+
+/**
+ * @brief A key and the index of the element it belongs to.
+ */
+template <class K, class I>
+struct keyed_index {
+    K key;
+    I idx;
+};
+
+/**
+ * @brief The fewest elements worth radix sorting.
+ */
+inline constexpr std::size_t RADIX_SORT_MIN_SIZE = 1024;
+
+/**
+ * @brief Stably sort @p pairs by their (unsigned integer) keys, with an LSD
+ * radix sort over bytes.
+ *
+ * All byte histograms are counted in one pass, and bytes that are the same in
+ * every key are skipped, so e.g. small values in wide integers take few passes.
+ *
+ * @param pairs The pairs to sort.
+ */
+template <class U, class I>
+inline void
+radix_sort(vec<keyed_index<U, I>>& pairs)
+{
+    constexpr std::size_t DIGITS = sizeof(U);
+    constexpr std::size_t RADIX = 256;
+    const std::size_t n = pairs.size();
+
+    vec<std::size_t> counts(DIGITS * RADIX, 0);
+    for (const auto& pair : pairs) {
+        for (std::size_t d = 0; d < DIGITS; d++)
+            counts[d * RADIX + ((pair.key >> (d * 8)) & 0xFFU)]++;
+    }
+
+    vec<keyed_index<U, I>> buffer(n, keyed_index<U, I>{});
+    for (std::size_t d = 0; d < DIGITS; d++) {
+        std::size_t* count = &counts[d * RADIX];
+        if (count[(pairs[0].key >> (d * 8)) & 0xFFU] == n)
+            continue;
+
+        std::size_t offset = 0;
+        for (std::size_t b = 0; b < RADIX; b++)
+            offset += std::exchange(count[b], offset);
+
+        for (const auto& pair : pairs)
+            buffer[count[(pair.key >> (d * 8)) & 0xFFU]++] = pair;
+        std::swap(pairs, buffer);
+    }
+}
+
+/**
+ * @brief Stably sort @p pairs by their keys with @p cmp.
+ */
+template <class K, class I, class Compare>
+inline void
+comparison_sort(vec<keyed_index<K, I>>& pairs, Compare& cmp)
+{
+    std::stable_sort(
+        pairs.begin(), pairs.end(),
+        [&](const keyed_index<K, I>& lhs, const keyed_index<K, I>& rhs) {
+            return cmp(lhs.key, rhs.key);
+        }
+    );
+}
+
+/**
+ * @brief Make the (key, index) pairs for every element of @p v.
+ */
+template <class I, class T, std::size_t A, class Key>
+[[nodiscard]] inline auto
+make_pairs(const vec<T, A>& v, Key& key)
+{
+    using K = std::decay_t<std::invoke_result_t<Key&, const T&>>;
+    vec<keyed_index<K, I>> pairs(v.size());
+    for (std::size_t i = 0; i < v.size(); i++)
+        pairs.emplace(i, keyed_index<K, I>{std::invoke(key, v[i]), static_cast<I>(i)});
+    return pairs;
+}
+
+/**
+ * @brief Extract the indices from sorted pairs.
+ */
+template <class I, class K>
+[[nodiscard]] inline vec<I>
+indices_of(const vec<keyed_index<K, I>>& pairs)
+{
+    vec<I> out(pairs.size(), 0);
+    for (std::size_t i = 0; i < pairs.size(); i++)
+        out[i] = pairs[i].idx;
+    return out;
+}
+
+/**
+ * @brief Whether @p Compare is `std::less` or `std::greater` on @p K.
+ */
+template <class Compare, class K>
+inline constexpr bool IS_NATURAL_ORDER =
+    std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<K>>
+    || std::is_same_v<Compare, std::greater<>>
+    || std::is_same_v<Compare, std::greater<K>>;
+
+/**
+ * @brief Whether @p Compare is `std::greater` on @p K.
+ */
+template <class Compare, class K>
+inline constexpr bool IS_REVERSE_ORDER =
+    std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<K>>;
+
+/**
+ * @brief Radix sort the indices of @p v by `key(v[i])`, an arithmetic key.
+ *
+ * @tparam Descending Whether to sort from the largest key to the smallest.
+ */
+template <bool Descending, class I, class T, std::size_t A, class Key>
+[[nodiscard]] inline vec<I>
+radix_argsort(const vec<T, A>& v, Key& key)
+{
+    auto bits = [&](const T& elem) {
+        return radix_key<Descending>(std::invoke(key, elem));
+    };
+    auto pairs = make_pairs<I>(v, bits);
+    if (pairs.size() >= RADIX_SORT_MIN_SIZE) {
+        radix_sort(pairs);
+    } else {
+        // Clearing and scanning the histograms costs more than it saves
+        std::less<> less;
+        comparison_sort(pairs, less);
+    }
+    return indices_of(pairs);
+}
+
+} // namespace detail
+
+/**
+ * @brief Find the order that would sort @p v: indices such that
+ * `v[idx[0]], v[idx[1]], ...` is sorted.
+ *
+ * Apply the result to @p v (and to any vectors that run parallel to it) with
+ * ds::gather() or ds::apply_permutation(). The sort is stable: equal elements
+ * keep their order.
+ *
+ * @p f is either a comparator, `bool f(const T&, const T&)`, or a key,
+ * `K f(const T&)`, which sorts by `f(v[i])` ascending.
+ *
+ * - Integer and floating point keys (including the elements themselves, with
+ *   `std::less` or `std::greater`) are radix sorted as compact (key, index)
+ *   pairs, in O(n) time and with no comparisons at all.
+ * - Other small, trivially copyable elements are sorted as (element, index)
+ *   pairs, so comparisons read adjacent memory instead of chasing indices.
+ *   Other keys are computed once, and sorted the same way.
+ * - Anything else sorts the indices, comparing through them.
+ *
+ * Floating point numbers are ordered by their bits: -0.0 comes right before
+ * 0.0, and NaNs go to either end, by their sign.
+ *
+ * @tparam I The index type, an unsigned integer type.
+ * @param v The elements to sort.
+ * @param f The comparator or key. Defaults to `std::less<>`.
+ * @return vec<I> The indices.
+ * @throws std::length_error If @p I cannot index all of @p v.
+ */
+template <class I = std::uint32_t, class T, std::size_t A, class F = std::less<>>
+[[nodiscard]] inline vec<I>
+argsort(const vec<T, A>& v, F f = {})
+{
+    static_assert(
+        std::is_integral_v<I> && std::is_unsigned_v<I>,
+        "argsort: the index type must be an unsigned integer type"
+    );
+    if (v.size() > 0 && v.size() - 1 > std::numeric_limits<I>::max())
+        throw std::length_error("argsort: too many elements for the index type!");
+
+    if constexpr (std::is_invocable_r_v<bool, F&, const T&, const T&>) {
+        // A comparator
+        if constexpr (detail::IS_RADIX_KEY<T> && detail::IS_NATURAL_ORDER<F, T>) {
+            auto self = [](const T& elem) { return elem; };
+            return detail::radix_argsort<detail::IS_REVERSE_ORDER<F, T>, I>(v, self);
+        } else if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= 16) {
+            auto self = [](const T& elem) { return elem; };
+            auto pairs = detail::make_pairs<I>(v, self);
+            detail::comparison_sort(pairs, f);
+            return detail::indices_of(pairs);
+        } else {
+            vec<I> out(v.size(), 0);
+            for (std::size_t i = 0; i < v.size(); i++)
+                out[i] = static_cast<I>(i);
+            std::stable_sort(out.begin(), out.end(), [&](I lhs, I rhs) {
+                return f(v[lhs], v[rhs]);
+            });
+            return out;
+        }
+    } else {
+        // A key
+        using K = std::decay_t<std::invoke_result_t<F&, const T&>>;
+        if constexpr (detail::IS_RADIX_KEY<K>) {
+            return detail::radix_argsort<false, I>(v, f);
+        } else {
+            std::less<> less;
+            auto pairs = detail::make_pairs<I>(v, f);
+            detail::comparison_sort(pairs, less);
+            return detail::indices_of(pairs);
+        }
+    }
+}
+
+} // namespace ds
+
+#endif // LIBDS_ARGSORT_HPP
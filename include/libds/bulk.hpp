@@ -0,0 +1,296 @@
+/**
+ * @file bulk.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Bulk memory copies and fills that bypass the cache.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_BULK_HPP
+#define LIBDS_BULK_HPP
+
+#include "libds/detail/parallel.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#  include <emmintrin.h>
+#  define LIBDS_HAS_STREAM 1
+#endif
+
+/**
+ * @brief The default size, in bytes, from which bulk copies and fills use
+ * non-temporal stores. Can be changed at runtime with ds::set_stream_threshold().
+ */
+#ifndef LIBDS_STREAM_THRESHOLD
+#  define LIBDS_STREAM_THRESHOLD (std::size_t{4} << 20U)
+#endif
+
+namespace ds {
+
+namespace detail {
+
+/**
+ * @brief The stream threshold setting, see ds::stream_threshold().
+ */
+inline std::atomic<std::size_t>&
+stream_threshold_setting() noexcept
+{
+    static std::atomic<std::size_t> threshold{LIBDS_STREAM_THRESHOLD};
+    return threshold;
+}
+
+/**
+ * @brief The bulk threads setting, see ds::bulk_threads().
+ */
+inline std::atomic<std::size_t>&
+bulk_threads_setting() noexcept
+{
+    static std::atomic<std::size_t> threads{1};
+    return threads;
+}
+
+/**
+ * @brief How many bytes each streamed block holds: one cache line.
+ */
+inline constexpr std::size_t STREAM_BLOCK = 64;
+
+/**
+ * @brief Copy @p bytes bytes with non-temporal stores, which go straight to
+ * memory instead of evicting cache lines.
+ *
+ * @param dest Where to copy to, which must not overlap @p src.
+ * @param src Where to copy from.
+ * @param bytes How many bytes to copy.
+ */
+inline void
+stream_copy(char* dest, const char* src, std::size_t bytes) noexcept
+{
+#ifdef LIBDS_HAS_STREAM
+    // The stores must be aligned, the loads need not be
+    std::size_t head = (16 - reinterpret_cast<std::uintptr_t>(dest) % 16) % 16;
+    head = head < bytes ? head : bytes;
+    std::memcpy(dest, src, head);
+    dest += head;
+    src += head;
+    bytes -= head;
+
+    for (; bytes >= STREAM_BLOCK; bytes -= STREAM_BLOCK) {
+        const auto* from = reinterpret_cast<const __m128i*>(src);
+        auto* to = reinterpret_cast<__m128i*>(dest);
+        const __m128i a = _mm_loadu_si128(from);
+        const __m128i b = _mm_loadu_si128(from + 1);
+        const __m128i c = _mm_loadu_si128(from + 2);
+        const __m128i d = _mm_loadu_si128(from + 3);
+        _mm_stream_si128(to, a);
+        _mm_stream_si128(to + 1, b);
+        _mm_stream_si128(to + 2, c);
+        _mm_stream_si128(to + 3, d);
+        dest += STREAM_BLOCK;
+        src += STREAM_BLOCK;
+    }
+
+    // Streamed stores are weakly ordered
+    _mm_sfence();
+#endif
+    std::memcpy(dest, src, bytes);
+}
+
+/**
+ * @brief Fill @p bytes bytes with copies of a @p size byte pattern, with
+ * non-temporal stores.
+ *
+ * @param dest Where to fill, at the start of a copy of the pattern.
+ * @param elem The pattern.
+ * @param size The size of the pattern, which must divide 16.
+ * @param bytes How many bytes to fill, a multiple of @p size.
+ */
+inline void
+stream_fill(char* dest, const char* elem, std::size_t size, std::size_t bytes) noexcept
+{
+    std::size_t done = 0;
+#ifdef LIBDS_HAS_STREAM
+    std::size_t head = (16 - reinterpret_cast<std::uintptr_t>(dest) % 16) % 16;
+    head = head < bytes ? head : bytes;
+    for (; done < head; done++)
+        dest[done] = elem[done % size];
+
+    // Every aligned 16 bytes from here on hold the same (rotated) pattern
+    alignas(16) char pattern[16];
+    for (std::size_t i = 0; i < 16; i++)
+        pattern[i] = elem[(head + i) % size];
+    const __m128i line = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern));
+
+    for (; bytes - done >= STREAM_BLOCK; done += STREAM_BLOCK) {
+        auto* to = reinterpret_cast<__m128i*>(dest + done);
+        _mm_stream_si128(to, line);
+        _mm_stream_si128(to + 1, line);
+        _mm_stream_si128(to + 2, line);
+        _mm_stream_si128(to + 3, line);
+    }
+
+    _mm_sfence();
+#endif
+    for (; done < bytes; done++)
+        dest[done] = elem[done % size];
+}
+
+} // namespace detail
+
+/**
+ * @brief Get the size, in bytes, from which bulk_copy() and bulk_fill() (and so
+ * ds::vec's copies, fills and reallocations) bypass the cache.
+ *
+ * Data written with non-temporal stores is not in the cache afterwards, which
+ * is a win when it is far bigger than the cache: it would have been evicted
+ * anyway, and writing it does not evict everything else. It is a loss when the
+ * data is read again soon, so keep the threshold well above the size of the
+ * last-level cache share of one core. Defaults to `LIBDS_STREAM_THRESHOLD`
+ * (4 MiB).
+ *
+ * @return std::size_t The threshold, in bytes.
+ */
+[[nodiscard]] inline std::size_t
+stream_threshold() noexcept
+{
+    return detail::stream_threshold_setting().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Set the size from which bulk copies and fills bypass the cache.
+ *
+ * @param bytes The threshold, in bytes. `SIZE_MAX` turns streaming off.
+ */
+inline void
+set_stream_threshold(std::size_t bytes) noexcept
+{
+    detail::stream_threshold_setting().store(bytes, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get how many threads bulk copies above the stream threshold use by
+ * default, including ds::vec's copies and reallocations.
+ *
+ * One core rarely saturates the memory bandwidth of a server, so a few threads
+ * can copy several times faster. Defaults to 1.
+ *
+ * @return std::size_t The number of threads.
+ */
+[[nodiscard]] inline std::size_t
+bulk_threads() noexcept
+{
+    return detail::bulk_threads_setting().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Set how many threads bulk copies use by default.
+ *
+ * Uses `std::thread`, so link with `Threads::Threads` when setting more than
+ * one.
+ *
+ * @param threads The number of threads.
+ */
+inline void
+set_bulk_threads(std::size_t threads) noexcept
+{
+    detail::bulk_threads_setting().store(threads, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Copy @p bytes bytes from @p src to @p dest.
+ *
+ * Small copies are plain memcpy()s. From stream_threshold() bytes, the copy
+ * uses non-temporal stores and is split over @p threads threads.
+ *
+ * @param dest Where to copy to, which must not overlap @p src.
+ * @param src Where to copy from.
+ * @param bytes How many bytes to copy.
+ * @param threads How many threads to copy with.
+ */
+inline void
+bulk_copy(
+    void* dest, const void* src, std::size_t bytes,
+    std::size_t threads = bulk_threads()
+) noexcept
+{
+    if (bytes < stream_threshold()) {
+        std::memcpy(dest, src, bytes);
+        return;
+    }
+
+    auto* to = static_cast<char*>(dest);
+    const auto* from = static_cast<const char*>(src);
+    const std::size_t blocks = bytes / detail::STREAM_BLOCK;
+    detail::parallel_chunks(blocks, threads, [=](std::size_t first, std::size_t last) {
+        const std::size_t begin = first * detail::STREAM_BLOCK;
+        const std::size_t end = last == blocks ? bytes : last * detail::STREAM_BLOCK;
+        detail::stream_copy(to + begin, from + begin, end - begin);
+    });
+}
+
+/**
+ * @brief Fill @p dest with @p count copies of the @p size bytes at @p elem.
+ *
+ * From stream_threshold() bytes, the fill uses non-temporal stores and is split
+ * over @p threads threads; each thread writes one contiguous part, so the pages
+ * are first touched by the thread that wrote them (see ds::make_numa_vec()).
+ *
+ * @param dest Where to fill.
+ * @param elem The bytes to copy.
+ * @param size How many bytes @p elem holds; non-temporal stores are only used
+ * if this divides 16.
+ * @param count How many copies to make.
+ * @param threads How many threads to fill with.
+ */
+inline void
+bulk_fill(
+    void* dest, const void* elem, std::size_t size, std::size_t count,
+    std::size_t threads = bulk_threads()
+) noexcept
+{
+    auto* to = static_cast<char*>(dest);
+    const auto* from = static_cast<const char*>(elem);
+    const std::size_t bytes = size * count;
+    if (size == 0 || 16 % size != 0 || bytes < stream_threshold()) {
+        for (std::size_t i = 0; i < bytes; i += size)
+            std::memcpy(to + i, from, size);
+        return;
+    }
+
+    const std::size_t blocks = bytes / detail::STREAM_BLOCK;
+    detail::parallel_chunks(blocks, threads, [=](std::size_t first, std::size_t last) {
+        // Blocks hold a whole number of patterns, so every part starts at one
+        const std::size_t begin = first * detail::STREAM_BLOCK;
+        const std::size_t end = last == blocks ? bytes : last * detail::STREAM_BLOCK;
+        detail::stream_fill(to + begin, from, size, end - begin);
+    });
+}
+
+} // namespace ds
+
+#endif // LIBDS_BULK_HPP
@@ -0,0 +1,1198 @@
+/**
+ * @file compact_vec.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Vectors with smaller headers: one pointer, or two 32-bit counts and a pointer.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_COMPACT_VEC_HPP
+#define LIBDS_COMPACT_VEC_HPP
+
+#include "libds/detail/relocate.hpp"
+#include "libds/span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace ds {
+
+namespace detail {
+
+/**
+ * @brief Keeps the size and capacity in front of the elements, on the heap, so
+ * the vector itself is one pointer. A vector without a buffer is a nullptr.
+ *
+ * @tparam T The type of the elements.
+ */
+template <class T>
+class prefix_layout {
+    static_assert(
+        alignof(T) <= alignof(std::max_align_t),
+        "compact_vec: over-aligned types are not supported"
+    );
+
+ public:
+    using size_type = std::size_t;
+
+    static constexpr size_type MAX_CAPACITY =
+        std::numeric_limits<size_type>::max() / sizeof(T) / 2;
+
+ private:
+    struct header_ {
+        size_type size;
+        size_type capacity;
+    };
+
+    /**
+     * @brief The size of the header, padded to keep the elements aligned.
+     */
+    static constexpr size_type HEADER_SIZE =
+        (sizeof(header_) + alignof(std::max_align_t) - 1)
+        / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    T* data_ = nullptr;
+
+    [[nodiscard]] static inline header_*
+    header_of_(T* data) noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<header_*>(reinterpret_cast<char*>(data) - HEADER_SIZE);
+    }
+
+    [[nodiscard]] static inline T*
+    elems_of_(void* block) noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<T*>(static_cast<char*>(block) + HEADER_SIZE);
+    }
+
+ public:
+    [[nodiscard]] static inline T*
+    allocate(size_type cap)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+        void* block = std::malloc(HEADER_SIZE + cap * sizeof(T));
+        if (block == nullptr)
+            throw std::runtime_error("compact_vec: could not allocate memory");
+
+        return elems_of_(block);
+    }
+
+    [[nodiscard]] static inline T*
+    reallocate(T* data, size_type cap)
+    {
+        void* old = data == nullptr ? nullptr : header_of_(data);
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+        void* block = std::realloc(old, HEADER_SIZE + cap * sizeof(T));
+        if (block == nullptr)
+            throw std::runtime_error("compact_vec: could not allocate memory");
+
+        return elems_of_(block);
+    }
+
+    static inline void
+    deallocate(T* data) noexcept
+    {
+        if (data != nullptr)
+            std::free(header_of_(data)); // NOLINT(cppcoreguidelines-no-malloc)
+    }
+
+    [[nodiscard]] inline T*
+    data() const noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] inline size_type
+    size() const noexcept
+    {
+        return data_ == nullptr ? 0 : header_of_(data_)->size;
+    }
+
+    [[nodiscard]] inline size_type
+    capacity() const noexcept
+    {
+        return data_ == nullptr ? 0 : header_of_(data_)->capacity;
+    }
+
+    /**
+     * @brief Change the size. Only valid with a buffer, or to 0.
+     */
+    inline void
+    set_size(size_type size) noexcept
+    {
+        if (data_ != nullptr)
+            header_of_(data_)->size = size;
+    }
+
+    /**
+     * @brief Switch to another buffer (or nullptr, with a capacity of 0).
+     */
+    inline void
+    reset(T* data, size_type size, size_type cap) noexcept
+    {
+        data_ = data;
+        if (data_ != nullptr)
+            *header_of_(data_) = header_{size, cap};
+    }
+};
+
+/**
+ * @brief Keeps the size and capacity as 32-bit counts next to the pointer, so
+ * the vector is 16 bytes and holds at most 2^32 - 1 elements.
+ *
+ * @tparam T The type of the elements.
+ */
+template <class T>
+class inline32_layout {
+ public:
+    using size_type = std::size_t;
+
+    static constexpr size_type MAX_CAPACITY = std::numeric_limits<std::uint32_t>::max();
+
+ private:
+    T* data_ = nullptr;
+    std::uint32_t size_ = 0;
+    std::uint32_t capacity_ = 0;
+
+ public:
+    [[nodiscard]] static inline T*
+    allocate(size_type cap)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+        auto* data = static_cast<T*>(std::malloc(cap * sizeof(T)));
+        if (data == nullptr)
+            throw std::runtime_error("compact_vec: could not allocate memory");
+
+        return data;
+    }
+
+    [[nodiscard]] static inline T*
+    reallocate(T* data, size_type cap)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+        auto* ptr = static_cast<T*>(std::realloc(data, cap * sizeof(T)));
+        if (ptr == nullptr)
+            throw std::runtime_error("compact_vec: could not allocate memory");
+
+        return ptr;
+    }
+
+    static inline void
+    deallocate(T* data) noexcept
+    {
+        std::free(data); // NOLINT(cppcoreguidelines-no-malloc)
+    }
+
+    [[nodiscard]] inline T*
+    data() const noexcept
+    {
+        return data_;
+    }
+
+    [[nodiscard]] inline size_type
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] inline size_type
+    capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /**
+     * @brief Change the size. Only valid with a buffer, or to 0.
+     */
+    inline void
+    set_size(size_type size) noexcept
+    {
+        size_ = static_cast<std::uint32_t>(size);
+    }
+
+    /**
+     * @brief Switch to another buffer (or nullptr, with a capacity of 0).
+     */
+    inline void
+    reset(T* data, size_type size, size_type cap) noexcept
+    {
+        data_ = data;
+        size_ = static_cast<std::uint32_t>(size);
+        capacity_ = static_cast<std::uint32_t>(cap);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A vector with the same interface as ds::vec, but a smaller header.
+ *
+ * Where the size and capacity are kept is up to @p Layout; see ds::compact_vec
+ * and ds::compact_vec32. Unlike ds::vec, an empty vector does not allocate
+ * until the first element is added.
+ *
+ * @tparam T The type of data this vector will hold.
+ * @tparam Layout Where the pointer, size and capacity are stored.
+ */
+template <class T, class Layout>
+class basic_compact_vec {
+ public:
+    /**
+     * @brief The type of the stored elements.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Unsigned integer type used for indicies.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief A random access iterator to @p T.
+     */
+    using iterator = T*;
+
+    /**
+     * @brief A constant random access iterator to @p T.
+     */
+    using const_iterator = const T*;
+
+ private:
+    /**
+     * @brief Whether elements can be moved with realloc.
+     */
+    static constexpr bool TRIVIALLY_RELOCATABLE =
+        detail::IS_TRIVIALLY_RELOCATABLE<T>;
+
+    Layout layout_;
+
+#pragma region "Helpers"
+
+    /**
+     * @brief Get the next capacity of the vector from the current capacity.
+     *
+     * @param cap The current capacity.
+     * @return size_type The next capacity of the vector.
+     */
+    [[nodiscard]] static inline size_type
+    next_capacity_(size_type cap) noexcept
+    {
+        if (cap <= 1)
+            return 2;
+
+        // NOLINTNEXTLINE(hicpp-signed-bitwise): size_type is guaranteed to be unsigned
+        return cap + (cap >> 1);
+    }
+
+    /**
+     * @brief Get the capacity needed to hold @p size elements, growing by 1.5x.
+     *
+     * @param size The number of elements to hold.
+     * @exception std::length_error More elements than the layout can count.
+     * @return size_type The new capacity.
+     */
+    [[nodiscard]] inline size_type
+    grown_capacity_(size_type size) const
+    {
+        if (size > Layout::MAX_CAPACITY)
+            throw std::length_error("compact_vec: too many elements!");
+
+        size_type cap = capacity();
+        while (cap < size)
+            cap = next_capacity_(cap);
+        return cap < Layout::MAX_CAPACITY ? cap : Layout::MAX_CAPACITY;
+    }
+
+    /**
+     * @brief Move the elements into the new buffer @p ptr, opening a gap on the way,
+     * and free the old one.
+     *
+     * If moving an element throws, @p ptr is freed instead and this vector is left as
+     * it was.
+     *
+     * @param ptr The new buffer.
+     * @param start Where to open the gap.
+     * @param places How big the gap should be.
+     */
+    inline void
+    move_to_new_(T* ptr, size_type start, size_type places)
+    {
+        T* data = layout_.data();
+        try {
+            detail::relocate_to_new(ptr, data, size(), start, places);
+        } catch (...) {
+            Layout::deallocate(ptr);
+            throw;
+        }
+        Layout::deallocate(data);
+    }
+
+    /**
+     * @brief Move the elements to a buffer of @p new_cap elements.
+     *
+     * @param new_cap The new capacity, at least size().
+     */
+    inline void
+    resize_(size_type new_cap)
+    {
+        const size_type size = this->size();
+        T* data = layout_.data();
+
+        if (new_cap == 0) {
+            Layout::deallocate(data);
+            layout_.reset(nullptr, 0, 0);
+            return;
+        }
+
+        T* ptr = nullptr;
+        if constexpr (TRIVIALLY_RELOCATABLE) {
+            ptr = Layout::reallocate(data, new_cap);
+        } else {
+            ptr = Layout::allocate(new_cap);
+            move_to_new_(ptr, 0, 0);
+        }
+        layout_.reset(ptr, size, new_cap);
+    }
+
+    /**
+     * @brief Destroy the elements and free the buffer.
+     */
+    inline void
+    free_() noexcept
+    {
+        detail::destroy(layout_.data(), size());
+        Layout::deallocate(layout_.data());
+        layout_.reset(nullptr, 0, 0);
+    }
+
+    /**
+     * @brief Open a gap of @p places uninitialized elements at @p start.
+     *
+     * @param start Where the gap starts.
+     * @param places How big the gap should be.
+     */
+    inline void
+    shift_(size_type start, size_type places)
+    {
+        const size_type size = this->size();
+        if (size + places > capacity()) {
+            const size_type new_cap = grown_capacity_(size + places);
+
+            if constexpr (!TRIVIALLY_RELOCATABLE) {
+                // Move the elements straight to their place in the new buffer
+                T* ptr = Layout::allocate(new_cap);
+                move_to_new_(ptr, start, places);
+
+                layout_.reset(ptr, size + places, new_cap);
+                return;
+            }
+
+            resize_(new_cap);
+        }
+
+        T* data = layout_.data();
+        detail::relocate(data + start + places, data + start, size - start);
+        layout_.set_size(size + places);
+    }
+
+    /**
+     * @brief Construct elements into a gap opened by shift_().
+     *
+     * If a constructor throws, the gap is closed again and the exception propagates.
+     *
+     * @tparam Construct Callable as `construct(T* where, size_type index)`.
+     * @param start Where the gap starts.
+     * @param places How big the gap is.
+     * @param construct Constructs the element at index @p index of the gap.
+     */
+    template <class Construct>
+    inline void
+    fill_gap_(size_type start, size_type places, Construct construct)
+    {
+        T* data = layout_.data();
+        size_type i = 0;
+        try {
+            for (; i < places; i++)
+                construct(&data[start + i], i);
+        } catch (...) {
+            const size_type size = this->size();
+            detail::destroy(&data[start], i);
+            detail::relocate(
+                &data[start], &data[start + places], size - start - places
+            );
+            layout_.set_size(size - places);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Copy elements into an empty vector with enough capacity.
+     *
+     * @param src The elements to copy.
+     * @param count How many elements to copy.
+     */
+    inline void
+    append_copy_(const T* src, size_type count)
+    {
+        T* data = layout_.data();
+        size_type i = 0;
+        try {
+            for (; i < count; i++)
+                ::new (static_cast<void*>(&data[i])) T(src[i]);
+        } catch (...) {
+            detail::destroy(data, i);
+            throw;
+        }
+        layout_.set_size(count);
+    }
+
+#pragma endregion
+
+ public:
+#pragma region "Constructors/Destructors and assignment operators"
+
+    /**
+     * @brief Construct a new empty vector. Does not allocate.
+     */
+    basic_compact_vec() noexcept = default;
+
+    /**
+     * @brief Construct a new empty vector, with a given capacity.
+     *
+     * @param capacity How many elements should this vector be able to hold initially.
+     */
+    explicit basic_compact_vec(size_type capacity) { reserve(capacity); }
+
+    /**
+     * @brief Construct a new vector with specified size, filled with elements.
+     *
+     * @param size The size of the vector.
+     * @param elem The element to fill the vector with
+     */
+    explicit basic_compact_vec(size_type size, T elem)
+    {
+        reserve(size);
+        try {
+            insert(0, size, elem);
+        } catch (...) {
+            free_();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Construct a new vector from an initializer list
+     *
+     * @param init The initializer list with vector elements.
+     */
+    basic_compact_vec(std::initializer_list<T> init)
+    {
+        reserve(init.size());
+        try {
+            append_copy_(std::data(init), init.size());
+        } catch (...) {
+            free_();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Copy constructor. The copy has no spare capacity.
+     *
+     * @param other The vector to copy to this one.
+     */
+    basic_compact_vec(const basic_compact_vec& other)
+    {
+        reserve(other.size());
+        try {
+            append_copy_(other.data(), other.size());
+        } catch (...) {
+            free_();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Move constructor.
+     *
+     * @param other The vector to move to this one.
+     */
+    basic_compact_vec(basic_compact_vec&& other) noexcept :
+        layout_(std::exchange(other.layout_, Layout{}))
+    {}
+
+    /**
+     * @brief Copy assignment operator.
+     *
+     * @param other The assigned object.
+     * @return The new object.
+     */
+    basic_compact_vec&
+    operator=(const basic_compact_vec& other)
+    {
+        // Guard self assignment
+        if (this == &other)
+            return *this;
+
+        clear();
+        reserve(other.size());
+        append_copy_(other.data(), other.size());
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * @param other The assigned object.
+     * @return The new object.
+     */
+    basic_compact_vec&
+    operator=(basic_compact_vec&& other) noexcept
+    {
+        // Guard self-assignment
+        if (this == &other)
+            return *this;
+
+        // Free our resources
+        free_();
+
+        // Leave the other in a valid state
+        layout_ = std::exchange(other.layout_, Layout{});
+
+        return *this;
+    }
+
+    /**
+     * @brief Destroy the vector object.
+     */
+    ~basic_compact_vec() noexcept { free_(); }
+
+#pragma endregion
+
+#pragma region "Accessors"
+
+    /**
+     * @brief Get a reference to the nth element.
+     *
+     * No bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] inline T&
+    operator[](size_type pos) noexcept
+    {
+        return layout_.data()[pos];
+    }
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * No bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @return const T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    operator[](size_type pos) const noexcept
+    {
+        return layout_.data()[pos];
+    }
+
+    /**
+     * @brief Get a reference to the nth element.
+     *
+     * Bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @exception std::out_of_range Index out of range of vector.
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] inline T&
+    at(size_type pos)
+    {
+        if (pos >= size())
+            throw std::out_of_range("compact_vec: index out of range!");
+        return layout_.data()[pos];
+    }
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * Bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @exception std::out_of_range Index out of range of vector.
+     * @return const T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    at(size_type pos) const
+    {
+        if (pos >= size())
+            throw std::out_of_range("compact_vec: index out of range!");
+        return layout_.data()[pos];
+    }
+
+    /**
+     * @brief Get the first element.
+     *
+     * @return T& A reference to the first element.
+     */
+    [[nodiscard]] inline T&
+    front() noexcept
+    {
+        return layout_.data()[0];
+    }
+
+    /**
+     * @brief Get the first element.
+     *
+     * @return const T& A reference to the first element.
+     */
+    [[nodiscard]] inline const T&
+    front() const noexcept
+    {
+        return layout_.data()[0];
+    }
+
+    /**
+     * @brief Get the last element.
+     *
+     * @return T& A reference to the last element.
+     */
+    [[nodiscard]] inline T&
+    back() noexcept
+    {
+        return layout_.data()[size() - 1];
+    }
+
+    /**
+     * @brief Get the last element.
+     *
+     * @return const T& A reference to the last element.
+     */
+    [[nodiscard]] inline const T&
+    back() const noexcept
+    {
+        return layout_.data()[size() - 1];
+    }
+
+    /**
+     * @brief Get access to the underlying data vector.
+     *
+     * Guaranteed to be valid up to size() elements; nullptr without a buffer.
+     *
+     * @return T* The underlying vector of data.
+     */
+    [[nodiscard]] inline T*
+    data() noexcept
+    {
+        return layout_.data();
+    }
+
+    /**
+     * @brief Get access to the underlying data vector.
+     *
+     * Guaranteed to be valid up to size() elements; nullptr without a buffer.
+     *
+     * @return const T* The underlying vector of data.
+     */
+    [[nodiscard]] inline const T*
+    data() const noexcept
+    {
+        return layout_.data();
+    }
+
+#pragma endregion
+
+#pragma region "Capacity"
+
+    /**
+     * @brief Check if the vector is empty.
+     *
+     * @return bool Whether or not the vector is empty.
+     */
+    [[nodiscard]] inline bool
+    empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Get the size of the vector.
+     *
+     * @return size_type The vector size.
+     */
+    [[nodiscard]] inline size_type
+    size() const noexcept
+    {
+        return layout_.size();
+    }
+
+    /**
+     * @brief Get the capacity of the vector.
+     *
+     * @return size_type The vector capacity.
+     */
+    [[nodiscard]] inline size_type
+    capacity() const noexcept
+    {
+        return layout_.capacity();
+    }
+
+    /**
+     * @brief Resize the vector to be able to hold at least @p new_cap elements.
+     *
+     * Does nothing if the desired capacity is less than the current capacity.
+     *
+     * @param new_cap The new desired capacity of the vector.
+     * @exception std::length_error More elements than the layout can count.
+     */
+    inline void
+    reserve(size_type new_cap)
+    {
+        if (new_cap <= capacity())
+            return;
+        if (new_cap > Layout::MAX_CAPACITY)
+            throw std::length_error("compact_vec: too many elements!");
+
+        resize_(new_cap);
+    }
+
+    /**
+     * @brief Remove any unused space from this vector.
+     *
+     * This sets capacity() to size(). An empty vector frees its buffer.
+     */
+    inline void
+    shrink_to_fit()
+    {
+        if (size() != capacity())
+            resize_(size());
+    }
+
+#pragma endregion
+
+#pragma region "Iterators"
+
+    /**
+     * @brief Get an iterator pointing to the beginning of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline iterator
+    begin() noexcept
+    {
+        return layout_.data();
+    }
+
+    /**
+     * @brief Get a const iterator pointing to the beginning of this vector.
+     *
+     * @return const_iterator The iterator.
+     */
+    [[nodiscard]] inline const_iterator
+    begin() const noexcept
+    {
+        return layout_.data();
+    }
+
+    /**
+     * @brief Get an iterator pointing to the end of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline iterator
+    end() noexcept
+    {
+        return layout_.data() + size();
+    }
+
+    /**
+     * @brief Get a const iterator pointing to the end of this vector.
+     *
+     * @return const_iterator The iterator.
+     */
+    [[nodiscard]] inline const_iterator
+    end() const noexcept
+    {
+        return layout_.data() + size();
+    }
+
+#pragma endregion
+
+#pragma region "Views"
+
+    /**
+     * @brief View all elements, without copying.
+     *
+     * @return span<T> The view.
+     */
+    [[nodiscard]] inline span<T>
+    as_span() noexcept
+    {
+        return span<T>(data(), size());
+    }
+
+    /**
+     * @brief View all elements, without copying.
+     *
+     * @return span<const T> The view.
+     */
+    [[nodiscard]] inline span<const T>
+    as_span() const noexcept
+    {
+        return span<const T>(data(), size());
+    }
+
+    /**
+     * @brief View @p count elements starting at @p first, without copying.
+     *
+     * The view is invalidated when this vector moves its elements.
+     *
+     * @param first The position of the first viewed element.
+     * @param count How many elements to view.
+     * @exception std::out_of_range The slice does not fit in this vector.
+     * @return span<T> The subview.
+     */
+    [[nodiscard]] inline span<T>
+    slice(size_type first, size_type count)
+    {
+        return as_span().slice(first, count);
+    }
+
+    /**
+     * @brief View @p count elements starting at @p first, without copying.
+     *
+     * The view is invalidated when this vector moves its elements.
+     *
+     * @param first The position of the first viewed element.
+     * @param count How many elements to view.
+     * @exception std::out_of_range The slice does not fit in this vector.
+     * @return span<const T> The subview.
+     */
+    [[nodiscard]] inline span<const T>
+    slice(size_type first, size_type count) const
+    {
+        return as_span().slice(first, count);
+    }
+
+    /**
+     * @brief Split this vector into two views at position @p pos.
+     *
+     * @param pos Where to split the vector.
+     * @exception std::out_of_range @p pos is greater than size().
+     * @return std::pair<span<T>, span<T>> Views of `[0, pos)` and `[pos, size())`.
+     */
+    [[nodiscard]] inline std::pair<span<T>, span<T>>
+    split_at(size_type pos)
+    {
+        return as_span().split_at(pos);
+    }
+
+    /**
+     * @brief Split this vector into two views at position @p pos.
+     *
+     * @param pos Where to split the vector.
+     * @exception std::out_of_range @p pos is greater than size().
+     * @return std::pair<span<const T>, span<const T>> Views of `[0, pos)` and
+     * `[pos, size())`.
+     */
+    [[nodiscard]] inline std::pair<span<const T>, span<const T>>
+    split_at(size_type pos) const
+    {
+        return as_span().split_at(pos);
+    }
+
+    /**
+     * @brief Iterate over non-overlapping views of @p size elements.
+     *
+     * @param size How many elements each chunk views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return chunk_range<T> A range of spans.
+     */
+    [[nodiscard]] inline chunk_range<T>
+    chunks(size_type size)
+    {
+        return as_span().chunks(size);
+    }
+
+    /**
+     * @brief Iterate over non-overlapping views of @p size elements.
+     *
+     * @param size How many elements each chunk views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return chunk_range<const T> A range of spans.
+     */
+    [[nodiscard]] inline chunk_range<const T>
+    chunks(size_type size) const
+    {
+        return as_span().chunks(size);
+    }
+
+    /**
+     * @brief Iterate over all overlapping views of @p size elements.
+     *
+     * @param size How many elements each window views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return window_range<T> A range of spans.
+     */
+    [[nodiscard]] inline window_range<T>
+    windows(size_type size)
+    {
+        return as_span().windows(size);
+    }
+
+    /**
+     * @brief Iterate over all overlapping views of @p size elements.
+     *
+     * @param size How many elements each window views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return window_range<const T> A range of spans.
+     */
+    [[nodiscard]] inline window_range<const T>
+    windows(size_type size) const
+    {
+        return as_span().windows(size);
+    }
+
+#pragma endregion
+
+#pragma region "Modifiers"
+
+    /* Everthing here changes vector size */
+
+    /**
+     * @brief Clear the contents of the vector.
+     *
+     * Does not change the capacity.
+     */
+    inline void
+    clear() noexcept
+    {
+        detail::destroy(layout_.data(), size());
+        layout_.set_size(0);
+    }
+
+    /**
+     * @brief Construct an element in place at position @p pos.
+     *
+     * The element is constructed from @p args directly in the vector when
+     * appending with spare capacity. Otherwise it is constructed first and then
+     * moved into the gap, so @p args may safely refer to elements of this vector.
+     * Can insert one past the end of the vector (at size());
+     *
+     * @tparam Args The types of the constructor arguments.
+     * @param pos The position to insert the element in (zero indexed).
+     * @param args The arguments to construct the element from.
+     * @return An iterator pointing to the new element.
+     */
+    template <class... Args>
+    inline iterator
+    emplace(size_type pos, Args&&... args)
+    {
+        const size_type size = this->size();
+        if (pos == size && size < capacity()) {
+            ::new (static_cast<void*>(&layout_.data()[pos]))
+                T(std::forward<Args>(args)...);
+            layout_.set_size(size + 1);
+
+            return layout_.data() + pos;
+        }
+
+        T elem(std::forward<Args>(args)...);
+        shift_(pos, 1);
+        fill_gap_(pos, 1, [&](T* where, size_type) {
+            ::new (static_cast<void*>(where)) T(std::move(elem));
+        });
+
+        return layout_.data() + pos;
+    }
+
+    /**
+     * @brief Insert an element @p elem at position @p pos.
+     *
+     * Copies the element into the vector.
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @return An iterator pointing to the new element.
+     */
+    inline iterator
+    insert(size_type pos, const T& elem)
+    {
+        return emplace(pos, elem);
+    }
+
+    /**
+     * @brief Insert an element @p elem at position @p pos.
+     *
+     * Moves the element into the vector.
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @return An iterator pointing to the new element.
+     */
+    inline iterator
+    insert(size_type pos, T&& elem)
+    {
+        return emplace(pos, std::move(elem));
+    }
+
+    /**
+     * @brief Insert @p count copies of @p elem at position @p pos.
+     *
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @return An iterator pointing to the first element inserted.
+     */
+    inline iterator
+    insert(size_type pos, size_type count, const T& elem)
+    {
+        if (count == 0)
+            return layout_.data() + pos;
+
+        // elem may be one of our own elements, which is about to be moved
+        const T copy(elem);
+        shift_(pos, count);
+        fill_gap_(pos, count, [&](T* where, size_type) {
+            ::new (static_cast<void*>(where)) T(copy);
+        });
+
+        return layout_.data() + pos;
+    }
+
+    /**
+     * @brief Insert @p elems at position @p pos.
+     *
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elems The elements to insert.
+     * @return An iterator pointing to the first element inserted.
+     */
+    inline iterator
+    insert(size_type pos, std::initializer_list<T> elems)
+    {
+        if (elems.size() == 0)
+            return layout_.data() + pos;
+
+        shift_(pos, elems.size());
+
+        auto* elem_data = std::data(elems);
+        fill_gap_(pos, elems.size(), [&](T* where, size_type i) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            ::new (static_cast<void*>(where)) T(elem_data[i]);
+        });
+
+        return layout_.data() + pos;
+    }
+
+    /**
+     * @brief Remove the last element.
+     *
+     * The vector must not be empty. Does not change the capacity.
+     */
+    inline void
+    pop_back() noexcept
+    {
+        const size_type size = this->size();
+        layout_.data()[size - 1].~T();
+        layout_.set_size(size - 1);
+    }
+
+#pragma endregion
+
+#pragma region "Equality operators"
+
+    inline friend bool
+    operator==(const basic_compact_vec& lhs, const basic_compact_vec& rhs)
+    {
+        // Check if the vectors are the same
+        if (&lhs == &rhs)
+            return true;
+
+        // Check if the vectors have different sizes
+        if (lhs.size() != rhs.size())
+            return false;
+
+        // Finally, check each element
+        for (size_type i = 0; i < lhs.size(); i++) {
+            if (lhs[i] != rhs[i])
+                return false;
+        }
+        return true;
+    }
+
+    inline friend bool
+    operator!=(const basic_compact_vec& lhs, const basic_compact_vec& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+#pragma endregion
+};
+
+/**
+ * @brief A vector that is a single pointer.
+ *
+ * The size and capacity are kept on the heap, in front of the elements, and an
+ * empty vector without a buffer is a nullptr. Meant for large tables with
+ * mostly empty vector members: those cost 8 bytes each instead of 24. Reading
+ * size() costs a branch and a load from the buffer.
+ *
+ * @tparam T The type of data this vector will hold.
+ */
+template <class T>
+using compact_vec = basic_compact_vec<T, detail::prefix_layout<T>>;
+
+/**
+ * @brief A 16-byte vector: a pointer, and a 32-bit size and capacity.
+ *
+ * Holds at most 2^32 - 1 elements; growing past that throws
+ * `std::length_error`. size() costs the same as for ds::vec.
+ *
+ * @tparam T The type of data this vector will hold.
+ */
+template <class T>
+using compact_vec32 = basic_compact_vec<T, detail::inline32_layout<T>>;
+
+} // namespace ds
+
+#endif // LIBDS_COMPACT_VEC_HPP
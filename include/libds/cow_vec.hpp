@@ -0,0 +1,921 @@
+/**
+ * @file cow_vec.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief A copy-on-write vector with a shared, reference counted buffer.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_COW_VEC_HPP
+#define LIBDS_COW_VEC_HPP
+
+#include "libds/detail/relocate.hpp"
+#include "libds/span.hpp"
+#include "libds/vec.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <atomic>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace ds {
+
+/**
+ * @brief A copy-on-write vector.
+ *
+ * Copies share one buffer and only bump its (atomic) reference count, so they
+ * are O(1). The buffer is never changed while it is shared: the first
+ * modification through a copy gives that copy a private buffer first. Call
+ * make_unique() to decide when that copy happens, e.g. before a batch of edits.
+ *
+ * Reading never checks the reference count. There is deliberately no
+ * non-const `operator[]` (which would have to), and elements are changed with
+ * mut() or through the span returned by make_unique(). This makes it cheap to
+ * publish snapshots: build a cow_vec, hand out copies to readers, and keep
+ * editing the original, which copies the buffer once when it is next changed.
+ *
+ * As with `std::shared_ptr`, different cow_vec objects can be used from
+ * different threads even when they share a buffer, but a single cow_vec must
+ * not be modified while other threads use it.
+ *
+ * @tparam T The type of data this vector will hold.
+ */
+template <class T>
+class cow_vec {
+    static_assert(
+        alignof(T) <= alignof(std::max_align_t),
+        "cow_vec: over-aligned types are not supported"
+    );
+
+ public:
+    /**
+     * @brief The type of the stored elements.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Unsigned integer type used for indicies.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief A random access iterator to @p T. Elements are read-only through
+     * iterators.
+     */
+    using iterator = const T*;
+
+    /**
+     * @brief A constant random access iterator to @p T.
+     */
+    using const_iterator = const T*;
+
+ private:
+    /**
+     * @brief The reference count, stored in front of the elements.
+     */
+    struct header_ {
+        std::atomic<size_type> refs;
+    };
+
+    /**
+     * @brief The size of the header, padded to keep the elements aligned.
+     */
+    static constexpr size_type HEADER_SIZE =
+        (sizeof(header_) + alignof(std::max_align_t) - 1)
+        / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    size_type size_;
+    size_type capacity_;
+    T* data_;
+
+#pragma region "Helpers"
+
+    /**
+     * @brief Get the next capacity of the vector from the current capacity.
+     *
+     * @param cap The current capacity.
+     * @return size_type The next capacity of the vector.
+     */
+    [[nodiscard]] static inline size_type
+    next_capacity_(size_type cap) noexcept
+    {
+        if (cap <= 1)
+            return 2;
+
+        // NOLINTNEXTLINE(hicpp-signed-bitwise): size_type is guaranteed to be unsigned
+        return cap + (cap >> 1);
+    }
+
+    /**
+     * @brief Get the header of a buffer.
+     *
+     * @param data The elements of the buffer.
+     * @return header_* The header in front of them.
+     */
+    [[nodiscard]] static inline header_*
+    header_of_(T* data) noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<header_*>(reinterpret_cast<char*>(data) - HEADER_SIZE);
+    }
+
+    /**
+     * @brief Allocate a buffer with a reference count of one.
+     *
+     * @param cap The amount of elements this should be able to hold.
+     * @return A pointer to the (uninitialized) elements of the buffer.
+     */
+    [[nodiscard]] static inline T*
+    alloc_(size_type cap)
+    {
+        if (cap == 0)
+            return nullptr;
+
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+        auto* ptr = static_cast<char*>(std::malloc(HEADER_SIZE + cap * sizeof(T)));
+        if (ptr == nullptr)
+            throw std::runtime_error("cow_vec: could not allocate memory");
+
+        ::new (static_cast<void*>(ptr)) header_{1};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<T*>(ptr + HEADER_SIZE);
+    }
+
+    /**
+     * @brief Free a buffer, without touching its elements.
+     *
+     * @param data The elements of the buffer.
+     */
+    static inline void
+    dealloc_(T* data) noexcept
+    {
+        if (data == nullptr)
+            return;
+
+        header_* header = header_of_(data);
+        header->~header_();
+        std::free(header); // NOLINT(cppcoreguidelines-no-malloc)
+    }
+
+    /**
+     * @brief Drop our reference to the buffer, freeing it if it was the last one.
+     */
+    inline void
+    release_() noexcept
+    {
+        if (data_ != nullptr
+            && header_of_(data_)->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            detail::destroy(data_, size_);
+            dealloc_(data_);
+        }
+
+        data_ = nullptr;
+    }
+
+    /**
+     * @brief Switch to a new private buffer, opening a gap on the way.
+     *
+     * The elements are copied if the old buffer is shared, and moved otherwise.
+     * Afterwards the elements before @p pos are followed by @p places elements of
+     * uninitialized memory, and then the rest of the elements; size() counts the
+     * gap.
+     *
+     * @param new_cap The capacity of the new buffer.
+     * @param pos Where to open the gap.
+     * @param places How big the gap should be.
+     */
+    inline void
+    unshare_(size_type new_cap, size_type pos = 0, size_type places = 0)
+    {
+        T* ptr = alloc_(new_cap);
+
+        if (is_unique()) {
+            try {
+                detail::relocate_to_new(ptr, data_, size_, pos, places);
+            } catch (...) {
+                dealloc_(ptr);
+                throw;
+            }
+            dealloc_(data_);
+        } else {
+            size_type done = 0;
+            try {
+                for (; done < size_; done++) {
+                    const size_type dest = done < pos ? done : done + places;
+                    ::new (static_cast<void*>(ptr + dest)) T(data_[done]);
+                }
+            } catch (...) {
+                for (size_type i = 0; i < done; i++)
+                    ptr[i < pos ? i : i + places].~T();
+                dealloc_(ptr);
+                throw;
+            }
+
+            // The other owners may have gone away since is_unique() was checked
+            release_();
+        }
+
+        data_ = ptr;
+        capacity_ = new_cap;
+        size_ += places;
+    }
+
+    /**
+     * @brief Open a gap of @p places uninitialized elements at @p pos, in a
+     * private buffer.
+     *
+     * @param pos Where to open the gap.
+     * @param places How big the gap should be.
+     */
+    inline void
+    shift_(size_type pos, size_type places)
+    {
+        size_type new_cap = capacity_;
+        while (size_ + places > new_cap)
+            new_cap = next_capacity_(new_cap);
+
+        if (new_cap != capacity_ || !is_unique()) {
+            unshare_(new_cap, pos, places);
+            return;
+        }
+
+        detail::relocate(data_ + pos + places, data_ + pos, size_ - pos);
+        size_ += places;
+    }
+
+    /**
+     * @brief Construct elements into a gap opened by shift_().
+     *
+     * If a constructor throws, the gap is closed again and the exception propagates.
+     *
+     * @tparam Construct Callable as `construct(T* where, size_type index)`.
+     * @param start Where the gap starts.
+     * @param places How big the gap is.
+     * @param construct Constructs the element at index @p index of the gap.
+     */
+    template <class Construct>
+    inline void
+    fill_gap_(size_type start, size_type places, Construct construct)
+    {
+        size_type i = 0;
+        try {
+            for (; i < places; i++)
+                construct(&data_[start + i], i);
+        } catch (...) {
+            detail::destroy(&data_[start], i);
+            detail::relocate(
+                &data_[start], &data_[start + places], size_ - start - places
+            );
+            size_ -= places;
+            throw;
+        }
+    }
+
+    /**
+     * @brief Copy @p size elements into a new private buffer.
+     *
+     * @param src The elements to copy.
+     * @param size How many elements to copy.
+     */
+    inline void
+    assign_copy_(const T* src, size_type size)
+    {
+        data_ = alloc_(size);
+        capacity_ = size;
+
+        try {
+            for (; size_ < size; size_++)
+                ::new (static_cast<void*>(&data_[size_])) T(src[size_]);
+        } catch (...) {
+            release_();
+            throw;
+        }
+    }
+
+#pragma endregion
+
+ public:
+#pragma region "Constructors/Destructors and assignment operators"
+
+    /**
+     * @brief Construct a new empty cow_vec object. Does not allocate.
+     */
+    cow_vec() noexcept : size_(0), capacity_(0), data_(nullptr) {}
+
+    /**
+     * @brief Construct a new empty cow_vec object, with a given capacity.
+     *
+     * @param capacity How many elements should this vector be able to hold initially.
+     */
+    explicit cow_vec(size_type capacity) :
+        size_(0), capacity_(capacity), data_(alloc_(capacity_))
+    {}
+
+    /**
+     * @brief Construct a new cow_vec object with specified size, filled with
+     * elements.
+     *
+     * @param size The size of the cow_vec.
+     * @param elem The element to fill the vector with
+     */
+    explicit cow_vec(size_type size, T elem) :
+        size_(0), capacity_(size), data_(alloc_(capacity_))
+    {
+        try {
+            for (; size_ < size; size_++)
+                ::new (static_cast<void*>(&data_[size_])) T(elem);
+        } catch (...) {
+            release_();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Construct a new cow_vec object from an initializer list
+     *
+     * @param init The initializer list with vector elements.
+     */
+    cow_vec(std::initializer_list<T> init) : size_(0), capacity_(0), data_(nullptr)
+    {
+        assign_copy_(std::data(init), init.size());
+    }
+
+    /**
+     * @brief Construct a new cow_vec object from the elements of a vec.
+     *
+     * @param other The vector to copy the elements from.
+     */
+    explicit cow_vec(const vec<T>& other) : size_(0), capacity_(0), data_(nullptr)
+    {
+        assign_copy_(other.data(), other.size());
+    }
+
+    /**
+     * @brief Copy constructor. Shares the buffer of @p other, in O(1).
+     *
+     * @param other The vector to copy to this one.
+     */
+    cow_vec(const cow_vec& other) noexcept :
+        size_(other.size_), capacity_(other.capacity_), data_(other.data_)
+    {
+        if (data_ != nullptr)
+            header_of_(data_)->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Move constructor.
+     *
+     * @param other The vector to move to this one.
+     */
+    cow_vec(cow_vec&& other) noexcept :
+        size_(std::exchange(other.size_, 0U)),
+        capacity_(std::exchange(other.capacity_, 0U)),
+        data_(std::exchange(other.data_, nullptr))
+    {}
+
+    /**
+     * @brief Copy assignment operator. Shares the buffer of @p other, in O(1).
+     *
+     * @param other The assigned object.
+     * @return The new object.
+     */
+    cow_vec&
+    operator=(const cow_vec& other) noexcept
+    {
+        // Guard self assignment (which includes sharing a buffer already)
+        if (data_ == other.data_)
+            return *this;
+
+        release_();
+
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        data_ = other.data_;
+        if (data_ != nullptr)
+            header_of_(data_)->refs.fetch_add(1, std::memory_order_relaxed);
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * @param other The assigned object.
+     * @return The new object.
+     */
+    cow_vec&
+    operator=(cow_vec&& other) noexcept
+    {
+        // Guard self-assignment
+        if (this == &other)
+            return *this;
+
+        // Free our resources
+        release_();
+
+        // Leave the other in a valid state
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, 0);
+        data_ = std::exchange(other.data_, nullptr);
+
+        return *this;
+    }
+
+    /**
+     * @brief Destroy the cow_vec object. Frees the buffer if it is the last
+     * reference to it.
+     */
+    ~cow_vec() noexcept { release_(); }
+
+#pragma endregion
+
+#pragma region "Sharing"
+
+    /**
+     * @brief Check whether this is the only reference to the buffer.
+     *
+     * @return bool Whether modifications can happen without copying.
+     */
+    [[nodiscard]] inline bool
+    is_unique() const noexcept
+    {
+        return data_ == nullptr
+            || header_of_(data_)->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    /**
+     * @brief Get the number of cow_vec objects sharing the buffer.
+     *
+     * Only a hint while other threads copy or destroy them.
+     *
+     * @return size_type The reference count, or 0 without a buffer.
+     */
+    [[nodiscard]] inline size_type
+    use_count() const noexcept
+    {
+        return data_ == nullptr
+                 ? 0
+                 : header_of_(data_)->refs.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Make sure this vector has a private buffer, copying it if it is
+     * shared.
+     *
+     * @return span<T> Mutable access to all elements, valid until this vector is
+     * copied or changes size.
+     */
+    inline span<T>
+    make_unique()
+    {
+        if (!is_unique())
+            unshare_(capacity_);
+
+        return span<T>(data_, size_);
+    }
+
+    /**
+     * @brief Get mutable access to the nth element, copying the buffer first if
+     * it is shared.
+     *
+     * No bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] inline T&
+    mut(size_type pos)
+    {
+        return make_unique()[pos];
+    }
+
+#pragma endregion
+
+#pragma region "Accessors"
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * No bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @return const T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    operator[](size_type pos) const noexcept
+    {
+        return data_[pos];
+    }
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * Bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @exception std::out_of_range Index out of range of vector.
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    at(size_type pos) const
+    {
+        if (pos >= size_)
+            throw std::out_of_range("cow_vec: index out of range!");
+        return data_[pos];
+    }
+
+    /**
+     * @brief Get the first element.
+     *
+     * @return T& A reference to the first element.
+     */
+    [[nodiscard]] inline const T&
+    front() const noexcept
+    {
+        return data_[0];
+    }
+
+    /**
+     * @brief Get the last element.
+     *
+     * @return T& A reference to the last element.
+     */
+    [[nodiscard]] inline const T&
+    back() const noexcept
+    {
+        return data_[size_ - 1];
+    }
+
+    /**
+     * @brief Get access to the underlying data vector.
+     *
+     * Guaranteed to be valid up to size() elements.
+     *
+     * @return const T* The underlying vector of data.
+     */
+    [[nodiscard]] inline const T*
+    data() const noexcept
+    {
+        return data_;
+    }
+
+#pragma endregion
+
+#pragma region "Capacity"
+
+    /**
+     * @brief Check if the vector is empty.
+     *
+     * @return bool Whether or not the vector is empty.
+     */
+    [[nodiscard]] inline bool
+    empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    /**
+     * @brief Get the size of the vector.
+     *
+     * @return size_type The vector size.
+     */
+    [[nodiscard]] inline size_type
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Get the capacity of the vector.
+     *
+     * @return size_type The vector capacity.
+     */
+    [[nodiscard]] inline size_type
+    capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /**
+     * @brief Resize the vector to be able to hold at least @p new_cap elements.
+     *
+     * Does nothing if the desired capacity is less than the current capacity.
+     * Otherwise this vector ends up with a private buffer.
+     *
+     * @param new_cap The new desired capacity of the vector.
+     */
+    inline void
+    reserve(size_type new_cap)
+    {
+        if (new_cap > capacity_)
+            unshare_(new_cap);
+    }
+
+    /**
+     * @brief Remove any unused space from this vector.
+     *
+     * This sets capacity() to size(), and gives this vector a private buffer.
+     */
+    inline void
+    shrink_to_fit()
+    {
+        if (size_ == 0) {
+            release_();
+            capacity_ = 0;
+        } else if (size_ != capacity_) {
+            unshare_(size_);
+        }
+    }
+
+#pragma endregion
+
+#pragma region "Iterators"
+
+    /**
+     * @brief Get an iterator pointing to the beginning of this vector.
+     *
+     * @return const_iterator The iterator.
+     */
+    [[nodiscard]] inline const_iterator
+    begin() const noexcept
+    {
+        return data_;
+    }
+
+    /**
+     * @brief Get an iterator pointing to the end of this vector.
+     *
+     * @return const_iterator The iterator.
+     */
+    [[nodiscard]] inline const_iterator
+    end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+#pragma endregion
+
+#pragma region "Views"
+
+    /**
+     * @brief View all elements, without copying.
+     *
+     * The view stays valid while this vector keeps its buffer.
+     *
+     * @return span<const T> The view.
+     */
+    [[nodiscard]] inline span<const T>
+    as_span() const noexcept
+    {
+        return span<const T>(data_, size_);
+    }
+
+    /**
+     * @brief View @p count elements starting at @p first, without copying.
+     *
+     * @param first The position of the first viewed element.
+     * @param count How many elements to view.
+     * @exception std::out_of_range The slice does not fit in this vector.
+     * @return span<const T> The subview.
+     */
+    [[nodiscard]] inline span<const T>
+    slice(size_type first, size_type count) const
+    {
+        return as_span().slice(first, count);
+    }
+
+    /**
+     * @brief Split this vector into two views at position @p pos.
+     *
+     * @param pos Where to split the vector.
+     * @exception std::out_of_range @p pos is greater than size().
+     * @return std::pair<span<const T>, span<const T>> Views of `[0, pos)` and
+     * `[pos, size())`.
+     */
+    [[nodiscard]] inline std::pair<span<const T>, span<const T>>
+    split_at(size_type pos) const
+    {
+        return as_span().split_at(pos);
+    }
+
+    /**
+     * @brief Iterate over non-overlapping views of @p size elements.
+     *
+     * @param size How many elements each chunk views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return chunk_range<const T> A range of spans.
+     */
+    [[nodiscard]] inline chunk_range<const T>
+    chunks(size_type size) const
+    {
+        return as_span().chunks(size);
+    }
+
+    /**
+     * @brief Iterate over all overlapping views of @p size elements.
+     *
+     * @param size How many elements each window views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return window_range<const T> A range of spans.
+     */
+    [[nodiscard]] inline window_range<const T>
+    windows(size_type size) const
+    {
+        return as_span().windows(size);
+    }
+
+#pragma endregion
+
+#pragma region "Modifiers"
+
+    /* Everthing here changes vector size, and gives this vector a private buffer */
+
+    /**
+     * @brief Clear the contents of the vector.
+     *
+     * Does not change the capacity of a private buffer. A shared buffer is simply
+     * let go of, without copying it.
+     */
+    inline void
+    clear() noexcept
+    {
+        if (is_unique()) {
+            detail::destroy(data_, size_);
+        } else {
+            release_();
+            capacity_ = 0;
+        }
+
+        size_ = 0;
+    }
+
+    /**
+     * @brief Construct an element in place at position @p pos.
+     *
+     * Can insert one past the end of the vector (at size());
+     *
+     * @tparam Args The types of the constructor arguments.
+     * @param pos The position to insert the element in (zero indexed).
+     * @param args The arguments to construct the element from.
+     * @return const_iterator An iterator pointing to the new element.
+     */
+    template <class... Args>
+    inline const_iterator
+    emplace(size_type pos, Args&&... args)
+    {
+        if (pos == size_ && size_ < capacity_ && is_unique()) {
+            ::new (static_cast<void*>(&data_[pos])) T(std::forward<Args>(args)...);
+            size_++;
+
+            return data_ + pos;
+        }
+
+        // args may refer to an element that is about to be moved
+        T elem(std::forward<Args>(args)...);
+        shift_(pos, 1);
+        fill_gap_(pos, 1, [&](T* where, size_type) {
+            ::new (static_cast<void*>(where)) T(std::move(elem));
+        });
+
+        return data_ + pos;
+    }
+
+    /**
+     * @brief Insert an element @p elem at position @p pos.
+     *
+     * Copies the element into the vector.
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @return const_iterator An iterator pointing to the new element.
+     */
+    inline const_iterator
+    insert(size_type pos, const T& elem)
+    {
+        return emplace(pos, elem);
+    }
+
+    /**
+     * @brief Insert an element @p elem at position @p pos.
+     *
+     * Moves the element into the vector.
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @return const_iterator An iterator pointing to the new element.
+     */
+    inline const_iterator
+    insert(size_type pos, T&& elem)
+    {
+        return emplace(pos, std::move(elem));
+    }
+
+    /**
+     * @brief Insert @p count copies of @p elem at position @p pos.
+     *
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @return const_iterator An iterator pointing to the first element inserted.
+     */
+    inline const_iterator
+    insert(size_type pos, size_type count, const T& elem)
+    {
+        // elem may be one of our own elements, which is about to be moved
+        const T copy(elem);
+        shift_(pos, count);
+        fill_gap_(pos, count, [&](T* where, size_type) {
+            ::new (static_cast<void*>(where)) T(copy);
+        });
+
+        return data_ + pos;
+    }
+
+    /**
+     * @brief Insert @p elems at position @p pos.
+     *
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elems The elements to insert.
+     * @return const_iterator An iterator pointing to the first element inserted.
+     */
+    inline const_iterator
+    insert(size_type pos, std::initializer_list<T> elems)
+    {
+        shift_(pos, elems.size());
+
+        auto* elem_data = std::data(elems);
+        fill_gap_(pos, elems.size(), [&](T* where, size_type i) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            ::new (static_cast<void*>(where)) T(elem_data[i]);
+        });
+
+        return data_ + pos;
+    }
+
+#pragma endregion
+
+#pragma region "Equality operators"
+
+    inline friend bool
+    operator==(const ds::cow_vec<T>& lhs, const ds::cow_vec<T>& rhs)
+    {
+        // Check if they share a buffer
+        if (lhs.data_ == rhs.data_ && lhs.size_ == rhs.size_)
+            return true;
+
+        // Check if the vectors have different sizes
+        if (lhs.size_ != rhs.size_)
+            return false;
+
+        // Finally, check each element
+        for (size_type i = 0; i < lhs.size_; i++) {
+            if (lhs[i] != rhs[i])
+                return false;
+        }
+        return true;
+    }
+
+    inline friend bool
+    operator!=(const ds::cow_vec<T>& lhs, const ds::cow_vec<T>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+#pragma endregion
+};
+
+} // namespace ds
+
+#endif // LIBDS_COW_VEC_HPP
@@ -0,0 +1,107 @@
+/**
+ * @file aligned_alloc.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Allocation with alignments beyond what malloc() guarantees.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_DETAIL_ALIGNED_ALLOC_HPP
+#define LIBDS_DETAIL_ALIGNED_ALLOC_HPP
+
+#include <cstddef>
+#include <cstdlib>
+
+#ifdef _WIN32
+#  include <malloc.h>
+#endif
+
+namespace ds::detail {
+
+/**
+ * @brief Whether @p Alignment is more than malloc() guarantees.
+ */
+template <std::size_t Alignment>
+inline constexpr bool IS_OVER_ALIGNED = Alignment > alignof(std::max_align_t);
+
+/**
+ * @brief Allocate @p size bytes aligned to @p alignment.
+ *
+ * There is no matching realloc(): growing means allocating, copying and freeing.
+ *
+ * @param size How many bytes to allocate.
+ * @param alignment The alignment, a power of two and a multiple of
+ * `sizeof(void*)`.
+ * @return void* The memory, or nullptr if it could not be allocated. Free it
+ * with aligned_free().
+ */
+[[nodiscard]] inline void*
+aligned_malloc(std::size_t size, std::size_t alignment) noexcept
+{
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    void* ptr = nullptr;
+    return ::posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+#endif
+}
+
+/**
+ * @brief Free memory from aligned_malloc().
+ *
+ * @param ptr The memory, or nullptr.
+ */
+inline void
+aligned_free(void* ptr) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+#endif
+}
+
+/**
+ * @brief Tell the compiler that @p ptr is aligned to @p Alignment bytes, so it
+ * can use aligned vector instructions on it.
+ *
+ * @tparam Alignment The alignment, a power of two.
+ * @param ptr The pointer, which must be aligned (or nullptr).
+ * @return T* The same pointer.
+ */
+template <std::size_t Alignment, class T>
+[[nodiscard]] inline T*
+assume_aligned(T* ptr) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<T*>(__builtin_assume_aligned(ptr, Alignment));
+#else
+    return ptr;
+#endif
+}
+
+} // namespace ds::detail
+
+#endif // LIBDS_DETAIL_ALIGNED_ALLOC_HPP
@@ -0,0 +1,216 @@
+/**
+ * @file index_iterator.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Random access iterators for containers that are indexed, not walked.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_DETAIL_INDEX_ITERATOR_HPP
+#define LIBDS_DETAIL_INDEX_ITERATOR_HPP
+
+#include <cstddef>
+
+#include <iterator>
+#include <type_traits>
+
+namespace ds::detail {
+
+/**
+ * @brief A random access iterator that holds a container and a position, and
+ * goes through the container's `operator[]`.
+ *
+ * For containers whose elements are not in one contiguous array (like
+ * ds::gap_vec), so a plain pointer cannot be used.
+ *
+ * @tparam Owner The container, const-qualified for const iterators.
+ * @tparam Elem The element type, const-qualified for const iterators.
+ */
+template <class Owner, class Elem>
+class index_iterator {
+    Owner* owner_;
+    std::size_t pos_;
+
+ public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<Elem>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Elem*;
+    using reference = Elem&;
+
+ private:
+    /**
+     * @brief The position @p off places away from this one.
+     */
+    [[nodiscard]] constexpr std::size_t
+    offset_(difference_type off) const noexcept
+    {
+        return static_cast<std::size_t>(static_cast<difference_type>(pos_) + off);
+    }
+
+ public:
+    constexpr index_iterator() noexcept : owner_(nullptr), pos_(0) {}
+
+    constexpr index_iterator(Owner* owner, std::size_t pos) noexcept :
+        owner_(owner), pos_(pos)
+    {}
+
+    /**
+     * @brief Convert a mutable iterator to a const one.
+     */
+    template <class O = Owner, std::enable_if_t<!std::is_const_v<O>, int> = 0>
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    constexpr operator index_iterator<const O, const Elem>() const noexcept
+    {
+        return {owner_, pos_};
+    }
+
+    [[nodiscard]] constexpr reference
+    operator*() const noexcept
+    {
+        return (*owner_)[pos_];
+    }
+
+    [[nodiscard]] constexpr pointer
+    operator->() const noexcept
+    {
+        return &(*owner_)[pos_];
+    }
+
+    [[nodiscard]] constexpr reference
+    operator[](difference_type off) const noexcept
+    {
+        return (*owner_)[offset_(off)];
+    }
+
+    constexpr index_iterator&
+    operator++() noexcept
+    {
+        ++pos_;
+        return *this;
+    }
+
+    constexpr index_iterator
+    operator++(int) noexcept
+    {
+        index_iterator prev = *this;
+        ++pos_;
+        return prev;
+    }
+
+    constexpr index_iterator&
+    operator--() noexcept
+    {
+        --pos_;
+        return *this;
+    }
+
+    constexpr index_iterator
+    operator--(int) noexcept
+    {
+        index_iterator prev = *this;
+        --pos_;
+        return prev;
+    }
+
+    constexpr index_iterator&
+    operator+=(difference_type off) noexcept
+    {
+        pos_ = offset_(off);
+        return *this;
+    }
+
+    constexpr index_iterator&
+    operator-=(difference_type off) noexcept
+    {
+        pos_ = offset_(-off);
+        return *this;
+    }
+
+    [[nodiscard]] constexpr friend index_iterator
+    operator+(index_iterator it, difference_type off) noexcept
+    {
+        return it += off;
+    }
+
+    [[nodiscard]] constexpr friend index_iterator
+    operator+(difference_type off, index_iterator it) noexcept
+    {
+        return it += off;
+    }
+
+    [[nodiscard]] constexpr friend index_iterator
+    operator-(index_iterator it, difference_type off) noexcept
+    {
+        return it -= off;
+    }
+
+    [[nodiscard]] constexpr friend difference_type
+    operator-(const index_iterator& lhs, const index_iterator& rhs) noexcept
+    {
+        return static_cast<difference_type>(lhs.pos_)
+             - static_cast<difference_type>(rhs.pos_);
+    }
+
+    [[nodiscard]] constexpr friend bool
+    operator==(const index_iterator& lhs, const index_iterator& rhs) noexcept
+    {
+        return lhs.pos_ == rhs.pos_;
+    }
+
+    [[nodiscard]] constexpr friend bool
+    operator!=(const index_iterator& lhs, const index_iterator& rhs) noexcept
+    {
+        return lhs.pos_ != rhs.pos_;
+    }
+
+    [[nodiscard]] constexpr friend bool
+    operator<(const index_iterator& lhs, const index_iterator& rhs) noexcept
+    {
+        return lhs.pos_ < rhs.pos_;
+    }
+
+    [[nodiscard]] constexpr friend bool
+    operator>(const index_iterator& lhs, const index_iterator& rhs) noexcept
+    {
+        return lhs.pos_ > rhs.pos_;
+    }
+
+    [[nodiscard]] constexpr friend bool
+    operator<=(const index_iterator& lhs, const index_iterator& rhs) noexcept
+    {
+        return lhs.pos_ <= rhs.pos_;
+    }
+
+    [[nodiscard]] constexpr friend bool
+    operator>=(const index_iterator& lhs, const index_iterator& rhs) noexcept
+    {
+        return lhs.pos_ >= rhs.pos_;
+    }
+};
+
+} // namespace ds::detail
+
+#endif // LIBDS_DETAIL_INDEX_ITERATOR_HPP
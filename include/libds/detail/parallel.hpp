@@ -0,0 +1,95 @@
+/**
+ * @file parallel.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Split a loop over a few threads.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_DETAIL_PARALLEL_HPP
+#define LIBDS_DETAIL_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+namespace ds::detail {
+
+/**
+ * @brief Split `[0, count)` into @p threads contiguous chunks of (almost) equal
+ * size, and call `fn(first, last)` for each chunk on its own thread.
+ *
+ * The calling thread does the first chunk and waits for the others. If a thread
+ * cannot be started, the calling thread does its chunk instead, so this never
+ * fails. Uses `std::thread`, so link with `Threads::Threads` when passing more
+ * than one thread.
+ *
+ * @tparam Fn Callable as `fn(std::size_t first, std::size_t last)`, which must not
+ * throw.
+ * @param count How many items there are.
+ * @param threads How many threads to use, at most.
+ * @param fn Processes the items in `[first, last)`.
+ */
+template <class Fn>
+inline void
+parallel_chunks(std::size_t count, std::size_t threads, Fn fn)
+{
+    threads = std::max<std::size_t>(1, std::min(threads, count));
+    if (threads == 1) {
+        fn(0, count);
+        return;
+    }
+
+    auto bound = [&](std::size_t i) {
+        return count / threads * i + std::min(i, count % threads);
+    };
+
+    std::unique_ptr<std::thread[]> workers;
+    try {
+        workers = std::make_unique<std::thread[]>(threads - 1);
+    } catch (...) {
+        fn(0, count);
+        return;
+    }
+
+    for (std::size_t i = 1; i < threads; i++) {
+        try {
+            workers[i - 1] = std::thread(fn, bound(i), bound(i + 1));
+        } catch (...) {
+            fn(bound(i), bound(i + 1));
+        }
+    }
+
+    fn(0, bound(1));
+    for (std::size_t i = 0; i + 1 < threads; i++) {
+        if (workers[i].joinable())
+            workers[i].join();
+    }
+}
+
+} // namespace ds::detail
+
+#endif // LIBDS_DETAIL_PARALLEL_HPP
@@ -0,0 +1,199 @@
+/**
+ * @file relocate.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Moving elements between raw buffers.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_DETAIL_RELOCATE_HPP
+#define LIBDS_DETAIL_RELOCATE_HPP
+
+#include <cstddef>
+#include <cstring>
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ds::detail {
+
+/**
+ * @brief Whether elements of @p T can be moved around with plain memory copies.
+ *
+ * @tparam T The element type.
+ */
+template <class T>
+inline constexpr bool IS_TRIVIALLY_RELOCATABLE = std::is_trivially_copyable_v<T>;
+
+/**
+ * @brief Destroy @p count elements, leaving uninitialized memory behind.
+ *
+ * @tparam T The element type.
+ * @param first The first element to destroy.
+ * @param count How many elements to destroy.
+ */
+template <class T>
+inline void
+destroy(T* first, std::size_t count) noexcept
+{
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (std::size_t i = 0; i < count; i++)
+            first[i].~T();
+    }
+}
+
+/**
+ * @brief Move @p count elements to another (possibly overlapping) place.
+ *
+ * Afterwards, @p dest holds the elements and @p src is uninitialized memory.
+ * Trivially copyable types are simply memmove()d. Everything else is move
+ * constructed into place and then destroyed, falling back to copying if the
+ * move constructor may throw (like `std::vector`).
+ *
+ * When the ranges overlap, elements that land on other (live) elements are move
+ * assigned instead, so only the places that are left behind get destroyed.
+ *
+ * @tparam T The element type.
+ * @param dest Where to move the elements to.
+ * @param src Where to move the elements from.
+ * @param count How many elements to move.
+ */
+template <class T>
+inline void
+relocate(T* dest, T* src, std::size_t count)
+{
+    if (dest == src || count == 0)
+        return;
+
+    if constexpr (IS_TRIVIALLY_RELOCATABLE<T>) {
+        std::memmove(dest, src, count * sizeof(T));
+        return;
+    } else if constexpr (
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>
+    ) {
+        if (dest < src && static_cast<std::size_t>(src - dest) < count) {
+            // Shifting down: the first dist places are free, the rest are not
+            const auto dist = static_cast<std::size_t>(src - dest);
+            for (std::size_t i = 0; i < dist; i++)
+                ::new (static_cast<void*>(dest + i)) T(std::move(src[i]));
+            std::move(src + dist, src + count, dest + dist);
+            destroy(src + count - dist, dist);
+            return;
+        }
+
+        if (src < dest && static_cast<std::size_t>(dest - src) < count) {
+            // Shifting up: the last dist places are free, the rest are not
+            const auto dist = static_cast<std::size_t>(dest - src);
+            for (std::size_t i = count; i-- > count - dist;)
+                ::new (static_cast<void*>(dest + i)) T(std::move(src[i]));
+            std::move_backward(src, src + count - dist, dest + count - dist);
+            destroy(src, dist);
+            return;
+        }
+    }
+
+    // Walk away from the overlap, so nothing is overwritten before it moved
+    if (dest < src) {
+        for (std::size_t i = 0; i < count; i++) {
+            ::new (static_cast<void*>(dest + i)) T(std::move_if_noexcept(src[i]));
+            src[i].~T();
+        }
+    } else {
+        for (std::size_t i = count; i-- > 0;) {
+            ::new (static_cast<void*>(dest + i)) T(std::move_if_noexcept(src[i]));
+            src[i].~T();
+        }
+    }
+}
+
+/**
+ * @brief Move or copy @p count elements into uninitialized memory that does not
+ * overlap them, leaving the sources alive.
+ *
+ * Elements whose move constructor may throw are copied. If that throws, the copies
+ * made so far are destroyed again.
+ *
+ * @tparam T The element type.
+ * @param dest Where to construct the elements.
+ * @param src The elements to move or copy.
+ * @param count How many elements to move or copy.
+ */
+template <class T>
+inline void
+uninitialized_move_if_noexcept(T* dest, T* src, std::size_t count)
+{
+    if constexpr (IS_TRIVIALLY_RELOCATABLE<T>) {
+        if (count > 0)
+            std::memcpy(dest, src, count * sizeof(T));
+    } else {
+        std::size_t i = 0;
+        try {
+            for (; i < count; i++)
+                ::new (static_cast<void*>(dest + i)) T(std::move_if_noexcept(src[i]));
+        } catch (...) {
+            destroy(dest, i);
+            throw;
+        }
+    }
+}
+
+/**
+ * @brief Move @p count elements into a new buffer, opening a gap on the way.
+ *
+ * Afterwards the first @p pos elements start at @p dest, followed by @p places
+ * elements of uninitialized memory and the rest of the elements, and @p src is
+ * uninitialized memory. Unlike relocate(), the sources are only destroyed once
+ * every element made it: if a copy throws, @p dest is left uninitialized and
+ * @p src as it was.
+ *
+ * @tparam T The element type.
+ * @param dest Where the first element should end up, which must not overlap
+ * @p src.
+ * @param src Where to move the elements from.
+ * @param count How many elements to move.
+ * @param pos Where to open the gap.
+ * @param places How big the gap should be.
+ */
+template <class T>
+inline void
+relocate_to_new(
+    T* dest, T* src, std::size_t count, std::size_t pos = 0, std::size_t places = 0
+)
+{
+    uninitialized_move_if_noexcept(dest, src, pos);
+    try {
+        uninitialized_move_if_noexcept(dest + pos + places, src + pos, count - pos);
+    } catch (...) {
+        destroy(dest, pos);
+        throw;
+    }
+    destroy(src, count);
+}
+
+} // namespace ds::detail
+
+#endif // LIBDS_DETAIL_RELOCATE_HPP
@@ -0,0 +1,132 @@
+/**
+ * @file simd.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Runtime-dispatched x86 SIMD support and prefetching.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_DETAIL_SIMD_HPP
+#define LIBDS_DETAIL_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+
+// Kernels for newer instruction sets are compiled with a target attribute and
+// picked at runtime, so the library does not need -mavx2 (or -march=native) to
+// use them.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#  include <immintrin.h>
+#  define LIBDS_HAS_X86_DISPATCH 1
+#  define LIBDS_TARGET_AVX2 __attribute__((target("avx2,bmi,bmi2,popcnt")))
+#endif
+
+namespace ds::detail {
+
+/**
+ * @brief Check whether the CPU supports AVX2.
+ *
+ * @return bool Whether kernels marked LIBDS_TARGET_AVX2 may run.
+ */
+[[nodiscard]] inline bool
+has_avx2() noexcept
+{
+#ifdef LIBDS_HAS_X86_DISPATCH
+    static const bool HAS = __builtin_cpu_supports("avx2") != 0;
+    return HAS;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Ask for the cache line at @p ptr to be loaded, for reading.
+ *
+ * @param ptr Any address; invalid ones are ignored.
+ */
+inline void
+prefetch(const void* ptr) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(ptr);
+#else
+    static_cast<void>(ptr);
+#endif
+}
+
+/**
+ * @brief Ask for the cache line at @p ptr to be loaded, for writing.
+ *
+ * @param ptr Any address; invalid ones are ignored.
+ */
+inline void
+prefetch_write(const void* ptr) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(ptr, 1);
+#else
+    static_cast<void>(ptr);
+#endif
+}
+
+/**
+ * @brief Build the table for compressing 32-bit lanes: for each mask of lanes
+ * to keep, the indices of those lanes, packed to the front, one byte each.
+ *
+ * @param lane_bits 32 for 32-bit lanes (8 per vector), 64 for 64-bit lanes (4
+ * per vector, each one two 32-bit lanes).
+ */
+template <std::size_t Entries>
+constexpr std::array<std::uint64_t, Entries>
+make_compress_table(std::size_t lane_bits)
+{
+    const std::size_t lanes = 256 / lane_bits;
+    const std::size_t per_lane = lane_bits / 32;
+    std::array<std::uint64_t, Entries> table{};
+    for (std::size_t mask = 0; mask < Entries; mask++) {
+        std::uint64_t entry = 0;
+        std::size_t out = 0;
+        for (std::size_t lane = 0; lane < lanes; lane++) {
+            if ((mask >> lane & 1U) == 0)
+                continue;
+            for (std::size_t half = 0; half < per_lane; half++, out++)
+                entry |= std::uint64_t{lane * per_lane + half} << (out * 8);
+        }
+        table[mask] = entry;
+    }
+    return table;
+}
+
+/**
+ * @brief Compression tables for 32-bit and 64-bit lanes.
+ */
+inline constexpr auto COMPRESS_32 = make_compress_table<256>(32);
+inline constexpr auto COMPRESS_64 = make_compress_table<16>(64);
+
+} // namespace ds::detail
+
+#endif // LIBDS_DETAIL_SIMD_HPP
@@ -0,0 +1,63 @@
+/**
+ * @file type_name.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Human readable type names for diagnostics.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_DETAIL_TYPE_NAME_HPP
+#define LIBDS_DETAIL_TYPE_NAME_HPP
+
+#include <string>
+#include <string_view>
+
+namespace ds::detail {
+
+/**
+ * @brief Get a human readable name for @p T, derived from the compiler's
+ * pretty function signature.
+ *
+ * @return std::string The type name.
+ */
+template <class T>
+[[nodiscard]] inline std::string
+type_name()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    std::string_view sig = __FUNCSIG__;
+    auto start = sig.find("type_name<") + 10;
+    auto end = sig.rfind(">(void)");
+#else
+    std::string_view sig = __PRETTY_FUNCTION__;
+    auto start = sig.find("T = ") + 4;
+    auto end = sig.find_first_of(";]", start);
+#endif
+    return std::string(sig.substr(start, end - start));
+}
+
+} // namespace ds::detail
+
+#endif // LIBDS_DETAIL_TYPE_NAME_HPP
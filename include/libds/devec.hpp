@@ -0,0 +1,1264 @@
+/**
+ * @file devec.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief A vector with spare capacity at both ends.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_DEVEC_HPP
+#define LIBDS_DEVEC_HPP
+
+#include "libds/detail/parallel.hpp"
+#include "libds/detail/relocate.hpp"
+#include "libds/span.hpp"
+
+#include <cstdlib>
+
+#include <functional>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ds {
+
+/**
+ * @brief A double-ended vector, which keeps spare capacity at both ends.
+ *
+ * The elements are contiguous, like in ds::vec, but do not have to start at the
+ * beginning of the buffer. Inserting or erasing shifts whichever side of the
+ * position is smaller, so push_front() and push_back() are both O(1) amortized
+ * and edits in the middle move at most half of the elements.
+ *
+ * When the side that should move has no room left, the elements are laid out
+ * again with the spare capacity split evenly between both ends: in place if at
+ * least a third of the buffer is free, and in a bigger buffer otherwise.
+ *
+ * Apart from the front operations, the API matches ds::vec.
+ *
+ * @tparam T The type of data this vector will hold.
+ */
+template <class T>
+class devec {
+ public:
+    /**
+     * @brief The type of the stored elements.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Unsigned integer type used for indicies.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief A random access iterator to @p T.
+     */
+    using iterator = T*;
+
+    /**
+     * @brief A constant random access iterator to @p T.
+     */
+    using const_iterator = const T*;
+
+ private:
+    size_type size_;
+    size_type capacity_;
+    T* buf_;
+    T* data_;
+
+    static constexpr size_type INITIAL_CAPACITY = 10;
+
+#pragma region "Helpers"
+
+    /**
+     * @brief Get the next capacity of the vector from the current capacity.
+     *
+     * @param cap The current capacity.
+     * @return size_type The next capacity of the vector.
+     */
+    [[nodiscard]] static inline size_type
+    next_capacity_(size_type cap) noexcept
+    {
+        if (cap <= 1)
+            return 2;
+
+        // NOLINTNEXTLINE(hicpp-signed-bitwise): size_type is guaranteed to be unsigned
+        return cap + (cap >> 1);
+    }
+
+    /**
+     * @brief Allocate memory
+     *
+     * @param cap The amount of elements this should be able to hold.
+     * @return A pointer to the (uninitialized) buffer.
+     */
+    [[nodiscard]] static inline T*
+    alloc_(size_type cap)
+    {
+        if (cap == 0)
+            return nullptr;
+
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc,modernize-use-auto)
+        auto* ptr = static_cast<T*>(std::malloc(cap * sizeof(T)));
+        if (ptr == nullptr)
+            throw std::runtime_error("devec: could not allocate memory");
+
+        return ptr;
+    }
+
+    /**
+     * @brief Free the internal array.
+     */
+    inline void
+    free_() noexcept
+    {
+        detail::destroy(data_, size_);
+
+        std::free(buf_); // NOLINT(cppcoreguidelines-no-malloc)
+        buf_ = nullptr;
+        data_ = nullptr;
+    }
+
+    /**
+     * @brief Move the elements to a new place, opening a gap on the way.
+     *
+     * Afterwards the elements before @p pos start at @p dest, followed by
+     * @p places elements of uninitialized memory and the rest of the elements.
+     * @p dest may point into the current buffer.
+     *
+     * @param dest Where the first element should end up.
+     * @param pos Where to open the gap.
+     * @param places How big the gap should be.
+     */
+    inline void
+    move_to_(T* dest, size_type pos, size_type places)
+    {
+        // Move the side that goes towards the other first, so it cannot overwrite
+        // elements that have not moved yet.
+        if (std::less<T*>()(data_, dest)) {
+            detail::relocate(dest + pos + places, data_ + pos, size_ - pos);
+            detail::relocate(dest, data_, pos);
+        } else {
+            detail::relocate(dest, data_, pos);
+            detail::relocate(dest + pos + places, data_ + pos, size_ - pos);
+        }
+
+        data_ = dest;
+    }
+
+    /**
+     * @brief Move the elements into a new buffer of @p new_cap elements, opening a
+     * gap on the way.
+     *
+     * Like move_to_(), but the first element ends up @p front places into the new
+     * buffer. If moving an element throws, the new buffer is freed again and this
+     * vector is left as it was.
+     *
+     * @param new_cap The capacity of the new buffer.
+     * @param front How much spare capacity to leave at the front.
+     * @param pos Where to open the gap.
+     * @param places How big the gap should be.
+     */
+    inline void
+    move_to_new_(size_type new_cap, size_type front, size_type pos, size_type places)
+    {
+        T* ptr = alloc_(new_cap);
+        try {
+            detail::relocate_to_new(ptr + front, data_, size_, pos, places);
+        } catch (...) {
+            std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+            throw;
+        }
+
+        std::free(buf_); // NOLINT(cppcoreguidelines-no-malloc)
+        buf_ = ptr;
+        data_ = ptr + front;
+        capacity_ = new_cap;
+    }
+
+    /**
+     * @brief Lay out the elements again, with the free space split evenly between
+     * both ends.
+     *
+     * Grows the buffer if less than a third of it would be free.
+     *
+     * @param pos Where to open a gap.
+     * @param places How big the gap should be.
+     */
+    inline void
+    relayout_(size_type pos, size_type places)
+    {
+        const size_type needed = size_ + places;
+
+        // Keep at least needed / 2 spare places, so the next relayout is at least
+        // needed / 4 edits away on either side.
+        size_type new_cap = capacity_;
+        while (new_cap < needed || new_cap - needed < needed / 2)
+            new_cap = next_capacity_(new_cap);
+
+        if (new_cap == capacity_) {
+            move_to_(buf_ + (capacity_ - needed) / 2, pos, places);
+            return;
+        }
+
+        move_to_new_(new_cap, (new_cap - needed) / 2, pos, places);
+    }
+
+    /**
+     * @brief Open a gap of @p places uninitialized elements at @p pos.
+     *
+     * Shifts the smaller side of @p pos if it has room, and lays out all elements
+     * again otherwise.
+     *
+     * @param pos Where to open the gap.
+     * @param places How big the gap should be.
+     */
+    inline void
+    open_gap_(size_type pos, size_type places)
+    {
+        const size_type after = size_ - pos;
+        const bool front_fits = front_capacity() >= places;
+        const bool back_fits = back_capacity() >= places;
+
+        if (pos < after ? front_fits : back_fits) {
+            if (pos < after)
+                move_to_(data_ - places, pos, places);
+            else
+                move_to_(data_, pos, places);
+        } else if (pos == after && front_fits) {
+            move_to_(data_ - places, pos, places);
+        } else {
+            relayout_(pos, places);
+        }
+
+        size_ += places;
+    }
+
+    /**
+     * @brief Close a gap of @p places uninitialized elements at @p pos.
+     *
+     * Shifts the smaller side of the gap over it.
+     *
+     * @param pos Where the gap starts.
+     * @param places How big the gap is.
+     */
+    inline void
+    close_gap_(size_type pos, size_type places)
+    {
+        const size_type after = size_ - pos - places;
+
+        if (pos < after) {
+            detail::relocate(data_ + places, data_, pos);
+            data_ += places;
+        } else {
+            detail::relocate(data_ + pos, data_ + pos + places, after);
+        }
+
+        size_ -= places;
+    }
+
+    /**
+     * @brief Construct elements into a gap opened by open_gap_().
+     *
+     * If a constructor throws, the gap is closed again and the exception propagates.
+     *
+     * @tparam Construct Callable as `construct(T* where, size_type index)`.
+     * @param start Where the gap starts.
+     * @param places How big the gap is.
+     * @param construct Constructs the element at index @p index of the gap.
+     */
+    template <class Construct>
+    inline void
+    fill_gap_(size_type start, size_type places, Construct construct)
+    {
+        size_type i = 0;
+        try {
+            for (; i < places; i++)
+                construct(&data_[start + i], i);
+        } catch (...) {
+            detail::destroy(&data_[start], i);
+            close_gap_(start, places);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Copy the elements of @p other onto the end of this vector.
+     *
+     * There must be enough capacity at the back for them already.
+     *
+     * @param other The vector to copy the elements from.
+     */
+    inline void
+    append_copy_(const devec& other)
+    {
+        for (size_type i = 0; i < other.size_; i++, size_++)
+            ::new (static_cast<void*>(&data_[size_])) T(other.data_[i]);
+    }
+
+#pragma endregion
+
+ public:
+#pragma region "Constructors/Destructors and assignment operators"
+
+    /**
+     * @brief Construct a new empty devec object, with a given capacity.
+     *
+     * All of the capacity starts out at the back.
+     *
+     * @param capacity How many elements should this vector be able to hold initially.
+     */
+    explicit devec(size_type capacity = INITIAL_CAPACITY) :
+        size_(0), capacity_(capacity), buf_(alloc_(capacity_)), data_(buf_)
+    {}
+
+    /**
+     * @brief Construct a new devec object with specified size, filled with elements.
+     *
+     * @param size The size of the devec.
+     * @param elem The element to fill the vector with
+     */
+    explicit devec(size_type size, T elem) :
+        size_(0), capacity_(size), buf_(alloc_(capacity_)), data_(buf_)
+    {
+        try {
+            for (; size_ < size; size_++)
+                ::new (static_cast<void*>(&data_[size_])) T(elem);
+        } catch (...) {
+            free_();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Construct a new devec object from an initializer list
+     *
+     * @param init The initializer list with vector elements.
+     */
+    devec(std::initializer_list<T> init) :
+        size_(0), capacity_(init.size()), buf_(alloc_(capacity_)), data_(buf_)
+    {
+        auto init_data = std::data(init);
+        try {
+            for (; size_ < init.size(); size_++) {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                ::new (static_cast<void*>(&data_[size_])) T(init_data[size_]);
+            }
+        } catch (...) {
+            free_();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Copy constructor.
+     *
+     * The copy keeps the capacity, but starts with all of it at the back.
+     *
+     * @param other The vector to copy to this one.
+     */
+    devec(const devec& other) :
+        size_(0), capacity_(other.capacity_), buf_(alloc_(capacity_)), data_(buf_)
+    {
+        try {
+            append_copy_(other);
+        } catch (...) {
+            free_();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Move constructor.
+     *
+     * @param other The vector to move to this one.
+     */
+    devec(devec&& other) noexcept :
+        size_(std::exchange(other.size_, 0U)),
+        capacity_(std::exchange(other.capacity_, 0U)),
+        buf_(std::exchange(other.buf_, nullptr)),
+        data_(std::exchange(other.data_, nullptr))
+    {}
+
+    /**
+     * @brief Copy assignment operator.
+     *
+     * @param other The assigned object.
+     * @return The new object.
+     */
+    devec&
+    operator=(const devec& other)
+    {
+        // Guard self assignment
+        if (this == &other)
+            return *this;
+
+        clear();
+        reserve(other.size_);
+
+        append_copy_(other);
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * @param other The assigned object.
+     * @return The new object.
+     */
+    devec&
+    operator=(devec&& other) noexcept
+    {
+        // Guard self-assignment
+        if (this == &other)
+            return *this;
+
+        // Free our resources
+        free_();
+
+        // Leave the other in a valid state
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, 0);
+        buf_ = std::exchange(other.buf_, nullptr);
+        data_ = std::exchange(other.data_, nullptr);
+
+        return *this;
+    }
+
+    /**
+     * @brief Destroy the devec object. Frees the internal array.
+     */
+    ~devec() noexcept { free_(); }
+
+#pragma endregion
+
+#pragma region "Accessors"
+
+    /**
+     * @brief Get a reference to the nth element.
+     *
+     * No bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] inline T&
+    operator[](size_type pos) noexcept
+    {
+        return data_[pos];
+    }
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * No bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @return const T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    operator[](size_type pos) const noexcept
+    {
+        return data_[pos];
+    }
+
+    /**
+     * @brief Get a reference to the nth element.
+     *
+     * Bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @exception std::out_of_range Index out of range of vector.
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] inline T&
+    at(size_type pos)
+    {
+        if (pos >= size_)
+            throw std::out_of_range("devec: index out of range!");
+        return data_[pos];
+    }
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * Bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @exception std::out_of_range Index out of range of vector.
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    at(size_type pos) const
+    {
+        if (pos >= size_)
+            throw std::out_of_range("devec: index out of range!");
+        return data_[pos];
+    }
+
+    /**
+     * @brief Get the first element.
+     *
+     * @return T& A reference to the first element.
+     */
+    [[nodiscard]] inline T&
+    front() noexcept
+    {
+        return data_[0];
+    }
+
+    /**
+     * @brief Get the first element.
+     *
+     * @return T& A reference to the first element.
+     */
+    [[nodiscard]] inline const T&
+    front() const noexcept
+    {
+        return data_[0];
+    }
+
+    /**
+     * @brief Get the last element.
+     *
+     * @return T& A reference to the last element.
+     */
+    [[nodiscard]] inline T&
+    back() noexcept
+    {
+        return data_[size_ - 1];
+    }
+
+    /**
+     * @brief Get the last element.
+     *
+     * @return T& A reference to the last element.
+     */
+    [[nodiscard]] inline const T&
+    back() const noexcept
+    {
+        return data_[size_ - 1];
+    }
+
+    /**
+     * @brief Get access to the underlying data vector.
+     *
+     * Guaranteed to be valid up to size() elements.
+     *
+     * @return T* The underlying vector of data.
+     */
+    [[nodiscard]] inline T*
+    data() noexcept
+    {
+        return data_;
+    }
+
+    /**
+     * @brief Get access to the underlying data vector.
+     *
+     * Guaranteed to be valid up to size() elements.
+     *
+     * @return const T* The underlying vector of data.
+     */
+    [[nodiscard]] inline const T*
+    data() const noexcept
+    {
+        return data_;
+    }
+
+#pragma endregion
+
+#pragma region "Capacity"
+
+    /**
+     * @brief Check if the vector is empty.
+     *
+     * @return bool Whether or not the vector is empty.
+     */
+    [[nodiscard]] inline bool
+    empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    /**
+     * @brief Get the size of the vector.
+     *
+     * This is the number of used spaces within the vector.
+     *
+     * @return size_type The vector size.
+     */
+    [[nodiscard]] inline size_type
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Get the capacity of the vector.
+     *
+     * This is the total size of the underlying array, including the spare
+     * capacity at both ends.
+     *
+     * @return size_type The vector capacity.
+     */
+    [[nodiscard]] inline size_type
+    capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /**
+     * @brief Get the spare capacity before the first element.
+     *
+     * @return size_type How many elements can be added to the front without moving
+     * any others.
+     */
+    [[nodiscard]] inline size_type
+    front_capacity() const noexcept
+    {
+        return static_cast<size_type>(data_ - buf_);
+    }
+
+    /**
+     * @brief Get the spare capacity after the last element.
+     *
+     * @return size_type How many elements can be added to the back without moving
+     * any others.
+     */
+    [[nodiscard]] inline size_type
+    back_capacity() const noexcept
+    {
+        return capacity_ - front_capacity() - size_;
+    }
+
+    /**
+     * @brief Make room for at least @p new_cap elements, counting from the first
+     * element.
+     *
+     * Like ds::vec::reserve(), afterwards the vector can grow at the back up to
+     * @p new_cap elements without reallocating. The spare capacity at the front is
+     * kept, so capacity() may end up larger than @p new_cap.
+     *
+     * @param new_cap The new desired capacity of the vector.
+     */
+    inline void
+    reserve(size_type new_cap)
+    {
+        if (new_cap <= size_ + back_capacity())
+            return;
+
+        const size_type front = front_capacity();
+        move_to_new_(front + new_cap, front, size_, 0);
+    }
+
+    /**
+     * @brief Remove any unused space from this vector, at both ends.
+     *
+     * This sets capacity() to size();
+     */
+    inline void
+    shrink_to_fit()
+    {
+        if (size_ == capacity_)
+            return;
+
+        move_to_new_(size_, 0, size_, 0);
+    }
+
+#pragma endregion
+
+#pragma region "Iterators"
+
+    /**
+     * @brief Get an iterator pointing to the beginning of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline iterator
+    begin() noexcept
+    {
+        return data_;
+    }
+
+    /**
+     * @brief Get an iterator pointing to the beginning of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline const_iterator
+    begin() const noexcept
+    {
+        return data_;
+    }
+
+    /**
+     * @brief Get an iterator pointing to the end of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline iterator
+    end() noexcept
+    {
+        return data_ + size_;
+    }
+
+    /**
+     * @brief Get an iterator pointing to the end of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline const_iterator
+    end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+#pragma endregion
+
+#pragma region "Views"
+
+    /**
+     * @brief View all elements, without copying.
+     *
+     * @return span<T> The view.
+     */
+    [[nodiscard]] inline span<T>
+    as_span() noexcept
+    {
+        return span<T>(data_, size_);
+    }
+
+    /**
+     * @brief View all elements, without copying.
+     *
+     * @return span<const T> The view.
+     */
+    [[nodiscard]] inline span<const T>
+    as_span() const noexcept
+    {
+        return span<const T>(data_, size_);
+    }
+
+    /**
+     * @brief View @p count elements starting at @p first, without copying.
+     *
+     * The view is invalidated when this vector moves its elements.
+     *
+     * @param first The position of the first viewed element.
+     * @param count How many elements to view.
+     * @exception std::out_of_range The slice does not fit in this vector.
+     * @return span<T> The subview.
+     */
+    [[nodiscard]] inline span<T>
+    slice(size_type first, size_type count)
+    {
+        return as_span().slice(first, count);
+    }
+
+    /**
+     * @brief View @p count elements starting at @p first, without copying.
+     *
+     * The view is invalidated when this vector moves its elements.
+     *
+     * @param first The position of the first viewed element.
+     * @param count How many elements to view.
+     * @exception std::out_of_range The slice does not fit in this vector.
+     * @return span<const T> The subview.
+     */
+    [[nodiscard]] inline span<const T>
+    slice(size_type first, size_type count) const
+    {
+        return as_span().slice(first, count);
+    }
+
+    /**
+     * @brief Split this vector into two views at position @p pos.
+     *
+     * @param pos Where to split the vector.
+     * @exception std::out_of_range @p pos is greater than size().
+     * @return std::pair<span<T>, span<T>> Views of `[0, pos)` and `[pos, size())`.
+     */
+    [[nodiscard]] inline std::pair<span<T>, span<T>>
+    split_at(size_type pos)
+    {
+        return as_span().split_at(pos);
+    }
+
+    /**
+     * @brief Split this vector into two views at position @p pos.
+     *
+     * @param pos Where to split the vector.
+     * @exception std::out_of_range @p pos is greater than size().
+     * @return std::pair<span<const T>, span<const T>> Views of `[0, pos)` and
+     * `[pos, size())`.
+     */
+    [[nodiscard]] inline std::pair<span<const T>, span<const T>>
+    split_at(size_type pos) const
+    {
+        return as_span().split_at(pos);
+    }
+
+    /**
+     * @brief Iterate over non-overlapping views of @p size elements.
+     *
+     * @param size How many elements each chunk views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return chunk_range<T> A range of spans.
+     */
+    [[nodiscard]] inline chunk_range<T>
+    chunks(size_type size)
+    {
+        return as_span().chunks(size);
+    }
+
+    /**
+     * @brief Iterate over non-overlapping views of @p size elements.
+     *
+     * @param size How many elements each chunk views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return chunk_range<const T> A range of spans.
+     */
+    [[nodiscard]] inline chunk_range<const T>
+    chunks(size_type size) const
+    {
+        return as_span().chunks(size);
+    }
+
+    /**
+     * @brief Iterate over all overlapping views of @p size elements.
+     *
+     * @param size How many elements each window views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return window_range<T> A range of spans.
+     */
+    [[nodiscard]] inline window_range<T>
+    windows(size_type size)
+    {
+        return as_span().windows(size);
+    }
+
+    /**
+     * @brief Iterate over all overlapping views of @p size elements.
+     *
+     * @param size How many elements each window views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return window_range<const T> A range of spans.
+     */
+    [[nodiscard]] inline window_range<const T>
+    windows(size_type size) const
+    {
+        return as_span().windows(size);
+    }
+
+#pragma endregion
+
+#pragma region "Modifiers"
+
+    /* Everthing here changes vector size */
+
+    /**
+     * @brief Clear the contents of the vector.
+     *
+     * Does not change the capacity, but moves all of it to the back.
+     */
+    inline void
+    clear() noexcept
+    {
+        detail::destroy(data_, size_);
+
+        size_ = 0;
+        data_ = buf_;
+    }
+
+    /**
+     * @brief Construct an element in place at position @p pos.
+     *
+     * The element is constructed from @p args directly in the vector when
+     * there is spare capacity at the end it is added to. Otherwise it is
+     * constructed first and then moved into the gap, so @p args may safely refer
+     * to elements of this vector.
+     * Can insert one past the end of the vector (at size());
+     *
+     * @tparam Args The types of the constructor arguments.
+     * @param pos The position to insert the element in (zero indexed).
+     * @param args The arguments to construct the element from.
+     * @return An iterator pointing to the new element.
+     */
+    template <class... Args>
+    inline iterator
+    emplace(size_type pos, Args&&... args)
+    {
+        if (pos == size_ && back_capacity() > 0) {
+            ::new (static_cast<void*>(&data_[pos])) T(std::forward<Args>(args)...);
+            size_++;
+
+            return data_ + pos;
+        }
+
+        if (pos == 0 && front_capacity() > 0) {
+            ::new (static_cast<void*>(data_ - 1)) T(std::forward<Args>(args)...);
+            data_--;
+            size_++;
+
+            return data_;
+        }
+
+        T elem(std::forward<Args>(args)...);
+        open_gap_(pos, 1);
+        fill_gap_(pos, 1, [&](T* where, size_type) {
+            ::new (static_cast<void*>(where)) T(std::move(elem));
+        });
+
+        return data_ + pos;
+    }
+
+    /**
+     * @brief Insert an element @p elem at position @p pos.
+     *
+     * Copies the element into the vector.
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @return An iterator pointing to the new element.
+     */
+    inline iterator
+    insert(size_type pos, const T& elem)
+    {
+        return emplace(pos, elem);
+    }
+
+    /**
+     * @brief Insert an element @p elem at position @p pos.
+     *
+     * Moves the element into the vector.
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @return An iterator pointing to the new element.
+     */
+    inline iterator
+    insert(size_type pos, T&& elem)
+    {
+        return emplace(pos, std::move(elem));
+    }
+
+    /**
+     * @brief Insert @p count copies of @p elem at position @p pos.
+     *
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @return An iterator pointing to the first element inserted.
+     */
+    inline iterator
+    insert(size_type pos, size_type count, const T& elem)
+    {
+        // elem may be one of our own elements, which open_gap_() is about to move
+        const T copy(elem);
+        open_gap_(pos, count);
+        fill_gap_(pos, count, [&](T* where, size_type) {
+            ::new (static_cast<void*>(where)) T(copy);
+        });
+
+        return data_ + pos;
+    }
+
+    /**
+     * @brief Insert @p elems at position @p pos.
+     *
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elems The elements to insert.
+     * @return An iterator pointing to the first element inserted.
+     */
+    inline iterator
+    insert(size_type pos, std::initializer_list<T> elems)
+    {
+        open_gap_(pos, elems.size());
+
+        auto* elem_data = std::data(elems);
+        fill_gap_(pos, elems.size(), [&](T* where, size_type i) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            ::new (static_cast<void*>(where)) T(elem_data[i]);
+        });
+
+        return data_ + pos;
+    }
+
+    /**
+     * @brief Construct an element in place at the front of the vector.
+     *
+     * O(1) amortized.
+     *
+     * @tparam Args The types of the constructor arguments.
+     * @param args The arguments to construct the element from.
+     * @return T& The new element.
+     */
+    template <class... Args>
+    inline T&
+    emplace_front(Args&&... args)
+    {
+        return *emplace(0, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Construct an element in place at the back of the vector.
+     *
+     * O(1) amortized.
+     *
+     * @tparam Args The types of the constructor arguments.
+     * @param args The arguments to construct the element from.
+     * @return T& The new element.
+     */
+    template <class... Args>
+    inline T&
+    emplace_back(Args&&... args)
+    {
+        return *emplace(size_, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Add an element to the front of the vector.
+     *
+     * @param elem The element to add.
+     */
+    inline void
+    push_front(const T& elem)
+    {
+        emplace(0, elem);
+    }
+
+    /**
+     * @brief Add an element to the front of the vector.
+     *
+     * @param elem The element to add.
+     */
+    inline void
+    push_front(T&& elem)
+    {
+        emplace(0, std::move(elem));
+    }
+
+    /**
+     * @brief Add an element to the back of the vector.
+     *
+     * @param elem The element to add.
+     */
+    inline void
+    push_back(const T& elem)
+    {
+        emplace(size_, elem);
+    }
+
+    /**
+     * @brief Add an element to the back of the vector.
+     *
+     * @param elem The element to add.
+     */
+    inline void
+    push_back(T&& elem)
+    {
+        emplace(size_, std::move(elem));
+    }
+
+    /**
+     * @brief Resize the vector to @p count elements.
+     *
+     * Removes elements from the end, or appends value-initialized ones.
+     *
+     * @param count The new size.
+     */
+    inline void
+    resize(size_type count)
+    {
+        if (count <= size_) {
+            while (size_ > count)
+                pop_back();
+            return;
+        }
+
+        const size_type start = size_;
+        open_gap_(start, count - start);
+        fill_gap_(start, count - start, [](T* where, size_type) {
+            ::new (static_cast<void*>(where)) T();
+        });
+    }
+
+    /**
+     * @brief Resize the vector to @p count elements.
+     *
+     * Removes elements from the end, or appends copies of @p elem, split over
+     * @p threads threads like ds::vec::resize(). Elements whose copy constructor
+     * can throw are always copied on the calling thread.
+     *
+     * @param count The new size.
+     * @param elem The element to append copies of.
+     * @param threads How many threads to copy with. Uses `std::thread`, so link
+     * with `Threads::Threads` when passing more than one.
+     */
+    inline void
+    resize(size_type count, const T& elem, size_type threads = 1)
+    {
+        if (count <= size_) {
+            while (size_ > count)
+                pop_back();
+            return;
+        }
+
+        // elem may be one of our own elements, which open_gap_() may move
+        const T copy(elem);
+        const size_type start = size_;
+        open_gap_(start, count - start);
+
+        if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+            auto fill = [&](size_type first, size_type last) {
+                for (; first < last; first++)
+                    ::new (static_cast<void*>(&data_[start + first])) T(copy);
+            };
+            detail::parallel_chunks(count - start, threads, fill);
+        } else {
+            fill_gap_(start, count - start, [&](T* where, size_type) {
+                ::new (static_cast<void*>(where)) T(copy);
+            });
+        }
+    }
+
+    /**
+     * @brief Resize the vector to @p count elements, for a caller that is about
+     * to overwrite the new ones.
+     *
+     * Like resize(), but appended elements are default-initialized, so trivial
+     * ones are left uninitialized instead of being zeroed first.
+     *
+     * @param count The new size.
+     */
+    inline void
+    resize_for_overwrite(size_type count)
+    {
+        if (count <= size_) {
+            while (size_ > count)
+                pop_back();
+            return;
+        }
+
+        const size_type start = size_;
+        open_gap_(start, count - start);
+        if constexpr (!std::is_trivially_default_constructible_v<T>) {
+            fill_gap_(start, count - start, [](T* where, size_type) {
+                ::new (static_cast<void*>(where)) T;
+            });
+        }
+    }
+
+    /**
+     * @brief Remove @p count elements starting at position @p pos.
+     *
+     * Shifts whichever side of the removed elements is smaller.
+     *
+     * @param pos The position of the first element to remove.
+     * @param count How many elements to remove.
+     * @exception std::out_of_range The elements are not all in this vector.
+     * @return An iterator pointing to the element after the removed ones.
+     */
+    inline iterator
+    erase(size_type pos, size_type count = 1)
+    {
+        if (pos > size_ || count > size_ - pos)
+            throw std::out_of_range("devec: erase out of range!");
+
+        detail::destroy(&data_[pos], count);
+        close_gap_(pos, count);
+
+        return data_ + pos;
+    }
+
+    /**
+     * @brief Remove the first element.
+     *
+     * The vector must not be empty. O(1).
+     */
+    inline void
+    pop_front() noexcept
+    {
+        data_[0].~T();
+        data_++;
+        size_--;
+    }
+
+    /**
+     * @brief Remove the last element.
+     *
+     * The vector must not be empty. O(1).
+     */
+    inline void
+    pop_back() noexcept
+    {
+        data_[size_ - 1].~T();
+        size_--;
+    }
+
+#pragma endregion
+
+#pragma region "Equality operators"
+
+    inline friend bool
+    operator==(const ds::devec<T>& lhs, const ds::devec<T>& rhs)
+    {
+        // Check if they are the same object
+        if (&lhs == &rhs)
+            return true;
+
+        // Check if the vectors have different sizes
+        if (lhs.size_ != rhs.size_)
+            return false;
+
+        // Finally, check each element
+        for (size_type i = 0; i < lhs.size_; i++) {
+            if (lhs[i] != rhs[i])
+                return false;
+        }
+        return true;
+    }
+
+    inline friend bool
+    operator!=(const ds::devec<T>& lhs, const ds::devec<T>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+#pragma endregion
+};
+
+} // namespace ds
+
+#endif // LIBDS_DEVEC_HPP
@@ -0,0 +1,941 @@
+/**
+ * @file gap_vec.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief A gap buffer, for repeated edits around a cursor.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_GAP_VEC_HPP
+#define LIBDS_GAP_VEC_HPP
+
+#include "libds/detail/index_iterator.hpp"
+#include "libds/detail/relocate.hpp"
+#include "libds/span.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace ds {
+
+/**
+ * @brief A gap buffer: a vector with a movable hole in the middle.
+ *
+ * The spare capacity sits between the elements, at the position of the last
+ * edit. Inserting or erasing at the gap is O(1) amortized, and editing anywhere
+ * else first moves the gap there, which costs O(distance) instead of the
+ * O(size() - pos) of ds::vec::insert(). Repeated edits around a moving cursor
+ * therefore only pay for how far the cursor moves.
+ *
+ * The elements are stored in two contiguous halves, before_gap() and
+ * after_gap(). Indexing has to check which half an element is in;
+ * make_contiguous() moves the gap to the end when a single span is needed.
+ *
+ * @tparam T The type of data this vector will hold.
+ */
+template <class T>
+class gap_vec {
+ public:
+    /**
+     * @brief The type of the stored elements.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Unsigned integer type used for indicies.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief A random access iterator to @p T.
+     */
+    using iterator = detail::index_iterator<gap_vec, T>;
+
+    /**
+     * @brief A constant random access iterator to @p T.
+     */
+    using const_iterator = detail::index_iterator<const gap_vec, const T>;
+
+ private:
+    size_type capacity_;
+    size_type gap_start_;
+    size_type gap_end_;
+    T* buf_;
+
+    static constexpr size_type INITIAL_CAPACITY = 10;
+
+#pragma region "Helpers"
+
+    /**
+     * @brief Get the next capacity of the vector from the current capacity.
+     *
+     * @param cap The current capacity.
+     * @return size_type The next capacity of the vector.
+     */
+    [[nodiscard]] static inline size_type
+    next_capacity_(size_type cap) noexcept
+    {
+        if (cap <= 1)
+            return 2;
+
+        // NOLINTNEXTLINE(hicpp-signed-bitwise): size_type is guaranteed to be unsigned
+        return cap + (cap >> 1);
+    }
+
+    /**
+     * @brief Allocate memory
+     *
+     * @param cap The amount of elements this should be able to hold.
+     * @return A pointer to the (uninitialized) buffer.
+     */
+    [[nodiscard]] static inline T*
+    alloc_(size_type cap)
+    {
+        if (cap == 0)
+            return nullptr;
+
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc,modernize-use-auto)
+        auto* ptr = static_cast<T*>(std::malloc(cap * sizeof(T)));
+        if (ptr == nullptr)
+            throw std::runtime_error("gap_vec: could not allocate memory");
+
+        return ptr;
+    }
+
+    /**
+     * @brief Free the internal array.
+     */
+    inline void
+    free_() noexcept
+    {
+        detail::destroy(buf_, gap_start_);
+        detail::destroy(buf_ + gap_end_, capacity_ - gap_end_);
+
+        std::free(buf_); // NOLINT(cppcoreguidelines-no-malloc)
+        buf_ = nullptr;
+    }
+
+    /**
+     * @brief Get the number of elements after the gap.
+     *
+     * @return size_type The size of after_gap().
+     */
+    [[nodiscard]] inline size_type
+    tail_size_() const noexcept
+    {
+        return capacity_ - gap_end_;
+    }
+
+    /**
+     * @brief Move the elements into a new buffer, keeping the gap where it is.
+     *
+     * @param new_cap The capacity of the new buffer.
+     */
+    inline void
+    resize_(size_type new_cap)
+    {
+        T* ptr = alloc_(new_cap);
+        const size_type tail = tail_size_();
+
+        // Only destroy the old elements once all of them made it
+        try {
+            detail::uninitialized_move_if_noexcept(ptr, buf_, gap_start_);
+            try {
+                detail::uninitialized_move_if_noexcept(
+                    ptr + new_cap - tail, buf_ + gap_end_, tail
+                );
+            } catch (...) {
+                detail::destroy(ptr, gap_start_);
+                throw;
+            }
+        } catch (...) {
+            std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+            throw;
+        }
+        detail::destroy(buf_, gap_start_);
+        detail::destroy(buf_ + gap_end_, tail);
+
+        std::free(buf_); // NOLINT(cppcoreguidelines-no-malloc)
+        buf_ = ptr;
+        gap_end_ = new_cap - tail;
+        capacity_ = new_cap;
+    }
+
+    /**
+     * @brief Make sure the gap can hold at least @p places elements.
+     *
+     * @param places How many elements are about to be inserted.
+     */
+    inline void
+    grow_gap_(size_type places)
+    {
+        if (gap_size() >= places)
+            return;
+
+        size_type new_cap = capacity_;
+        while (new_cap - size() < places)
+            new_cap = next_capacity_(new_cap);
+
+        resize_(new_cap);
+    }
+
+    /**
+     * @brief Copy the elements of @p other into this (empty) vector, with the gap
+     * at the same position.
+     *
+     * Our capacity must be at least the capacity of @p other.
+     *
+     * @param other The vector to copy the elements from.
+     */
+    inline void
+    copy_from_(const gap_vec& other)
+    {
+        for (; gap_start_ < other.gap_start_; gap_start_++)
+            ::new (static_cast<void*>(&buf_[gap_start_])) T(other.buf_[gap_start_]);
+
+        const size_type tail = other.tail_size_();
+        for (size_type i = tail; i-- > 0; gap_end_--) {
+            ::new (static_cast<void*>(&buf_[gap_end_ - 1]))
+                T(other.buf_[other.gap_end_ + i]);
+        }
+    }
+
+#pragma endregion
+
+ public:
+#pragma region "Constructors/Destructors and assignment operators"
+
+    /**
+     * @brief Construct a new empty gap_vec object, with a given capacity.
+     *
+     * @param capacity How many elements should this vector be able to hold initially.
+     */
+    explicit gap_vec(size_type capacity = INITIAL_CAPACITY) :
+        capacity_(capacity), gap_start_(0), gap_end_(capacity), buf_(alloc_(capacity_))
+    {}
+
+    /**
+     * @brief Construct a new gap_vec object with specified size, filled with
+     * elements.
+     *
+     * The gap starts out empty, at the end.
+     *
+     * @param size The size of the gap_vec.
+     * @param elem The element to fill the vector with
+     */
+    explicit gap_vec(size_type size, T elem) :
+        capacity_(size), gap_start_(0), gap_end_(size), buf_(alloc_(capacity_))
+    {
+        try {
+            for (; gap_start_ < size; gap_start_++)
+                ::new (static_cast<void*>(&buf_[gap_start_])) T(elem);
+        } catch (...) {
+            free_();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Construct a new gap_vec object from an initializer list
+     *
+     * The gap starts out empty, at the end.
+     *
+     * @param init The initializer list with vector elements.
+     */
+    gap_vec(std::initializer_list<T> init) :
+        capacity_(init.size()),
+        gap_start_(0),
+        gap_end_(init.size()),
+        buf_(alloc_(capacity_))
+    {
+        auto init_data = std::data(init);
+        try {
+            for (; gap_start_ < init.size(); gap_start_++) {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                ::new (static_cast<void*>(&buf_[gap_start_])) T(init_data[gap_start_]);
+            }
+        } catch (...) {
+            free_();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Copy constructor.
+     *
+     * The copy has the same capacity, and its gap in the same place.
+     *
+     * @param other The vector to copy to this one.
+     */
+    gap_vec(const gap_vec& other) :
+        capacity_(other.capacity_),
+        gap_start_(0),
+        gap_end_(other.capacity_),
+        buf_(alloc_(capacity_))
+    {
+        try {
+            copy_from_(other);
+        } catch (...) {
+            free_();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Move constructor.
+     *
+     * @param other The vector to move to this one.
+     */
+    gap_vec(gap_vec&& other) noexcept :
+        capacity_(std::exchange(other.capacity_, 0U)),
+        gap_start_(std::exchange(other.gap_start_, 0U)),
+        gap_end_(std::exchange(other.gap_end_, 0U)),
+        buf_(std::exchange(other.buf_, nullptr))
+    {}
+
+    /**
+     * @brief Copy assignment operator.
+     *
+     * @param other The assigned object.
+     * @return The new object.
+     */
+    gap_vec&
+    operator=(const gap_vec& other)
+    {
+        // Guard self assignment
+        if (this == &other)
+            return *this;
+
+        clear();
+        if (capacity_ < other.capacity_)
+            resize_(other.capacity_);
+
+        copy_from_(other);
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * @param other The assigned object.
+     * @return The new object.
+     */
+    gap_vec&
+    operator=(gap_vec&& other) noexcept
+    {
+        // Guard self-assignment
+        if (this == &other)
+            return *this;
+
+        // Free our resources
+        free_();
+
+        // Leave the other in a valid state
+        capacity_ = std::exchange(other.capacity_, 0);
+        gap_start_ = std::exchange(other.gap_start_, 0);
+        gap_end_ = std::exchange(other.gap_end_, 0);
+        buf_ = std::exchange(other.buf_, nullptr);
+
+        return *this;
+    }
+
+    /**
+     * @brief Destroy the gap_vec object. Frees the internal array.
+     */
+    ~gap_vec() noexcept { free_(); }
+
+#pragma endregion
+
+#pragma region "Accessors"
+
+    /**
+     * @brief Get a reference to the nth element.
+     *
+     * No bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] inline T&
+    operator[](size_type pos) noexcept
+    {
+        return pos < gap_start_ ? buf_[pos] : buf_[pos - gap_start_ + gap_end_];
+    }
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * No bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @return const T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    operator[](size_type pos) const noexcept
+    {
+        return pos < gap_start_ ? buf_[pos] : buf_[pos - gap_start_ + gap_end_];
+    }
+
+    /**
+     * @brief Get a reference to the nth element.
+     *
+     * Bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @exception std::out_of_range Index out of range of vector.
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] inline T&
+    at(size_type pos)
+    {
+        if (pos >= size())
+            throw std::out_of_range("gap_vec: index out of range!");
+        return (*this)[pos];
+    }
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * Bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @exception std::out_of_range Index out of range of vector.
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    at(size_type pos) const
+    {
+        if (pos >= size())
+            throw std::out_of_range("gap_vec: index out of range!");
+        return (*this)[pos];
+    }
+
+    /**
+     * @brief Get the first element.
+     *
+     * @return T& A reference to the first element.
+     */
+    [[nodiscard]] inline T&
+    front() noexcept
+    {
+        return (*this)[0];
+    }
+
+    /**
+     * @brief Get the first element.
+     *
+     * @return T& A reference to the first element.
+     */
+    [[nodiscard]] inline const T&
+    front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    /**
+     * @brief Get the last element.
+     *
+     * @return T& A reference to the last element.
+     */
+    [[nodiscard]] inline T&
+    back() noexcept
+    {
+        return (*this)[size() - 1];
+    }
+
+    /**
+     * @brief Get the last element.
+     *
+     * @return T& A reference to the last element.
+     */
+    [[nodiscard]] inline const T&
+    back() const noexcept
+    {
+        return (*this)[size() - 1];
+    }
+
+#pragma endregion
+
+#pragma region "Capacity"
+
+    /**
+     * @brief Check if the vector is empty.
+     *
+     * @return bool Whether or not the vector is empty.
+     */
+    [[nodiscard]] inline bool
+    empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Get the size of the vector.
+     *
+     * This is the number of elements on both sides of the gap.
+     *
+     * @return size_type The vector size.
+     */
+    [[nodiscard]] inline size_type
+    size() const noexcept
+    {
+        return gap_start_ + tail_size_();
+    }
+
+    /**
+     * @brief Get the capacity of the vector.
+     *
+     * This is the total size of the underlying array, including the gap.
+     *
+     * @return size_type The vector capacity.
+     */
+    [[nodiscard]] inline size_type
+    capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /**
+     * @brief Get the position of the gap.
+     *
+     * This is the number of elements before the gap, where the next edit is O(1).
+     *
+     * @return size_type The gap position.
+     */
+    [[nodiscard]] inline size_type
+    gap_position() const noexcept
+    {
+        return gap_start_;
+    }
+
+    /**
+     * @brief Get the size of the gap.
+     *
+     * @return size_type How many elements can be inserted without reallocating.
+     */
+    [[nodiscard]] inline size_type
+    gap_size() const noexcept
+    {
+        return gap_end_ - gap_start_;
+    }
+
+    /**
+     * @brief Resize the vector to be able to hold at least @p new_cap elements.
+     *
+     * Does nothing if the desired capacity is less than the current capacity. The
+     * gap stays where it is.
+     *
+     * @param new_cap The new desired capacity of the vector.
+     */
+    inline void
+    reserve(size_type new_cap)
+    {
+        if (new_cap > capacity_)
+            resize_(new_cap);
+    }
+
+    /**
+     * @brief Remove the gap.
+     *
+     * This sets capacity() to size();
+     */
+    inline void
+    shrink_to_fit()
+    {
+        if (gap_size() != 0)
+            resize_(size());
+    }
+
+#pragma endregion
+
+#pragma region "Iterators"
+
+    /**
+     * @brief Get an iterator pointing to the beginning of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline iterator
+    begin() noexcept
+    {
+        return {this, 0};
+    }
+
+    /**
+     * @brief Get an iterator pointing to the beginning of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline const_iterator
+    begin() const noexcept
+    {
+        return {this, 0};
+    }
+
+    /**
+     * @brief Get an iterator pointing to the end of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline iterator
+    end() noexcept
+    {
+        return {this, size()};
+    }
+
+    /**
+     * @brief Get an iterator pointing to the end of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline const_iterator
+    end() const noexcept
+    {
+        return {this, size()};
+    }
+
+#pragma endregion
+
+#pragma region "Views"
+
+    /**
+     * @brief View the elements before the gap, without copying.
+     *
+     * The view is invalidated when the gap moves.
+     *
+     * @return span<T> Elements `[0, gap_position())`.
+     */
+    [[nodiscard]] inline span<T>
+    before_gap() noexcept
+    {
+        return span<T>(buf_, gap_start_);
+    }
+
+    /**
+     * @brief View the elements before the gap, without copying.
+     *
+     * The view is invalidated when the gap moves.
+     *
+     * @return span<const T> Elements `[0, gap_position())`.
+     */
+    [[nodiscard]] inline span<const T>
+    before_gap() const noexcept
+    {
+        return span<const T>(buf_, gap_start_);
+    }
+
+    /**
+     * @brief View the elements after the gap, without copying.
+     *
+     * The view is invalidated when the gap moves.
+     *
+     * @return span<T> Elements `[gap_position(), size())`.
+     */
+    [[nodiscard]] inline span<T>
+    after_gap() noexcept
+    {
+        return span<T>(buf_ + gap_end_, tail_size_());
+    }
+
+    /**
+     * @brief View the elements after the gap, without copying.
+     *
+     * The view is invalidated when the gap moves.
+     *
+     * @return span<const T> Elements `[gap_position(), size())`.
+     */
+    [[nodiscard]] inline span<const T>
+    after_gap() const noexcept
+    {
+        return span<const T>(buf_ + gap_end_, tail_size_());
+    }
+
+    /**
+     * @brief View both halves, without copying.
+     *
+     * @return std::pair<span<T>, span<T>> before_gap() and after_gap().
+     */
+    [[nodiscard]] inline std::pair<span<T>, span<T>>
+    halves() noexcept
+    {
+        return {before_gap(), after_gap()};
+    }
+
+    /**
+     * @brief View both halves, without copying.
+     *
+     * @return std::pair<span<const T>, span<const T>> before_gap() and
+     * after_gap().
+     */
+    [[nodiscard]] inline std::pair<span<const T>, span<const T>>
+    halves() const noexcept
+    {
+        return {before_gap(), after_gap()};
+    }
+
+    /**
+     * @brief Move the gap to the end, and view all elements as one span.
+     *
+     * O(size() - gap_position()).
+     *
+     * @return span<T> All elements.
+     */
+    [[nodiscard]] inline span<T>
+    make_contiguous()
+    {
+        move_gap(size());
+        return before_gap();
+    }
+
+#pragma endregion
+
+#pragma region "Modifiers"
+
+    /* Everthing here changes vector size */
+
+    /**
+     * @brief Move the gap to position @p pos.
+     *
+     * Moves the elements between the gap and @p pos, so this is O(distance).
+     *
+     * @param pos The new gap position, at most size().
+     * @exception std::out_of_range @p pos is greater than size().
+     */
+    inline void
+    move_gap(size_type pos)
+    {
+        if (pos > size())
+            throw std::out_of_range("gap_vec: gap position out of range!");
+
+        if (pos < gap_start_) {
+            const size_type dist = gap_start_ - pos;
+            detail::relocate(buf_ + gap_end_ - dist, buf_ + pos, dist);
+            gap_start_ -= dist;
+            gap_end_ -= dist;
+        } else if (pos > gap_start_) {
+            const size_type dist = pos - gap_start_;
+            detail::relocate(buf_ + gap_start_, buf_ + gap_end_, dist);
+            gap_start_ += dist;
+            gap_end_ += dist;
+        }
+    }
+
+    /**
+     * @brief Clear the contents of the vector.
+     *
+     * Does not change the capacity. The gap ends up covering the whole buffer.
+     */
+    inline void
+    clear() noexcept
+    {
+        detail::destroy(buf_, gap_start_);
+        detail::destroy(buf_ + gap_end_, tail_size_());
+
+        gap_start_ = 0;
+        gap_end_ = capacity_;
+    }
+
+    /**
+     * @brief Construct an element in place at position @p pos.
+     *
+     * Moves the gap to @p pos first, and leaves it after the new element, so
+     * consecutive insertions are O(1) amortized.
+     *
+     * @tparam Args The types of the constructor arguments.
+     * @param pos The position to insert the element in (zero indexed).
+     * @param args The arguments to construct the element from.
+     * @exception std::out_of_range @p pos is greater than size().
+     * @return iterator An iterator pointing to the new element.
+     */
+    template <class... Args>
+    inline iterator
+    emplace(size_type pos, Args&&... args)
+    {
+        if (pos == gap_start_ && gap_size() > 0) {
+            T* where = &buf_[gap_start_];
+            ::new (static_cast<void*>(where)) T(std::forward<Args>(args)...);
+            gap_start_++;
+
+            return {this, pos};
+        }
+
+        // args may refer to an element that is about to be moved
+        T elem(std::forward<Args>(args)...);
+
+        move_gap(pos);
+        grow_gap_(1);
+
+        ::new (static_cast<void*>(&buf_[gap_start_])) T(std::move(elem));
+        gap_start_++;
+
+        return {this, pos};
+    }
+
+    /**
+     * @brief Insert an element @p elem at position @p pos.
+     *
+     * Copies the element into the vector.
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @exception std::out_of_range @p pos is greater than size().
+     * @return iterator An iterator pointing to the new element.
+     */
+    inline iterator
+    insert(size_type pos, const T& elem)
+    {
+        return emplace(pos, elem);
+    }
+
+    /**
+     * @brief Insert an element @p elem at position @p pos.
+     *
+     * Moves the element into the vector.
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @exception std::out_of_range @p pos is greater than size().
+     * @return iterator An iterator pointing to the new element.
+     */
+    inline iterator
+    insert(size_type pos, T&& elem)
+    {
+        return emplace(pos, std::move(elem));
+    }
+
+    /**
+     * @brief Insert @p count copies of @p elem at position @p pos.
+     *
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @exception std::out_of_range @p pos is greater than size().
+     * @return iterator An iterator pointing to the first element inserted.
+     */
+    inline iterator
+    insert(size_type pos, size_type count, const T& elem)
+    {
+        // elem may be one of our own elements, which is about to be moved
+        const T copy(elem);
+
+        move_gap(pos);
+        grow_gap_(count);
+
+        for (size_type i = 0; i < count; i++, gap_start_++)
+            ::new (static_cast<void*>(&buf_[gap_start_])) T(copy);
+
+        return {this, pos};
+    }
+
+    /**
+     * @brief Insert @p elems at position @p pos.
+     *
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elems The elements to insert.
+     * @exception std::out_of_range @p pos is greater than size().
+     * @return iterator An iterator pointing to the first element inserted.
+     */
+    inline iterator
+    insert(size_type pos, std::initializer_list<T> elems)
+    {
+        move_gap(pos);
+        grow_gap_(elems.size());
+
+        for (const T& elem : elems) {
+            ::new (static_cast<void*>(&buf_[gap_start_])) T(elem);
+            gap_start_++;
+        }
+
+        return {this, pos};
+    }
+
+    /**
+     * @brief Remove @p count elements starting at position @p pos.
+     *
+     * Moves the gap to @p pos first, and then widens it over the elements.
+     *
+     * @param pos The position of the first element to remove.
+     * @param count How many elements to remove.
+     * @exception std::out_of_range The elements are not all in this vector.
+     * @return iterator An iterator pointing to the element after the removed ones.
+     */
+    inline iterator
+    erase(size_type pos, size_type count = 1)
+    {
+        if (pos > size() || count > size() - pos)
+            throw std::out_of_range("gap_vec: erase out of range!");
+
+        move_gap(pos);
+        detail::destroy(buf_ + gap_end_, count);
+        gap_end_ += count;
+
+        return {this, pos};
+    }
+
+#pragma endregion
+
+#pragma region "Equality operators"
+
+    inline friend bool
+    operator==(const ds::gap_vec<T>& lhs, const ds::gap_vec<T>& rhs)
+    {
+        // Check if they are the same object
+        if (&lhs == &rhs)
+            return true;
+
+        // Check if the vectors have different sizes
+        if (lhs.size() != rhs.size())
+            return false;
+
+        // Finally, check each element
+        for (size_type i = 0; i < lhs.size(); i++) {
+            if (lhs[i] != rhs[i])
+                return false;
+        }
+        return true;
+    }
+
+    inline friend bool
+    operator!=(const ds::gap_vec<T>& lhs, const ds::gap_vec<T>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+#pragma endregion
+};
+
+} // namespace ds
+
+#endif // LIBDS_GAP_VEC_HPP
@@ -0,0 +1,338 @@
+/**
+ * @file gather.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Gather, scatter and in-place permutation of ds::vec elements.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_GATHER_HPP
+#define LIBDS_GATHER_HPP
+
+#include "libds/detail/parallel.hpp"
+#include "libds/detail/simd.hpp"
+#include "libds/span.hpp"
+#include "libds/vec.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ds {
+
+namespace detail {
+
+/**
+ * @brief How many indices ahead of the current one to prefetch.
+ *
+ * Random accesses into a large array each miss the cache; prefetching the
+ * target of a later index keeps several misses in flight instead of waiting for
+ * one at a time.
+ */
+inline constexpr std::size_t PREFETCH_DISTANCE = 32;
+
+/**
+ * @brief Whether gather() can use hardware gathers for these element and index
+ * types.
+ */
+template <class T, class I>
+inline constexpr bool IS_SIMD_GATHERABLE = std::is_trivially_copyable_v<T>
+                                        && (sizeof(T) == 4 || sizeof(T) == 8)
+                                        && std::is_integral_v<I>
+                                        && (sizeof(I) == 4 || sizeof(I) == 8);
+
+/**
+ * @brief Set `dst[i] = src[idx[i]]` for every i in `[first, last)`.
+ */
+template <class T, class I>
+inline void
+gather_scalar(const T* src, const I* idx, T* dst, std::size_t first, std::size_t last)
+{
+    std::size_t i = first;
+    for (; i + PREFETCH_DISTANCE < last; i++) {
+        prefetch(&src[idx[i + PREFETCH_DISTANCE]]);
+        dst[i] = src[idx[i]];
+    }
+    for (; i < last; i++)
+        dst[i] = src[idx[i]];
+}
+
+#ifdef LIBDS_HAS_X86_DISPATCH
+/**
+ * @brief gather_scalar(), with AVX2 gather instructions.
+ *
+ * A gather already keeps all of its loads in flight at once, and prefetching
+ * every lane separately costs more than it saves, so there is no prefetching
+ * here. 32-bit indices are sign-extended by the hardware, so they must be below
+ * 2^31.
+ */
+template <class T, class I>
+LIBDS_TARGET_AVX2 inline void
+gather_avx2(const T* src, const I* idx, T* dst, std::size_t first, std::size_t last)
+{
+    constexpr std::size_t LANES = 32 / (sizeof(T) > sizeof(I) ? sizeof(T) : sizeof(I));
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    std::size_t i = first;
+    for (; i + LANES <= last; i += LANES) {
+        const auto* narrow = reinterpret_cast<const __m128i*>(idx + i);
+        const auto* wide = reinterpret_cast<const __m256i*>(idx + i);
+        const auto* src32 = reinterpret_cast<const int*>(src);
+        const auto* src64 = reinterpret_cast<const long long*>(src);
+        if constexpr (sizeof(T) == 4 && sizeof(I) == 4) {
+            const __m256i elems =
+                _mm256_i32gather_epi32(src32, _mm256_loadu_si256(wide), 4);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), elems);
+        } else if constexpr (sizeof(T) == 4) {
+            const __m128i elems =
+                _mm256_i64gather_epi32(src32, _mm256_loadu_si256(wide), 4);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), elems);
+        } else if constexpr (sizeof(I) == 4) {
+            const __m256i elems =
+                _mm256_i32gather_epi64(src64, _mm_loadu_si128(narrow), 8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), elems);
+        } else {
+            const __m256i elems =
+                _mm256_i64gather_epi64(src64, _mm256_loadu_si256(wide), 8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), elems);
+        }
+    }
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    gather_scalar(src, idx, dst, i, last);
+}
+#endif
+
+/**
+ * @brief Set `dst[idx[i]] = src[i]` for every i in `[first, last)`.
+ */
+template <class T, class I>
+inline void
+scatter_scalar(const T* src, const I* idx, T* dst, std::size_t first, std::size_t last)
+{
+    std::size_t i = first;
+    for (; i + PREFETCH_DISTANCE < last; i++) {
+        prefetch_write(&dst[idx[i + PREFETCH_DISTANCE]]);
+        dst[idx[i]] = src[i];
+    }
+    for (; i < last; i++)
+        dst[idx[i]] = src[i];
+}
+
+} // namespace detail
+
+/**
+ * @brief Gather elements by index: set `dst[i] = src[idx[i]]` for every i.
+ *
+ * The accesses to @p src are random, so on large inputs the time goes into
+ * waiting for memory. 4 and 8 byte elements are loaded with AVX2 gather
+ * instructions where the CPU has them, which keeps a whole vector of loads in
+ * flight; other elements prefetch the targets of later indices instead.
+ *
+ * @param src The elements to gather from.
+ * @param idx The indices into @p src, which are not checked.
+ * @param dst Where to store the elements, as big as @p idx.
+ * @param threads How many threads to split the work over. Elements that may
+ * throw while being copied are always gathered on the calling thread.
+ */
+template <class T, class I>
+inline void
+gather(span<const T> src, span<const I> idx, span<T> dst, std::size_t threads = 1)
+{
+    if (idx.size() != dst.size())
+        throw std::invalid_argument("gather: idx and dst differ in size!");
+
+    if constexpr (!std::is_nothrow_copy_assignable_v<T>)
+        threads = 1;
+
+    auto kernel = [&](std::size_t first, std::size_t last) {
+#ifdef LIBDS_HAS_X86_DISPATCH
+        if constexpr (detail::IS_SIMD_GATHERABLE<T, I>) {
+            const bool fits = sizeof(I) == 8
+                           || src.size() <= std::numeric_limits<std::int32_t>::max();
+            if (fits && detail::has_avx2()) {
+                detail::gather_avx2(src.data(), idx.data(), dst.data(), first, last);
+                return;
+            }
+        }
+#endif
+        detail::gather_scalar(src.data(), idx.data(), dst.data(), first, last);
+    };
+    detail::parallel_chunks(idx.size(), threads, kernel);
+}
+
+/**
+ * @brief Gather elements by index: set `dst[i] = src[idx[i]]` for every i.
+ *
+ * @p dst is resized to the size of @p idx first. See the span version for
+ * details.
+ *
+ * @param src The elements to gather from.
+ * @param idx The indices into @p src, which are not checked.
+ * @param dst Where to store the elements.
+ * @param threads How many threads to split the work over.
+ */
+template <class T, std::size_t A, class I, std::size_t B, std::size_t C>
+inline void
+gather(
+    const vec<T, A>& src, const vec<I, B>& idx, vec<T, C>& dst,
+    std::size_t threads = 1
+)
+{
+    dst.resize(idx.size());
+    gather(span<const T>(src), span<const I>(idx), span<T>(dst), threads);
+}
+
+/**
+ * @brief Scatter elements by index: set `dst[idx[i]] = src[i]` for every i.
+ *
+ * The targets of later indices are prefetched, to overlap the cache misses of
+ * the random stores.
+ *
+ * @param src The elements to scatter.
+ * @param idx Where in @p dst each element goes; not checked.
+ * @param dst Where to store the elements.
+ * @param threads How many threads to split the work over. With more than one,
+ * the indices must all be different. Elements that may throw while being copied
+ * are always scattered on the calling thread.
+ */
+template <class T, class I>
+inline void
+scatter(span<const T> src, span<const I> idx, span<T> dst, std::size_t threads = 1)
+{
+    if (idx.size() != src.size())
+        throw std::invalid_argument("scatter: src and idx differ in size!");
+
+    if constexpr (!std::is_nothrow_copy_assignable_v<T>)
+        threads = 1;
+
+    auto kernel = [&](std::size_t first, std::size_t last) {
+        detail::scatter_scalar(src.data(), idx.data(), dst.data(), first, last);
+    };
+    detail::parallel_chunks(idx.size(), threads, kernel);
+}
+
+/**
+ * @brief Scatter elements by index: set `dst[idx[i]] = src[i]` for every i.
+ *
+ * See the span version for details.
+ *
+ * @param src The elements to scatter.
+ * @param idx Where in @p dst each element goes; not checked.
+ * @param dst Where to store the elements, already big enough.
+ * @param threads How many threads to split the work over.
+ */
+template <class T, std::size_t A, class I, std::size_t B, std::size_t C>
+inline void
+scatter(
+    const vec<T, A>& src, const vec<I, B>& idx, vec<T, C>& dst,
+    std::size_t threads = 1
+)
+{
+    scatter(span<const T>(src), span<const I>(idx), span<T>(dst), threads);
+}
+
+/**
+ * @brief Reorder @p v in place so that `v[i]` becomes the old `v[perm[i]]`.
+ *
+ * This is gather() with @p v as both source and destination, e.g. to apply the
+ * result of an argsort. Each cycle of the permutation is followed once, moving
+ * every element exactly once, with one bit of extra memory per element. The
+ * permutation is checked before anything is moved.
+ *
+ * Each step of a cycle has to wait for the previous one's cache miss, so on
+ * vectors much bigger than the cache, gather() into a second vector is many
+ * times faster, if the memory for it is available.
+ *
+ * @param v The vector to reorder.
+ * @param perm A permutation of `0, ..., v.size() - 1`.
+ * @throws std::invalid_argument If @p perm is not such a permutation.
+ */
+template <class T, std::size_t A, class I>
+inline void
+apply_permutation(vec<T, A>& v, span<const I> perm)
+{
+    const std::size_t n = v.size();
+    if (perm.size() != n)
+        throw std::invalid_argument("apply_permutation: wrong permutation size!");
+
+    constexpr std::size_t BITS = 64;
+    vec<std::uint64_t> done((n + BITS - 1) / BITS, 0);
+    auto mark = [&](std::size_t i) {
+        const std::uint64_t bit = std::uint64_t{1} << (i % BITS);
+        const bool was_set = (done[i / BITS] & bit) != 0;
+        done[i / BITS] |= bit;
+        return was_set;
+    };
+
+    for (std::size_t i = 0; i < n; i++) {
+        const auto to = static_cast<std::size_t>(perm[i]);
+        if (to >= n || mark(to))
+            throw std::invalid_argument("apply_permutation: not a permutation!");
+    }
+
+    // Clear a bit when its place gets its final element
+    for (std::size_t start = 0; start < n; start++) {
+        if ((done[start / BITS] & (std::uint64_t{1} << (start % BITS))) == 0)
+            continue;
+
+        T tmp(std::move(v[start]));
+        std::size_t at = start;
+        for (;;) {
+            done[at / BITS] &= ~(std::uint64_t{1} << (at % BITS));
+            const auto from = static_cast<std::size_t>(perm[at]);
+            if (from == start)
+                break;
+
+            v[at] = std::move(v[from]);
+            at = from;
+        }
+        v[at] = std::move(tmp);
+    }
+}
+
+/**
+ * @brief Reorder @p v in place so that `v[i]` becomes the old `v[perm[i]]`.
+ *
+ * See the span version for details.
+ *
+ * @param v The vector to reorder.
+ * @param perm A permutation of `0, ..., v.size() - 1`.
+ * @throws std::invalid_argument If @p perm is not such a permutation.
+ */
+template <class T, std::size_t A, class I, std::size_t B>
+inline void
+apply_permutation(vec<T, A>& v, const vec<I, B>& perm)
+{
+    apply_permutation(v, span<const I>(perm));
+}
+
+} // namespace ds
+
+#endif // LIBDS_GATHER_HPP
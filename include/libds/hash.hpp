@@ -0,0 +1,599 @@
+/**
+ * @file hash.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Fast non-cryptographic hashing of contiguous bytes.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_HASH_HPP
+#define LIBDS_HASH_HPP
+
+#include "libds/detail/simd.hpp"
+#include "libds/span.hpp"
+#include "libds/vec.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <array>
+#include <functional>
+#include <type_traits>
+
+// The long-input path is kept out of line, so that hashing a short key inlines
+// to a few instructions, and so that GCC does not warn about reads past the end
+// of small arrays on a path it cannot prove is never taken for them.
+#if defined(__GNUC__) || defined(__clang__)
+#  define LIBDS_HASH_NOINLINE __attribute__((noinline))
+#else
+#  define LIBDS_HASH_NOINLINE
+#endif
+
+namespace ds {
+
+namespace detail {
+
+/**
+ * @brief The odd constants of wyhash.
+ */
+inline constexpr std::array<std::uint64_t, 4> WY_PRIMES = {
+    0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL,
+    0x4d5a2da51de1aa47ULL
+};
+
+/**
+ * @brief Inputs up to this many bytes are hashed by the short-input path.
+ */
+inline constexpr std::size_t HASH_SHORT_MAX = 256;
+
+/**
+ * @brief The long-input path reads this many bytes at a time, as 8 lanes of 8.
+ */
+inline constexpr std::size_t HASH_STRIPE = 64;
+
+/**
+ * @brief The long-input path scrambles its accumulators after this many
+ * stripes.
+ */
+inline constexpr std::size_t HASH_BLOCK_STRIPES = 16;
+
+/**
+ * @brief How many key words the long-input path uses: a window of 8 slides
+ * along them by one word per stripe of a block.
+ */
+inline constexpr std::size_t HASH_KEYS = 8 + HASH_BLOCK_STRIPES - 1;
+
+/**
+ * @brief Where the key windows for scrambling and for the last stripe start.
+ */
+inline constexpr std::size_t HASH_SCRAMBLE_KEY = HASH_BLOCK_STRIPES - 1;
+inline constexpr std::size_t HASH_LAST_KEY = 7;
+
+/**
+ * @brief Multiplier for scrambling the accumulators; 32 bits, so vectors can
+ * multiply by it with 32-bit multiplies.
+ */
+inline constexpr std::uint64_t HASH_SCRAMBLE_PRIME = 0x9E3779B1U;
+
+/**
+ * @brief The key words for seed 0: the first outputs of SplitMix64.
+ */
+constexpr std::array<std::uint64_t, HASH_KEYS>
+make_hash_secret()
+{
+    std::array<std::uint64_t, HASH_KEYS> secret{};
+    std::uint64_t state = 0;
+    for (std::uint64_t& word : secret) {
+        state += 0x9E3779B97F4A7C15ULL;
+        std::uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        word = z ^ (z >> 31);
+    }
+    return secret;
+}
+
+inline constexpr std::array<std::uint64_t, HASH_KEYS> HASH_SECRET = make_hash_secret();
+
+/**
+ * @brief The key words for @p seed.
+ */
+inline std::array<std::uint64_t, HASH_KEYS>
+hash_keys(std::uint64_t seed) noexcept
+{
+    std::array<std::uint64_t, HASH_KEYS> keys = HASH_SECRET;
+    for (std::size_t i = 0; i < HASH_KEYS; i++)
+        keys[i] += i % 2 == 0 ? seed : 0 - seed;
+    return keys;
+}
+
+/**
+ * @brief Multiply @p lhs by @p rhs, setting them to the low and high halves of
+ * the 128-bit product.
+ */
+inline void
+mum(std::uint64_t& lhs, std::uint64_t& rhs) noexcept
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 uint128;
+    const uint128 product = static_cast<uint128>(lhs) * rhs;
+    lhs = static_cast<std::uint64_t>(product);
+    rhs = static_cast<std::uint64_t>(product >> 64);
+#else
+    const std::uint64_t lo_lo = (lhs & 0xFFFFFFFFU) * (rhs & 0xFFFFFFFFU);
+    const std::uint64_t hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFFU);
+    const std::uint64_t lo_hi = (lhs & 0xFFFFFFFFU) * (rhs >> 32);
+    const std::uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+    const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFU) + lo_hi;
+    lhs = (cross << 32) | (lo_lo & 0xFFFFFFFFU);
+    rhs = hi_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+/**
+ * @brief Fold the 128-bit product of @p lhs and @p rhs to 64 bits.
+ */
+inline std::uint64_t
+mix(std::uint64_t lhs, std::uint64_t rhs) noexcept
+{
+    mum(lhs, rhs);
+    return lhs ^ rhs;
+}
+
+/**
+ * @brief Read 8 bytes, little endian on little-endian machines.
+ */
+inline std::uint64_t
+read64(const unsigned char* ptr) noexcept
+{
+    std::uint64_t val = 0;
+    std::memcpy(&val, ptr, sizeof(val));
+    return val;
+}
+
+/**
+ * @brief Read 4 bytes.
+ */
+inline std::uint64_t
+read32(const unsigned char* ptr) noexcept
+{
+    std::uint32_t val = 0;
+    std::memcpy(&val, ptr, sizeof(val));
+    return val;
+}
+
+/**
+ * @brief Hash at most HASH_SHORT_MAX bytes, the way wyhash does.
+ */
+inline std::uint64_t
+hash_short(const unsigned char* ptr, std::size_t len, std::uint64_t seed) noexcept
+{
+    seed ^= mix(seed ^ WY_PRIMES[0], WY_PRIMES[1]);
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    if (len <= 16) {
+        if (len >= 4) {
+            const std::size_t off = (len >> 3) << 2;
+            a = (read32(ptr) << 32) | read32(ptr + off);
+            b = (read32(ptr + len - 4) << 32) | read32(ptr + len - 4 - off);
+        } else if (len > 0) {
+            a = (std::uint64_t{ptr[0]} << 16) | (std::uint64_t{ptr[len >> 1]} << 8)
+              | ptr[len - 1];
+        }
+    } else {
+        std::size_t left = len;
+        if (left >= 48) {
+            std::uint64_t see1 = seed;
+            std::uint64_t see2 = seed;
+            do {
+                seed = mix(read64(ptr) ^ WY_PRIMES[1], read64(ptr + 8) ^ seed);
+                see1 = mix(read64(ptr + 16) ^ WY_PRIMES[2], read64(ptr + 24) ^ see1);
+                see2 = mix(read64(ptr + 32) ^ WY_PRIMES[3], read64(ptr + 40) ^ see2);
+                ptr += 48;
+                left -= 48;
+            } while (left >= 48);
+            seed ^= see1 ^ see2;
+        }
+        while (left > 16) {
+            seed = mix(read64(ptr) ^ WY_PRIMES[1], read64(ptr + 8) ^ seed);
+            ptr += 16;
+            left -= 16;
+        }
+        a = read64(ptr + left - 16);
+        b = read64(ptr + left - 8);
+    }
+    a ^= WY_PRIMES[1];
+    b ^= seed;
+    mum(a, b);
+    return mix(a ^ WY_PRIMES[0] ^ len, b ^ WY_PRIMES[1]);
+}
+
+/**
+ * @brief Add one stripe at @p ptr to the accumulators, with the key window
+ * starting at @p key.
+ *
+ * Each lane adds the product of the low and high halves of its data mixed with
+ * its key, and its neighbour's raw data, so no input can cancel out.
+ */
+inline void
+accumulate_stripe_scalar(
+    std::uint64_t* acc, const unsigned char* ptr, const std::uint64_t* key
+) noexcept
+{
+    for (std::size_t i = 0; i < 8; i++) {
+        const std::uint64_t data = read64(ptr + i * 8);
+        const std::uint64_t keyed = data ^ key[i];
+        acc[i ^ 1] += data;
+        acc[i] += (keyed & 0xFFFFFFFFU) * (keyed >> 32);
+    }
+}
+
+/**
+ * @brief Spread the high bits of the accumulators into their low bits, which
+ * the 32-bit products only ever read.
+ */
+inline void
+scramble_scalar(std::uint64_t* acc, const std::uint64_t* key) noexcept
+{
+    for (std::size_t i = 0; i < 8; i++) {
+        acc[i] ^= acc[i] >> 47;
+        acc[i] ^= key[i];
+        acc[i] *= HASH_SCRAMBLE_PRIME;
+    }
+}
+
+/**
+ * @brief Add @p stripes stripes from @p ptr to the accumulators, the first
+ * being stripe number @p first of the input.
+ */
+inline void
+accumulate_scalar(
+    std::uint64_t* acc,
+    const unsigned char* ptr,
+    std::size_t stripes,
+    std::size_t first,
+    const std::uint64_t* keys
+) noexcept
+{
+    for (std::size_t s = first; s < first + stripes; s++, ptr += HASH_STRIPE) {
+        accumulate_stripe_scalar(acc, ptr, keys + s % HASH_BLOCK_STRIPES);
+        if (s % HASH_BLOCK_STRIPES == HASH_BLOCK_STRIPES - 1)
+            scramble_scalar(acc, keys + HASH_SCRAMBLE_KEY);
+    }
+}
+
+#ifdef LIBDS_HAS_X86_DISPATCH
+/**
+ * @brief Load 4 words from @p ptr.
+ */
+LIBDS_TARGET_AVX2 inline __m256i
+hash_load_avx2(const void* ptr) noexcept
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+}
+
+/**
+ * @brief accumulate_stripe_scalar() for 4 lanes.
+ */
+LIBDS_TARGET_AVX2 inline __m256i
+hash_step_avx2(__m256i acc, const unsigned char* ptr, const std::uint64_t* key) noexcept
+{
+    const __m256i data = hash_load_avx2(ptr);
+    const __m256i keyed = _mm256_xor_si256(data, hash_load_avx2(key));
+    const __m256i product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+    // Swap the 64-bit halves of each 128-bit lane: lane i gets lane i ^ 1
+    const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+    return _mm256_add_epi64(acc, _mm256_add_epi64(product, swapped));
+}
+
+/**
+ * @brief scramble_scalar() for 4 lanes.
+ */
+LIBDS_TARGET_AVX2 inline __m256i
+hash_scramble_avx2(__m256i acc, const std::uint64_t* key) noexcept
+{
+    const __m256i prime = _mm256_set1_epi64x(HASH_SCRAMBLE_PRIME);
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47));
+    acc = _mm256_xor_si256(acc, hash_load_avx2(key));
+    const __m256i lo = _mm256_mul_epu32(acc, prime);
+    const __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(acc, 32), prime);
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+}
+
+/**
+ * @brief accumulate_scalar(), with AVX2: the same arithmetic on 4 lanes per
+ * vector, with the accumulators kept in registers.
+ */
+LIBDS_TARGET_AVX2 inline void
+accumulate_avx2(
+    std::uint64_t* acc,
+    const unsigned char* ptr,
+    std::size_t stripes,
+    std::size_t first,
+    const std::uint64_t* keys
+) noexcept
+{
+    __m256i acc_lo = hash_load_avx2(acc);
+    __m256i acc_hi = hash_load_avx2(acc + 4);
+    for (std::size_t s = first; s < first + stripes; s++, ptr += HASH_STRIPE) {
+        const std::uint64_t* key = keys + s % HASH_BLOCK_STRIPES;
+        acc_lo = hash_step_avx2(acc_lo, ptr, key);
+        acc_hi = hash_step_avx2(acc_hi, ptr + 32, key + 4);
+        if (s % HASH_BLOCK_STRIPES == HASH_BLOCK_STRIPES - 1) {
+            acc_lo = hash_scramble_avx2(acc_lo, keys + HASH_SCRAMBLE_KEY);
+            acc_hi = hash_scramble_avx2(acc_hi, keys + HASH_SCRAMBLE_KEY + 4);
+        }
+    }
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), acc_lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4), acc_hi);
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+#endif
+
+/**
+ * @brief Add @p stripes stripes from @p ptr to the accumulators, the first
+ * being stripe number @p first, with AVX2 where the CPU has it.
+ */
+inline void
+accumulate(
+    std::uint64_t* acc,
+    const unsigned char* ptr,
+    std::size_t stripes,
+    std::size_t first,
+    const std::uint64_t* keys
+) noexcept
+{
+#ifdef LIBDS_HAS_X86_DISPATCH
+    if (has_avx2()) {
+        accumulate_avx2(acc, ptr, stripes, first, keys);
+        return;
+    }
+#endif
+    accumulate_scalar(acc, ptr, stripes, first, keys);
+}
+
+/**
+ * @brief The starting accumulators of the long-input path.
+ */
+inline constexpr std::array<std::uint64_t, 8> HASH_ACC_INIT = {
+    WY_PRIMES[0], WY_PRIMES[1], WY_PRIMES[2], WY_PRIMES[3],
+    ~WY_PRIMES[0], ~WY_PRIMES[1], ~WY_PRIMES[2], ~WY_PRIMES[3]
+};
+
+/**
+ * @brief Finish the long-input path: add the last 64 bytes of the input, which
+ * end at @p end, and fold the accumulators into the hash.
+ *
+ * @param len The length of the whole input.
+ */
+inline std::uint64_t
+finish_long(
+    std::array<std::uint64_t, 8> acc,
+    const unsigned char* end,
+    std::size_t len,
+    const std::uint64_t* keys
+) noexcept
+{
+    accumulate_stripe_scalar(acc.data(), end - HASH_STRIPE, keys + HASH_LAST_KEY);
+    std::uint64_t hash = len * WY_PRIMES[0];
+    for (std::size_t i = 0; i < 8; i += 2)
+        hash += mix(acc[i] ^ keys[11 + i], acc[i + 1] ^ keys[12 + i]);
+    hash = mix(hash ^ (hash >> 29) ^ WY_PRIMES[1], WY_PRIMES[2]);
+    return hash ^ (hash >> 32);
+}
+
+/**
+ * @brief Hash more than HASH_SHORT_MAX bytes.
+ *
+ * Every stripe but the last is added to 8 accumulators, 8 bytes to each, and
+ * the accumulators are scrambled after every block of stripes; then the last
+ * 64 bytes are added, overlapping the previous stripe unless the length is a
+ * multiple of 64. The stripes are independent, so with AVX2 this runs at a few
+ * bytes per cycle.
+ */
+LIBDS_HASH_NOINLINE inline std::uint64_t
+hash_long(const unsigned char* ptr, std::size_t len, std::uint64_t seed) noexcept
+{
+    const auto keys = seed == 0 ? HASH_SECRET : hash_keys(seed);
+    std::array<std::uint64_t, 8> acc = HASH_ACC_INIT;
+    accumulate(acc.data(), ptr, (len - 1) / HASH_STRIPE, 0, keys.data());
+    return finish_long(acc, ptr + len, len, keys.data());
+}
+
+} // namespace detail
+
+/**
+ * @brief Hash @p len bytes at @p data.
+ *
+ * Not cryptographic: fast, and well distributed for use in hash tables and for
+ * finding duplicate contents, but not resistant to deliberately made
+ * collisions. Inputs up to 256 bytes are hashed the way wyhash does; longer
+ * ones are accumulated 64 bytes at a time in the manner of XXH3, with AVX2
+ * where the CPU has it. The result does not depend on the CPU, and equals
+ * ds::hasher's over the same bytes.
+ *
+ * @param data The bytes.
+ * @param len How many bytes there are.
+ * @param seed Picks one of many unrelated hash functions. Defaults to 0.
+ * @return std::uint64_t The hash.
+ */
+[[nodiscard]] inline std::uint64_t
+hash_bytes(const void* data, std::size_t len, std::uint64_t seed = 0) noexcept
+{
+    const auto* ptr = static_cast<const unsigned char*>(data);
+    if (len <= detail::HASH_SHORT_MAX)
+        return detail::hash_short(ptr, len, seed);
+    return detail::hash_long(ptr, len, seed);
+}
+
+/**
+ * @brief Computes hash_bytes() of bytes that arrive in pieces, such as a vector
+ * that is being appended to.
+ *
+ * Buffers at most 256 bytes, and feeds everything else straight to the
+ * accumulators, so it is as fast as hash_bytes() on large updates. digest() can
+ * be called at any point, and updating can go on afterwards.
+ */
+class hasher {
+    std::array<std::uint64_t, detail::HASH_KEYS> keys_;
+    std::array<std::uint64_t, 8> acc_ = detail::HASH_ACC_INIT;
+    std::uint64_t seed_;
+    std::size_t total_ = 0;
+    std::size_t stripes_ = 0;
+    std::size_t pending_ = 0;
+    // The last stripe added to the accumulators, followed by the bytes not yet
+    // added, so the last 64 bytes of the input are always contiguous here.
+    std::array<unsigned char, detail::HASH_STRIPE + detail::HASH_SHORT_MAX> buf_{};
+
+    static constexpr std::size_t PENDING = detail::HASH_STRIPE;
+
+    /**
+     * @brief Add @p stripes stripes at @p ptr, and remember the last of them.
+     */
+    void
+    consume_(const unsigned char* ptr, std::size_t stripes) noexcept
+    {
+        detail::accumulate(acc_.data(), ptr, stripes, stripes_, keys_.data());
+        stripes_ += stripes;
+        std::memcpy(
+            buf_.data(), ptr + (stripes - 1) * detail::HASH_STRIPE, detail::HASH_STRIPE
+        );
+    }
+
+ public:
+    /**
+     * @brief Start hashing.
+     *
+     * @param seed The seed, as for hash_bytes(). Defaults to 0.
+     */
+    explicit hasher(std::uint64_t seed = 0) noexcept :
+        keys_(detail::hash_keys(seed)), seed_(seed)
+    {}
+
+    /**
+     * @brief Append @p len bytes at @p data to the input.
+     */
+    void
+    update(const void* data, std::size_t len) noexcept
+    {
+        const auto* ptr = static_cast<const unsigned char*>(data);
+        total_ += len;
+        while (len > 0) {
+            // Stripes are only added once more input follows them
+            if (pending_ == detail::HASH_SHORT_MAX) {
+                consume_(
+                    buf_.data() + PENDING, detail::HASH_SHORT_MAX / detail::HASH_STRIPE
+                );
+                pending_ = 0;
+            }
+
+            if (pending_ == 0 && len > detail::HASH_SHORT_MAX) {
+                const std::size_t stripes = (len - 1) / detail::HASH_STRIPE;
+                consume_(ptr, stripes);
+                ptr += stripes * detail::HASH_STRIPE;
+                len -= stripes * detail::HASH_STRIPE;
+            }
+
+            const std::size_t take = std::min(len, detail::HASH_SHORT_MAX - pending_);
+            std::memcpy(buf_.data() + PENDING + pending_, ptr, take);
+            pending_ += take;
+            ptr += take;
+            len -= take;
+        }
+    }
+
+    /**
+     * @brief Append the elements of @p elems to the input, as bytes.
+     */
+    template <class T>
+    void
+    update(span<const T> elems) noexcept
+    {
+        static_assert(
+            std::is_trivially_copyable_v<T>, "hasher: elements must be bytes!"
+        );
+        update(elems.data(), elems.size_bytes());
+    }
+
+    /**
+     * @brief Get the hash of the input so far.
+     *
+     * @return std::uint64_t What hash_bytes() would return for it.
+     */
+    [[nodiscard]] std::uint64_t
+    digest() const noexcept
+    {
+        const unsigned char* pending = buf_.data() + PENDING;
+        if (total_ <= detail::HASH_SHORT_MAX)
+            return detail::hash_short(pending, total_, seed_);
+
+        std::array<std::uint64_t, 8> acc = acc_;
+        const std::size_t stripes = (pending_ - 1) / detail::HASH_STRIPE;
+        detail::accumulate(acc.data(), pending, stripes, stripes_, keys_.data());
+        return detail::finish_long(acc, pending + pending_, total_, keys_.data());
+    }
+};
+
+} // namespace ds
+
+namespace std {
+
+/**
+ * @brief Hashes vectors by their elements, so that equal vectors hash equal.
+ *
+ * Elements whose value is their bytes (see
+ * `std::has_unique_object_representations`), such as integers, are hashed as
+ * one block with ds::hash_bytes(). Others, such as floating point numbers and
+ * strings, are hashed one by one with their own `std::hash` and the results
+ * hashed together.
+ */
+template <class T, std::size_t A>
+struct hash<ds::vec<T, A>> {
+    [[nodiscard]] std::size_t
+    operator()(const ds::vec<T, A>& v) const
+    {
+        if constexpr (std::has_unique_object_representations_v<T>) {
+            return static_cast<std::size_t>(
+                ds::hash_bytes(v.data(), v.size() * sizeof(T))
+            );
+        } else {
+            ds::hasher state;
+            const std::hash<T> hash_elem;
+            for (const T& elem : v) {
+                const std::size_t elem_hash = hash_elem(elem);
+                state.update(&elem_hash, sizeof(elem_hash));
+            }
+            return static_cast<std::size_t>(state.digest());
+        }
+    }
+};
+
+} // namespace std
+
+#endif // LIBDS_HASH_HPP
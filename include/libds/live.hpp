@@ -0,0 +1,396 @@
+/**
+ * @file live.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Opt-in registry of live ds::vec instances for capacity accounting.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_LIVE_HPP
+#define LIBDS_LIVE_HPP
+
+#include "libds/detail/type_name.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Accounting of the memory held by live ds::vec instances.
+ *
+ * When `LIBDS_REGISTRY` is defined for the whole program, every ds::vec
+ * registers itself here on construction and unregisters on destruction.
+ * Operators can then ask how much capacity is allocated versus used, which
+ * element types waste the most, and shrink every vector whose spare capacity
+ * exceeds a ratio. Without `LIBDS_REGISTRY` ds::vec carries no registry entry
+ * and the registry stays empty.
+ *
+ * Registration and unregistration are lock-free and spread over several
+ * shards, so they are safe (and cheap) from any thread. collect() and
+ * shrink_all_above() however read and modify the registered vectors
+ * themselves, and ds::vec is not thread-safe: only call them at a point where
+ * no registered vector is being created, destroyed or modified concurrently.
+ */
+namespace ds::live {
+
+/**
+ * @brief Type-erased operations on a registered container.
+ */
+struct entry_ops {
+    std::string (*type)();
+    std::size_t element_size;
+    std::size_t (*size)(const void*);
+    std::size_t (*capacity)(const void*);
+    void (*shrink)(void*);
+};
+
+/**
+ * @brief The operations for container type @p V.
+ */
+template <class V>
+inline constexpr entry_ops OPS_FOR = {
+    &detail::type_name<typename V::value_type>,
+    sizeof(typename V::value_type),
+    [](const void* obj) { return static_cast<const V*>(obj)->size(); },
+    [](const void* obj) { return static_cast<const V*>(obj)->capacity(); },
+    [](void* obj) { static_cast<V*>(obj)->shrink_to_fit(); },
+};
+
+class entry;
+
+/**
+ * @brief The sharded set of live entries.
+ *
+ * Each shard is a list of fixed-size blocks of slots. Blocks are only ever
+ * added, so a slot's address is stable and an entry can release its slot with
+ * a single store.
+ */
+class registry {
+ public:
+    /**
+     * @brief How many entries one block of slots holds.
+     */
+    static constexpr std::size_t BLOCK_SLOTS = 256;
+
+    /**
+     * @brief How many independent shards registrations are spread over.
+     */
+    static constexpr std::size_t SHARDS = 16;
+
+    /**
+     * @brief A fixed-size block of slots.
+     */
+    struct block {
+        std::atomic<entry*> slots[BLOCK_SLOTS] = {};
+        std::atomic<std::size_t> used{0};
+        block* next = nullptr;
+    };
+
+ private:
+    /**
+     * @brief A list of blocks, padded to avoid false sharing between shards.
+     */
+    struct alignas(64) shard {
+        std::atomic<block*> head;
+    };
+
+    inline static shard shards_[SHARDS];
+    inline static std::atomic<std::size_t> next_shard_{0};
+
+    /**
+     * @brief The shard this thread registers into, assigned round-robin.
+     */
+    [[nodiscard]] static inline shard&
+    local_shard_() noexcept
+    {
+        thread_local std::size_t idx =
+            next_shard_.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+        return shards_[idx];
+    }
+
+    /**
+     * @brief Try to claim a free slot in @p blk for @p ent.
+     *
+     * @return std::atomic<entry*>* The claimed slot, or `nullptr` if full.
+     */
+    [[nodiscard]] static inline std::atomic<entry*>*
+    claim_(block& blk, entry* ent) noexcept
+    {
+        if (blk.used.load(std::memory_order_relaxed) >= BLOCK_SLOTS)
+            return nullptr;
+
+        for (auto& slot : blk.slots) {
+            entry* expected = nullptr;
+            if (slot.load(std::memory_order_relaxed) == nullptr
+                && slot.compare_exchange_strong(
+                    expected, ent, std::memory_order_release,
+                    std::memory_order_relaxed
+                ))
+            {
+                blk.used.fetch_add(1, std::memory_order_relaxed);
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+ public:
+    /**
+     * @brief Register @p ent.
+     *
+     * @param ent The entry to register.
+     * @param[out] owner The block the returned slot belongs to.
+     * @return std::atomic<entry*>* The slot now holding @p ent.
+     */
+    [[nodiscard]] static inline std::atomic<entry*>*
+    add(entry* ent, block*& owner)
+    {
+        auto& shrd = local_shard_();
+
+        block* head = shrd.head.load(std::memory_order_acquire);
+        for (block* blk = head; blk != nullptr; blk = blk->next) {
+            if (auto* slot = claim_(*blk, ent); slot != nullptr) {
+                owner = blk;
+                return slot;
+            }
+        }
+
+        // Every block is full, push a fresh one
+        auto* blk = new block;
+        blk->slots[0].store(ent, std::memory_order_relaxed);
+        blk->used.store(1, std::memory_order_relaxed);
+        blk->next = head;
+        while (!shrd.head.compare_exchange_weak(
+            blk->next, blk, std::memory_order_release, std::memory_order_acquire
+        ))
+        {}
+
+        owner = blk;
+        return &blk->slots[0];
+    }
+
+    /**
+     * @brief Release a slot returned by add().
+     */
+    static inline void
+    remove(std::atomic<entry*>* slot, block* owner) noexcept
+    {
+        slot->store(nullptr, std::memory_order_release);
+        owner->used.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Call @p fn with every registered entry.
+     */
+    template <class Fn>
+    static inline void
+    for_each(Fn&& fn)
+    {
+        for (auto& shrd : shards_) {
+            for (block* blk = shrd.head.load(std::memory_order_acquire);
+                 blk != nullptr; blk = blk->next)
+            {
+                for (auto& slot : blk->slots) {
+                    if (entry* ent = slot.load(std::memory_order_acquire);
+                        ent != nullptr)
+                        fn(*ent);
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @brief A container's membership in the registry.
+ *
+ * Embedded in every ds::vec when `LIBDS_REGISTRY` is defined. Copying or
+ * moving a container creates a fresh entry for the new object; the entry
+ * itself always stays with the object it was constructed in.
+ */
+class entry {
+    void* owner_;
+    const entry_ops* ops_;
+    registry::block* block_ = nullptr;
+    std::atomic<entry*>* slot_;
+
+ public:
+    /**
+     * @brief Register the container @p owner.
+     *
+     * @param owner The container this entry describes.
+     * @param ops The operations for the container's type.
+     */
+    inline entry(void* owner, const entry_ops* ops) :
+        owner_(owner), ops_(ops), slot_(registry::add(this, block_))
+    {}
+
+    entry(const entry&) = delete;
+    entry(entry&&) = delete;
+    entry& operator=(const entry&) = delete;
+    entry& operator=(entry&&) = delete;
+
+    inline ~entry() noexcept { registry::remove(slot_, block_); }
+
+    [[nodiscard]] inline const entry_ops&
+    ops() const noexcept
+    {
+        return *ops_;
+    }
+
+    [[nodiscard]] inline std::size_t
+    size() const
+    {
+        return ops_->size(owner_);
+    }
+
+    [[nodiscard]] inline std::size_t
+    capacity() const
+    {
+        return ops_->capacity(owner_);
+    }
+
+    inline void
+    shrink()
+    {
+        ops_->shrink(owner_);
+    }
+};
+
+/**
+ * @brief Memory held by all live containers of one element type.
+ */
+struct type_usage {
+    std::string type;
+    std::size_t element_size = 0;
+    std::size_t instances = 0;
+    std::size_t capacity_bytes = 0;
+    std::size_t used_bytes = 0;
+
+    [[nodiscard]] inline std::size_t
+    wasted_bytes() const noexcept
+    {
+        return capacity_bytes - used_bytes;
+    }
+};
+
+/**
+ * @brief Memory held by all live containers.
+ */
+struct report {
+    std::size_t instances = 0;
+    std::size_t capacity_bytes = 0;
+    std::size_t used_bytes = 0;
+
+    /**
+     * @brief Usage per element type, biggest waster first.
+     */
+    std::vector<type_usage> types;
+
+    [[nodiscard]] inline std::size_t
+    wasted_bytes() const noexcept
+    {
+        return capacity_bytes - used_bytes;
+    }
+};
+
+/**
+ * @brief Account for the memory held by every live container.
+ *
+ * Must not run concurrently with modifications of registered containers.
+ *
+ * @return report The totals and the per-type breakdown.
+ */
+[[nodiscard]] inline report
+collect()
+{
+    report res;
+    std::vector<const entry_ops*> ops;
+
+    registry::for_each([&](const entry& ent) {
+        auto idx = static_cast<std::size_t>(
+            std::find(ops.begin(), ops.end(), &ent.ops()) - ops.begin()
+        );
+        if (idx == ops.size()) {
+            ops.push_back(&ent.ops());
+            res.types.push_back({ent.ops().type(), ent.ops().element_size});
+        }
+
+        auto& usage = res.types[idx];
+        usage.instances++;
+        usage.capacity_bytes += ent.capacity() * usage.element_size;
+        usage.used_bytes += ent.size() * usage.element_size;
+    });
+
+    for (const auto& usage : res.types) {
+        res.instances += usage.instances;
+        res.capacity_bytes += usage.capacity_bytes;
+        res.used_bytes += usage.used_bytes;
+    }
+
+    std::sort(
+        res.types.begin(), res.types.end(),
+        [](const type_usage& lhs, const type_usage& rhs) {
+            return lhs.wasted_bytes() > rhs.wasted_bytes();
+        }
+    );
+    return res;
+}
+
+/**
+ * @brief Shrink every live container whose unused fraction of capacity is
+ * above @p waste_ratio.
+ *
+ * Must not run concurrently with any use of registered containers.
+ *
+ * @param waste_ratio A fraction in `[0, 1)`, e.g. `0.5` shrinks containers
+ * that use less than half of their capacity.
+ * @return std::size_t How many bytes of capacity were released.
+ */
+inline std::size_t
+shrink_all_above(double waste_ratio)
+{
+    std::size_t released = 0;
+
+    registry::for_each([&](entry& ent) {
+        std::size_t cap = ent.capacity();
+        std::size_t size = ent.size();
+        auto wasted = static_cast<double>(cap - size);
+        if (cap == 0 || wasted <= waste_ratio * static_cast<double>(cap))
+            return;
+
+        ent.shrink();
+        released += (cap - ent.capacity()) * ent.ops().element_size;
+    });
+
+    return released;
+}
+
+} // namespace ds::live
+
+#endif // LIBDS_LIVE_HPP
@@ -0,0 +1,462 @@
+/**
+ * @file merge.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Merging many sorted runs at once.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_MERGE_HPP
+#define LIBDS_MERGE_HPP
+
+#include "libds/bulk.hpp"
+#include "libds/detail/parallel.hpp"
+#include "libds/detail/type_identity.hpp"
+#include "libds/span.hpp"
+#include "libds/vec.hpp"
+
+#include <cstddef>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace ds {
+
+namespace detail {
+
+/**
+ * @brief How many elements in a row one run has to win before merge_k() looks
+ * for the end of its streak and copies it whole.
+ */
+inline constexpr std::size_t MERGE_GALLOP_STREAK = 8;
+
+/**
+ * @brief The fewest output elements per thread worth merging in parallel.
+ */
+inline constexpr std::size_t PARALLEL_MERGE_MIN = std::size_t{1} << 14;
+
+/**
+ * @brief Find the end of the elements from @p first to @p last that satisfy
+ * @p pred, which the elements must be partitioned by.
+ *
+ * Probes 1, 2, 4, ... elements ahead and then binary searches the last step, so
+ * it costs O(log d) for a result d elements ahead.
+ */
+template <class T, class Pred>
+inline const T*
+gallop_partition(const T* first, const T* last, Pred pred)
+{
+    const auto n = static_cast<std::size_t>(last - first);
+    std::size_t lo = 0;
+    std::size_t hi = 1;
+    while (hi < n && pred(first[hi])) {
+        lo = hi;
+        hi *= 2;
+    }
+    return std::partition_point(first + lo, first + std::min(hi, n), pred);
+}
+
+/**
+ * @brief A tournament tree over sorted runs, whose inner nodes hold the loser
+ * of the match played there.
+ *
+ * Taking the smallest head and replacing it with the next element of its run
+ * replays only the matches on that run's path to the root: one comparison per
+ * level, instead of the two per level of a binary heap's sift-down. Matches are
+ * decided without branches, since on random data their outcome cannot be
+ * predicted. Ties go to the run that comes first, so merging is stable.
+ */
+template <class T, class Compare>
+class loser_tree {
+    // The head of each run. Exhausted runs keep pointing at an element, so
+    // matches can compare heads before looking at done_.
+    vec<const T*> heads_;
+    vec<const T*> ends_;
+    vec<unsigned char> done_;
+    // tree_[0] is the overall winner, tree_[1, k) the losers of the inner nodes.
+    // The leaf of run i is node k + i, and the parent of node n is node n / 2.
+    vec<std::size_t> tree_;
+    Compare& cmp_;
+
+    /**
+     * @brief Whether run @p lhs's head comes before run @p rhs's.
+     */
+    [[nodiscard]] bool
+    beats_(std::size_t lhs, std::size_t rhs) const
+    {
+        const T& left = *heads_[lhs];
+        const T& right = *heads_[rhs];
+        const bool live = done_[lhs] == 0;
+        const bool other_done = done_[rhs] != 0;
+        const bool less = cmp_(left, right);
+        const bool tie_won = !cmp_(right, left) && lhs < rhs;
+        return live & (other_done | less | tie_won);
+    }
+
+    /**
+     * @brief Play run @p run's path to the root again.
+     */
+    void
+    replay_(std::size_t run)
+    {
+        const std::size_t k = heads_.size();
+        for (std::size_t node = (run + k) / 2; node > 0; node /= 2) {
+            // Swap the loser kept here with the run coming up, if it wins
+            const std::size_t kept = tree_[node];
+            const std::size_t swap =
+                (kept ^ run) & (std::size_t{0} - std::size_t{beats_(kept, run)});
+            tree_[node] = kept ^ swap;
+            run ^= swap;
+        }
+        tree_[0] = run;
+    }
+
+    /**
+     * @brief Find the run whose head comes right after the winner's, which lost
+     * to it somewhere on its path.
+     *
+     * @return std::size_t The run, or the winner if every other run is empty.
+     */
+    [[nodiscard]] std::size_t
+    runner_up_() const
+    {
+        const std::size_t k = heads_.size();
+        const std::size_t winner = tree_[0];
+        std::size_t best = winner;
+        for (std::size_t node = (winner + k) / 2; node > 0; node /= 2) {
+            const std::size_t loser = tree_[node];
+            if (done_[loser] == 0 && (best == winner || beats_(loser, best)))
+                best = loser;
+        }
+        return best;
+    }
+
+ public:
+    /**
+     * @brief Build the tree over @p runs.
+     *
+     * @param runs The runs, each sorted by @p cmp. There must be at least one.
+     * @param cmp The order, which must outlive the tree.
+     */
+    loser_tree(span<const span<const T>> runs, Compare& cmp) :
+        heads_(runs.size()),
+        ends_(runs.size()),
+        done_(runs.size()),
+        tree_(runs.size(), 0),
+        cmp_(cmp)
+    {
+        const std::size_t k = runs.size();
+        const T* any = nullptr;
+        for (const auto& run : runs) {
+            if (!run.empty())
+                any = run.data();
+        }
+        for (std::size_t i = 0; i < k; i++) {
+            heads_.insert(i, runs[i].empty() ? any : runs[i].data());
+            ends_.insert(i, runs[i].data() + runs[i].size());
+            done_.insert(i, static_cast<unsigned char>(runs[i].empty()));
+        }
+        if (any == nullptr)
+            return;
+
+        // Play every match bottom-up, remembering who went on from each node
+        vec<std::size_t> winners(2 * k, 0);
+        for (std::size_t i = 0; i < k; i++)
+            winners[k + i] = i;
+        for (std::size_t node = k - 1; node > 0; node--) {
+            const std::size_t lhs = winners[2 * node];
+            const std::size_t rhs = winners[2 * node + 1];
+            const bool left_wins = beats_(lhs, rhs);
+            tree_[node] = left_wins ? rhs : lhs;
+            winners[node] = left_wins ? lhs : rhs;
+        }
+        tree_[0] = winners[1];
+    }
+
+    /**
+     * @brief Merge every run into @p out, which has room for all of them.
+     *
+     * When one run wins MERGE_GALLOP_STREAK times in a row, the rest of its
+     * streak is found by galloping up to the runner-up's head and copied whole.
+     *
+     * @param threads How many threads bulk copies may use.
+     */
+    void
+    merge(T* out, std::size_t threads)
+    {
+        std::size_t last = heads_.size();
+        std::size_t streak = 0;
+        for (;;) {
+            const std::size_t winner = tree_[0];
+            if (done_[winner] != 0)
+                return;
+
+            const T*& head = heads_[winner];
+            const T* end = ends_[winner];
+            streak = winner == last ? streak + 1 : 0;
+            last = winner;
+            if (streak >= MERGE_GALLOP_STREAK) {
+                const std::size_t next = runner_up_();
+                if (next != winner) {
+                    const T& bound = *heads_[next];
+                    if (winner < next) {
+                        end = gallop_partition(head, end, [&](const T& elem) {
+                            return !cmp_(bound, elem);
+                        });
+                    } else {
+                        end = gallop_partition(head, end, [&](const T& elem) {
+                            return cmp_(elem, bound);
+                        });
+                    }
+                }
+
+                // Copy all but the last of the streak, which goes below
+                const auto count = static_cast<std::size_t>(end - head) - 1;
+                if constexpr (std::is_trivially_copyable_v<T>)
+                    bulk_copy(out, head, count * sizeof(T), threads);
+                else
+                    std::copy(head, head + count, out);
+                out += count;
+                head += count;
+                streak = 0;
+            }
+
+            *out++ = *head;
+            if (++head == ends_[winner]) {
+                done_[winner] = 1;
+                head--;
+            }
+            replay_(winner);
+        }
+    }
+};
+
+/**
+ * @brief Find where the first @p rank elements of the merge of @p runs end in
+ * each run.
+ *
+ * Narrows a window of possible cut positions in every run: the middle element
+ * of the widest window is ranked among all the runs, and the cuts move past it
+ * or stop before it accordingly, until the rank falls among the copies of one
+ * value. Those are handed out in run order, matching the merge's tie breaking.
+ *
+ * @param cuts Set to one position per run.
+ */
+template <class T, class Compare>
+inline void
+merge_path_cuts(
+    span<const span<const T>> runs, std::size_t rank, std::size_t* cuts, Compare& cmp
+)
+{
+    const std::size_t k = runs.size();
+    vec<std::size_t> hi(k, 0);
+    for (std::size_t i = 0; i < k; i++) {
+        cuts[i] = 0;
+        hi[i] = runs[i].size();
+    }
+
+    for (;;) {
+        std::size_t widest = 0;
+        for (std::size_t i = 1; i < k; i++) {
+            if (hi[i] - cuts[i] > hi[widest] - cuts[widest])
+                widest = i;
+        }
+        if (hi[widest] == cuts[widest])
+            return;
+
+        const T& pivot = runs[widest][(cuts[widest] + hi[widest]) / 2];
+        std::size_t below = 0;
+        std::size_t up_to = 0;
+        for (const auto& run : runs) {
+            below += static_cast<std::size_t>(
+                std::lower_bound(run.begin(), run.end(), pivot, cmp) - run.begin()
+            );
+            up_to += static_cast<std::size_t>(
+                std::upper_bound(run.begin(), run.end(), pivot, cmp) - run.begin()
+            );
+        }
+
+        if (rank < below || rank > up_to) {
+            // Everything up to the pivot is in, or everything from it is out
+            for (std::size_t i = 0; i < k; i++) {
+                const auto& run = runs[i];
+                if (rank > up_to) {
+                    const auto pos = static_cast<std::size_t>(
+                        std::upper_bound(run.begin(), run.end(), pivot, cmp)
+                        - run.begin()
+                    );
+                    cuts[i] = std::max(cuts[i], pos);
+                } else {
+                    const auto pos = static_cast<std::size_t>(
+                        std::lower_bound(run.begin(), run.end(), pivot, cmp)
+                        - run.begin()
+                    );
+                    hi[i] = std::min(hi[i], pos);
+                }
+            }
+            continue;
+        }
+
+        // The cut falls among the copies of the pivot
+        std::size_t left = rank - below;
+        for (std::size_t i = 0; i < k; i++) {
+            const auto& run = runs[i];
+            const auto first = std::lower_bound(run.begin(), run.end(), pivot, cmp);
+            const auto last = std::upper_bound(first, run.end(), pivot, cmp);
+            const auto equal = static_cast<std::size_t>(last - first);
+            const std::size_t take = std::min(left, equal);
+            cuts[i] = static_cast<std::size_t>(first - run.begin()) + take;
+            left -= take;
+        }
+        return;
+    }
+}
+
+/**
+ * @brief Merge @p runs into the @p total elements at @p out, with a loser tree
+ * on each of @p threads threads.
+ */
+template <class T, class Compare>
+inline void
+merge_runs(
+    span<const span<const T>> runs,
+    std::size_t total,
+    T* out,
+    Compare& cmp,
+    std::size_t threads
+)
+{
+    if (threads == 1) {
+        loser_tree<T, Compare>(runs, cmp).merge(out, bulk_threads());
+        return;
+    }
+
+    // Part t of the output starts at rank `bound(t)`; find where in each run
+    const std::size_t k = runs.size();
+    auto bound = [&](std::size_t part) { return total / threads * part; };
+    vec<std::size_t> cuts((threads + 1) * k, 0);
+    for (std::size_t part = 1; part < threads; part++)
+        merge_path_cuts(runs, bound(part), &cuts[part * k], cmp);
+    for (std::size_t i = 0; i < k; i++)
+        cuts[threads * k + i] = runs[i].size();
+
+    vec<vec<span<const T>>> parts(threads);
+    for (std::size_t part = 0; part < threads; part++) {
+        vec<span<const T>> pieces(k);
+        for (std::size_t i = 0; i < k; i++) {
+            const std::size_t first = cuts[part * k + i];
+            pieces.insert(
+                i, runs[i].slice(first, cuts[(part + 1) * k + i] - first)
+            );
+        }
+        parts.insert(part, std::move(pieces));
+    }
+
+    parallel_chunks(threads, threads, [&](std::size_t first, std::size_t last) {
+        for (std::size_t part = first; part < last; part++) {
+            const auto& pieces = parts[part];
+            loser_tree<T, Compare>(span<const span<const T>>(pieces), cmp)
+                .merge(out + bound(part), 1);
+        }
+    });
+}
+
+} // namespace detail
+
+/**
+ * @brief Merge the sorted @p runs into @p out.
+ *
+ * The heads of the runs play a tournament in a loser tree, so each output
+ * element costs one comparison per level of the tree. When one run keeps
+ * winning, the end of its streak is found by galloping up to the next best
+ * head and the whole streak is copied at once (with ds::bulk_copy() for
+ * trivially copyable elements). The merge is stable: equivalent elements keep
+ * the order of their runs.
+ *
+ * With more than one thread, the output is split into equal parts, the cut in
+ * every run for each part's first rank is found by binary search (the k-way
+ * generalisation of a merge path), and each part is merged on its own thread.
+ *
+ * @param runs The runs, each sorted by @p cmp.
+ * @param out Replaced with the merged elements. Its storage is reused, so
+ * reserving it beforehand avoids any allocation. Must not hold any of @p runs.
+ * @param cmp The order. Defaults to `std::less<>`.
+ * @param threads How many threads to merge with. Only used for elements that
+ * can be copied without throwing, and at most one per PARALLEL_MERGE_MIN output
+ * elements. @p cmp must not throw when more than one is used. Uses
+ * `std::thread`, so link with `Threads::Threads` when passing more than one.
+ */
+template <class T, std::size_t A, class Compare = std::less<>>
+inline void
+merge_k(
+    span<const span<const detail::type_identity_t<T>>> runs,
+    vec<T, A>& out,
+    Compare cmp = {},
+    std::size_t threads = 1
+)
+{
+    std::size_t total = 0;
+    for (const auto& run : runs)
+        total += run.size();
+
+    out.clear();
+    out.resize_for_overwrite(total);
+    if (total == 0)
+        return;
+
+    if constexpr (!std::is_nothrow_copy_assignable_v<T>)
+        threads = 1;
+    threads = std::max<std::size_t>(
+        1, std::min(threads, total / detail::PARALLEL_MERGE_MIN)
+    );
+    detail::merge_runs(runs, total, out.data(), cmp, threads);
+}
+
+/**
+ * @brief Merge the sorted @p runs into @p out.
+ *
+ * See the span version.
+ */
+template <class T, std::size_t A, class Compare = std::less<>>
+inline void
+merge_k(
+    std::initializer_list<span<const detail::type_identity_t<T>>> runs,
+    vec<T, A>& out,
+    Compare cmp = {},
+    std::size_t threads = 1
+)
+{
+    merge_k(
+        span<const span<const T>>(runs.begin(), runs.size()), out, std::move(cmp),
+        threads
+    );
+}
+
+} // namespace ds
+
+#endif // LIBDS_MERGE_HPP
@@ -0,0 +1,329 @@
+/**
+ * @file numa.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief NUMA placement policies for large ds::vec buffers.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_NUMA_HPP
+#define LIBDS_NUMA_HPP
+
+#include "libds/vec.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <stdexcept>
+
+#ifdef __linux__
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace ds {
+
+/**
+ * @brief Where the pages of a buffer should be placed.
+ */
+enum class numa_mode {
+    /**
+     * @brief On the node of the thread that first writes each page.
+     */
+    local,
+    /**
+     * @brief Round-robin over a set of nodes, page by page.
+     */
+    interleave,
+    /**
+     * @brief Only on a set of nodes.
+     */
+    bind,
+};
+
+/**
+ * @brief A NUMA placement policy: a mode, plus the nodes it applies to.
+ */
+struct numa_policy {
+    /**
+     * @brief How pages are placed.
+     */
+    numa_mode mode = numa_mode::local;
+
+    /**
+     * @brief The nodes pages may be placed on, one bit per node. Ignored by
+     * numa_mode::local.
+     */
+    std::uint64_t nodes = 0;
+
+    /**
+     * @brief Place each page on the node of the thread that first writes it.
+     *
+     * @return numa_policy The policy.
+     */
+    [[nodiscard]] static constexpr numa_policy
+    local() noexcept
+    {
+        return {numa_mode::local, 0};
+    }
+
+    /**
+     * @brief Spread pages evenly over @p nodes.
+     *
+     * @param nodes The nodes, one bit per node. Defaults to every node.
+     * @return numa_policy The policy.
+     */
+    [[nodiscard]] static constexpr numa_policy
+    interleave(std::uint64_t nodes = ~std::uint64_t{0}) noexcept
+    {
+        return {numa_mode::interleave, nodes};
+    }
+
+    /**
+     * @brief Place every page on node @p node.
+     *
+     * @param node The node, less than 64.
+     * @exception std::out_of_range @p node is 64 or more.
+     * @return numa_policy The policy.
+     */
+    [[nodiscard]] static constexpr numa_policy
+    bind(unsigned node)
+    {
+        if (node >= 64)
+            throw std::out_of_range("numa_policy: node out of range!");
+
+        return {numa_mode::bind, std::uint64_t{1} << node};
+    }
+};
+
+/**
+ * @brief Applies NUMA policies with the Linux `mbind` system call.
+ *
+ * Binders are how ds::numa_bind() and ds::make_numa_vec() reach the kernel, so
+ * code using them can be tested with a binder that just records its calls.
+ * A binder has a single member:
+ *
+ * @code
+ * bool bind(void* addr, std::size_t bytes, const ds::numa_policy& policy,
+ *           bool move) noexcept;
+ * @endcode
+ *
+ * where @p addr and @p bytes are page-aligned, and @p move asks for pages
+ * that already exist to be migrated. It returns whether the policy was applied.
+ */
+struct mbind_binder {
+    /**
+     * @brief Apply @p policy to the pages in `[addr, addr + bytes)`.
+     *
+     * Fails (and does nothing) on kernels without NUMA support, or where the
+     * nodes in the policy do not exist.
+     *
+     * @param addr The first page.
+     * @param bytes The size of the range, a multiple of the page size.
+     * @param policy The policy.
+     * @param move Whether to migrate pages that were already touched.
+     * @return bool Whether the policy was applied.
+     */
+    inline bool
+    bind(
+        [[maybe_unused]] void* addr, [[maybe_unused]] std::size_t bytes,
+        [[maybe_unused]] const numa_policy& policy, [[maybe_unused]] bool move
+    ) const noexcept
+    {
+#if defined(__linux__) && defined(SYS_mbind)
+        // From <linux/mempolicy.h>, which only recent kernel headers ship
+        constexpr int MODE_BIND = 2;
+        constexpr int MODE_INTERLEAVE = 3;
+        constexpr int MODE_LOCAL = 4;
+        constexpr unsigned FLAG_MOVE = 1U << 1U;
+
+        unsigned long mask = policy.nodes;
+        const unsigned long* nodemask = &mask;
+        // The kernel reads maxnode - 1 bits
+        unsigned long maxnode = sizeof(mask) * 8 + 1;
+        int mode = MODE_LOCAL;
+        switch (policy.mode) {
+            case numa_mode::local:
+                nodemask = nullptr;
+                maxnode = 0;
+                break;
+            case numa_mode::interleave:
+                mode = MODE_INTERLEAVE;
+                break;
+            case numa_mode::bind:
+                mode = MODE_BIND;
+                break;
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+        long res = syscall(
+            SYS_mbind, addr, bytes, mode, nodemask, maxnode, move ? FLAG_MOVE : 0U
+        );
+        return res == 0;
+#else
+        return false;
+#endif
+    }
+};
+
+/**
+ * @brief A binder that never applies a policy, for machines (or tests) where
+ * placement does not matter.
+ */
+struct null_binder {
+    /**
+     * @brief Do nothing.
+     *
+     * @return bool Always false.
+     */
+    inline bool
+    bind(void*, std::size_t, const numa_policy&, bool) const noexcept
+    {
+        return false;
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Get the size of a memory page.
+ *
+ * @return std::size_t The page size, in bytes.
+ */
+[[nodiscard]] inline std::size_t
+page_size() noexcept
+{
+#ifdef __linux__
+    static const std::size_t SIZE = [] {
+        long size = sysconf(_SC_PAGESIZE);
+        return size > 0 ? static_cast<std::size_t>(size) : std::size_t{4096};
+    }();
+    return SIZE;
+#else
+    return 4096;
+#endif
+}
+
+/**
+ * @brief Apply @p policy to every page that lies entirely inside
+ * `[addr, addr + bytes)`.
+ *
+ * Pages at either end that are only partly inside are left alone, since they
+ * may belong to other allocations.
+ *
+ * @return bool Whether the policy was applied, or true if there are no such
+ * pages.
+ */
+template <class Binder>
+inline bool
+bind_pages(
+    Binder& binder, void* addr, std::size_t bytes, const numa_policy& policy, bool move
+)
+{
+    const std::size_t page = page_size();
+    const auto begin = reinterpret_cast<std::uintptr_t>(addr);
+    const std::uintptr_t first = (begin + page - 1) / page * page;
+    const std::uintptr_t last = (begin + bytes) / page * page;
+    if (first >= last)
+        return true;
+
+    // NOLINTNEXTLINE(performance-no-int-to-ptr)
+    return binder.bind(reinterpret_cast<void*>(first), last - first, policy, move);
+}
+
+} // namespace detail
+
+/**
+ * @brief Apply a NUMA policy to the whole buffer of @p v, including its spare
+ * capacity.
+ *
+ * Pages that were already written are migrated; pages that were not are placed
+ * by the policy when they are first written. The policy belongs to the buffer,
+ * so it is lost when the vector reallocates: reserve() first. The pages at the
+ * very start and end of the buffer are shared with other allocations unless the
+ * vector is page-aligned (e.g. `ds::vec<T, 4096>`), and are left alone.
+ *
+ * @tparam Binder How to apply the policy.
+ * @param v The vector.
+ * @param policy The policy.
+ * @param binder The binder to use.
+ * @return bool Whether the policy was applied.
+ */
+template <class T, std::size_t Alignment, class Binder = mbind_binder>
+inline bool
+numa_bind(vec<T, Alignment>& v, const numa_policy& policy, Binder binder = {})
+{
+    return detail::bind_pages(
+        binder, v.data(), v.capacity() * sizeof(T), policy, /* move = */ true
+    );
+}
+
+/**
+ * @brief Make a vector of @p size copies of @p elem, with its pages placed by
+ * @p policy.
+ *
+ * The policy is applied before any element is written, so nothing needs to be
+ * migrated. The elements are then written by @p threads threads, each filling
+ * one contiguous part (see vec::resize()). With numa_mode::local, this puts
+ * each part on the node of the thread that wrote it; run the threads that will
+ * later process each part on the same nodes (e.g. with the same pinned thread
+ * pool) to keep their accesses local.
+ *
+ * If the policy cannot be applied, e.g. on a kernel without NUMA support, the
+ * vector is still made, with only the parallel first-touch; pass @p applied to
+ * find out whether it was.
+ *
+ * @tparam Alignment The alignment of the vector's buffer.
+ * @tparam Binder How to apply the policy.
+ * @param size The size of the vector.
+ * @param elem The element to fill the vector with.
+ * @param policy The policy.
+ * @param threads How many threads to fill the vector with. Uses `std::thread`,
+ * so link with `Threads::Threads` when passing more than one.
+ * @param binder The binder to use.
+ * @param[out] applied If not null, set to whether the policy was applied.
+ * @return vec<T, Alignment> The vector.
+ */
+template <class T, std::size_t Alignment = alignof(T), class Binder = mbind_binder>
+[[nodiscard]] inline vec<T, Alignment>
+make_numa_vec(
+    std::size_t size, const T& elem, const numa_policy& policy,
+    std::size_t threads = 1, Binder binder = {}, bool* applied = nullptr
+)
+{
+    vec<T, Alignment> v(size);
+    const bool bound = detail::bind_pages(
+        binder, v.data(), size * sizeof(T), policy, /* move = */ false
+    );
+    if (applied != nullptr)
+        *applied = bound;
+
+    v.resize(size, elem, threads);
+    return v;
+}
+
+} // namespace ds
+
+#endif // LIBDS_NUMA_HPP
@@ -0,0 +1,298 @@
+/**
+ * @file perf_scope.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Hardware performance counters for a region of code.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_PERF_SCOPE_HPP
+#define LIBDS_PERF_SCOPE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace ds {
+
+/**
+ * @brief The hardware events a perf_scope records.
+ */
+enum class perf_event : std::size_t {
+    cycles,
+    instructions,
+    cache_misses,
+    branch_misses,
+    dtlb_misses,
+};
+
+/**
+ * @brief How many different perf_event values there are.
+ */
+inline constexpr std::size_t PERF_EVENT_COUNT = 5;
+
+/**
+ * @brief Get a short, identifier-like name for @p event.
+ *
+ * @param event The event.
+ * @return const char* The name, e.g. `"cache_misses"`.
+ */
+[[nodiscard]] constexpr const char*
+perf_event_name(perf_event event) noexcept
+{
+    constexpr const char* NAMES[PERF_EVENT_COUNT] = {
+        "cycles", "instructions", "cache_misses", "branch_misses", "dtlb_misses",
+    };
+    return NAMES[static_cast<std::size_t>(event)];
+}
+
+/**
+ * @brief Counts recorded by a perf_scope.
+ */
+struct perf_counts {
+    /**
+     * @brief The count of each event, indexed by perf_event.
+     */
+    std::uint64_t values[PERF_EVENT_COUNT] = {};
+
+    /**
+     * @brief Whether each event could be recorded, indexed by perf_event.
+     */
+    bool valid[PERF_EVENT_COUNT] = {};
+
+    /**
+     * @brief Check whether @p event was recorded.
+     *
+     * @param event The event.
+     * @return bool Whether its count is meaningful.
+     */
+    [[nodiscard]] constexpr bool
+    has(perf_event event) const noexcept
+    {
+        return valid[static_cast<std::size_t>(event)];
+    }
+
+    /**
+     * @brief Get the count of @p event.
+     *
+     * @param event The event.
+     * @return std::uint64_t Its count, or 0 if it was not recorded.
+     */
+    [[nodiscard]] constexpr std::uint64_t
+    operator[](perf_event event) const noexcept
+    {
+        return values[static_cast<std::size_t>(event)];
+    }
+};
+
+/**
+ * @brief Record hardware performance counters for a region of code.
+ *
+ * Counting starts on construction and stops on destruction, and only covers
+ * the calling thread (user space only, so it works with the default
+ * `perf_event_paranoid` setting). Events are opened independently, so a
+ * machine without e.g. a dTLB miss counter still reports the rest. Where
+ * `perf_event_open` is unavailable altogether (other platforms, containers,
+ * VMs without a PMU) nothing is recorded and no error is raised; check
+ * perf_counts::has() or available().
+ *
+ * When the kernel multiplexes more events than the PMU has counters, the
+ * counts are scaled by the fraction of time each event was actually counted.
+ *
+ * @code
+ * ds::perf_counts counts;
+ * {
+ *     ds::perf_scope scope(counts);
+ *     work();
+ * }
+ * if (counts.has(ds::perf_event::cache_misses))
+ *     ...
+ * @endcode
+ */
+class perf_scope {
+    int fds_[PERF_EVENT_COUNT];
+    perf_counts* out_;
+
+#ifdef __linux__
+    /**
+     * @brief Open a counter for @p event on the calling thread.
+     *
+     * @return int The file descriptor, or -1 if unsupported.
+     */
+    [[nodiscard]] static inline int
+    open_(perf_event event) noexcept
+    {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format =
+            PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        switch (event) {
+            case perf_event::cycles:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case perf_event::instructions:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case perf_event::cache_misses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+            case perf_event::branch_misses:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            case perf_event::dtlb_misses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_DTLB
+                            | (PERF_COUNT_HW_CACHE_OP_READ << 8U)
+                            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U);
+                break;
+        }
+
+        // pid = 0, cpu = -1: this thread, on any CPU
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+        long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0UL);
+        return fd < 0 ? -1 : static_cast<int>(fd);
+    }
+#endif
+
+ public:
+    /**
+     * @brief Start counting.
+     *
+     * @param out Where to store the counts when this scope ends, if anywhere.
+     */
+    explicit perf_scope(perf_counts* out = nullptr) noexcept : fds_(), out_(out)
+    {
+        for (std::size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+#ifdef __linux__
+            fds_[i] = open_(static_cast<perf_event>(i));
+#else
+            fds_[i] = -1;
+#endif
+        }
+
+#ifdef __linux__
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0); // NOLINT(hicpp-vararg)
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0); // NOLINT(hicpp-vararg)
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief Start counting.
+     *
+     * @param out Where to store the counts when this scope ends.
+     */
+    explicit perf_scope(perf_counts& out) noexcept : perf_scope(&out) {}
+
+    perf_scope(const perf_scope&) = delete;
+    perf_scope(perf_scope&&) = delete;
+    perf_scope& operator=(const perf_scope&) = delete;
+    perf_scope& operator=(perf_scope&&) = delete;
+
+    /**
+     * @brief Stop counting, and store the counts if requested.
+     */
+    ~perf_scope() noexcept
+    {
+        if (out_ != nullptr)
+            *out_ = read();
+
+#ifdef __linux__
+        for (int fd : fds_) {
+            if (fd >= 0)
+                close(fd);
+        }
+#endif
+    }
+
+    /**
+     * @brief Check whether any event is being recorded.
+     *
+     * @return bool Whether perf events are available at all.
+     */
+    [[nodiscard]] inline bool
+    available() const noexcept
+    {
+        for (int fd : fds_) {
+            if (fd >= 0)
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Get the counts so far, without stopping.
+     *
+     * @return perf_counts The counts since construction.
+     */
+    [[nodiscard]] inline perf_counts
+    read() const noexcept
+    {
+        perf_counts res;
+
+#ifdef __linux__
+        for (std::size_t i = 0; i < PERF_EVENT_COUNT; i++) {
+            // value, time enabled, time running
+            std::uint64_t buf[3] = {};
+            if (fds_[i] < 0
+                || ::read(fds_[i], buf, sizeof(buf))
+                       != static_cast<ssize_t>(sizeof(buf)))
+                continue;
+
+            res.valid[i] = true;
+            res.values[i] = buf[0];
+            if (buf[2] != 0 && buf[2] < buf[1]) {
+                res.values[i] = static_cast<std::uint64_t>(
+                    static_cast<double>(buf[0]) * static_cast<double>(buf[1])
+                    / static_cast<double>(buf[2])
+                );
+            }
+        }
+#endif
+
+        return res;
+    }
+};
+
+} // namespace ds
+
+#endif // LIBDS_PERF_SCOPE_HPP
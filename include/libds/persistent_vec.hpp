@@ -0,0 +1,1526 @@
+/**
+ * @file persistent_vec.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief An immutable vector whose versions share structure (an RRB tree).
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_PERSISTENT_VEC_HPP
+#define LIBDS_PERSISTENT_VEC_HPP
+
+#include "libds/detail/index_iterator.hpp"
+#include "libds/detail/relocate.hpp"
+#include "libds/span.hpp"
+#include "libds/vec.hpp"
+
+#include <cstddef>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace ds {
+
+template <class T>
+class transient_vec;
+
+/**
+ * @brief An immutable vector. Every modification returns a new version, which
+ * shares all unchanged parts with the old one.
+ *
+ * The elements live in the leaves of a relaxed radix balanced (RRB) tree with
+ * 32 children per node, plus a tail leaf that holds the last (up to) 32
+ * elements. Indexing, set() and push_back() are O(log32 n), and push_back()
+ * usually only copies the tail. Every inner node keeps the cumulative sizes of
+ * its children, so leaves do not have to be full: concat() and slice() cut and
+ * join the trees along one path and only repack the leaves at the seam, in
+ * O(log n) instead of O(n).
+ *
+ * Keeping many versions around costs O(log n) new nodes per modification, while
+ * copying a ds::vec per version costs O(n). Versions can be shared between
+ * threads; nodes are reference counted atomically.
+ *
+ * For batches of edits use transient(): a ds::transient_vec changes the nodes
+ * only it refers to in place, and only copies the ones still shared with other
+ * versions.
+ *
+ * @tparam T The type of data this vector will hold.
+ */
+template <class T>
+class persistent_vec {
+    friend class transient_vec<T>;
+
+ public:
+    /**
+     * @brief The type of the stored elements.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Unsigned integer type used for indicies.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief A random access iterator to @p T. Elements are read-only.
+     */
+    using iterator = detail::index_iterator<const persistent_vec, const T>;
+
+    /**
+     * @brief A constant random access iterator to @p T.
+     */
+    using const_iterator = iterator;
+
+    /**
+     * @brief The mutable counterpart of this vector, for batches of edits.
+     */
+    using transient_type = transient_vec<T>;
+
+ private:
+    /**
+     * @brief log2 of the number of children of a node.
+     */
+    static constexpr size_type BITS = 5;
+
+    /**
+     * @brief The number of children of a node, and of elements in a leaf.
+     */
+    static constexpr size_type BRANCHES = size_type{1} << BITS;
+
+    /**
+     * @brief The parts shared by leaves and inner nodes.
+     *
+     * Whether a node is a leaf follows from its height, so it is not stored.
+     */
+    struct node_ {
+        mutable std::atomic<size_type> refs{1};
+        size_type count{0};
+    };
+
+    /**
+     * @brief A node with up to BRANCHES elements.
+     */
+    struct leaf_ : node_ {
+        alignas(T) unsigned char storage[BRANCHES * sizeof(T)];
+
+        leaf_() noexcept {} // NOLINT(modernize-use-equals-default): no zeroing
+
+        leaf_(const leaf_&) = delete;
+        leaf_& operator=(const leaf_&) = delete;
+
+        ~leaf_() noexcept { detail::destroy(elems(), this->count); }
+
+        [[nodiscard]] T*
+        elems() noexcept
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            return reinterpret_cast<T*>(storage);
+        }
+
+        [[nodiscard]] const T*
+        elems() const noexcept
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            return reinterpret_cast<const T*>(storage);
+        }
+    };
+
+    /**
+     * @brief A node with up to BRANCHES children, and their cumulative sizes.
+     */
+    struct inner_ : node_ {
+        std::array<node_*, BRANCHES> children{};
+        std::array<size_type, BRANCHES> sizes{};
+    };
+
+    /**
+     * @brief The one or two nodes that two subtrees are merged into.
+     */
+    struct merged_ {
+        std::array<node_*, 2> nodes{};
+        size_type count{0};
+    };
+
+    node_* root_;
+    node_* tail_;
+    size_type size_;
+    size_type shift_;
+
+#pragma region "Helpers"
+
+    [[nodiscard]] static inline leaf_*
+    as_leaf_(node_* node) noexcept
+    {
+        return static_cast<leaf_*>(node);
+    }
+
+    [[nodiscard]] static inline const leaf_*
+    as_leaf_(const node_* node) noexcept
+    {
+        return static_cast<const leaf_*>(node);
+    }
+
+    [[nodiscard]] static inline inner_*
+    as_inner_(node_* node) noexcept
+    {
+        return static_cast<inner_*>(node);
+    }
+
+    [[nodiscard]] static inline const inner_*
+    as_inner_(const node_* node) noexcept
+    {
+        return static_cast<const inner_*>(node);
+    }
+
+    /**
+     * @brief Add a reference to a node.
+     *
+     * @param node The node, or nullptr.
+     * @return node_* The node.
+     */
+    static inline node_*
+    retain_(node_* node) noexcept
+    {
+        if (node != nullptr)
+            node->refs.fetch_add(1, std::memory_order_relaxed);
+        return node;
+    }
+
+    /**
+     * @brief Drop a reference to a node, freeing it (and dropping its references
+     * to its children) if it was the last one.
+     *
+     * @param node The node, or nullptr.
+     * @param shift The height of the node: 0 for leaves, BITS more per level.
+     */
+    static void
+    release_(node_* node, size_type shift) noexcept
+    {
+        if (node == nullptr || node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        if (shift == 0) {
+            delete as_leaf_(node); // NOLINT(cppcoreguidelines-owning-memory)
+            return;
+        }
+
+        inner_* inner = as_inner_(node);
+        for (size_type i = 0; i < inner->count; i++)
+            release_(inner->children[i], shift - BITS);
+        delete inner; // NOLINT(cppcoreguidelines-owning-memory)
+    }
+
+    /**
+     * @brief Check whether only one reference to a node exists, so it can be
+     * changed in place.
+     */
+    [[nodiscard]] static inline bool
+    is_unique_(const node_* node) noexcept
+    {
+        return node->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    /**
+     * @brief Get the number of elements under a node.
+     *
+     * @param node The node.
+     * @param shift The height of the node.
+     * @return size_type The number of elements.
+     */
+    [[nodiscard]] static inline size_type
+    size_of_(const node_* node, size_type shift) noexcept
+    {
+        if (shift == 0)
+            return node->count;
+
+        const inner_* inner = as_inner_(node);
+        return inner->sizes[inner->count - 1];
+    }
+
+    /**
+     * @brief Find the child of a node that holds the element at @p pos.
+     *
+     * A child holds at most `1 << shift` elements, so the radix guess never
+     * overshoots, and it is exact for nodes whose children are all full.
+     *
+     * @param inner The node.
+     * @param pos The position in the node, changed to the position in the child.
+     * @param shift The height of the node.
+     * @return size_type The index of the child.
+     */
+    [[nodiscard]] static inline size_type
+    child_(const inner_* inner, size_type& pos, size_type shift) noexcept
+    {
+        size_type child = pos >> shift;
+        while (inner->sizes[child] <= pos)
+            child++;
+
+        if (child > 0)
+            pos -= inner->sizes[child - 1];
+        return child;
+    }
+
+    /**
+     * @brief Append a child to a node that has room for it.
+     *
+     * @param inner The node.
+     * @param child The child. The node takes over the reference.
+     * @param child_shift The height of the child.
+     */
+    static inline void
+    append_child_(inner_* inner, node_* child, size_type child_shift) noexcept
+    {
+        const size_type before = inner->count > 0 ? inner->sizes[inner->count - 1] : 0;
+        inner->children[inner->count] = child;
+        inner->sizes[inner->count] = before + size_of_(child, child_shift);
+        inner->count++;
+    }
+
+    /**
+     * @brief Copy @p count elements of a leaf into a new leaf.
+     *
+     * @param src The leaf to copy from.
+     * @param first The first element to copy.
+     * @param count How many elements to copy.
+     * @return node_* The new leaf.
+     */
+    [[nodiscard]] static node_*
+    copy_leaf_(const node_* src, size_type first, size_type count)
+    {
+        auto* leaf = new leaf_; // NOLINT(cppcoreguidelines-owning-memory)
+        try {
+            for (; leaf->count < count; leaf->count++) {
+                ::new (static_cast<void*>(&leaf->elems()[leaf->count]))
+                    T(as_leaf_(src)->elems()[first + leaf->count]);
+            }
+        } catch (...) {
+            delete leaf; // NOLINT(cppcoreguidelines-owning-memory)
+            throw;
+        }
+
+        return leaf;
+    }
+
+    /**
+     * @brief Make sure a node referred to by @p slot is only referred to once,
+     * replacing it by a copy if needed.
+     *
+     * @param slot Where the node is referred to from.
+     * @param shift The height of the node.
+     * @return inner_* The node, which can now be changed in place.
+     */
+    static inner_*
+    own_inner_(node_*& slot, size_type shift)
+    {
+        if (!is_unique_(slot)) {
+            const inner_* src = as_inner_(slot);
+            auto* copy = new inner_; // NOLINT(cppcoreguidelines-owning-memory)
+            for (size_type i = 0; i < src->count; i++)
+                copy->children[i] = retain_(src->children[i]);
+            copy->sizes = src->sizes;
+            copy->count = src->count;
+
+            release_(slot, shift);
+            slot = copy;
+        }
+
+        return as_inner_(slot);
+    }
+
+    /**
+     * @brief Like own_inner_(), for leaves.
+     *
+     * @param slot Where the leaf is referred to from.
+     * @return leaf_* The leaf, which can now be changed in place.
+     */
+    static leaf_*
+    own_leaf_(node_*& slot)
+    {
+        if (!is_unique_(slot)) {
+            node_* copy = copy_leaf_(slot, 0, slot->count);
+            release_(slot, 0);
+            slot = copy;
+        }
+
+        return as_leaf_(slot);
+    }
+
+    /**
+     * @brief Get the position of the first element in the tail.
+     */
+    [[nodiscard]] inline size_type
+    tail_offset_() const noexcept
+    {
+        return tail_ == nullptr ? size_ : size_ - tail_->count;
+    }
+
+    /**
+     * @brief Find the leaf that holds the element at @p pos.
+     *
+     * @param pos The position, changed to the position in the leaf.
+     * @return const leaf_* The leaf (possibly the tail).
+     */
+    [[nodiscard]] inline const leaf_*
+    leaf_for_(size_type& pos) const noexcept
+    {
+        const size_type offset = tail_offset_();
+        if (pos >= offset) {
+            pos -= offset;
+            return as_leaf_(tail_);
+        }
+
+        const node_* node = root_;
+        for (size_type shift = shift_; shift > 0; shift -= BITS) {
+            const inner_* inner = as_inner_(node);
+            node = inner->children[child_(inner, pos, shift)];
+        }
+        return as_leaf_(node);
+    }
+
+    /**
+     * @brief Check whether another leaf fits under a node.
+     */
+    [[nodiscard]] static bool
+    has_room_(const node_* node, size_type shift) noexcept
+    {
+        const inner_* inner = as_inner_(node);
+        if (inner->count < BRANCHES)
+            return true;
+
+        return shift > BITS && has_room_(inner->children[BRANCHES - 1], shift - BITS);
+    }
+
+    /**
+     * @brief Build a chain of single-child nodes down to a leaf.
+     *
+     * @param shift The height of the top of the chain.
+     * @param leaf The leaf. The chain takes over the reference, but only once
+     * nothing can throw anymore.
+     * @return node_* The top of the chain.
+     */
+    [[nodiscard]] static node_*
+    path_(size_type shift, node_* leaf)
+    {
+        std::array<inner_*, sizeof(size_type) * 8 / BITS + 1> chain{};
+        const size_type height = shift / BITS;
+        try {
+            for (size_type i = 0; i < height; i++)
+                chain[i] = new inner_; // NOLINT(cppcoreguidelines-owning-memory)
+        } catch (...) {
+            for (inner_* inner : chain)
+                delete inner; // NOLINT(cppcoreguidelines-owning-memory)
+            throw;
+        }
+
+        node_* node = leaf;
+        for (size_type i = 0; i < height; i++) {
+            append_child_(chain[i], node, i * BITS);
+            node = chain[i];
+        }
+        return node;
+    }
+
+    /**
+     * @brief Append a leaf to a subtree that has room for it.
+     *
+     * @param slot Where the subtree is referred to from.
+     * @param shift The height of the subtree.
+     * @param leaf The leaf. The subtree takes over the reference.
+     */
+    static void
+    push_leaf_(node_*& slot, size_type shift, node_* leaf)
+    {
+        inner_* inner = own_inner_(slot, shift);
+        node_*& last = inner->children[inner->count - 1];
+
+        if (shift > BITS && has_room_(last, shift - BITS)) {
+            push_leaf_(last, shift - BITS, leaf);
+            inner->sizes[inner->count - 1] += leaf->count;
+        } else {
+            append_child_(inner, path_(shift - BITS, leaf), shift - BITS);
+        }
+    }
+
+    /**
+     * @brief Append a leaf to the tree, making it taller if it is full.
+     *
+     * @param leaf The leaf. The tree takes over the reference (which is dropped
+     * if this throws).
+     */
+    inline void
+    push_tail_leaf_(node_* leaf)
+    {
+        try {
+            if (root_ == nullptr) {
+                root_ = path_(BITS, leaf);
+                shift_ = BITS;
+                return;
+            }
+
+            if (!has_room_(root_, shift_)) {
+                auto* root = new inner_; // NOLINT(cppcoreguidelines-owning-memory)
+                append_child_(root, root_, shift_);
+                root_ = root;
+                shift_ += BITS;
+            }
+
+            push_leaf_(root_, shift_, leaf);
+        } catch (...) {
+            release_(leaf, 0);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Remove roots with a single child.
+     */
+    inline void
+    collapse_() noexcept
+    {
+        while (shift_ > BITS && root_->count == 1) {
+            node_* child = retain_(as_inner_(root_)->children[0]);
+            release_(root_, shift_);
+            root_ = child;
+            shift_ -= BITS;
+        }
+    }
+
+    /**
+     * @brief Drop the whole tree, keeping only the tail.
+     */
+    inline void
+    drop_tree_() noexcept
+    {
+        release_(root_, shift_);
+        root_ = nullptr;
+        shift_ = BITS;
+    }
+
+    /**
+     * @brief Construct an element at the end, in place where possible.
+     *
+     * @tparam Args The types of the constructor arguments.
+     * @param args The arguments to construct the element from.
+     */
+    template <class... Args>
+    void
+    emplace_back_(Args&&... args)
+    {
+        if (tail_ != nullptr && tail_->count < BRANCHES) {
+            if (is_unique_(tail_)) {
+                leaf_* tail = as_leaf_(tail_);
+                ::new (static_cast<void*>(&tail->elems()[tail->count]))
+                    T(std::forward<Args>(args)...);
+                tail->count++;
+            } else {
+                // args may refer to an element of the old tail, so keep it alive
+                node_* tail = copy_leaf_(tail_, 0, tail_->count);
+                try {
+                    ::new (static_cast<void*>(&as_leaf_(tail)->elems()[tail->count]))
+                        T(std::forward<Args>(args)...);
+                } catch (...) {
+                    release_(tail, 0);
+                    throw;
+                }
+                tail->count++;
+
+                release_(tail_, 0);
+                tail_ = tail;
+            }
+        } else {
+            auto* tail = new leaf_; // NOLINT(cppcoreguidelines-owning-memory)
+            try {
+                ::new (static_cast<void*>(tail->elems()))
+                    T(std::forward<Args>(args)...);
+                tail->count++;
+
+                if (tail_ != nullptr)
+                    push_tail_leaf_(retain_(tail_));
+            } catch (...) {
+                release_(tail, 0);
+                throw;
+            }
+
+            release_(tail_, 0);
+            tail_ = tail;
+        }
+
+        size_++;
+    }
+
+    /**
+     * @brief Replace the element at @p pos, copying the path to it if it is
+     * shared.
+     *
+     * @param pos The position of the element.
+     * @param elem The new element.
+     */
+    void
+    set_(size_type pos, T elem)
+    {
+        const size_type offset = tail_offset_();
+        if (pos >= offset) {
+            own_leaf_(tail_)->elems()[pos - offset] = std::move(elem);
+            return;
+        }
+
+        node_** slot = &root_;
+        for (size_type shift = shift_; shift > 0; shift -= BITS) {
+            inner_* inner = own_inner_(*slot, shift);
+            slot = &inner->children[child_(inner, pos, shift)];
+        }
+        own_leaf_(*slot)->elems()[pos] = std::move(elem);
+    }
+
+    /**
+     * @brief Keep only the first @p count elements of a subtree.
+     *
+     * @param slot Where the subtree is referred to from.
+     * @param shift The height of the subtree.
+     * @param count How many elements to keep (at least one).
+     */
+    static void
+    truncate_(node_*& slot, size_type shift, size_type count)
+    {
+        if (shift == 0) {
+            if (count < slot->count) {
+                leaf_* leaf = own_leaf_(slot);
+                detail::destroy(leaf->elems() + count, leaf->count - count);
+                leaf->count = count;
+            }
+            return;
+        }
+
+        inner_* inner = own_inner_(slot, shift);
+        size_type pos = count - 1;
+        const size_type last = child_(inner, pos, shift);
+
+        for (size_type i = last + 1; i < inner->count; i++)
+            release_(inner->children[i], shift - BITS);
+        inner->count = last + 1;
+
+        truncate_(inner->children[last], shift - BITS, pos + 1);
+        inner->sizes[last] = count;
+    }
+
+    /**
+     * @brief Remove the first @p count elements of a subtree.
+     *
+     * @param slot Where the subtree is referred to from.
+     * @param shift The height of the subtree.
+     * @param count How many elements to remove (less than the subtree holds).
+     */
+    static void
+    cut_front_(node_*& slot, size_type shift, size_type count)
+    {
+        if (shift == 0) {
+            node_* leaf = copy_leaf_(slot, count, slot->count - count);
+            release_(slot, 0);
+            slot = leaf;
+            return;
+        }
+
+        inner_* inner = own_inner_(slot, shift);
+        size_type pos = count;
+        const size_type first = child_(inner, pos, shift);
+
+        for (size_type i = 0; i < first; i++)
+            release_(inner->children[i], shift - BITS);
+        for (size_type i = first; i < inner->count; i++) {
+            inner->children[i - first] = inner->children[i];
+            inner->sizes[i - first] = inner->sizes[i] - count;
+        }
+        inner->count -= first;
+
+        if (pos > 0)
+            cut_front_(inner->children[0], shift - BITS, pos);
+    }
+
+    /**
+     * @brief Keep only the first @p count elements.
+     *
+     * @param count How many elements to keep.
+     */
+    void
+    take_(size_type count)
+    {
+        if (count == 0) {
+            drop_tree_();
+            release_(tail_, 0);
+            tail_ = nullptr;
+            size_ = 0;
+            return;
+        }
+
+        const size_type offset = tail_offset_();
+        if (count > offset) {
+            leaf_* tail = own_leaf_(tail_);
+            detail::destroy(tail->elems() + (count - offset), size_ - count);
+            tail->count = count - offset;
+        } else {
+            // The leaf holding the new last element becomes the tail
+            size_type pos = count - 1;
+            const leaf_* last = leaf_for_(pos);
+            node_* tail = copy_leaf_(last, 0, pos + 1);
+
+            const size_type rest = count - (pos + 1);
+            if (rest == 0) {
+                drop_tree_();
+            } else {
+                try {
+                    truncate_(root_, shift_, rest);
+                } catch (...) {
+                    release_(tail, 0);
+                    throw;
+                }
+                collapse_();
+            }
+
+            release_(tail_, 0);
+            tail_ = tail;
+        }
+
+        size_ = count;
+    }
+
+    /**
+     * @brief Remove the first @p count elements.
+     *
+     * @param count How many elements to remove (less than size()).
+     */
+    void
+    drop_(size_type count)
+    {
+        const size_type offset = tail_offset_();
+        if (count >= offset) {
+            node_* tail = copy_leaf_(tail_, count - offset, size_ - count);
+            drop_tree_();
+            release_(tail_, 0);
+            tail_ = tail;
+        } else {
+            cut_front_(root_, shift_, count);
+            collapse_();
+        }
+
+        size_ -= count;
+    }
+
+    /**
+     * @brief Put nodes under one or two new parents.
+     *
+     * @param all The nodes. The parents take over the references.
+     * @param count The number of nodes, at most `2 * BRANCHES`.
+     * @param shift The height of the parents.
+     * @return merged_ The parents.
+     */
+    static merged_
+    group_(node_* const* all, size_type count, size_type shift)
+    {
+        merged_ out;
+        out.count = (count + BRANCHES - 1) / BRANCHES;
+
+        out.nodes[0] = new inner_; // NOLINT(cppcoreguidelines-owning-memory)
+        if (out.count == 2) {
+            try {
+                out.nodes[1] = new inner_; // NOLINT(cppcoreguidelines-owning-memory)
+            } catch (...) {
+                // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+                delete as_inner_(out.nodes[0]);
+                throw;
+            }
+        }
+
+        for (size_type i = 0; i < count; i++)
+            append_child_(as_inner_(out.nodes[i / BRANCHES]), all[i], shift - BITS);
+        return out;
+    }
+
+    /**
+     * @brief Copy the elements of the leaves under two nodes into full leaves.
+     *
+     * Full leaves are shared instead of copied, as long as they do not have to
+     * move.
+     *
+     * @param left The left node, of height BITS.
+     * @param right The right node, of height BITS.
+     * @param all Where to put the leaves.
+     * @param count The number of leaves in @p all, updated.
+     */
+    static void
+    repack_leaves_(
+        const inner_* left, const inner_* right, node_** all, size_type& count
+    )
+    {
+        leaf_* building = nullptr;
+        try {
+            for (const inner_* inner : {left, right}) {
+                for (size_type i = 0; i < inner->count; i++) {
+                    const leaf_* leaf = as_leaf_(inner->children[i]);
+                    if (building == nullptr && leaf->count == BRANCHES) {
+                        all[count++] = retain_(inner->children[i]);
+                        continue;
+                    }
+
+                    for (size_type j = 0; j < leaf->count; j++) {
+                        if (building == nullptr) {
+                            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+                            building = new leaf_;
+                        }
+
+                        ::new (static_cast<void*>(&building->elems()[building->count]))
+                            T(leaf->elems()[j]);
+                        if (++building->count == BRANCHES)
+                            all[count++] = std::exchange(building, nullptr);
+                    }
+                }
+            }
+        } catch (...) {
+            delete building; // NOLINT(cppcoreguidelines-owning-memory)
+            throw;
+        }
+
+        if (building != nullptr)
+            all[count++] = building;
+    }
+
+    /**
+     * @brief Merge two subtrees, which are placed side by side.
+     *
+     * Descends along the right edge of @p left and the left edge of @p right
+     * until both have the same height, and on the way back up puts the children
+     * next to the seam under new nodes. At the bottom the leaves are repacked, so
+     * the seam does not leave a trail of half-empty leaves.
+     *
+     * @param left The left subtree.
+     * @param left_shift The height of the left subtree.
+     * @param right The right subtree.
+     * @param right_shift The height of the right subtree.
+     * @return merged_ One or two new nodes, as high as the higher subtree.
+     */
+    static merged_
+    merge_(node_* left, size_type left_shift, node_* right, size_type right_shift)
+    {
+        const inner_* lhs = as_inner_(left);
+        const inner_* rhs = as_inner_(right);
+        const size_type shift = std::max(left_shift, right_shift);
+
+        std::array<node_*, 2 * BRANCHES> all{};
+        size_type count = 0;
+        try {
+            if (shift == BITS) {
+                repack_leaves_(lhs, rhs, all.data(), count);
+            } else {
+                const bool left_high = left_shift == shift;
+                const bool right_high = right_shift == shift;
+
+                if (left_high) {
+                    for (size_type i = 0; i + 1 < lhs->count; i++)
+                        all[count++] = retain_(lhs->children[i]);
+                }
+
+                const merged_ mid = merge_(
+                    left_high ? lhs->children[lhs->count - 1] : left,
+                    left_high ? shift - BITS : left_shift,
+                    right_high ? rhs->children[0] : right,
+                    right_high ? shift - BITS : right_shift
+                );
+                for (size_type i = 0; i < mid.count; i++)
+                    all[count++] = mid.nodes[i];
+
+                if (right_high) {
+                    for (size_type i = 1; i < rhs->count; i++)
+                        all[count++] = retain_(rhs->children[i]);
+                }
+            }
+
+            return group_(all.data(), count, shift);
+        } catch (...) {
+            for (size_type i = 0; i < count; i++)
+                release_(all[i], shift - BITS);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Call @p fn with the elements of every leaf under a node.
+     */
+    template <class Fn>
+    static void
+    for_each_leaf_(const node_* node, size_type shift, Fn& fn)
+    {
+        if (shift == 0) {
+            fn(span<const T>(as_leaf_(node)->elems(), node->count));
+            return;
+        }
+
+        const inner_* inner = as_inner_(node);
+        for (size_type i = 0; i < inner->count; i++)
+            for_each_leaf_(inner->children[i], shift - BITS, fn);
+    }
+
+    /**
+     * @brief Throw if @p pos is not the position of an element.
+     */
+    inline void
+    check_index_(size_type pos) const
+    {
+        if (pos >= size_)
+            throw std::out_of_range("persistent_vec: index out of range!");
+    }
+
+#pragma endregion
+
+ public:
+#pragma region "Constructors/Destructors and assignment operators"
+
+    /**
+     * @brief Construct a new empty persistent_vec object. Does not allocate.
+     */
+    persistent_vec() noexcept :
+        root_(nullptr), tail_(nullptr), size_(0), shift_(BITS)
+    {}
+
+    /**
+     * @brief Construct a new persistent_vec object with specified size, filled
+     * with elements.
+     *
+     * @param size The size of the persistent_vec.
+     * @param elem The element to fill the vector with
+     */
+    explicit persistent_vec(size_type size, const T& elem) : persistent_vec()
+    {
+        for (size_type i = 0; i < size; i++)
+            emplace_back_(elem);
+    }
+
+    /**
+     * @brief Construct a new persistent_vec object from an initializer list
+     *
+     * @param init The initializer list with vector elements.
+     */
+    persistent_vec(std::initializer_list<T> init) : persistent_vec()
+    {
+        for (const T& elem : init)
+            emplace_back_(elem);
+    }
+
+    /**
+     * @brief Construct a new persistent_vec object from the elements of a vec.
+     *
+     * @param other The vector to copy the elements from.
+     */
+    explicit persistent_vec(const vec<T>& other) : persistent_vec()
+    {
+        for (const T& elem : other)
+            emplace_back_(elem);
+    }
+
+    /**
+     * @brief Copy constructor. Shares all nodes of @p other, in O(1).
+     *
+     * @param other The vector to copy to this one.
+     */
+    persistent_vec(const persistent_vec& other) noexcept :
+        root_(retain_(other.root_)),
+        tail_(retain_(other.tail_)),
+        size_(other.size_),
+        shift_(other.shift_)
+    {}
+
+    /**
+     * @brief Move constructor.
+     *
+     * @param other The vector to move to this one.
+     */
+    persistent_vec(persistent_vec&& other) noexcept :
+        root_(std::exchange(other.root_, nullptr)),
+        tail_(std::exchange(other.tail_, nullptr)),
+        size_(std::exchange(other.size_, 0U)),
+        shift_(std::exchange(other.shift_, BITS))
+    {}
+
+    /**
+     * @brief Copy assignment operator. Shares all nodes of @p other, in O(1).
+     *
+     * @param other The assigned object.
+     * @return The new object.
+     */
+    persistent_vec&
+    operator=(const persistent_vec& other) noexcept
+    {
+        // Guard self assignment
+        if (this == &other)
+            return *this;
+
+        retain_(other.root_);
+        retain_(other.tail_);
+        release_(root_, shift_);
+        release_(tail_, 0);
+
+        root_ = other.root_;
+        tail_ = other.tail_;
+        size_ = other.size_;
+        shift_ = other.shift_;
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * @param other The assigned object.
+     * @return The new object.
+     */
+    persistent_vec&
+    operator=(persistent_vec&& other) noexcept
+    {
+        // Guard self-assignment
+        if (this == &other)
+            return *this;
+
+        // Free our resources
+        release_(root_, shift_);
+        release_(tail_, 0);
+
+        // Leave the other in a valid state
+        root_ = std::exchange(other.root_, nullptr);
+        tail_ = std::exchange(other.tail_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        shift_ = std::exchange(other.shift_, BITS);
+
+        return *this;
+    }
+
+    /**
+     * @brief Destroy the persistent_vec object. Frees the nodes no other version
+     * refers to.
+     */
+    ~persistent_vec() noexcept
+    {
+        release_(root_, shift_);
+        release_(tail_, 0);
+    }
+
+#pragma endregion
+
+#pragma region "Accessors"
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * No bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @return const T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    operator[](size_type pos) const noexcept
+    {
+        const leaf_* leaf = leaf_for_(pos);
+        return leaf->elems()[pos];
+    }
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * Bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @exception std::out_of_range Index out of range of vector.
+     * @return const T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    at(size_type pos) const
+    {
+        check_index_(pos);
+        return (*this)[pos];
+    }
+
+    /**
+     * @brief Get the first element.
+     *
+     * @return const T& A reference to the first element.
+     */
+    [[nodiscard]] inline const T&
+    front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    /**
+     * @brief Get the last element.
+     *
+     * @return const T& A reference to the last element.
+     */
+    [[nodiscard]] inline const T&
+    back() const noexcept
+    {
+        return as_leaf_(tail_)->elems()[tail_->count - 1];
+    }
+
+#pragma endregion
+
+#pragma region "Capacity"
+
+    /**
+     * @brief Check if the vector is empty.
+     *
+     * @return bool Whether or not the vector is empty.
+     */
+    [[nodiscard]] inline bool
+    empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    /**
+     * @brief Get the size of the vector.
+     *
+     * @return size_type The vector size.
+     */
+    [[nodiscard]] inline size_type
+    size() const noexcept
+    {
+        return size_;
+    }
+
+#pragma endregion
+
+#pragma region "Iterators"
+
+    /**
+     * @brief Get an iterator pointing to the beginning of this vector.
+     *
+     * @return const_iterator The iterator.
+     */
+    [[nodiscard]] inline const_iterator
+    begin() const noexcept
+    {
+        return const_iterator(this, 0);
+    }
+
+    /**
+     * @brief Get an iterator pointing to the end of this vector.
+     *
+     * @return const_iterator The iterator.
+     */
+    [[nodiscard]] inline const_iterator
+    end() const noexcept
+    {
+        return const_iterator(this, size_);
+    }
+
+    /**
+     * @brief Call @p fn with every leaf's elements, in order.
+     *
+     * Visits one span per leaf, so it is the fastest way to scan the vector.
+     *
+     * @tparam Fn Callable as `fn(span<const T>)`.
+     * @param fn The function to call.
+     */
+    template <class Fn>
+    inline void
+    for_each_segment(Fn fn) const
+    {
+        if (root_ != nullptr)
+            for_each_leaf_(root_, shift_, fn);
+        if (tail_ != nullptr)
+            fn(span<const T>(as_leaf_(tail_)->elems(), tail_->count));
+    }
+
+#pragma endregion
+
+#pragma region "Versions"
+
+    /* Everything here leaves this vector alone, and returns a new version */
+
+    /**
+     * @brief Replace the element at @p pos.
+     *
+     * @param pos The position of the element.
+     * @param elem The new element.
+     * @exception std::out_of_range Index out of range of vector.
+     * @return persistent_vec The new version.
+     */
+    [[nodiscard]] inline persistent_vec
+    set(size_type pos, T elem) const
+    {
+        check_index_(pos);
+
+        persistent_vec result(*this);
+        result.set_(pos, std::move(elem));
+        return result;
+    }
+
+    /**
+     * @brief Append a copy of @p elem.
+     *
+     * @param elem The element to append.
+     * @return persistent_vec The new version.
+     */
+    [[nodiscard]] inline persistent_vec
+    push_back(const T& elem) const
+    {
+        persistent_vec result(*this);
+        result.emplace_back_(elem);
+        return result;
+    }
+
+    /**
+     * @brief Append @p elem, moving it in.
+     *
+     * @param elem The element to append.
+     * @return persistent_vec The new version.
+     */
+    [[nodiscard]] inline persistent_vec
+    push_back(T&& elem) const
+    {
+        persistent_vec result(*this);
+        result.emplace_back_(std::move(elem));
+        return result;
+    }
+
+    /**
+     * @brief Remove the last element. The vector must not be empty.
+     *
+     * @return persistent_vec The new version.
+     */
+    [[nodiscard]] inline persistent_vec
+    pop_back() const
+    {
+        persistent_vec result(*this);
+        result.take_(size_ - 1);
+        return result;
+    }
+
+    /**
+     * @brief Append the elements of @p other.
+     *
+     * O(log n): both trees are shared, except along the seam.
+     *
+     * @param other The vector to append.
+     * @return persistent_vec The new version.
+     */
+    [[nodiscard]] persistent_vec
+    concat(const persistent_vec& other) const
+    {
+        if (other.empty())
+            return *this;
+        if (empty())
+            return other;
+
+        persistent_vec result(*this);
+        if (other.root_ == nullptr) {
+            const leaf_* tail = as_leaf_(other.tail_);
+            for (size_type i = 0; i < tail->count; i++)
+                result.emplace_back_(tail->elems()[i]);
+            return result;
+        }
+
+        result.push_tail_leaf_(std::exchange(result.tail_, nullptr));
+
+        const merged_ top =
+            merge_(result.root_, result.shift_, other.root_, other.shift_);
+        size_type shift = std::max(result.shift_, other.shift_);
+        result.drop_tree_();
+
+        if (top.count == 1) {
+            result.root_ = top.nodes[0];
+        } else {
+            auto* root = new inner_; // NOLINT(cppcoreguidelines-owning-memory)
+            append_child_(root, top.nodes[0], shift);
+            append_child_(root, top.nodes[1], shift);
+            result.root_ = root;
+            shift += BITS;
+        }
+
+        result.shift_ = shift;
+        result.tail_ = retain_(other.tail_);
+        result.size_ = size_ + other.size_;
+        result.collapse_();
+        return result;
+    }
+
+    /**
+     * @brief Keep only @p count elements starting at @p first.
+     *
+     * O(log n): the tree is shared, except along the two cuts.
+     *
+     * @param first The position of the first kept element.
+     * @param count How many elements to keep.
+     * @exception std::out_of_range The slice does not fit in this vector.
+     * @return persistent_vec The new version.
+     */
+    [[nodiscard]] persistent_vec
+    slice(size_type first, size_type count) const
+    {
+        if (first > size_ || count > size_ - first)
+            throw std::out_of_range("persistent_vec: slice out of range!");
+        if (count == 0)
+            return persistent_vec();
+
+        persistent_vec result(*this);
+        if (first + count < size_)
+            result.take_(first + count);
+        if (first > 0)
+            result.drop_(first);
+        return result;
+    }
+
+    /**
+     * @brief Get a mutable copy of this vector, for batches of edits.
+     *
+     * O(1): the copy shares all nodes, and copies them as it changes them.
+     *
+     * @return transient_vec<T> The mutable copy.
+     */
+    [[nodiscard]] inline transient_vec<T>
+    transient() const noexcept
+    {
+        return transient_vec<T>(*this);
+    }
+
+#pragma endregion
+
+#pragma region "Equality operators"
+
+    inline friend bool
+    operator==(const ds::persistent_vec<T>& lhs, const ds::persistent_vec<T>& rhs)
+    {
+        // Check if they are the same version
+        if (lhs.root_ == rhs.root_ && lhs.tail_ == rhs.tail_ && lhs.size_ == rhs.size_)
+            return true;
+
+        // Check if the vectors have different sizes
+        if (lhs.size_ != rhs.size_)
+            return false;
+
+        // Finally, check each element
+        size_type i = 0;
+        bool equal = true;
+        lhs.for_each_segment([&](span<const T> segment) {
+            for (const T& elem : segment)
+                equal = equal && elem == rhs[i++];
+        });
+        return equal;
+    }
+
+    inline friend bool
+    operator!=(const ds::persistent_vec<T>& lhs, const ds::persistent_vec<T>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+#pragma endregion
+};
+
+/**
+ * @brief The mutable counterpart of ds::persistent_vec, for batches of edits.
+ *
+ * Changes the nodes that no version refers to in place, and copies the others
+ * once: after the first edit in a leaf, later edits there cost no allocations,
+ * and push_back() is amortized O(1). persistent() returns a version in O(1),
+ * after which this vector can still be changed without affecting that version.
+ *
+ * @tparam T The type of data this vector will hold.
+ */
+template <class T>
+class transient_vec {
+    persistent_vec<T> vec_;
+
+ public:
+    /**
+     * @brief The type of the stored elements.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Unsigned integer type used for indicies.
+     */
+    using size_type = std::size_t;
+
+#pragma region "Constructors/Destructors and assignment operators"
+
+    /**
+     * @brief Construct a new empty transient_vec object. Does not allocate.
+     */
+    transient_vec() noexcept = default;
+
+    /**
+     * @brief Construct a new transient_vec object from a version, in O(1).
+     *
+     * @param vec The version to start from.
+     */
+    explicit transient_vec(persistent_vec<T> vec) noexcept : vec_(std::move(vec)) {}
+
+#pragma endregion
+
+#pragma region "Accessors"
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * No bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @return const T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    operator[](size_type pos) const noexcept
+    {
+        return vec_[pos];
+    }
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * Bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @exception std::out_of_range Index out of range of vector.
+     * @return const T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    at(size_type pos) const
+    {
+        return vec_.at(pos);
+    }
+
+#pragma endregion
+
+#pragma region "Capacity"
+
+    /**
+     * @brief Check if the vector is empty.
+     *
+     * @return bool Whether or not the vector is empty.
+     */
+    [[nodiscard]] inline bool
+    empty() const noexcept
+    {
+        return vec_.empty();
+    }
+
+    /**
+     * @brief Get the size of the vector.
+     *
+     * @return size_type The vector size.
+     */
+    [[nodiscard]] inline size_type
+    size() const noexcept
+    {
+        return vec_.size();
+    }
+
+#pragma endregion
+
+#pragma region "Versions"
+
+    /**
+     * @brief Get the current contents as a version, in O(1).
+     *
+     * @return persistent_vec<T> The version.
+     */
+    [[nodiscard]] inline persistent_vec<T>
+    persistent() const noexcept
+    {
+        return vec_;
+    }
+
+#pragma endregion
+
+#pragma region "Modifiers"
+
+    /* Everthing here changes vector size */
+
+    /**
+     * @brief Replace the element at @p pos.
+     *
+     * @param pos The position of the element.
+     * @param elem The new element.
+     * @exception std::out_of_range Index out of range of vector.
+     */
+    inline void
+    set(size_type pos, T elem)
+    {
+        vec_.check_index_(pos);
+        vec_.set_(pos, std::move(elem));
+    }
+
+    /**
+     * @brief Construct an element in place at the end of the vector.
+     *
+     * @tparam Args The types of the constructor arguments.
+     * @param args The arguments to construct the element from.
+     */
+    template <class... Args>
+    inline void
+    emplace_back(Args&&... args)
+    {
+        vec_.emplace_back_(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Append a copy of @p elem.
+     *
+     * @param elem The element to append.
+     */
+    inline void
+    push_back(const T& elem)
+    {
+        vec_.emplace_back_(elem);
+    }
+
+    /**
+     * @brief Append @p elem, moving it in.
+     *
+     * @param elem The element to append.
+     */
+    inline void
+    push_back(T&& elem)
+    {
+        vec_.emplace_back_(std::move(elem));
+    }
+
+    /**
+     * @brief Remove the last element. The vector must not be empty.
+     */
+    inline void
+    pop_back()
+    {
+        vec_.take_(vec_.size() - 1);
+    }
+
+#pragma endregion
+};
+
+} // namespace ds
+
+#endif // LIBDS_PERSISTENT_VEC_HPP
@@ -0,0 +1,80 @@
+/**
+ * @file probes.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Static (USDT) tracepoints for the growth paths of libds containers.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_PROBES_HPP
+#define LIBDS_PROBES_HPP
+
+#if !defined(LIBDS_NO_PROBES) && defined(__has_include)
+#  if __has_include(<sys/sdt.h>)
+#    include <sys/sdt.h>
+#    define LIBDS_HAS_PROBES 1
+#  endif
+#endif
+
+/**
+ * @brief Fire the `libds:name` probe with the standard four arguments.
+ *
+ * Every probe lives in the `libds` provider and carries the same four
+ * arguments, so one bpftrace script can handle all of them:
+ *
+ *   - `arg0`: the capacity before the event, in elements.
+ *   - `arg1`: the capacity after the event, in elements.
+ *   - `arg2`: the element size, in bytes.
+ *   - `arg3`: how many bytes the event moves (or may move, for reallocations).
+ *
+ * The probes are:
+ *
+ *   - `vec_alloc`: a fresh buffer was allocated.
+ *   - `vec_resize`: the buffer was reallocated.
+ *   - `vec_free`: the buffer was freed.
+ *   - `vec_shift`: elements were shifted to open a gap for an insertion.
+ *
+ * For example, to see which reallocations move the most data:
+ *
+ *   bpftrace -e 'usdt:./app:libds:vec_resize { @moved = hist(arg3); }'
+ *
+ * The probes are compiled in whenever `<sys/sdt.h>` (from systemtap) is
+ * available. Each one is a single `nop` plus an ELF note, so they cost nothing
+ * until a tracer attaches. Define `LIBDS_NO_PROBES` to leave them out entirely;
+ * the macro then expands to nothing and its arguments are not evaluated.
+ */
+#ifdef LIBDS_HAS_PROBES
+#  define LIBDS_PROBE(name, old_cap, new_cap, elem_size, bytes)                  \
+      DTRACE_PROBE4(                                                             \
+          libds, name, static_cast<unsigned long long>(old_cap),                 \
+          static_cast<unsigned long long>(new_cap),                              \
+          static_cast<unsigned long long>(elem_size),                            \
+          static_cast<unsigned long long>(bytes)                                 \
+      )
+#else
+#  define LIBDS_PROBE(name, old_cap, new_cap, elem_size, bytes) static_cast<void>(0)
+#endif
+
+#endif // LIBDS_PROBES_HPP
@@ -0,0 +1,511 @@
+/**
+ * @file ragged_vec.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief A vector of variable-length rows, stored in two flat arrays (CSR).
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_RAGGED_VEC_HPP
+#define LIBDS_RAGGED_VEC_HPP
+
+#include "libds/span.hpp"
+#include "libds/vec.hpp"
+
+#include <cstddef>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace ds {
+
+/**
+ * @brief A vector of rows of different lengths, in compressed sparse row (CSR)
+ * layout.
+ *
+ * All rows are stored back to back in one ds::vec of values, and a second
+ * ds::vec holds where each row ends. Unlike `vec<vec<T>>`, which costs an
+ * allocation, a header and a pointer chase per row, this takes two allocations
+ * for any number of rows, and row(i) is two loads. Rows can only be added at
+ * the end, as a whole.
+ *
+ * Large instances can be built in parallel: let each thread fill its own
+ * ragged_vec, and join() the parts.
+ *
+ * @tparam T The type of data this vector will hold.
+ */
+template <class T>
+class ragged_vec {
+ public:
+    /**
+     * @brief The type of the stored elements.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Unsigned integer type used for indicies.
+     */
+    using size_type = std::size_t;
+
+ private:
+    vec<T> values_;
+    vec<size_type> ends_;
+
+#pragma region "Helpers"
+
+    /**
+     * @brief Get the position of the first value of a row.
+     *
+     * @param row The row.
+     * @return size_type The position in values().
+     */
+    [[nodiscard]] inline size_type
+    begin_of_(size_type row) const noexcept
+    {
+        return row == 0 ? 0 : ends_[row - 1];
+    }
+
+    /**
+     * @brief Throw if @p row is not a row of this vector.
+     */
+    inline void
+    check_row_(size_type row) const
+    {
+        if (row >= ends_.size())
+            throw std::out_of_range("ragged_vec: row out of range!");
+    }
+
+    /**
+     * @brief Copy the values and row ends of a part into place.
+     *
+     * @param part The part.
+     * @param first_value Where the values of the part start.
+     * @param first_row Where the rows of the part start.
+     */
+    inline void
+    place_(const ragged_vec& part, size_type first_value, size_type first_row)
+    {
+        for (size_type i = 0; i < part.values_.size(); i++)
+            values_[first_value + i] = part.values_[i];
+        for (size_type i = 0; i < part.ends_.size(); i++)
+            ends_[first_row + i] = first_value + part.ends_[i];
+    }
+
+    /**
+     * @brief Whether @p elem is one of our own values.
+     */
+    template <class U>
+    [[nodiscard]] inline bool
+    owns_(const U& elem) const noexcept
+    {
+        if constexpr (std::is_same_v<U, T>) {
+            const std::less<const T*> less;
+            const T* ptr = std::addressof(elem);
+            return !less(ptr, values_.data())
+                && less(ptr, values_.data() + values_.size());
+        } else {
+            return false;
+        }
+    }
+
+#pragma endregion
+
+ public:
+#pragma region "Constructors/Destructors and assignment operators"
+
+    /**
+     * @brief Construct a new empty ragged_vec object.
+     */
+    ragged_vec() = default;
+
+    /**
+     * @brief Construct a new empty ragged_vec object, with a given capacity.
+     *
+     * @param rows How many rows this vector should be able to hold initially.
+     * @param values How many values, over all rows, this vector should be able to
+     * hold initially.
+     */
+    ragged_vec(size_type rows, size_type values) : values_(values), ends_(rows) {}
+
+    /**
+     * @brief Construct a new ragged_vec object from a list of rows.
+     *
+     * @param init The rows.
+     */
+    ragged_vec(std::initializer_list<std::initializer_list<T>> init) :
+        values_(0), ends_(init.size())
+    {
+        size_type values = 0;
+        for (const auto& row : init)
+            values += row.size();
+        values_.reserve(values);
+
+        for (const auto& row : init)
+            push_row(row);
+    }
+
+#pragma endregion
+
+#pragma region "Accessors"
+
+    /**
+     * @brief Get the nth row.
+     *
+     * No bounds checking is performed.
+     *
+     * @param row The position of the desired row.
+     * @return span<T> A view of the row.
+     */
+    [[nodiscard]] inline span<T>
+    operator[](size_type row) noexcept
+    {
+        const size_type first = begin_of_(row);
+        return span<T>(values_.data() + first, ends_[row] - first);
+    }
+
+    /**
+     * @brief Get the nth row.
+     *
+     * No bounds checking is performed.
+     *
+     * @param row The position of the desired row.
+     * @return span<const T> A view of the row.
+     */
+    [[nodiscard]] inline span<const T>
+    operator[](size_type row) const noexcept
+    {
+        const size_type first = begin_of_(row);
+        return span<const T>(values_.data() + first, ends_[row] - first);
+    }
+
+    /**
+     * @brief Get the nth row.
+     *
+     * Bounds checking is performed.
+     *
+     * @param row The position of the desired row.
+     * @exception std::out_of_range Row out of range of vector.
+     * @return span<T> A view of the row.
+     */
+    [[nodiscard]] inline span<T>
+    row(size_type row)
+    {
+        check_row_(row);
+        return (*this)[row];
+    }
+
+    /**
+     * @brief Get the nth row.
+     *
+     * Bounds checking is performed.
+     *
+     * @param row The position of the desired row.
+     * @exception std::out_of_range Row out of range of vector.
+     * @return span<const T> A view of the row.
+     */
+    [[nodiscard]] inline span<const T>
+    row(size_type row) const
+    {
+        check_row_(row);
+        return (*this)[row];
+    }
+
+    /**
+     * @brief Get the length of the nth row.
+     *
+     * No bounds checking is performed.
+     *
+     * @param row The position of the desired row.
+     * @return size_type The number of values in the row.
+     */
+    [[nodiscard]] inline size_type
+    row_size(size_type row) const noexcept
+    {
+        return ends_[row] - begin_of_(row);
+    }
+
+    /**
+     * @brief View the values of all rows, back to back.
+     *
+     * @return span<T> The values.
+     */
+    [[nodiscard]] inline span<T>
+    values() noexcept
+    {
+        return span<T>(values_);
+    }
+
+    /**
+     * @brief View the values of all rows, back to back.
+     *
+     * @return span<const T> The values.
+     */
+    [[nodiscard]] inline span<const T>
+    values() const noexcept
+    {
+        return span<const T>(values_);
+    }
+
+    /**
+     * @brief View where each row ends in values().
+     *
+     * Row `i` is `values()[ends()[i - 1]]` up to `values()[ends()[i]]`, and row
+     * 0 starts at 0.
+     *
+     * @return span<const size_type> The row ends.
+     */
+    [[nodiscard]] inline span<const size_type>
+    ends() const noexcept
+    {
+        return span<const size_type>(ends_);
+    }
+
+#pragma endregion
+
+#pragma region "Capacity"
+
+    /**
+     * @brief Check if the vector has no rows.
+     *
+     * @return bool Whether or not the vector is empty.
+     */
+    [[nodiscard]] inline bool
+    empty() const noexcept
+    {
+        return ends_.empty();
+    }
+
+    /**
+     * @brief Get the number of rows.
+     *
+     * @return size_type The number of rows.
+     */
+    [[nodiscard]] inline size_type
+    size() const noexcept
+    {
+        return ends_.size();
+    }
+
+    /**
+     * @brief Get the number of values, over all rows.
+     *
+     * @return size_type The number of values.
+     */
+    [[nodiscard]] inline size_type
+    value_count() const noexcept
+    {
+        return values_.size();
+    }
+
+    /**
+     * @brief Make room for at least @p rows rows and @p values values.
+     *
+     * @param rows The desired row capacity.
+     * @param values The desired value capacity, over all rows.
+     */
+    inline void
+    reserve(size_type rows, size_type values)
+    {
+        ends_.reserve(rows);
+        values_.reserve(values);
+    }
+
+    /**
+     * @brief Remove any unused space from this vector.
+     */
+    inline void
+    shrink_to_fit()
+    {
+        ends_.shrink_to_fit();
+        values_.shrink_to_fit();
+    }
+
+#pragma endregion
+
+#pragma region "Modifiers"
+
+    /* Everthing here changes vector size */
+
+    /**
+     * @brief Remove all rows.
+     *
+     * Does not change the capacity.
+     */
+    inline void
+    clear() noexcept
+    {
+        values_.clear();
+        ends_.clear();
+    }
+
+    /**
+     * @brief Append a row with the elements of @p range.
+     *
+     * @tparam Range A range of elements convertible to @p T; ranges with forward
+     * iterators are appended with at most one reallocation.
+     * @param range The elements of the new row.
+     * @return span<T> A view of the new row.
+     */
+    template <class Range>
+    inline span<T>
+    push_row(const Range& range)
+    {
+        using std::begin;
+        using std::end;
+
+        const size_type first = values_.size();
+        auto it = begin(range);
+        auto last = end(range);
+
+        using category = typename std::iterator_traits<decltype(it)>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+            const auto count = static_cast<size_type>(std::distance(it, last));
+            if (count > 0 && owns_(*it)) {
+                // One of our own rows, which growing values_ would free: copy it out
+                vec<T> copy(count);
+                for (; it != last; ++it)
+                    copy.emplace(copy.size(), *it);
+                return push_row(copy);
+            }
+
+            if (first + count > values_.capacity())
+                values_.reserve(std::max(first + count, values_.capacity() * 3 / 2));
+        }
+
+        try {
+            for (; it != last; ++it)
+                values_.emplace(values_.size(), *it);
+            ends_.emplace(ends_.size(), values_.size());
+        } catch (...) {
+            while (values_.size() > first)
+                values_.pop_back();
+            throw;
+        }
+
+        return (*this)[ends_.size() - 1];
+    }
+
+    /**
+     * @brief Append a row with the elements of @p elems.
+     *
+     * @param elems The elements of the new row.
+     * @return span<T> A view of the new row.
+     */
+    inline span<T>
+    push_row(std::initializer_list<T> elems)
+    {
+        return push_row<std::initializer_list<T>>(elems);
+    }
+
+    /**
+     * @brief Build one vector out of parts that were filled separately, e.g. by
+     * different threads.
+     *
+     * The rows of @p parts[0] come first, then those of @p parts[1], and so on.
+     * Copying the parts into place is split over @p threads threads if elements
+     * can be copied without throwing. Uses `std::thread`, so link with
+     * `Threads::Threads` when passing more than one thread.
+     *
+     * @param parts The parts.
+     * @param threads How many threads to copy with.
+     * @return ragged_vec The joined vector.
+     */
+    [[nodiscard]] static ragged_vec
+    join(span<const ragged_vec> parts, size_type threads = 1)
+    {
+        vec<size_type> first_values(parts.size() + 1);
+        vec<size_type> first_rows(parts.size() + 1);
+        first_values.emplace(0, 0U);
+        first_rows.emplace(0, 0U);
+        for (const ragged_vec& part : parts) {
+            first_values.emplace(
+                first_values.size(), first_values.back() + part.value_count()
+            );
+            first_rows.emplace(first_rows.size(), first_rows.back() + part.size());
+        }
+
+        ragged_vec result;
+        result.values_ = vec<T>(first_values.back(), T());
+        result.ends_ = vec<size_type>(first_rows.back(), 0);
+
+        auto place = [&](size_type worker, size_type workers) {
+            for (size_type i = worker; i < parts.size(); i += workers)
+                result.place_(parts[i], first_values[i], first_rows[i]);
+        };
+
+        const bool parallel =
+            threads > 1 && parts.size() > 1 && std::is_nothrow_copy_assignable_v<T>;
+        if (!parallel) {
+            place(0, 1);
+            return result;
+        }
+
+        threads = std::min(threads, parts.size());
+        vec<std::thread> workers(threads - 1);
+        try {
+            for (size_type i = 1; i < threads; i++)
+                workers.emplace(workers.size(), place, i, threads);
+        } catch (...) {
+            for (std::thread& worker : workers)
+                worker.join();
+            throw;
+        }
+
+        place(0, threads);
+        for (std::thread& worker : workers)
+            worker.join();
+
+        return result;
+    }
+
+#pragma endregion
+
+#pragma region "Equality operators"
+
+    inline friend bool
+    operator==(const ds::ragged_vec<T>& lhs, const ds::ragged_vec<T>& rhs)
+    {
+        return lhs.ends_ == rhs.ends_ && lhs.values_ == rhs.values_;
+    }
+
+    inline friend bool
+    operator!=(const ds::ragged_vec<T>& lhs, const ds::ragged_vec<T>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+#pragma endregion
+};
+
+} // namespace ds
+
+#endif // LIBDS_RAGGED_VEC_HPP
@@ -0,0 +1,557 @@
+/**
+ * @file select.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Selecting the smallest or largest elements of a vector.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_SELECT_HPP
+#define LIBDS_SELECT_HPP
+
+#include "libds/detail/parallel.hpp"
+#include "libds/detail/simd.hpp"
+#include "libds/vec.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ds {
+
+namespace detail {
+
+/**
+ * @brief Ranges at most this long are finished with `std::nth_element`.
+ */
+inline constexpr std::size_t SELECT_CUTOFF = 512;
+
+/**
+ * @brief How many elements to sample for each pivot.
+ */
+inline constexpr std::size_t SELECT_SAMPLE = 255;
+
+/**
+ * @brief How many sample ranks past the target to take the pivot from, about
+ * the square root of the sample size.
+ */
+inline constexpr std::size_t SELECT_MARGIN = 16;
+
+/**
+ * @brief How many elements one block of block_partition() classifies at once.
+ */
+inline constexpr std::size_t PARTITION_BLOCK = 64;
+
+/**
+ * @brief The largest k for which top_k() and partial_sort() keep a bounded heap
+ * instead of selecting in a copy.
+ */
+inline constexpr std::size_t SELECT_HEAP_MAX = 4096;
+
+/**
+ * @brief The fewest elements per thread worth selecting in parallel.
+ */
+inline constexpr std::size_t PARALLEL_SELECT_MIN = std::size_t{1} << 16;
+
+/**
+ * @brief Whether @p Compare is `std::greater` on @p T.
+ */
+template <class Compare, class T>
+inline constexpr bool IS_GREATER =
+    std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<T>>;
+
+/**
+ * @brief Whether the bounded heap can screen elements of @p T ordered by
+ * @p Compare with SIMD comparisons.
+ */
+template <class T, class Compare>
+inline constexpr bool IS_SIMD_SELECT =
+    std::is_arithmetic_v<T> && (sizeof(T) == 4 || sizeof(T) == 8)
+    && (IS_GREATER<Compare, T> || std::is_same_v<Compare, std::less<>>
+        || std::is_same_v<Compare, std::less<T>>);
+
+/**
+ * @brief Whether to keep a bounded heap to select @p k of @p n elements.
+ */
+inline bool
+use_select_heap(std::size_t k, std::size_t n) noexcept
+{
+    return k <= SELECT_HEAP_MAX && k * 16 <= n;
+}
+
+/**
+ * @brief Partition `[first, last)` around @p pivot: everything before the
+ * returned position is not after @p pivot, everything from it on is not before
+ * it.
+ *
+ * Works inwards from both ends a block at a time: first the positions of the
+ * misplaced elements of a block are collected without branching on the data,
+ * then misplaced pairs are swapped. So unlike a plain Hoare partition, no
+ * branch depends on how an element compares with the pivot. Elements equal to
+ * the pivot are swapped too, which keeps ranges of equal elements balanced.
+ */
+template <class T, class Compare>
+inline T*
+block_partition(T* first, T* last, const T& pivot, Compare& cmp)
+{
+    unsigned char left[PARTITION_BLOCK];
+    unsigned char right[PARTITION_BLOCK];
+    std::size_t num_left = 0;
+    std::size_t num_right = 0;
+    std::size_t start_left = 0;
+    std::size_t start_right = 0;
+
+    // Everything before first, and from last on, is in place
+    while (static_cast<std::size_t>(last - first) >= 2 * PARTITION_BLOCK) {
+        if (num_left == 0) {
+            start_left = 0;
+            for (std::size_t i = 0; i < PARTITION_BLOCK; i++) {
+                left[num_left] = static_cast<unsigned char>(i);
+                num_left += static_cast<std::size_t>(!cmp(first[i], pivot));
+            }
+        }
+        if (num_right == 0) {
+            start_right = 0;
+            for (std::size_t i = 0; i < PARTITION_BLOCK; i++) {
+                right[num_right] = static_cast<unsigned char>(i);
+                num_right += static_cast<std::size_t>(!cmp(pivot, *(last - 1 - i)));
+            }
+        }
+
+        const std::size_t swaps = std::min(num_left, num_right);
+        for (std::size_t i = 0; i < swaps; i++) {
+            using std::swap;
+            swap(first[left[start_left + i]], *(last - 1 - right[start_right + i]));
+        }
+        num_left -= swaps;
+        num_right -= swaps;
+        start_left += swaps;
+        start_right += swaps;
+        if (num_left == 0)
+            first += PARTITION_BLOCK;
+        if (num_right == 0)
+            last -= PARTITION_BLOCK;
+    }
+
+    // Partly classified blocks are simply classified again
+    for (;;) {
+        while (first < last && cmp(*first, pivot))
+            first++;
+        while (first < last && cmp(pivot, *(last - 1)))
+            last--;
+        if (last - first <= 1)
+            return first;
+        using std::swap;
+        swap(*first, *(last - 1));
+        first++;
+        last--;
+    }
+}
+
+/**
+ * @brief Pick a pivot for moving the element of rank `nth - first` of
+ * `[first, last)` into place.
+ *
+ * Sorts part of an evenly spaced sample and takes the element a little past
+ * the target rank, on the side away from the nearer end, so the part that
+ * still holds the target after partitioning is small (as in Floyd and
+ * Rivest's SELECT).
+ */
+template <class T, class Compare>
+inline T
+select_pivot(const T* first, const T* nth, const T* last, Compare& cmp)
+{
+    const auto n = static_cast<std::size_t>(last - first);
+    const auto rank = static_cast<std::size_t>(nth - first);
+    const std::size_t stride = n / SELECT_SAMPLE;
+
+    vec<T> sample(SELECT_SAMPLE);
+    for (std::size_t i = 0; i < SELECT_SAMPLE; i++)
+        sample.insert(i, first[i * stride + stride / 2]);
+
+    const std::size_t target = rank * SELECT_SAMPLE / n;
+    const std::size_t pick = target < SELECT_SAMPLE / 2
+                               ? std::min(target + SELECT_MARGIN, SELECT_SAMPLE - 1)
+                               : target - std::min(target, SELECT_MARGIN);
+    std::nth_element(sample.begin(), sample.begin() + pick, sample.end(), cmp);
+    return sample[pick];
+}
+
+/**
+ * @brief Move the element of `[first, last)` that belongs at @p nth there, with
+ * nothing after it before it, and nothing before it after it.
+ *
+ * Quickselect with sampled pivots and block_partition(). Falls back to
+ * `std::nth_element` for short ranges, and when partitioning stops making
+ * progress.
+ */
+template <class T, class Compare>
+inline void
+select(T* first, T* nth, T* last, Compare& cmp)
+{
+    std::size_t rounds = 0;
+    while (static_cast<std::size_t>(last - first) > SELECT_CUTOFF && rounds++ < 64) {
+        const T pivot = select_pivot<T>(first, nth, last, cmp);
+        T* mid = block_partition(first, last, pivot, cmp);
+        if (mid == first || mid == last)
+            break;
+        if (nth < mid)
+            last = mid;
+        else
+            first = mid;
+    }
+    std::nth_element(first, nth, last, cmp);
+}
+
+#ifdef LIBDS_HAS_X86_DISPATCH
+/**
+ * @brief Find which of the elements at @p data come before @p bound: are
+ * greater than it if @p Greater, otherwise less.
+ *
+ * @return unsigned One bit per element, for 32 / sizeof(T) elements.
+ */
+template <bool Greater, class T>
+LIBDS_TARGET_AVX2 inline unsigned
+beats_mask_avx2(const T* data, T bound) noexcept
+{
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m256i raw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    if constexpr (std::is_same_v<T, float>) {
+        const __m256 elems = _mm256_castsi256_ps(raw);
+        const __m256 limit = _mm256_set1_ps(bound);
+        const __m256 beats = Greater ? _mm256_cmp_ps(elems, limit, _CMP_GT_OQ)
+                                     : _mm256_cmp_ps(elems, limit, _CMP_LT_OQ);
+        return static_cast<unsigned>(_mm256_movemask_ps(beats));
+    } else if constexpr (std::is_same_v<T, double>) {
+        const __m256d elems = _mm256_castsi256_pd(raw);
+        const __m256d limit = _mm256_set1_pd(bound);
+        const __m256d beats = Greater ? _mm256_cmp_pd(elems, limit, _CMP_GT_OQ)
+                                      : _mm256_cmp_pd(elems, limit, _CMP_LT_OQ);
+        return static_cast<unsigned>(_mm256_movemask_pd(beats));
+    } else if constexpr (sizeof(T) == 4) {
+        // Unsigned numbers compare like signed ones with the top bit flipped
+        const std::int32_t flip = std::is_signed_v<T> ? 0 : INT32_MIN;
+        std::int32_t bits = 0;
+        std::memcpy(&bits, &bound, sizeof(T));
+        const __m256i bias = _mm256_set1_epi32(flip);
+        const __m256i elems = _mm256_xor_si256(raw, bias);
+        const __m256i limit = _mm256_set1_epi32(bits ^ flip);
+        const __m256i beats = Greater ? _mm256_cmpgt_epi32(elems, limit)
+                                      : _mm256_cmpgt_epi32(limit, elems);
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(beats)));
+    } else {
+        const std::int64_t flip = std::is_signed_v<T> ? 0 : INT64_MIN;
+        std::int64_t bits = 0;
+        std::memcpy(&bits, &bound, sizeof(T));
+        const __m256i bias = _mm256_set1_epi64x(flip);
+        const __m256i elems = _mm256_xor_si256(raw, bias);
+        const __m256i limit = _mm256_set1_epi64x(bits ^ flip);
+        const __m256i beats = Greater ? _mm256_cmpgt_epi64(elems, limit)
+                                      : _mm256_cmpgt_epi64(limit, elems);
+        return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(beats)));
+    }
+}
+#endif
+
+/**
+ * @brief A bounded heap of the indices of the best elements seen so far, with
+ * the worst of them on top.
+ */
+template <class T, class Compare>
+struct select_heap {
+    const T* data;
+    std::size_t* heap;
+    std::size_t size;
+    Compare& cmp;
+
+    /**
+     * @brief Whether the element at index @p lhs comes after the one at @p rhs.
+     */
+    [[nodiscard]] bool
+    operator()(std::size_t lhs, std::size_t rhs) const
+    {
+        return cmp(data[lhs], data[rhs]);
+    }
+
+    /**
+     * @brief Put the element at index @p idx in the place of the worst one, if
+     * it comes before it.
+     */
+    void
+    offer(std::size_t idx)
+    {
+        if (!cmp(data[idx], data[heap[0]]))
+            return;
+        std::pop_heap(heap, heap + size, *this);
+        heap[size - 1] = idx;
+        std::push_heap(heap, heap + size, *this);
+    }
+};
+
+/**
+ * @brief Find the indices of the (up to) @p k elements of `[first, last)` of
+ * @p data that come first in @p cmp order, in no particular order.
+ *
+ * Keeps a heap of the best @p k so far with the worst on top, so almost every
+ * later element is rejected by one comparison with the top. For numbers in
+ * `std::less` or `std::greater` order, those comparisons are done a vector at
+ * a time with AVX2 where the CPU has it.
+ *
+ * @param idx Room for @p k indices.
+ * @return std::size_t How many indices were written: @p k, or fewer if the
+ * range is shorter.
+ */
+template <class T, class Compare>
+inline std::size_t
+select_indices(
+    const T* data,
+    std::size_t first,
+    std::size_t last,
+    std::size_t k,
+    Compare& cmp,
+    std::size_t* idx
+)
+{
+    const std::size_t count = std::min(k, last - first);
+    if (count == 0)
+        return 0;
+    for (std::size_t i = 0; i < count; i++)
+        idx[i] = first + i;
+
+    select_heap<T, Compare> heap{data, idx, count, cmp};
+    std::make_heap(idx, idx + count, heap);
+
+    std::size_t i = first + count;
+#ifdef LIBDS_HAS_X86_DISPATCH
+    if constexpr (IS_SIMD_SELECT<T, Compare>) {
+        if (has_avx2()) {
+            constexpr std::size_t LANES = 32 / sizeof(T);
+            constexpr bool GREATER = IS_GREATER<Compare, T>;
+            for (; i + LANES <= last; i += LANES) {
+                unsigned beats = beats_mask_avx2<GREATER>(data + i, data[idx[0]]);
+                for (; beats != 0; beats &= beats - 1)
+                    heap.offer(i + static_cast<std::size_t>(__builtin_ctz(beats)));
+            }
+        }
+    }
+#endif
+
+    for (; i < last; i++)
+        heap.offer(i);
+    return count;
+}
+
+/**
+ * @brief Find the indices of the (up to) @p k elements of the @p n at @p data
+ * that come first in @p cmp order, in no particular order, on @p threads
+ * threads.
+ *
+ * Each thread keeps a bounded heap over one part of the elements; the best
+ * @p k of their results are then selected on the calling thread.
+ *
+ * @param idx Set to the indices found.
+ */
+template <class T, class Compare>
+inline void
+select_indices_parallel(
+    const T* data, std::size_t n, std::size_t k, Compare& cmp, std::size_t threads,
+    vec<std::size_t>& idx
+)
+{
+    idx.clear();
+    if (k == 0)
+        return;
+
+    auto bound = [&](std::size_t part) {
+        return n / threads * part + std::min(part, n % threads);
+    };
+
+    vec<std::size_t> found(threads, 0);
+    idx.resize_for_overwrite(threads * k);
+    parallel_chunks(threads, threads, [&](std::size_t first, std::size_t last) {
+        for (std::size_t part = first; part < last; part++) {
+            found[part] = select_indices(
+                data, bound(part), bound(part + 1), k, cmp, &idx[part * k]
+            );
+        }
+    });
+
+    std::size_t total = 0;
+    for (std::size_t part = 0; part < threads; part++) {
+        std::copy_n(&idx[part * k], found[part], &idx[total]);
+        total += found[part];
+    }
+
+    const std::size_t count = std::min(k, total);
+    const select_heap<T, Compare> by{data, nullptr, 0, cmp};
+    std::nth_element(idx.begin(), idx.begin() + (count - 1), idx.begin() + total, by);
+    idx.erase(count, idx.size() - count);
+}
+
+} // namespace detail
+
+/**
+ * @brief Reorder @p v so that the element at @p nth is the one that would be
+ * there if @p v were sorted, no element before it comes after it, and no
+ * element after it comes before it.
+ *
+ * Quickselect, with pivots taken from a sample just past the target rank so
+ * that few elements are left after the first couple of rounds, and a
+ * partition that does not branch on comparisons.
+ *
+ * @param v The vector.
+ * @param nth The position to fill.
+ * @param cmp The order. Defaults to `std::less<>`.
+ * @throws std::out_of_range If @p nth is not a position in @p v.
+ */
+template <class T, std::size_t A, class Compare = std::less<>>
+inline void
+nth_element(vec<T, A>& v, std::size_t nth, Compare cmp = {})
+{
+    if (nth >= v.size())
+        throw std::out_of_range("nth_element: position out of range!");
+    detail::select(v.begin(), v.begin() + nth, v.end(), cmp);
+}
+
+/**
+ * @brief Sort the first @p k elements of @p v in @p cmp order, leaving the rest
+ * in an unspecified order.
+ *
+ * For small @p k, the elements are screened through a bounded heap of the
+ * indices of the best ones so far, and only the winners are then moved to the
+ * front, so at most 2k elements move. Larger @p k use nth_element() and sort
+ * the front.
+ *
+ * @param v The vector.
+ * @param k How many elements to sort. At most `v.size()` are.
+ * @param cmp The order. Defaults to `std::less<>`.
+ */
+template <class T, std::size_t A, class Compare = std::less<>>
+inline void
+partial_sort(vec<T, A>& v, std::size_t k, Compare cmp = {})
+{
+    const std::size_t n = v.size();
+    k = std::min(k, n);
+    if (k == 0)
+        return;
+    if (!detail::use_select_heap(k, n)) {
+        if (k < n)
+            detail::select(v.begin(), v.begin() + (k - 1), v.end(), cmp);
+        std::sort(v.begin(), v.begin() + k, cmp);
+        return;
+    }
+
+    vec<std::size_t> idx(k, 0);
+    detail::select_indices(v.data(), 0, n, k, cmp, idx.data());
+    std::sort(idx.begin(), idx.end());
+
+    // Swap the winners behind the front with the losers in it
+    std::size_t hole = 0;
+    std::size_t next = 0;
+    for (std::size_t winner : idx) {
+        if (winner < k)
+            continue;
+        while (next < k && idx[next] == hole) {
+            next++;
+            hole++;
+        }
+        using std::swap;
+        swap(v[hole], v[winner]);
+        hole++;
+    }
+    std::sort(v.begin(), v.begin() + k, cmp);
+}
+
+/**
+ * @brief Get the @p k elements of @p v that come first in @p cmp order (by
+ * default, the @p k largest), sorted.
+ *
+ * @p v is only read. For small @p k, every element is screened against the
+ * worst of a bounded heap of the best so far, with AVX2 for numbers in
+ * `std::less` or `std::greater` order; with several threads, each screens one
+ * part of @p v and their results are combined. Larger @p k select in a copy.
+ *
+ * @param v The vector.
+ * @param k How many elements to get. At most `v.size()` are.
+ * @param cmp The order. Defaults to `std::greater<>`.
+ * @param threads How many threads to screen with. Only used for small @p k,
+ * elements that can be copied without throwing, and at most one per
+ * PARALLEL_SELECT_MIN elements. @p cmp must not throw when more than one is
+ * used. Uses `std::thread`, so link with `Threads::Threads` when passing more
+ * than one.
+ * @return vec<T> The elements, best first.
+ */
+template <class T, std::size_t A, class Compare = std::greater<>>
+inline vec<T>
+top_k(const vec<T, A>& v, std::size_t k, Compare cmp = {}, std::size_t threads = 1)
+{
+    const std::size_t n = v.size();
+    k = std::min(k, n);
+    if (k == 0)
+        return vec<T>(0);
+    if (!detail::use_select_heap(k, n)) {
+        vec<T> out(n);
+        out.resize_for_overwrite(n);
+        std::copy(v.begin(), v.end(), out.begin());
+        if (k < n)
+            detail::select(out.begin(), out.begin() + (k - 1), out.end(), cmp);
+        out.erase(k, n - k);
+        std::sort(out.begin(), out.end(), cmp);
+        return out;
+    }
+
+    if constexpr (!std::is_nothrow_copy_assignable_v<T>)
+        threads = 1;
+    threads = std::max<std::size_t>(
+        1, std::min(threads, n / detail::PARALLEL_SELECT_MIN)
+    );
+
+    vec<std::size_t> idx(k, 0);
+    if (threads > 1) {
+        detail::select_indices_parallel(v.data(), n, k, cmp, threads, idx);
+    } else {
+        const std::size_t found =
+            detail::select_indices(v.data(), 0, n, k, cmp, idx.data());
+        idx.erase(found, idx.size() - found);
+    }
+
+    const detail::select_heap<T, Compare> by{v.data(), nullptr, 0, cmp};
+    std::sort(idx.begin(), idx.end(), by);
+    vec<T> out(idx.size());
+    for (std::size_t i : idx)
+        out.insert(out.size(), v[i]);
+    return out;
+}
+
+} // namespace ds
+
+#endif // LIBDS_SELECT_HPP
@@ -0,0 +1,724 @@
+/**
+ * @file set_ops.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Set operations on sorted vectors.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_SET_OPS_HPP
+#define LIBDS_SET_OPS_HPP
+
+#include "libds/detail/simd.hpp"
+#include "libds/detail/type_identity.hpp"
+#include "libds/span.hpp"
+#include "libds/vec.hpp"
+
+#include <cstddef>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace ds {
+
+namespace detail {
+
+/**
+ * @brief How many times longer one input has to be than the other for the
+ * set operations to search for each element of the shorter one instead of
+ * merging.
+ */
+inline constexpr std::size_t GALLOP_RATIO = 32;
+
+/**
+ * @brief How many elements past the end of their output the kernels may write.
+ */
+inline constexpr std::size_t SET_SLACK = 8;
+
+/**
+ * @brief Whether the set operations have a SIMD kernel for @p T ordered by
+ * @p Compare.
+ */
+template <class T, class Compare>
+inline constexpr bool IS_SIMD_SET =
+    std::is_integral_v<T> && sizeof(T) == 4
+    && (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>);
+
+/**
+ * @brief Whether inputs of @p n and @p m elements (both non-zero) are far enough
+ * apart in size to gallop through the longer one.
+ */
+inline bool
+is_skewed(std::size_t n, std::size_t m) noexcept
+{
+    return n < m ? m / GALLOP_RATIO >= n : n / GALLOP_RATIO >= m;
+}
+
+/**
+ * @brief Write @p elem to `out[k]` and advance @p k, if @p keep.
+ *
+ * Trivially copyable elements are always written and @p k is advanced by
+ * @p keep, so there is no branch to mispredict.
+ */
+template <class T>
+inline void
+emit(T* out, std::size_t& k, const T& elem, bool keep)
+{
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        out[k] = elem;
+        k += static_cast<std::size_t>(keep);
+    } else if (keep) {
+        out[k++] = elem;
+    }
+}
+
+/**
+ * @brief Find the first of the @p n elements at @p data, from @p first on, that
+ * is not less than @p key.
+ *
+ * Probes 1, 2, 4, ... elements ahead and then binary searches the last step, so
+ * it costs O(log d) for a result d elements ahead, instead of O(log n).
+ *
+ * @return std::size_t The index found, or @p n.
+ */
+template <class T, class Compare>
+inline std::size_t
+gallop(const T* data, std::size_t first, std::size_t n, const T& key, Compare& cmp)
+{
+    std::size_t lo = first;
+    std::size_t hi = first;
+    std::size_t step = 1;
+    while (hi < n && cmp(data[hi], key)) {
+        lo = hi + 1;
+        hi += step;
+        step *= 2;
+    }
+    return static_cast<std::size_t>(
+        std::lower_bound(data + lo, data + std::min(hi, n), key, cmp) - data
+    );
+}
+
+/**
+ * @brief Intersect the @p n elements at @p a with the @p m elements at @p b by
+ * merging them.
+ *
+ * @tparam Store Whether to write the result to @p out, or only count it.
+ * @return std::size_t How many elements the intersection has.
+ */
+template <bool Store, class T, class Compare>
+inline std::size_t
+intersect_merge(
+    const T* a, std::size_t n, const T* b, std::size_t m, T* out, Compare& cmp
+)
+{
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t k = 0;
+    while (i < n && j < m) {
+        const bool lt = cmp(a[i], b[j]);
+        const bool gt = cmp(b[j], a[i]);
+        if constexpr (Store)
+            emit(out, k, a[i], !lt && !gt);
+        else
+            k += static_cast<std::size_t>(!lt && !gt);
+        i += static_cast<std::size_t>(!gt);
+        j += static_cast<std::size_t>(!lt);
+    }
+    return k;
+}
+
+/**
+ * @brief Intersect the @p n elements at @p small with the @p m elements at
+ * @p large by galloping through @p large.
+ *
+ * @tparam Store Whether to write the result to @p out, or only count it.
+ * @return std::size_t How many elements the intersection has.
+ */
+template <bool Store, class T, class Compare>
+inline std::size_t
+intersect_gallop(
+    const T* small, std::size_t n, const T* large, std::size_t m, T* out, Compare& cmp
+)
+{
+    std::size_t j = 0;
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        j = gallop(large, j, m, small[i], cmp);
+        if (j == m)
+            break;
+        if (!cmp(small[i], large[j])) {
+            if constexpr (Store)
+                out[k] = small[i];
+            k++;
+            j++;
+        }
+    }
+    return k;
+}
+
+/**
+ * @brief Subtract the @p m elements at @p b from the @p n elements at @p a by
+ * merging them.
+ *
+ * @return std::size_t How many elements the difference has.
+ */
+template <class T, class Compare>
+inline std::size_t
+subtract_merge(
+    const T* a, std::size_t n, const T* b, std::size_t m, T* out, Compare& cmp
+)
+{
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t k = 0;
+    while (i < n && j < m) {
+        const bool lt = cmp(a[i], b[j]);
+        const bool gt = cmp(b[j], a[i]);
+        emit(out, k, a[i], lt);
+        i += static_cast<std::size_t>(!gt);
+        j += static_cast<std::size_t>(!lt);
+    }
+    std::copy(a + i, a + n, out + k);
+    return k + (n - i);
+}
+
+/**
+ * @brief Subtract the @p m elements at @p b from the @p n elements at @p a,
+ * when @p b is much longer, by galloping through @p b.
+ *
+ * @return std::size_t How many elements the difference has.
+ */
+template <class T, class Compare>
+inline std::size_t
+subtract_gallop_b(
+    const T* a, std::size_t n, const T* b, std::size_t m, T* out, Compare& cmp
+)
+{
+    std::size_t j = 0;
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        j = gallop(b, j, m, a[i], cmp);
+        if (j == m) {
+            std::copy(a + i, a + n, out + k);
+            return k + (n - i);
+        }
+        emit(out, k, a[i], cmp(a[i], b[j]));
+    }
+    return k;
+}
+
+/**
+ * @brief Subtract the @p m elements at @p b from the @p n elements at @p a,
+ * when @p a is much longer, by galloping through @p a and copying the runs
+ * between the elements of @p b whole.
+ *
+ * @return std::size_t How many elements the difference has.
+ */
+template <class T, class Compare>
+inline std::size_t
+subtract_gallop_a(
+    const T* a, std::size_t n, const T* b, std::size_t m, T* out, Compare& cmp
+)
+{
+    T* const start = out;
+    std::size_t i = 0;
+    for (std::size_t j = 0; j < m && i < n; j++) {
+        const std::size_t next = gallop(a, i, n, b[j], cmp);
+        out = std::copy(a + i, a + next, out);
+        i = next;
+        if (i < n && !cmp(b[j], a[i]))
+            i++;
+    }
+    out = std::copy(a + i, a + n, out);
+    return static_cast<std::size_t>(out - start);
+}
+
+/**
+ * @brief Unite the @p n elements at @p a with the @p m elements at @p b by
+ * merging them.
+ *
+ * @return std::size_t How many elements the union has.
+ */
+template <class T, class Compare>
+inline std::size_t
+unite_merge(const T* a, std::size_t n, const T* b, std::size_t m, T* out, Compare& cmp)
+{
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t k = 0;
+    while (i < n && j < m) {
+        const bool lt = cmp(a[i], b[j]);
+        const bool gt = cmp(b[j], a[i]);
+        out[k++] = gt ? b[j] : a[i];
+        i += static_cast<std::size_t>(!gt);
+        j += static_cast<std::size_t>(!lt);
+    }
+    out = std::copy(a + i, a + n, out + k);
+    std::copy(b + j, b + m, out);
+    return k + (n - i) + (m - j);
+}
+
+/**
+ * @brief Unite the @p n elements at @p small with the @p m elements at
+ * @p large by galloping through @p large and copying the runs between the
+ * elements of @p small whole.
+ *
+ * @return std::size_t How many elements the union has.
+ */
+template <class T, class Compare>
+inline std::size_t
+unite_gallop(
+    const T* small, std::size_t n, const T* large, std::size_t m, T* out, Compare& cmp
+)
+{
+    T* const start = out;
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        const std::size_t next = gallop(large, j, m, small[i], cmp);
+        out = std::copy(large + j, large + next, out);
+        j = next;
+        *out++ = small[i];
+        if (j < m && !cmp(small[i], large[j]))
+            j++;
+    }
+    out = std::copy(large + j, large + m, out);
+    return static_cast<std::size_t>(out - start);
+}
+
+#ifdef LIBDS_HAS_X86_DISPATCH
+/**
+ * @brief Find the lanes of @p va that are equal to some lane of @p vb.
+ *
+ * Compares @p va with all 8 rotations of @p vb.
+ *
+ * @return unsigned One bit per lane of @p va.
+ */
+LIBDS_TARGET_AVX2 inline unsigned
+match_lanes_avx2(__m256i va, __m256i vb) noexcept
+{
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    __m256i eq = _mm256_cmpeq_epi32(va, vb);
+    for (int r = 1; r < 8; r++) {
+        vb = _mm256_permutevar8x32_epi32(vb, rotate);
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+    }
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+}
+
+/**
+ * @brief Store the lanes of @p v in @p keep, packed to the front, at @p out.
+ *
+ * Always writes 8 elements.
+ */
+template <class T>
+LIBDS_TARGET_AVX2 inline void
+compress_store_avx2(T* out, __m256i v, unsigned keep) noexcept
+{
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m256i order = _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&COMPRESS_32[keep]))
+    );
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(v, order)
+    );
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+/**
+ * @brief Load 8 elements from @p data.
+ */
+template <class T>
+LIBDS_TARGET_AVX2 inline __m256i
+load_avx2(const T* data) noexcept
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+}
+
+/**
+ * @brief Intersect the @p n elements at @p a with the @p m elements at @p b, 8
+ * by 8, with AVX2.
+ *
+ * Each block of @p a is compared with a block of @p b all-against-all, its
+ * matches are packed to the front with one permutation and stored
+ * unconditionally, and whichever block ends first (or both) is advanced. The
+ * only branch is the loop condition.
+ *
+ * @tparam Store Whether to write the result to @p out, or only count it.
+ * @return std::size_t How many elements the intersection has.
+ */
+template <bool Store, class T, class Compare>
+LIBDS_TARGET_AVX2 inline std::size_t
+intersect_avx2(
+    const T* a, std::size_t n, const T* b, std::size_t m, T* out, Compare& cmp
+)
+{
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t k = 0;
+    while (i + 8 <= n && j + 8 <= m) {
+        const T a_max = a[i + 7];
+        const T b_max = b[j + 7];
+        const unsigned match = match_lanes_avx2(load_avx2(a + i), load_avx2(b + j));
+        if constexpr (Store)
+            compress_store_avx2(out + k, load_avx2(a + i), match);
+        k += static_cast<std::size_t>(_mm_popcnt_u32(match));
+        i += static_cast<std::size_t>(a_max <= b_max) * 8;
+        j += static_cast<std::size_t>(b_max <= a_max) * 8;
+    }
+
+    // Matched elements left in a's block are smaller than b[j], so are skipped
+    T* rest = nullptr;
+    if constexpr (Store)
+        rest = out + k;
+    return k + intersect_merge<Store>(a + i, n - i, b + j, m - j, rest, cmp);
+}
+
+/**
+ * @brief Subtract the @p m elements at @p b from the @p n elements at @p a, 8 by
+ * 8, with AVX2.
+ *
+ * Like intersect_avx2(), but the matches of a block of @p a are collected over
+ * every block of @p b it overlaps, and the rest of it is stored when it is done.
+ *
+ * @return std::size_t How many elements the difference has.
+ */
+template <class T, class Compare>
+LIBDS_TARGET_AVX2 inline std::size_t
+subtract_avx2(
+    const T* a, std::size_t n, const T* b, std::size_t m, T* out, Compare& cmp
+)
+{
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t k = 0;
+    unsigned matched = 0;
+    while (i + 8 <= n && j + 8 <= m) {
+        const T a_max = a[i + 7];
+        const T b_max = b[j + 7];
+        const __m256i va = load_avx2(a + i);
+        matched |= match_lanes_avx2(va, load_avx2(b + j));
+        if (a_max <= b_max) {
+            const unsigned keep = ~matched & 0xFFU;
+            compress_store_avx2(out + k, va, keep);
+            k += static_cast<std::size_t>(_mm_popcnt_u32(keep));
+            matched = 0;
+            i += 8;
+        }
+        j += static_cast<std::size_t>(b_max <= a_max) * 8;
+    }
+
+    // Finish a block of a that is partly matched already
+    if (matched != 0) {
+        for (std::size_t lane = 0; lane < 8; lane++, i++) {
+            if ((matched >> lane & 1U) != 0)
+                continue;
+            while (j < m && cmp(b[j], a[i]))
+                j++;
+            emit(out, k, a[i], j == m || cmp(a[i], b[j]));
+        }
+    }
+    return k + subtract_merge(a + i, n - i, b + j, m - j, out + k, cmp);
+}
+#endif
+
+/**
+ * @brief Intersect the @p n elements at @p a with the @p m elements at @p b,
+ * picking the fastest kernel for their sizes.
+ *
+ * @tparam Store Whether to write the result to @p out, which must have room for
+ * the smaller input plus SET_SLACK elements, or only count it.
+ * @return std::size_t How many elements the intersection has.
+ */
+template <bool Store, class T, class Compare>
+inline std::size_t
+intersect(const T* a, std::size_t n, const T* b, std::size_t m, T* out, Compare& cmp)
+{
+    if (n == 0 || m == 0)
+        return 0;
+    if (is_skewed(n, m)) {
+        return n < m ? intersect_gallop<Store>(a, n, b, m, out, cmp)
+                     : intersect_gallop<Store>(b, m, a, n, out, cmp);
+    }
+
+#ifdef LIBDS_HAS_X86_DISPATCH
+    if constexpr (IS_SIMD_SET<T, Compare>) {
+        if (has_avx2())
+            return intersect_avx2<Store>(a, n, b, m, out, cmp);
+    }
+#endif
+
+    return intersect_merge<Store>(a, n, b, m, out, cmp);
+}
+
+/**
+ * @brief Subtract the @p m elements at @p b from the @p n elements at @p a,
+ * picking the fastest kernel for their sizes.
+ *
+ * @param out Room for @p n plus SET_SLACK elements.
+ * @return std::size_t How many elements the difference has.
+ */
+template <class T, class Compare>
+inline std::size_t
+subtract(const T* a, std::size_t n, const T* b, std::size_t m, T* out, Compare& cmp)
+{
+    if (n == 0 || m == 0) {
+        std::copy(a, a + n, out);
+        return n;
+    }
+    if (is_skewed(n, m)) {
+        return n < m ? subtract_gallop_b(a, n, b, m, out, cmp)
+                     : subtract_gallop_a(a, n, b, m, out, cmp);
+    }
+
+#ifdef LIBDS_HAS_X86_DISPATCH
+    if constexpr (IS_SIMD_SET<T, Compare>) {
+        if (has_avx2())
+            return subtract_avx2(a, n, b, m, out, cmp);
+    }
+#endif
+
+    return subtract_merge(a, n, b, m, out, cmp);
+}
+
+/**
+ * @brief Unite the @p n elements at @p a with the @p m elements at @p b,
+ * picking the fastest kernel for their sizes.
+ *
+ * @param out Room for `n + m` elements.
+ * @return std::size_t How many elements the union has.
+ */
+template <class T, class Compare>
+inline std::size_t
+unite(const T* a, std::size_t n, const T* b, std::size_t m, T* out, Compare& cmp)
+{
+    if (is_skewed(n, m) || n == 0 || m == 0) {
+        return n < m ? unite_gallop(a, n, b, m, out, cmp)
+                     : unite_gallop(b, m, a, n, out, cmp);
+    }
+    return unite_merge(a, n, b, m, out, cmp);
+}
+
+} // namespace detail
+
+/**
+ * @brief Compute the intersection of the sorted sets @p a and @p b into @p out.
+ *
+ * Both inputs must be sorted by @p cmp and hold no duplicates, like posting
+ * lists. Inputs of similar sizes are merged: 32-bit integers in `std::less`
+ * order are compared 8 against 8 with AVX2 where the CPU has it, and anything
+ * else without branching on the data. When one input is at least 32
+ * times longer than the other, each element of the shorter one is instead
+ * searched for in the longer one, with exponential then binary search from
+ * where the last one was found.
+ *
+ * @param a The first set.
+ * @param b The second set.
+ * @param out Replaced with the elements in both @p a and @p b, in order. Must
+ * not be @p a or @p b.
+ * @param cmp The order of the sets. Defaults to `std::less<>`.
+ */
+template <
+    class T,
+    std::size_t A,
+    std::size_t B,
+    std::size_t C,
+    class Compare = std::less<>>
+inline void
+set_intersection(
+    const vec<T, A>& a, const vec<T, B>& b, vec<T, C>& out, Compare cmp = {}
+)
+{
+    out.clear();
+    out.resize_for_overwrite(std::min(a.size(), b.size()) + detail::SET_SLACK);
+    const std::size_t k = detail::intersect<true>(
+        a.data(), a.size(), b.data(), b.size(), out.data(), cmp
+    );
+    out.erase(k, out.size() - k);
+}
+
+/**
+ * @brief Count the elements in both of the sorted sets @p a and @p b, without
+ * writing them anywhere.
+ *
+ * Uses the same kernels as set_intersection(). The sizes of the union and
+ * difference follow from it: `a.size() + b.size() - n` and `a.size() - n`.
+ *
+ * @param a The first set.
+ * @param b The second set.
+ * @param cmp The order of the sets. Defaults to `std::less<>`.
+ * @return std::size_t The size of the intersection.
+ */
+template <class T, std::size_t A, std::size_t B, class Compare = std::less<>>
+inline std::size_t
+intersection_size(const vec<T, A>& a, const vec<T, B>& b, Compare cmp = {})
+{
+    return detail::intersect<false>(
+        a.data(), a.size(), b.data(), b.size(), static_cast<T*>(nullptr), cmp
+    );
+}
+
+/**
+ * @brief Compute the intersection of several sorted sets into @p out.
+ *
+ * The sets are intersected from the smallest up, so each step works on an
+ * intermediate result no larger than the smallest set, and the whole thing
+ * stops as soon as that result is empty. Each step is a set_intersection().
+ *
+ * @param lists The sets, each sorted by @p cmp and without duplicates.
+ * @param out Replaced with the elements in all of @p lists, in order. Must not
+ * be one of them. Empty if there are no lists.
+ * @param cmp The order of the sets. Defaults to `std::less<>`.
+ */
+template <class T, std::size_t A, class Compare = std::less<>>
+inline void
+set_intersection(
+    span<const span<const detail::type_identity_t<T>>> lists,
+    vec<T, A>& out,
+    Compare cmp = {}
+)
+{
+    out.clear();
+    if (lists.empty())
+        return;
+
+    vec<span<const T>> order(lists.size(), span<const T>());
+    std::copy(lists.begin(), lists.end(), order.begin());
+    std::sort(order.begin(), order.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.size() < rhs.size();
+    });
+
+    const span<const T> smallest = order[0];
+    if (order.size() == 1) {
+        out.resize_for_overwrite(smallest.size());
+        std::copy(smallest.begin(), smallest.end(), out.begin());
+        return;
+    }
+
+    vec<T, A> next(smallest.size() + detail::SET_SLACK);
+    out.resize_for_overwrite(smallest.size() + detail::SET_SLACK);
+    std::size_t k = detail::intersect<true>(
+        smallest.data(), smallest.size(), order[1].data(), order[1].size(),
+        out.data(), cmp
+    );
+    out.erase(k, out.size() - k);
+
+    for (std::size_t l = 2; l < order.size() && !out.empty(); l++) {
+        next.clear();
+        next.resize_for_overwrite(out.size() + detail::SET_SLACK);
+        k = detail::intersect<true>(
+            out.data(), out.size(), order[l].data(), order[l].size(), next.data(),
+            cmp
+        );
+        next.erase(k, next.size() - k);
+        std::swap(out, next);
+    }
+}
+
+/**
+ * @brief Compute the intersection of several sorted sets into @p out.
+ *
+ * See the span version.
+ */
+template <class T, std::size_t A, class Compare = std::less<>>
+inline void
+set_intersection(
+    std::initializer_list<span<const detail::type_identity_t<T>>> lists,
+    vec<T, A>& out,
+    Compare cmp = {}
+)
+{
+    set_intersection(
+        span<const span<const T>>(lists.begin(), lists.size()), out, std::move(cmp)
+    );
+}
+
+/**
+ * @brief Compute the union of the sorted sets @p a and @p b into @p out.
+ *
+ * Both inputs must be sorted by @p cmp and hold no duplicates. Inputs of
+ * similar sizes are merged without branching on the data; when one is at least
+ * 32 times longer, the runs of it between the elements of the other are found
+ * by galloping and copied whole.
+ *
+ * @param a The first set.
+ * @param b The second set.
+ * @param out Replaced with the elements in @p a or @p b, in order, each once.
+ * Must not be @p a or @p b.
+ * @param cmp The order of the sets. Defaults to `std::less<>`.
+ */
+template <
+    class T,
+    std::size_t A,
+    std::size_t B,
+    std::size_t C,
+    class Compare = std::less<>>
+inline void
+set_union(const vec<T, A>& a, const vec<T, B>& b, vec<T, C>& out, Compare cmp = {})
+{
+    out.clear();
+    out.resize_for_overwrite(a.size() + b.size());
+    const std::size_t k =
+        detail::unite(a.data(), a.size(), b.data(), b.size(), out.data(), cmp);
+    out.erase(k, out.size() - k);
+}
+
+/**
+ * @brief Compute the difference of the sorted sets @p a and @p b into @p out.
+ *
+ * Both inputs must be sorted by @p cmp and hold no duplicates. Uses the same
+ * strategies as set_intersection(); when @p a is the longer one, the runs of it
+ * between the elements of @p b are copied whole.
+ *
+ * @param a The set to subtract from.
+ * @param b The set to subtract.
+ * @param out Replaced with the elements in @p a but not in @p b, in order. Must
+ * not be @p a or @p b.
+ * @param cmp The order of the sets. Defaults to `std::less<>`.
+ */
+template <
+    class T,
+    std::size_t A,
+    std::size_t B,
+    std::size_t C,
+    class Compare = std::less<>>
+inline void
+set_difference(
+    const vec<T, A>& a, const vec<T, B>& b, vec<T, C>& out, Compare cmp = {}
+)
+{
+    out.clear();
+    out.resize_for_overwrite(a.size() + detail::SET_SLACK);
+    const std::size_t k =
+        detail::subtract(a.data(), a.size(), b.data(), b.size(), out.data(), cmp);
+    out.erase(k, out.size() - k);
+}
+
+} // namespace ds
+
+#endif // LIBDS_SET_OPS_HPP
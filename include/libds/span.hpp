@@ -0,0 +1,680 @@
+/**
+ * @file span.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief A non-owning view over a contiguous sequence of elements.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_SPAN_HPP
+#define LIBDS_SPAN_HPP
+
+#include <cstddef>
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ds {
+
+template <class T, std::size_t Alignment = alignof(T)>
+class vec;
+
+template <class T>
+class devec;
+
+template <class T, class Layout>
+class basic_compact_vec;
+
+template <class T>
+class chunk_range;
+
+template <class T>
+class window_range;
+
+/**
+ * @brief A non-owning view over a contiguous sequence of @p T.
+ *
+ * Spans never allocate or copy elements; they are a pointer and a length.
+ * A `span<T>` converts implicitly to a `span<const T>`, and both can be
+ * created implicitly from a ds::vec, ds::devec or ds::compact_vec, so functions
+ * taking spans can be handed a whole vector or any subrange of one without
+ * copying.
+ *
+ * The viewed elements must outlive the span. Anything that reallocates the
+ * underlying vector (e.g. growing it with insert()) invalidates the span.
+ *
+ * @tparam T The type of data this span views. May be const-qualified.
+ */
+template <class T>
+class span {
+ public:
+    /**
+     * @brief The type of the viewed elements, including cv-qualifiers.
+     */
+    using element_type = T;
+
+    /**
+     * @brief The type of the viewed elements, without cv-qualifiers.
+     */
+    using value_type = std::remove_cv_t<T>;
+
+    /**
+     * @brief Unsigned integer type used for indicies.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief A random access iterator to @p T.
+     */
+    using iterator = T*;
+
+ private:
+    T* data_;
+    size_type size_;
+
+    /**
+     * @brief Whether a span of @p U can be viewed as a span of @p T.
+     *
+     * Only qualification conversions (e.g. adding const) are allowed.
+     */
+    template <class U>
+    static constexpr bool is_compatible_ = std::is_convertible_v<U (*)[], T (*)[]>;
+
+ public:
+#pragma region "Constructors"
+
+    /**
+     * @brief Construct an empty span.
+     */
+    constexpr span() noexcept : data_(nullptr), size_(0) {}
+
+    /**
+     * @brief Construct a span over @p size elements starting at @p data.
+     *
+     * @param data A pointer to the first element.
+     * @param size How many elements to view.
+     */
+    constexpr span(T* data, size_type size) noexcept : data_(data), size_(size) {}
+
+    /**
+     * @brief Construct a span over a range of elements.
+     *
+     * @param first A pointer to the first element.
+     * @param last A pointer one past the last element.
+     */
+    constexpr span(T* first, T* last) noexcept :
+        data_(first), size_(static_cast<size_type>(last - first))
+    {}
+
+    /**
+     * @brief Convert from a span with a compatible element type.
+     *
+     * Used to turn a `span<T>` into a `span<const T>`.
+     *
+     * @param other The span to view.
+     */
+    template <class U, std::enable_if_t<is_compatible_<U>, int> = 0>
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    constexpr span(const span<U>& other) noexcept :
+        data_(other.data()), size_(other.size())
+    {}
+
+    /**
+     * @brief View all elements of a vector.
+     *
+     * @param v The vector to view.
+     */
+    template <class U, std::size_t A, std::enable_if_t<is_compatible_<U>, int> = 0>
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    constexpr span(vec<U, A>& v) noexcept : data_(v.data()), size_(v.size())
+    {}
+
+    /**
+     * @brief View all elements of a const vector.
+     *
+     * Only available for spans of const elements.
+     *
+     * @param v The vector to view.
+     */
+    template <
+        class U, std::size_t A, std::enable_if_t<is_compatible_<const U>, int> = 0>
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    constexpr span(const vec<U, A>& v) noexcept : data_(v.data()), size_(v.size())
+    {}
+
+    /**
+     * @brief View all elements of a double-ended vector.
+     *
+     * @param v The vector to view.
+     */
+    template <class U, std::enable_if_t<is_compatible_<U>, int> = 0>
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    constexpr span(devec<U>& v) noexcept : data_(v.data()), size_(v.size())
+    {}
+
+    /**
+     * @brief View all elements of a const double-ended vector.
+     *
+     * Only available for spans of const elements.
+     *
+     * @param v The vector to view.
+     */
+    template <class U, std::enable_if_t<is_compatible_<const U>, int> = 0>
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    constexpr span(const devec<U>& v) noexcept : data_(v.data()), size_(v.size())
+    {}
+
+    /**
+     * @brief View all elements of a compact vector.
+     *
+     * @param v The vector to view.
+     */
+    template <class U, class L, std::enable_if_t<is_compatible_<U>, int> = 0>
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    constexpr span(basic_compact_vec<U, L>& v) noexcept :
+        data_(v.data()), size_(v.size())
+    {}
+
+    /**
+     * @brief View all elements of a const compact vector.
+     *
+     * Only available for spans of const elements.
+     *
+     * @param v The vector to view.
+     */
+    template <class U, class L, std::enable_if_t<is_compatible_<const U>, int> = 0>
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    constexpr span(const basic_compact_vec<U, L>& v) noexcept :
+        data_(v.data()), size_(v.size())
+    {}
+
+#pragma endregion
+
+#pragma region "Accessors"
+
+    /**
+     * @brief Get a reference to the nth element.
+     *
+     * No bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] constexpr T&
+    operator[](size_type pos) const noexcept
+    {
+        return data_[pos];
+    }
+
+    /**
+     * @brief Get a reference to the nth element.
+     *
+     * Bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @exception std::out_of_range Index out of range of span.
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] constexpr T&
+    at(size_type pos) const
+    {
+        if (pos >= size_)
+            throw std::out_of_range("span: index out of range!");
+        return data_[pos];
+    }
+
+    /**
+     * @brief Get the first element.
+     *
+     * @return T& A reference to the first element.
+     */
+    [[nodiscard]] constexpr T&
+    front() const noexcept
+    {
+        return data_[0];
+    }
+
+    /**
+     * @brief Get the last element.
+     *
+     * @return T& A reference to the last element.
+     */
+    [[nodiscard]] constexpr T&
+    back() const noexcept
+    {
+        return data_[size_ - 1];
+    }
+
+    /**
+     * @brief Get access to the viewed data.
+     *
+     * @return T* A pointer to the first element.
+     */
+    [[nodiscard]] constexpr T*
+    data() const noexcept
+    {
+        return data_;
+    }
+
+#pragma endregion
+
+#pragma region "Capacity"
+
+    /**
+     * @brief Check if the span is empty.
+     *
+     * @return bool Whether or not the span is empty.
+     */
+    [[nodiscard]] constexpr bool
+    empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    /**
+     * @brief Get the number of viewed elements.
+     *
+     * @return size_type The span size.
+     */
+    [[nodiscard]] constexpr size_type
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Get the number of viewed bytes.
+     *
+     * @return size_type The span size in bytes.
+     */
+    [[nodiscard]] constexpr size_type
+    size_bytes() const noexcept
+    {
+        return size_ * sizeof(T);
+    }
+
+#pragma endregion
+
+#pragma region "Iterators"
+
+    /**
+     * @brief Get an iterator pointing to the beginning of this span.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] constexpr iterator
+    begin() const noexcept
+    {
+        return data_;
+    }
+
+    /**
+     * @brief Get an iterator pointing to the end of this span.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] constexpr iterator
+    end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+#pragma endregion
+
+#pragma region "Subviews"
+
+    /**
+     * @brief View the first @p count elements.
+     *
+     * @param count How many elements to view.
+     * @exception std::out_of_range @p count is greater than size().
+     * @return span The subview.
+     */
+    [[nodiscard]] constexpr span
+    first(size_type count) const
+    {
+        return slice(0, count);
+    }
+
+    /**
+     * @brief View the last @p count elements.
+     *
+     * @param count How many elements to view.
+     * @exception std::out_of_range @p count is greater than size().
+     * @return span The subview.
+     */
+    [[nodiscard]] constexpr span
+    last(size_type count) const
+    {
+        if (count > size_)
+            throw std::out_of_range("span: slice out of range!");
+        return {data_ + (size_ - count), count};
+    }
+
+    /**
+     * @brief View @p count elements starting at @p first.
+     *
+     * @param first The position of the first viewed element.
+     * @param count How many elements to view.
+     * @exception std::out_of_range The slice does not fit in this span.
+     * @return span The subview.
+     */
+    [[nodiscard]] constexpr span
+    slice(size_type first, size_type count) const
+    {
+        if (first > size_ || count > size_ - first)
+            throw std::out_of_range("span: slice out of range!");
+        return {data_ + first, count};
+    }
+
+    /**
+     * @brief Split this span into two at position @p pos.
+     *
+     * The first span views `[0, pos)`, the second views `[pos, size())`.
+     *
+     * @param pos Where to split the span.
+     * @exception std::out_of_range @p pos is greater than size().
+     * @return std::pair<span, span> The two halves.
+     */
+    [[nodiscard]] constexpr std::pair<span, span>
+    split_at(size_type pos) const
+    {
+        if (pos > size_)
+            throw std::out_of_range("span: split position out of range!");
+        return {span(data_, pos), span(data_ + pos, size_ - pos)};
+    }
+
+    /**
+     * @brief Iterate over non-overlapping subviews of @p size elements.
+     *
+     * The last chunk is shorter if size() is not a multiple of @p size.
+     *
+     * @param size How many elements each chunk views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return chunk_range<T> A range of spans.
+     */
+    [[nodiscard]] constexpr chunk_range<T>
+    chunks(size_type size) const
+    {
+        return chunk_range<T>(*this, size);
+    }
+
+    /**
+     * @brief Iterate over all overlapping subviews of @p size elements.
+     *
+     * Yields nothing if @p size is greater than size().
+     *
+     * @param size How many elements each window views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return window_range<T> A range of spans.
+     */
+    [[nodiscard]] constexpr window_range<T>
+    windows(size_type size) const
+    {
+        return window_range<T>(*this, size);
+    }
+
+#pragma endregion
+};
+
+template <class T>
+span(T*, std::size_t) -> span<T>;
+
+template <class T, std::size_t A>
+span(vec<T, A>&) -> span<T>;
+
+template <class T, std::size_t A>
+span(const vec<T, A>&) -> span<const T>;
+
+template <class T>
+span(devec<T>&) -> span<T>;
+
+template <class T>
+span(const devec<T>&) -> span<const T>;
+
+template <class T, class L>
+span(basic_compact_vec<T, L>&) -> span<T>;
+
+template <class T, class L>
+span(const basic_compact_vec<T, L>&) -> span<const T>;
+
+/**
+ * @brief A range over the non-overlapping chunks of a span.
+ *
+ * Returned by span::chunks().
+ *
+ * @tparam T The type of data the span views.
+ */
+template <class T>
+class chunk_range {
+ public:
+    /**
+     * @brief Unsigned integer type used for sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief A forward iterator yielding `span<T>` chunks.
+     */
+    class iterator {
+        span<T> rest_;
+        size_type size_;
+
+     public:
+        using value_type = span<T>;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr iterator(span<T> rest, size_type size) noexcept :
+            rest_(rest), size_(size)
+        {}
+
+        [[nodiscard]] constexpr span<T>
+        operator*() const noexcept
+        {
+            return {rest_.data(), rest_.size() < size_ ? rest_.size() : size_};
+        }
+
+        constexpr iterator&
+        operator++() noexcept
+        {
+            size_type step = rest_.size() < size_ ? rest_.size() : size_;
+            rest_ = span<T>(rest_.data() + step, rest_.size() - step);
+            return *this;
+        }
+
+        constexpr iterator
+        operator++(int) noexcept
+        {
+            iterator prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        [[nodiscard]] constexpr friend bool
+        operator==(const iterator& lhs, const iterator& rhs) noexcept
+        {
+            return lhs.rest_.data() == rhs.rest_.data()
+                && lhs.rest_.size() == rhs.rest_.size();
+        }
+
+        [[nodiscard]] constexpr friend bool
+        operator!=(const iterator& lhs, const iterator& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+ private:
+    span<T> view_;
+    size_type size_;
+
+ public:
+    /**
+     * @brief Construct a range over the chunks of @p view.
+     *
+     * @param view The span to split up.
+     * @param size How many elements each chunk views.
+     * @exception std::invalid_argument @p size is zero.
+     */
+    constexpr chunk_range(span<T> view, size_type size) : view_(view), size_(size)
+    {
+        if (size == 0)
+            throw std::invalid_argument("span: chunk size must be non-zero!");
+    }
+
+    /**
+     * @brief Get the number of chunks.
+     *
+     * @return size_type The number of chunks.
+     */
+    [[nodiscard]] constexpr size_type
+    size() const noexcept
+    {
+        return (view_.size() + size_ - 1) / size_;
+    }
+
+    [[nodiscard]] constexpr iterator
+    begin() const noexcept
+    {
+        return {view_, size_};
+    }
+
+    [[nodiscard]] constexpr iterator
+    end() const noexcept
+    {
+        return {span<T>(view_.end(), size_type{0}), size_};
+    }
+};
+
+/**
+ * @brief A range over the overlapping windows of a span.
+ *
+ * Returned by span::windows().
+ *
+ * @tparam T The type of data the span views.
+ */
+template <class T>
+class window_range {
+ public:
+    /**
+     * @brief Unsigned integer type used for sizes.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief A forward iterator yielding `span<T>` windows.
+     */
+    class iterator {
+        T* first_;
+        size_type size_;
+
+     public:
+        using value_type = span<T>;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr iterator(T* first, size_type size) noexcept :
+            first_(first), size_(size)
+        {}
+
+        [[nodiscard]] constexpr span<T>
+        operator*() const noexcept
+        {
+            return {first_, size_};
+        }
+
+        constexpr iterator&
+        operator++() noexcept
+        {
+            ++first_;
+            return *this;
+        }
+
+        constexpr iterator
+        operator++(int) noexcept
+        {
+            iterator prev = *this;
+            ++first_;
+            return prev;
+        }
+
+        [[nodiscard]] constexpr friend bool
+        operator==(const iterator& lhs, const iterator& rhs) noexcept
+        {
+            return lhs.first_ == rhs.first_;
+        }
+
+        [[nodiscard]] constexpr friend bool
+        operator!=(const iterator& lhs, const iterator& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+ private:
+    span<T> view_;
+    size_type size_;
+
+ public:
+    /**
+     * @brief Construct a range over the windows of @p view.
+     *
+     * @param view The span to slide over.
+     * @param size How many elements each window views.
+     * @exception std::invalid_argument @p size is zero.
+     */
+    constexpr window_range(span<T> view, size_type size) : view_(view), size_(size)
+    {
+        if (size == 0)
+            throw std::invalid_argument("span: window size must be non-zero!");
+    }
+
+    /**
+     * @brief Get the number of windows.
+     *
+     * @return size_type The number of windows.
+     */
+    [[nodiscard]] constexpr size_type
+    size() const noexcept
+    {
+        return size_ > view_.size() ? 0 : view_.size() - size_ + 1;
+    }
+
+    [[nodiscard]] constexpr iterator
+    begin() const noexcept
+    {
+        return {view_.data(), size_};
+    }
+
+    [[nodiscard]] constexpr iterator
+    end() const noexcept
+    {
+        return {view_.data() + size(), size_};
+    }
+};
+
+} // namespace ds
+
+#endif // LIBDS_SPAN_HPP
@@ -0,0 +1,568 @@
+/**
+ * @file stats.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Opt-in allocation and relocation counters for ds::vec.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_STATS_HPP
+#define LIBDS_STATS_HPP
+
+#include "libds/detail/type_name.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * @brief Attribute ds::vec events on this thread to the enclosing scope.
+ *
+ * Expands to nothing unless `LIBDS_STATS` is defined.
+ */
+#ifdef LIBDS_STATS
+#  define LIBDS_STATS_SCOPE()                                                    \
+      static ::ds::stats::site_stats libds_stats_site_{__FILE__, __LINE__, __func__}; \
+      ::ds::stats::site_scope libds_stats_scope_(libds_stats_site_)
+#else
+#  define LIBDS_STATS_SCOPE() static_cast<void>(0)
+#endif
+
+/**
+ * @brief Allocation statistics for ds::vec.
+ *
+ * When `LIBDS_STATS` is defined for the whole program, every ds::vec
+ * reports its allocations, reallocations, frees, copied bytes and peak
+ * capacity here, aggregated per element type. Events can additionally be
+ * attributed to a call site with LIBDS_STATS_SCOPE(). Without `LIBDS_STATS`
+ * ds::vec contains no instrumentation at all and this registry stays empty.
+ *
+ * All counters are updated with relaxed atomics, so reading them while other
+ * threads use vectors is safe, but a snapshot is not a consistent cut.
+ */
+namespace ds::stats {
+
+/**
+ * @brief A plain snapshot of a set of counters.
+ */
+struct counters {
+    /**
+     * @brief How many fresh buffers were allocated.
+     */
+    std::uint64_t allocations = 0;
+
+    /**
+     * @brief How many existing buffers were grown or shrunk.
+     */
+    std::uint64_t reallocations = 0;
+
+    /**
+     * @brief How many buffers were freed.
+     */
+    std::uint64_t frees = 0;
+
+    /**
+     * @brief Total bytes requested by allocations and reallocations.
+     */
+    std::uint64_t bytes_allocated = 0;
+
+    /**
+     * @brief Total bytes moved by element copies and shifts.
+     */
+    std::uint64_t bytes_copied = 0;
+
+    /**
+     * @brief The largest capacity (in elements) any vector reached.
+     */
+    std::uint64_t peak_capacity = 0;
+};
+
+/**
+ * @brief Atomic counters, shared by the per-type and per-site records.
+ */
+class counter_set {
+    std::atomic<std::uint64_t> allocations_{0};
+    std::atomic<std::uint64_t> reallocations_{0};
+    std::atomic<std::uint64_t> frees_{0};
+    std::atomic<std::uint64_t> bytes_allocated_{0};
+    std::atomic<std::uint64_t> bytes_copied_{0};
+    std::atomic<std::uint64_t> peak_capacity_{0};
+
+    inline void
+    update_peak_(std::uint64_t cap) noexcept
+    {
+        std::uint64_t peak = peak_capacity_.load(std::memory_order_relaxed);
+        while (cap > peak
+               && !peak_capacity_.compare_exchange_weak(
+                   peak, cap, std::memory_order_relaxed
+               ))
+        {}
+    }
+
+ public:
+    inline void
+    on_alloc(std::uint64_t cap, std::uint64_t bytes) noexcept
+    {
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+        update_peak_(cap);
+    }
+
+    inline void
+    on_realloc(std::uint64_t cap, std::uint64_t bytes) noexcept
+    {
+        reallocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+        update_peak_(cap);
+    }
+
+    inline void
+    on_free() noexcept
+    {
+        frees_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void
+    on_copy(std::uint64_t bytes) noexcept
+    {
+        bytes_copied_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Take a snapshot of the counters.
+     *
+     * @return counters The current values.
+     */
+    [[nodiscard]] inline counters
+    snapshot() const noexcept
+    {
+        counters res;
+        res.allocations = allocations_.load(std::memory_order_relaxed);
+        res.reallocations = reallocations_.load(std::memory_order_relaxed);
+        res.frees = frees_.load(std::memory_order_relaxed);
+        res.bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed);
+        res.bytes_copied = bytes_copied_.load(std::memory_order_relaxed);
+        res.peak_capacity = peak_capacity_.load(std::memory_order_relaxed);
+        return res;
+    }
+
+    /**
+     * @brief Zero all counters.
+     */
+    inline void
+    reset() noexcept
+    {
+        allocations_.store(0, std::memory_order_relaxed);
+        reallocations_.store(0, std::memory_order_relaxed);
+        frees_.store(0, std::memory_order_relaxed);
+        bytes_allocated_.store(0, std::memory_order_relaxed);
+        bytes_copied_.store(0, std::memory_order_relaxed);
+        peak_capacity_.store(0, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Counters for every ds::vec event attributed to one call site.
+ *
+ * Created by LIBDS_STATS_SCOPE(); registers itself on construction.
+ */
+class site_stats : public counter_set {
+    const char* file_;
+    unsigned line_;
+    const char* function_;
+    site_stats* next_ = nullptr;
+
+    friend class registry;
+
+ public:
+    inline site_stats(const char* file, unsigned line, const char* function) noexcept;
+
+    site_stats(const site_stats&) = delete;
+    site_stats(site_stats&&) = delete;
+    site_stats& operator=(const site_stats&) = delete;
+    site_stats& operator=(site_stats&&) = delete;
+    ~site_stats() = default;
+
+    [[nodiscard]] inline const char*
+    file() const noexcept
+    {
+        return file_;
+    }
+
+    [[nodiscard]] inline unsigned
+    line() const noexcept
+    {
+        return line_;
+    }
+
+    [[nodiscard]] inline const char*
+    function() const noexcept
+    {
+        return function_;
+    }
+};
+
+/**
+ * @brief Counters for every ds::vec of one element type.
+ *
+ * Obtained through for_type(); registers itself on first use.
+ */
+class type_stats : public counter_set {
+    std::string name_;
+    std::size_t element_size_;
+    type_stats* next_ = nullptr;
+
+    friend class registry;
+
+ public:
+    inline type_stats(std::string name, std::size_t element_size) noexcept;
+
+    type_stats(const type_stats&) = delete;
+    type_stats(type_stats&&) = delete;
+    type_stats& operator=(const type_stats&) = delete;
+    type_stats& operator=(type_stats&&) = delete;
+    ~type_stats() = default;
+
+    [[nodiscard]] inline const std::string&
+    name() const noexcept
+    {
+        return name_;
+    }
+
+    [[nodiscard]] inline std::size_t
+    element_size() const noexcept
+    {
+        return element_size_;
+    }
+};
+
+/**
+ * @brief The global lists of type and site records.
+ *
+ * Records are pushed with a lock-free CAS and never removed, so iteration is
+ * always safe.
+ */
+class registry {
+    inline static std::atomic<type_stats*> types_{nullptr};
+    inline static std::atomic<site_stats*> sites_{nullptr};
+    inline static thread_local site_stats* current_site_ = nullptr;
+
+    template <class Node>
+    static inline void
+    push_(std::atomic<Node*>& head, Node* node) noexcept
+    {
+        node->next_ = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(
+            node->next_, node, std::memory_order_release, std::memory_order_relaxed
+        ))
+        {}
+    }
+
+    friend class type_stats;
+    friend class site_stats;
+    friend class site_scope;
+
+ public:
+    /**
+     * @brief Call @p fn with every registered type record.
+     */
+    template <class Fn>
+    static inline void
+    for_each_type(Fn&& fn)
+    {
+        for (auto* node = types_.load(std::memory_order_acquire); node != nullptr;
+             node = node->next_)
+            fn(static_cast<const type_stats&>(*node));
+    }
+
+    /**
+     * @brief Call @p fn with every registered site record.
+     */
+    template <class Fn>
+    static inline void
+    for_each_site(Fn&& fn)
+    {
+        for (auto* node = sites_.load(std::memory_order_acquire); node != nullptr;
+             node = node->next_)
+            fn(static_cast<const site_stats&>(*node));
+    }
+
+    /**
+     * @brief Zero the counters of every record.
+     */
+    static inline void
+    reset() noexcept
+    {
+        for (auto* node = types_.load(std::memory_order_acquire); node != nullptr;
+             node = node->next_)
+            node->reset();
+        for (auto* node = sites_.load(std::memory_order_acquire); node != nullptr;
+             node = node->next_)
+            node->reset();
+    }
+
+    /**
+     * @brief The site this thread's events are currently attributed to.
+     *
+     * @return site_stats* The site, or `nullptr` outside of any scope.
+     */
+    [[nodiscard]] static inline site_stats*
+    current_site() noexcept
+    {
+        return current_site_;
+    }
+};
+
+inline site_stats::site_stats(
+    const char* file, unsigned line, const char* function
+) noexcept :
+    file_(file), line_(line), function_(function)
+{
+    registry::push_(registry::sites_, this);
+}
+
+inline type_stats::type_stats(std::string name, std::size_t element_size) noexcept :
+    name_(std::move(name)), element_size_(element_size)
+{
+    registry::push_(registry::types_, this);
+}
+
+/**
+ * @brief RAII guard attributing this thread's events to a site.
+ *
+ * Scopes nest; the innermost one wins. Use LIBDS_STATS_SCOPE() rather than
+ * constructing this directly.
+ */
+class site_scope {
+    site_stats* prev_;
+
+ public:
+    explicit site_scope(site_stats& site) noexcept :
+        prev_(std::exchange(registry::current_site_, &site))
+    {}
+
+    site_scope(const site_scope&) = delete;
+    site_scope(site_scope&&) = delete;
+    site_scope& operator=(const site_scope&) = delete;
+    site_scope& operator=(site_scope&&) = delete;
+
+    ~site_scope() noexcept { registry::current_site_ = prev_; }
+};
+
+namespace detail {
+
+/**
+ * @brief Write @p str to @p out as a JSON string literal.
+ */
+inline void
+write_json_string(std::ostream& out, std::string_view str)
+{
+    out << '"';
+    for (char chr : str) {
+        if (chr == '"' || chr == '\\')
+            out << '\\' << chr;
+        else if (static_cast<unsigned char>(chr) < 0x20)
+            out << ' ';
+        else
+            out << chr;
+    }
+    out << '"';
+}
+
+/**
+ * @brief Write the fields of @p vals to @p out as JSON object members.
+ */
+inline void
+write_json_counters(std::ostream& out, const counters& vals)
+{
+    out << "\"allocations\":" << vals.allocations
+        << ",\"reallocations\":" << vals.reallocations << ",\"frees\":" << vals.frees
+        << ",\"bytes_allocated\":" << vals.bytes_allocated
+        << ",\"bytes_copied\":" << vals.bytes_copied
+        << ",\"peak_capacity\":" << vals.peak_capacity;
+}
+
+/**
+ * @brief Write @p vals to @p out as a line of the human readable report.
+ */
+inline void
+write_text_counters(std::ostream& out, const counters& vals)
+{
+    out << " allocs=" << vals.allocations << " reallocs=" << vals.reallocations
+        << " frees=" << vals.frees << " bytes_allocated=" << vals.bytes_allocated
+        << " bytes_copied=" << vals.bytes_copied
+        << " peak_capacity=" << vals.peak_capacity << '\n';
+}
+
+} // namespace detail
+
+/**
+ * @brief Get the record for vectors of @p T, registering it on first use.
+ *
+ * @return type_stats& The record.
+ */
+template <class T>
+[[nodiscard]] inline type_stats&
+for_type()
+{
+    static type_stats stats(::ds::detail::type_name<T>(), sizeof(T));
+    return stats;
+}
+
+/**
+ * @brief Record a fresh allocation of @p cap elements of @p T.
+ */
+template <class T>
+inline void
+record_alloc(std::size_t cap)
+{
+    for_type<T>().on_alloc(cap, cap * sizeof(T));
+    if (auto* site = registry::current_site(); site != nullptr)
+        site->on_alloc(cap, cap * sizeof(T));
+}
+
+/**
+ * @brief Record a reallocation of a buffer of @p T to @p cap elements.
+ */
+template <class T>
+inline void
+record_realloc(std::size_t cap)
+{
+    for_type<T>().on_realloc(cap, cap * sizeof(T));
+    if (auto* site = registry::current_site(); site != nullptr)
+        site->on_realloc(cap, cap * sizeof(T));
+}
+
+/**
+ * @brief Record freeing a buffer of @p T.
+ */
+template <class T>
+inline void
+record_free()
+{
+    for_type<T>().on_free();
+    if (auto* site = registry::current_site(); site != nullptr)
+        site->on_free();
+}
+
+/**
+ * @brief Record copying or shifting @p count elements of @p T.
+ */
+template <class T>
+inline void
+record_copy(std::size_t count)
+{
+    for_type<T>().on_copy(count * sizeof(T));
+    if (auto* site = registry::current_site(); site != nullptr)
+        site->on_copy(count * sizeof(T));
+}
+
+/**
+ * @brief Zero all counters.
+ */
+inline void
+reset() noexcept
+{
+    registry::reset();
+}
+
+/**
+ * @brief Write a human readable report of all counters to @p out.
+ *
+ * @param out The stream to write to.
+ */
+inline void
+dump(std::ostream& out)
+{
+    registry::for_each_type([&](const type_stats& rec) {
+        out << "vec<" << rec.name() << "> (" << rec.element_size() << " B):";
+        detail::write_text_counters(out, rec.snapshot());
+    });
+    registry::for_each_site([&](const site_stats& rec) {
+        out << rec.file() << ':' << rec.line() << " (" << rec.function() << "):";
+        detail::write_text_counters(out, rec.snapshot());
+    });
+}
+
+/**
+ * @brief Write all counters to @p out as a JSON document.
+ *
+ * The document has the shape
+ * `{"types": [{"type", "element_size", <counters>}...],
+ *   "sites": [{"file", "line", "function", <counters>}...]}`.
+ *
+ * @param out The stream to write to.
+ */
+inline void
+write_json(std::ostream& out)
+{
+    bool first = true;
+    out << "{\"types\":[";
+    registry::for_each_type([&](const type_stats& rec) {
+        out << (first ? "" : ",") << "{\"type\":";
+        detail::write_json_string(out, rec.name());
+        out << ",\"element_size\":" << rec.element_size() << ',';
+        detail::write_json_counters(out, rec.snapshot());
+        out << '}';
+        first = false;
+    });
+
+    first = true;
+    out << "],\"sites\":[";
+    registry::for_each_site([&](const site_stats& rec) {
+        out << (first ? "" : ",") << "{\"file\":";
+        detail::write_json_string(out, rec.file());
+        out << ",\"line\":" << rec.line() << ",\"function\":";
+        detail::write_json_string(out, rec.function());
+        out << ',';
+        detail::write_json_counters(out, rec.snapshot());
+        out << '}';
+        first = false;
+    });
+    out << "]}";
+}
+
+/**
+ * @brief Get all counters as a JSON document.
+ *
+ * @return std::string The document, see write_json().
+ */
+[[nodiscard]] inline std::string
+to_json()
+{
+    std::ostringstream out;
+    write_json(out);
+    return out.str();
+}
+
+} // namespace ds::stats
+
+#endif // LIBDS_STATS_HPP
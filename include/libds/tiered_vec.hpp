@@ -0,0 +1,916 @@
+/**
+ * @file tiered_vec.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief A tiered vector, with O(sqrt n) insertion and erasure anywhere.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_TIERED_VEC_HPP
+#define LIBDS_TIERED_VEC_HPP
+
+#include "libds/detail/index_iterator.hpp"
+#include "libds/devec.hpp"
+#include "libds/span.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace ds {
+
+/**
+ * @brief A tiered vector: a sequence of fixed-size circular blocks.
+ *
+ * Every block holds block_size() elements, except the last one, so element
+ * `i` is always in block `i / block_size()` and indexing is O(1). Each block is
+ * a ring buffer, which lets an element move from the back of one block to the
+ * front of the next in O(1). Inserting or erasing therefore shifts elements
+ * inside one block (O(block_size())) and then passes one element along each of
+ * the following blocks (O(size() / block_size())).
+ *
+ * The block size is a power of two, and doubles whenever the number of blocks
+ * would exceed twice the block size, so both terms stay O(sqrt n). Scans should
+ * use for_each_segment(), which hands out the contiguous pieces of the blocks
+ * instead of indexing element by element.
+ *
+ * @tparam T The type of data this vector will hold.
+ */
+template <class T>
+class tiered_vec {
+ public:
+    /**
+     * @brief The type of the stored elements.
+     */
+    using value_type = T;
+
+    /**
+     * @brief Unsigned integer type used for indicies.
+     */
+    using size_type = std::size_t;
+
+    /**
+     * @brief A random access iterator to @p T.
+     */
+    using iterator = detail::index_iterator<tiered_vec, T>;
+
+    /**
+     * @brief A constant random access iterator to @p T.
+     */
+    using const_iterator = detail::index_iterator<const tiered_vec, const T>;
+
+ private:
+    /**
+     * @brief One block: a ring buffer of block_size() elements.
+     */
+    struct tier_ {
+        T* data;
+        size_type head;
+    };
+
+    devec<tier_> tiers_;
+    size_type size_;
+    size_type shift_;
+
+    static constexpr size_type INITIAL_SHIFT = 6;
+
+#pragma region "Helpers"
+
+    /**
+     * @brief Get the index of an element within its block.
+     *
+     * @param pos The position of the element.
+     * @return size_type The offset of the element from the block's head.
+     */
+    [[nodiscard]] inline size_type
+    offset_(size_type pos) const noexcept
+    {
+        return pos & (block_size() - 1);
+    }
+
+    /**
+     * @brief Get a pointer to the @p pos th element of a block.
+     *
+     * @param tier The block.
+     * @param pos The position within the block, counting from its head.
+     * @return T* The (possibly uninitialized) slot.
+     */
+    [[nodiscard]] inline T*
+    slot_(const tier_& tier, size_type pos) const noexcept
+    {
+        return tier.data + ((tier.head + pos) & (block_size() - 1));
+    }
+
+    /**
+     * @brief Get how many elements are in a block.
+     *
+     * @param index The index of the block.
+     * @return size_type The number of elements in it.
+     */
+    [[nodiscard]] inline size_type
+    tier_size_(size_type index) const noexcept
+    {
+        const size_type first = index << shift_;
+        if (first >= size_)
+            return 0;
+        return size_ - first < block_size() ? size_ - first : block_size();
+    }
+
+    /**
+     * @brief Move an element to an uninitialized slot.
+     *
+     * @param dest The slot to move it to.
+     * @param src The element to move, which is destroyed afterwards.
+     */
+    static inline void
+    move_slot_(T* dest, T* src)
+    {
+        ::new (static_cast<void*>(dest)) T(std::move_if_noexcept(*src));
+        src->~T();
+    }
+
+    /**
+     * @brief Allocate an empty block.
+     *
+     * @param shift The log2 of the block size.
+     * @return tier_ The new block.
+     */
+    [[nodiscard]] static inline tier_
+    alloc_tier_(size_type shift)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc,modernize-use-auto)
+        auto* ptr = static_cast<T*>(std::malloc((size_type{1} << shift) * sizeof(T)));
+        if (ptr == nullptr)
+            throw std::runtime_error("tiered_vec: could not allocate memory");
+
+        return {ptr, 0};
+    }
+
+    /**
+     * @brief Destroy all elements and free all blocks.
+     */
+    inline void
+    free_() noexcept
+    {
+        for (size_type i = 0; i < tiers_.size(); i++) {
+            const size_type count = tier_size_(i);
+            for (size_type j = 0; j < count; j++)
+                slot_(tiers_[i], j)->~T();
+
+            std::free(tiers_[i].data); // NOLINT(cppcoreguidelines-no-malloc)
+        }
+
+        tiers_.clear();
+        size_ = 0;
+    }
+
+    /**
+     * @brief Open an uninitialized slot at @p pos in a block that is not full.
+     *
+     * Shifts whichever side of @p pos is smaller.
+     *
+     * @param tier The block.
+     * @param count How many elements are in the block.
+     * @param pos Where to open the slot.
+     */
+    inline void
+    open_slot_(tier_& tier, size_type count, size_type pos)
+    {
+        if (pos < count - pos) {
+            tier.head = (tier.head - 1) & (block_size() - 1);
+            for (size_type i = 0; i < pos; i++)
+                move_slot_(slot_(tier, i), slot_(tier, i + 1));
+        } else {
+            for (size_type i = count; i > pos; i--)
+                move_slot_(slot_(tier, i), slot_(tier, i - 1));
+        }
+    }
+
+    /**
+     * @brief Close the uninitialized slot at @p pos in a block.
+     *
+     * Shifts whichever side of @p pos is smaller.
+     *
+     * @param tier The block.
+     * @param count How many elements are in the block, counting the slot.
+     * @param pos Where the slot is.
+     */
+    inline void
+    close_slot_(tier_& tier, size_type count, size_type pos)
+    {
+        if (pos < count - 1 - pos) {
+            for (size_type i = pos; i > 0; i--)
+                move_slot_(slot_(tier, i), slot_(tier, i - 1));
+            tier.head = (tier.head + 1) & (block_size() - 1);
+        } else {
+            for (size_type i = pos; i + 1 < count; i++)
+                move_slot_(slot_(tier, i), slot_(tier, i + 1));
+        }
+    }
+
+    /**
+     * @brief Move all elements into blocks of `1 << new_shift` elements.
+     *
+     * @param new_shift The log2 of the new block size.
+     */
+    inline void
+    retier_(size_type new_shift)
+    {
+        const size_type new_block = size_type{1} << new_shift;
+
+        const size_type count = (size_ + new_block - 1) / new_block;
+
+        // Allocate everything up front, so running out of memory loses nothing
+        devec<tier_> new_tiers(count);
+        try {
+            for (size_type i = 0; i < count; i++)
+                new_tiers.push_back(alloc_tier_(new_shift));
+        } catch (...) {
+            for (auto& tier : new_tiers)
+                std::free(tier.data); // NOLINT(cppcoreguidelines-no-malloc)
+            throw;
+        }
+
+        for (size_type i = 0; i < size_; i++) {
+            move_slot_(
+                new_tiers[i >> new_shift].data + (i & (new_block - 1)),
+                slot_(tiers_[i >> shift_], offset_(i))
+            );
+        }
+
+        for (auto& tier : tiers_)
+            std::free(tier.data); // NOLINT(cppcoreguidelines-no-malloc)
+
+        tiers_ = std::move(new_tiers);
+        shift_ = new_shift;
+    }
+
+    /**
+     * @brief Call @p fn with every contiguous run of elements of @p self.
+     *
+     * @tparam Elem @p T, possibly const-qualified.
+     * @tparam Self tiered_vec, possibly const-qualified.
+     * @tparam Fn Callable as `fn(span<Elem>)`.
+     * @param self The vector to walk.
+     * @param fn The function to call.
+     */
+    template <class Elem, class Self, class Fn>
+    static inline void
+    for_each_segment_(Self& self, Fn& fn)
+    {
+        const size_type mask = self.block_size() - 1;
+        for (size_type i = 0; (i << self.shift_) < self.size_; i++) {
+            const tier_& tier = self.tiers_[i];
+            const size_type count = self.tier_size_(i);
+            const size_type first = self.block_size() - tier.head;
+
+            if (count <= first) {
+                fn(span<Elem>(tier.data + tier.head, count));
+            } else {
+                fn(span<Elem>(tier.data + tier.head, first));
+                fn(span<Elem>(tier.data, (tier.head + count) & mask));
+            }
+        }
+    }
+
+    /**
+     * @brief Make sure there is a block for the element at position size().
+     */
+    inline void
+    reserve_back_()
+    {
+        if ((size_ >> shift_) >= tiers_.size())
+            tiers_.push_back(alloc_tier_(shift_));
+    }
+
+    /**
+     * @brief Grow the blocks if there are too many of them.
+     */
+    inline void
+    rebalance_()
+    {
+        if (tiers_.size() > 2 * block_size())
+            retier_(shift_ + 1);
+    }
+
+#pragma endregion
+
+ public:
+#pragma region "Constructors/Destructors and assignment operators"
+
+    /**
+     * @brief Construct a new empty tiered_vec object.
+     */
+    tiered_vec() : tiers_(0), size_(0), shift_(INITIAL_SHIFT) {}
+
+    /**
+     * @brief Construct a new tiered_vec object with specified size, filled with
+     * elements.
+     *
+     * @param size The size of the tiered_vec.
+     * @param elem The element to fill the vector with
+     */
+    explicit tiered_vec(size_type size, T elem) : tiered_vec()
+    {
+        try {
+            for (size_type i = 0; i < size; i++)
+                emplace_back(elem);
+        } catch (...) {
+            free_();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Construct a new tiered_vec object from an initializer list
+     *
+     * @param init The initializer list with vector elements.
+     */
+    tiered_vec(std::initializer_list<T> init) : tiered_vec()
+    {
+        try {
+            for (const T& elem : init)
+                emplace_back(elem);
+        } catch (...) {
+            free_();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Copy constructor.
+     *
+     * @param other The vector to copy to this one.
+     */
+    tiered_vec(const tiered_vec& other) :
+        tiers_(other.tiers_.size()), size_(0), shift_(other.shift_)
+    {
+        try {
+            other.for_each_segment([this](span<const T> segment) {
+                for (const T& elem : segment)
+                    emplace_back(elem);
+            });
+        } catch (...) {
+            free_();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Move constructor.
+     *
+     * @param other The vector to move to this one.
+     */
+    tiered_vec(tiered_vec&& other) noexcept :
+        tiers_(std::move(other.tiers_)),
+        size_(std::exchange(other.size_, 0U)),
+        shift_(std::exchange(other.shift_, INITIAL_SHIFT))
+    {}
+
+    /**
+     * @brief Copy assignment operator.
+     *
+     * @param other The assigned object.
+     * @return The new object.
+     */
+    tiered_vec&
+    operator=(const tiered_vec& other)
+    {
+        // Guard self assignment
+        if (this == &other)
+            return *this;
+
+        *this = tiered_vec(other);
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * @param other The assigned object.
+     * @return The new object.
+     */
+    tiered_vec&
+    operator=(tiered_vec&& other) noexcept
+    {
+        // Guard self-assignment
+        if (this == &other)
+            return *this;
+
+        // Free our resources
+        free_();
+
+        // Leave the other in a valid state
+        tiers_ = std::move(other.tiers_);
+        size_ = std::exchange(other.size_, 0);
+        shift_ = std::exchange(other.shift_, INITIAL_SHIFT);
+
+        return *this;
+    }
+
+    /**
+     * @brief Destroy the tiered_vec object. Frees all blocks.
+     */
+    ~tiered_vec() noexcept { free_(); }
+
+#pragma endregion
+
+#pragma region "Accessors"
+
+    /**
+     * @brief Get a reference to the nth element.
+     *
+     * No bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] inline T&
+    operator[](size_type pos) noexcept
+    {
+        return *slot_(tiers_[pos >> shift_], offset_(pos));
+    }
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * No bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @return const T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    operator[](size_type pos) const noexcept
+    {
+        return *slot_(tiers_[pos >> shift_], offset_(pos));
+    }
+
+    /**
+     * @brief Get a reference to the nth element.
+     *
+     * Bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @exception std::out_of_range Index out of range of vector.
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] inline T&
+    at(size_type pos)
+    {
+        if (pos >= size_)
+            throw std::out_of_range("tiered_vec: index out of range!");
+        return (*this)[pos];
+    }
+
+    /**
+     * @brief Get a const reference to the nth element.
+     *
+     * Bounds checking is performed.
+     *
+     * @param pos The position of the desired element
+     * @exception std::out_of_range Index out of range of vector.
+     * @return T& The element at position pos.
+     */
+    [[nodiscard]] inline const T&
+    at(size_type pos) const
+    {
+        if (pos >= size_)
+            throw std::out_of_range("tiered_vec: index out of range!");
+        return (*this)[pos];
+    }
+
+    /**
+     * @brief Get the first element.
+     *
+     * @return T& A reference to the first element.
+     */
+    [[nodiscard]] inline T&
+    front() noexcept
+    {
+        return (*this)[0];
+    }
+
+    /**
+     * @brief Get the first element.
+     *
+     * @return T& A reference to the first element.
+     */
+    [[nodiscard]] inline const T&
+    front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    /**
+     * @brief Get the last element.
+     *
+     * @return T& A reference to the last element.
+     */
+    [[nodiscard]] inline T&
+    back() noexcept
+    {
+        return (*this)[size_ - 1];
+    }
+
+    /**
+     * @brief Get the last element.
+     *
+     * @return T& A reference to the last element.
+     */
+    [[nodiscard]] inline const T&
+    back() const noexcept
+    {
+        return (*this)[size_ - 1];
+    }
+
+#pragma endregion
+
+#pragma region "Capacity"
+
+    /**
+     * @brief Check if the vector is empty.
+     *
+     * @return bool Whether or not the vector is empty.
+     */
+    [[nodiscard]] inline bool
+    empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    /**
+     * @brief Get the size of the vector.
+     *
+     * @return size_type The vector size.
+     */
+    [[nodiscard]] inline size_type
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Get the capacity of the vector.
+     *
+     * This is the total size of all allocated blocks.
+     *
+     * @return size_type The vector capacity.
+     */
+    [[nodiscard]] inline size_type
+    capacity() const noexcept
+    {
+        return tiers_.size() << shift_;
+    }
+
+    /**
+     * @brief Get the number of elements per block.
+     *
+     * @return size_type The block size, a power of two.
+     */
+    [[nodiscard]] inline size_type
+    block_size() const noexcept
+    {
+        return size_type{1} << shift_;
+    }
+
+    /**
+     * @brief Free any blocks that hold no elements.
+     */
+    inline void
+    shrink_to_fit()
+    {
+        while (tiers_.size() > ((size_ + block_size() - 1) >> shift_)) {
+            std::free(tiers_.back().data); // NOLINT(cppcoreguidelines-no-malloc)
+            tiers_.pop_back();
+        }
+        tiers_.shrink_to_fit();
+    }
+
+#pragma endregion
+
+#pragma region "Iterators"
+
+    /**
+     * @brief Get an iterator pointing to the beginning of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline iterator
+    begin() noexcept
+    {
+        return {this, 0};
+    }
+
+    /**
+     * @brief Get an iterator pointing to the beginning of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline const_iterator
+    begin() const noexcept
+    {
+        return {this, 0};
+    }
+
+    /**
+     * @brief Get an iterator pointing to the end of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline iterator
+    end() noexcept
+    {
+        return {this, size_};
+    }
+
+    /**
+     * @brief Get an iterator pointing to the end of this vector.
+     *
+     * @return iterator The iterator.
+     */
+    [[nodiscard]] inline const_iterator
+    end() const noexcept
+    {
+        return {this, size_};
+    }
+
+    /**
+     * @brief Call @p fn with every contiguous run of elements, in order.
+     *
+     * Each block is at most two runs (its ring buffer may wrap around), so this
+     * visits at most `2 * size() / block_size() + 2` spans, and is the fastest
+     * way to scan the vector.
+     *
+     * @tparam Fn Callable as `fn(span<T>)`.
+     * @param fn The function to call.
+     */
+    template <class Fn>
+    inline void
+    for_each_segment(Fn fn)
+    {
+        for_each_segment_<T>(*this, fn);
+    }
+
+    /**
+     * @brief Call @p fn with every contiguous run of elements, in order.
+     *
+     * @tparam Fn Callable as `fn(span<const T>)`.
+     * @param fn The function to call.
+     */
+    template <class Fn>
+    inline void
+    for_each_segment(Fn fn) const
+    {
+        for_each_segment_<const T>(*this, fn);
+    }
+
+#pragma endregion
+
+#pragma region "Modifiers"
+
+    /* Everthing here changes vector size */
+
+    /**
+     * @brief Clear the contents of the vector, and free all blocks.
+     */
+    inline void
+    clear() noexcept
+    {
+        free_();
+    }
+
+    /**
+     * @brief Construct an element in place at the back of the vector.
+     *
+     * O(1) amortized.
+     *
+     * @tparam Args The types of the constructor arguments.
+     * @param args The arguments to construct the element from.
+     * @return T& The new element.
+     */
+    template <class... Args>
+    inline T&
+    emplace_back(Args&&... args)
+    {
+        reserve_back_();
+
+        T* slot = slot_(tiers_[size_ >> shift_], offset_(size_));
+        ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+        size_++;
+
+        rebalance_();
+        return back();
+    }
+
+    /**
+     * @brief Construct an element in place at position @p pos.
+     *
+     * O(sqrt(size())).
+     * Can insert one past the end of the vector (at size());
+     *
+     * @tparam Args The types of the constructor arguments.
+     * @param pos The position to insert the element in (zero indexed).
+     * @param args The arguments to construct the element from.
+     * @return An iterator pointing to the new element.
+     */
+    template <class... Args>
+    inline iterator
+    emplace(size_type pos, Args&&... args)
+    {
+        if (pos == size_) {
+            emplace_back(std::forward<Args>(args)...);
+            return {this, pos};
+        }
+
+        // args may refer to an element that is about to be moved
+        T elem(std::forward<Args>(args)...);
+        reserve_back_();
+
+        // Make room in the block of pos by passing one element along each of the
+        // following blocks, from the back.
+        const size_type index = pos >> shift_;
+        const size_type last = size_ >> shift_;
+        for (size_type i = last; i > index; i--) {
+            tier_& tier = tiers_[i];
+            tier.head = (tier.head - 1) & (block_size() - 1);
+            move_slot_(tier.data + tier.head, slot_(tiers_[i - 1], block_size() - 1));
+        }
+
+        tier_& tier = tiers_[index];
+        const size_type count = index == last ? offset_(size_) : block_size() - 1;
+        open_slot_(tier, count, offset_(pos));
+        ::new (static_cast<void*>(slot_(tier, offset_(pos)))) T(std::move(elem));
+        size_++;
+
+        rebalance_();
+        return {this, pos};
+    }
+
+    /**
+     * @brief Insert an element @p elem at position @p pos.
+     *
+     * Copies the element into the vector.
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @return An iterator pointing to the new element.
+     */
+    inline iterator
+    insert(size_type pos, const T& elem)
+    {
+        return emplace(pos, elem);
+    }
+
+    /**
+     * @brief Insert an element @p elem at position @p pos.
+     *
+     * Moves the element into the vector.
+     * Can insert one past the end of the vector (at size());
+     *
+     * @param pos The position to insert the element in (zero indexed).
+     * @param elem The element to insert.
+     * @return An iterator pointing to the new element.
+     */
+    inline iterator
+    insert(size_type pos, T&& elem)
+    {
+        return emplace(pos, std::move(elem));
+    }
+
+    /**
+     * @brief Add an element to the back of the vector.
+     *
+     * @param elem The element to add.
+     */
+    inline void
+    push_back(const T& elem)
+    {
+        emplace_back(elem);
+    }
+
+    /**
+     * @brief Add an element to the back of the vector.
+     *
+     * @param elem The element to add.
+     */
+    inline void
+    push_back(T&& elem)
+    {
+        emplace_back(std::move(elem));
+    }
+
+    /**
+     * @brief Remove the element at position @p pos.
+     *
+     * O(sqrt(size())).
+     *
+     * @param pos The position of the element to remove.
+     * @exception std::out_of_range @p pos is not in this vector.
+     * @return An iterator pointing to the element after the removed one.
+     */
+    inline iterator
+    erase(size_type pos)
+    {
+        if (pos >= size_)
+            throw std::out_of_range("tiered_vec: erase out of range!");
+
+        const size_type index = pos >> shift_;
+        const size_type last = (size_ - 1) >> shift_;
+
+        tier_& tier = tiers_[index];
+        slot_(tier, offset_(pos))->~T();
+        close_slot_(tier, tier_size_(index), offset_(pos));
+
+        // Fill the hole at the end of the block with the front of the next one,
+        // and so on.
+        for (size_type i = index + 1; i <= last; i++) {
+            tier_& next = tiers_[i];
+            move_slot_(slot_(tiers_[i - 1], block_size() - 1), next.data + next.head);
+            next.head = (next.head + 1) & (block_size() - 1);
+        }
+        size_--;
+
+        // Keep one empty block around, so erasing and inserting at a block
+        // boundary does not allocate every time.
+        if (tiers_.size() > (size_ >> shift_) + 2) {
+            std::free(tiers_.back().data); // NOLINT(cppcoreguidelines-no-malloc)
+            tiers_.pop_back();
+        }
+
+        return {this, pos};
+    }
+
+    /**
+     * @brief Remove the last element.
+     *
+     * The vector must not be empty. O(1).
+     */
+    inline void
+    pop_back() noexcept
+    {
+        back().~T();
+        size_--;
+    }
+
+#pragma endregion
+
+#pragma region "Equality operators"
+
+    inline friend bool
+    operator==(const ds::tiered_vec<T>& lhs, const ds::tiered_vec<T>& rhs)
+    {
+        // Check if they are the same object
+        if (&lhs == &rhs)
+            return true;
+
+        // Check if the vectors have different sizes
+        if (lhs.size_ != rhs.size_)
+            return false;
+
+        // Finally, check each element
+        for (size_type i = 0; i < lhs.size_; i++) {
+            if (lhs[i] != rhs[i])
+                return false;
+        }
+        return true;
+    }
+
+    inline friend bool
+    operator!=(const ds::tiered_vec<T>& lhs, const ds::tiered_vec<T>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+#pragma endregion
+};
+
+} // namespace ds
+
+#endif // LIBDS_TIERED_VEC_HPP
@@ -0,0 +1,746 @@
+/**
+ * @file trace.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief Recording and reading ds::vec operation traces.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_TRACE_HPP
+#define LIBDS_TRACE_HPP
+
+#include "libds/vec.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <initializer_list>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+namespace ds {
+
+/**
+ * @brief The operations recorded in a trace.
+ */
+enum class trace_op : std::uint8_t {
+    create = 1,  ///< A vector was created; `arg0` capacity, `arg1` element size.
+    destroy,     ///< A vector was destroyed.
+    copy,        ///< A vector was copy constructed from vector `arg0`.
+    move,        ///< A vector was move constructed from vector `arg0`.
+    assign,      ///< A vector was copy assigned from vector `arg0`.
+    move_assign, ///< A vector was move assigned from vector `arg0`.
+    insert,      ///< `arg1` elements were inserted at position `arg0`.
+    reserve,     ///< Capacity for `arg0` elements was reserved.
+    shrink,      ///< shrink_to_fit() was called.
+    clear,       ///< clear() was called.
+    resize,      ///< The vector was resized to `arg0` elements.
+    erase,       ///< `arg1` elements were erased from position `arg0`.
+};
+
+/**
+ * @brief One recorded operation.
+ */
+struct trace_record {
+    /**
+     * @brief What happened.
+     */
+    trace_op op = trace_op::create;
+
+    /**
+     * @brief Which vector it happened to, unique within a trace.
+     */
+    std::uint64_t id = 0;
+
+    /**
+     * @brief The first argument, see trace_op.
+     */
+    std::uint64_t arg0 = 0;
+
+    /**
+     * @brief The second argument, see trace_op.
+     */
+    std::uint64_t arg1 = 0;
+
+    [[nodiscard]] friend bool
+    operator==(const trace_record& lhs, const trace_record& rhs) noexcept
+    {
+        return lhs.op == rhs.op && lhs.id == rhs.id && lhs.arg0 == rhs.arg0
+            && lhs.arg1 == rhs.arg1;
+    }
+
+    [[nodiscard]] friend bool
+    operator!=(const trace_record& lhs, const trace_record& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+};
+
+/**
+ * @brief How many arguments @p op carries.
+ *
+ * @param op The operation.
+ * @return unsigned The number of arguments, 0 to 2.
+ */
+[[nodiscard]] constexpr unsigned
+trace_arity(trace_op op) noexcept
+{
+    switch (op) {
+        case trace_op::create:
+        case trace_op::insert:
+        case trace_op::erase:
+            return 2;
+        case trace_op::copy:
+        case trace_op::move:
+        case trace_op::assign:
+        case trace_op::move_assign:
+        case trace_op::reserve:
+        case trace_op::resize:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Writes a compact binary trace.
+ *
+ * The format is the 8-byte magic `LDSTRACE`, a version byte, and then one
+ * record per operation: the trace_op byte, followed by the vector id and the
+ * op's arguments (see trace_arity()) as LEB128 varints. Most records are 3 to
+ * 6 bytes long.
+ *
+ * Writing is serialized with a mutex, so vectors on different threads can
+ * share a writer.
+ */
+class trace_writer {
+    std::ostream* out_;
+    std::mutex mutex_;
+    std::atomic<std::uint64_t> next_id_{0};
+
+    inline void
+    write_varint_(std::uint64_t val)
+    {
+        while (val >= 0x80) {
+            out_->put(static_cast<char>((val & 0x7FU) | 0x80U));
+            val >>= 7U;
+        }
+        out_->put(static_cast<char>(val));
+    }
+
+ public:
+    /**
+     * @brief The bytes every trace starts with.
+     */
+    static constexpr char MAGIC[8] = {'L', 'D', 'S', 'T', 'R', 'A', 'C', 'E'};
+
+    /**
+     * @brief The format version written after the magic.
+     */
+    static constexpr std::uint8_t VERSION = 1;
+
+    /**
+     * @brief Start a trace on @p out.
+     *
+     * @param out The (binary) stream to write to; must outlive the writer.
+     */
+    explicit trace_writer(std::ostream& out) : out_(&out)
+    {
+        out_->write(MAGIC, sizeof(MAGIC));
+        out_->put(static_cast<char>(VERSION));
+    }
+
+    trace_writer(const trace_writer&) = delete;
+    trace_writer(trace_writer&&) = delete;
+    trace_writer& operator=(const trace_writer&) = delete;
+    trace_writer& operator=(trace_writer&&) = delete;
+    ~trace_writer() = default;
+
+    /**
+     * @brief Allocate an id for a new vector.
+     *
+     * @return std::uint64_t The id.
+     */
+    [[nodiscard]] inline std::uint64_t
+    new_id() noexcept
+    {
+        return next_id_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Append @p rec to the trace.
+     *
+     * @param rec The record.
+     */
+    inline void
+    write(const trace_record& rec)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        out_->put(static_cast<char>(rec.op));
+        write_varint_(rec.id);
+
+        unsigned arity = trace_arity(rec.op);
+        if (arity >= 1)
+            write_varint_(rec.arg0);
+        if (arity >= 2)
+            write_varint_(rec.arg1);
+    }
+
+    /**
+     * @brief Flush the underlying stream.
+     */
+    inline void
+    flush()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        out_->flush();
+    }
+};
+
+/**
+ * @brief Reads a trace written by trace_writer.
+ */
+class trace_reader {
+    std::istream* in_;
+
+    [[nodiscard]] inline std::uint64_t
+    read_varint_()
+    {
+        std::uint64_t val = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            int byte = in_->get();
+            if (byte == std::char_traits<char>::eof())
+                throw std::runtime_error("trace: truncated record");
+
+            val |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((static_cast<unsigned>(byte) & 0x80U) == 0)
+                return val;
+        }
+        throw std::runtime_error("trace: malformed varint");
+    }
+
+ public:
+    /**
+     * @brief Start reading a trace from @p in.
+     *
+     * @param in The (binary) stream to read from; must outlive the reader.
+     * @exception std::runtime_error The stream does not hold a trace.
+     */
+    explicit trace_reader(std::istream& in) : in_(&in)
+    {
+        char magic[sizeof(trace_writer::MAGIC)] = {};
+        in_->read(magic, sizeof(magic));
+        for (std::size_t i = 0; i < sizeof(magic); i++) {
+            if (!*in_ || magic[i] != trace_writer::MAGIC[i])
+                throw std::runtime_error("trace: bad magic");
+        }
+
+        if (in_->get() != trace_writer::VERSION)
+            throw std::runtime_error("trace: unsupported version");
+    }
+
+    /**
+     * @brief Read the next record.
+     *
+     * @param[out] rec Where to store the record.
+     * @exception std::runtime_error The trace is corrupt.
+     * @return bool Whether a record was read, false at the end of the trace.
+     */
+    inline bool
+    next(trace_record& rec)
+    {
+        int byte = in_->get();
+        if (byte == std::char_traits<char>::eof())
+            return false;
+
+        if (byte < static_cast<int>(trace_op::create)
+            || byte > static_cast<int>(trace_op::erase))
+            throw std::runtime_error("trace: unknown operation");
+
+        rec = trace_record();
+        rec.op = static_cast<trace_op>(byte);
+        rec.id = read_varint_();
+
+        unsigned arity = trace_arity(rec.op);
+        if (arity >= 1)
+            rec.arg0 = read_varint_();
+        if (arity >= 2)
+            rec.arg1 = read_varint_();
+        return true;
+    }
+};
+
+/**
+ * @brief A ds::vec that records every operation which changes its size or
+ * capacity to a trace_writer.
+ *
+ * Element values and reads are not recorded, only the shape of the workload,
+ * so traces stay small and can be replayed against other containers and
+ * growth policies with the `libds_replay` tool. Operations are recorded once
+ * they returned, so ones that throw are left out.
+ *
+ * @tparam T The type of data this vector will hold.
+ */
+template <class T>
+class traced_vec {
+ public:
+    using value_type = typename vec<T>::value_type;
+    using size_type = typename vec<T>::size_type;
+    using iterator = typename vec<T>::iterator;
+    using const_iterator = typename vec<T>::const_iterator;
+
+ private:
+    trace_writer* writer_;
+    std::uint64_t id_;
+    vec<T> vec_;
+
+    inline void
+    record_(trace_op op, std::uint64_t arg0 = 0, std::uint64_t arg1 = 0)
+    {
+        writer_->write({op, id_, arg0, arg1});
+    }
+
+    inline void
+    record_create_()
+    {
+        record_(trace_op::create, vec_.capacity(), sizeof(T));
+    }
+
+ public:
+#pragma region "Constructors/Destructors and assignment operators"
+
+    /**
+     * @brief Construct an empty vector, recording to @p writer.
+     *
+     * @param writer Where to record operations; must outlive this vector.
+     */
+    explicit traced_vec(trace_writer& writer) :
+        writer_(&writer), id_(writer.new_id())
+    {
+        record_create_();
+    }
+
+    /**
+     * @brief Construct an empty vector with a given capacity.
+     *
+     * @param writer Where to record operations; must outlive this vector.
+     * @param capacity How many elements the vector can hold initially.
+     */
+    traced_vec(trace_writer& writer, size_type capacity) :
+        writer_(&writer), id_(writer.new_id()), vec_(capacity)
+    {
+        record_create_();
+    }
+
+    /**
+     * @brief Construct a vector of @p size copies of @p elem.
+     *
+     * @param writer Where to record operations; must outlive this vector.
+     * @param size The size of the vector.
+     * @param elem The element to fill the vector with.
+     */
+    traced_vec(trace_writer& writer, size_type size, T elem) :
+        writer_(&writer), id_(writer.new_id()), vec_(size, std::move(elem))
+    {
+        record_create_();
+        record_(trace_op::insert, 0, size);
+    }
+
+    /**
+     * @brief Construct a vector from an initializer list.
+     *
+     * @param writer Where to record operations; must outlive this vector.
+     * @param init The initializer list with vector elements.
+     */
+    traced_vec(trace_writer& writer, std::initializer_list<T> init) :
+        writer_(&writer), id_(writer.new_id()), vec_(init)
+    {
+        record_create_();
+        record_(trace_op::insert, 0, init.size());
+    }
+
+    /**
+     * @brief Copy constructor. The copy gets its own id.
+     */
+    traced_vec(const traced_vec& other) :
+        writer_(other.writer_), id_(other.writer_->new_id()), vec_(other.vec_)
+    {
+        record_(trace_op::copy, other.id_);
+    }
+
+    /**
+     * @brief Move constructor. The new vector gets its own id.
+     */
+    traced_vec(traced_vec&& other) noexcept :
+        writer_(other.writer_), id_(other.writer_->new_id()), vec_(std::move(other.vec_))
+    {
+        try {
+            record_(trace_op::move, other.id_);
+        } catch (...) { // NOLINT(bugprone-empty-catch): tracing is best-effort
+        }
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     */
+    traced_vec&
+    operator=(const traced_vec& other)
+    {
+        if (this == &other)
+            return *this;
+
+        vec_ = other.vec_;
+        record_(trace_op::assign, other.id_);
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     */
+    traced_vec&
+    operator=(traced_vec&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        vec_ = std::move(other.vec_);
+        try {
+            record_(trace_op::move_assign, other.id_);
+        } catch (...) { // NOLINT(bugprone-empty-catch): tracing is best-effort
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destroy the vector, recording its destruction.
+     */
+    ~traced_vec() noexcept
+    {
+        try {
+            record_(trace_op::destroy);
+        } catch (...) { // NOLINT(bugprone-empty-catch): tracing is best-effort
+        }
+    }
+
+#pragma endregion
+
+#pragma region "Accessors"
+
+    /**
+     * @brief Get the id of this vector in the trace.
+     *
+     * @return std::uint64_t The id.
+     */
+    [[nodiscard]] inline std::uint64_t
+    trace_id() const noexcept
+    {
+        return id_;
+    }
+
+    /**
+     * @brief Get read-only access to the traced vector.
+     *
+     * @return const vec<T>& The vector.
+     */
+    [[nodiscard]] inline const vec<T>&
+    get() const noexcept
+    {
+        return vec_;
+    }
+
+    /**
+     * @brief Forwards to vec::operator[]().
+     */
+    [[nodiscard]] inline T&
+    operator[](size_type pos) noexcept
+    {
+        return vec_[pos];
+    }
+
+    /**
+     * @brief Forwards to vec::operator[]().
+     */
+    [[nodiscard]] inline const T&
+    operator[](size_type pos) const noexcept
+    {
+        return vec_[pos];
+    }
+
+    /**
+     * @brief Forwards to vec::at().
+     */
+    [[nodiscard]] inline T&
+    at(size_type pos)
+    {
+        return vec_.at(pos);
+    }
+
+    /**
+     * @brief Forwards to vec::at().
+     */
+    [[nodiscard]] inline const T&
+    at(size_type pos) const
+    {
+        return vec_.at(pos);
+    }
+
+    /**
+     * @brief Forwards to vec::data().
+     */
+    [[nodiscard]] inline T*
+    data() noexcept
+    {
+        return vec_.data();
+    }
+
+    /**
+     * @brief Forwards to vec::data().
+     */
+    [[nodiscard]] inline const T*
+    data() const noexcept
+    {
+        return vec_.data();
+    }
+
+    /**
+     * @brief Forwards to vec::begin().
+     */
+    [[nodiscard]] inline iterator
+    begin() noexcept
+    {
+        return vec_.begin();
+    }
+
+    /**
+     * @brief Forwards to vec::begin().
+     */
+    [[nodiscard]] inline const_iterator
+    begin() const noexcept
+    {
+        return vec_.begin();
+    }
+
+    /**
+     * @brief Forwards to vec::end().
+     */
+    [[nodiscard]] inline iterator
+    end() noexcept
+    {
+        return vec_.end();
+    }
+
+    /**
+     * @brief Forwards to vec::end().
+     */
+    [[nodiscard]] inline const_iterator
+    end() const noexcept
+    {
+        return vec_.end();
+    }
+
+#pragma endregion
+
+#pragma region "Capacity"
+
+    /**
+     * @brief Forwards to vec::empty().
+     */
+    [[nodiscard]] inline bool
+    empty() const noexcept
+    {
+        return vec_.empty();
+    }
+
+    /**
+     * @brief Forwards to vec::size().
+     */
+    [[nodiscard]] inline size_type
+    size() const noexcept
+    {
+        return vec_.size();
+    }
+
+    /**
+     * @brief Forwards to vec::capacity().
+     */
+    [[nodiscard]] inline size_type
+    capacity() const noexcept
+    {
+        return vec_.capacity();
+    }
+
+    /**
+     * @brief Forwards to vec::reserve() and records the operation.
+     */
+    inline void
+    reserve(size_type new_cap)
+    {
+        vec_.reserve(new_cap);
+        record_(trace_op::reserve, new_cap);
+    }
+
+    /**
+     * @brief Forwards to vec::shrink_to_fit() and records the operation.
+     */
+    inline void
+    shrink_to_fit()
+    {
+        vec_.shrink_to_fit();
+        record_(trace_op::shrink);
+    }
+
+#pragma endregion
+
+#pragma region "Modifiers"
+
+    /**
+     * @brief Forwards to vec::clear() and records the operation.
+     */
+    inline void
+    clear()
+    {
+        vec_.clear();
+        record_(trace_op::clear);
+    }
+
+    /**
+     * @brief Forwards to vec::insert() and records the operation.
+     */
+    inline iterator
+    insert(size_type pos, const T& elem)
+    {
+        auto it = vec_.insert(pos, elem);
+        record_(trace_op::insert, pos, 1);
+        return it;
+    }
+
+    /**
+     * @brief Forwards to vec::insert() and records the operation.
+     */
+    inline iterator
+    insert(size_type pos, T&& elem)
+    {
+        auto it = vec_.insert(pos, std::move(elem));
+        record_(trace_op::insert, pos, 1);
+        return it;
+    }
+
+    /**
+     * @brief Forwards to vec::insert() and records the operation.
+     */
+    inline iterator
+    insert(size_type pos, size_type count, const T& elem)
+    {
+        auto it = vec_.insert(pos, count, elem);
+        record_(trace_op::insert, pos, count);
+        return it;
+    }
+
+    /**
+     * @brief Forwards to vec::insert() and records the operation.
+     */
+    inline iterator
+    insert(size_type pos, std::initializer_list<T> elems)
+    {
+        auto it = vec_.insert(pos, elems);
+        record_(trace_op::insert, pos, elems.size());
+        return it;
+    }
+
+    /**
+     * @brief Forwards to vec::emplace() and records it as an insertion.
+     */
+    template <class... Args>
+    inline iterator
+    emplace(size_type pos, Args&&... args)
+    {
+        auto it = vec_.emplace(pos, std::forward<Args>(args)...);
+        record_(trace_op::insert, pos, 1);
+        return it;
+    }
+
+    /**
+     * @brief Forwards to vec::erase() and records the operation.
+     */
+    inline iterator
+    erase(size_type pos, size_type count = 1)
+    {
+        auto it = vec_.erase(pos, count);
+        record_(trace_op::erase, pos, count);
+        return it;
+    }
+
+    /**
+     * @brief Forwards to vec::pop_back() and records it as an erasure.
+     */
+    inline void
+    pop_back()
+    {
+        const size_type pos = vec_.size() - 1;
+        vec_.pop_back();
+        record_(trace_op::erase, pos, 1);
+    }
+
+    /**
+     * @brief Forwards to vec::resize() and records the operation.
+     */
+    inline void
+    resize(size_type count)
+    {
+        vec_.resize(count);
+        record_(trace_op::resize, count);
+    }
+
+    /**
+     * @brief Forwards to vec::resize() and records the operation.
+     */
+    inline void
+    resize(size_type count, const T& elem, size_type threads = 1)
+    {
+        vec_.resize(count, elem, threads);
+        record_(trace_op::resize, count);
+    }
+
+    /**
+     * @brief Forwards to vec::resize_for_overwrite() and records it as a resize.
+     */
+    inline void
+    resize_for_overwrite(size_type count)
+    {
+        vec_.resize_for_overwrite(count);
+        record_(trace_op::resize, count);
+    }
+
+#pragma endregion
+};
+
+} // namespace ds
+
+#endif // LIBDS_TRACE_HPP
@@ -0,0 +1,406 @@
+/**
+ * @file unique.hpp
+ * @author Nino Maruszewski (nino.maruszewski@gmail.com)
+ * @brief In-place deduplication and partitioning of ds::vec elements.
+ * @version 0.1
+ * @date 2022-12-18
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Nino Maruszewski
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LIBDS_UNIQUE_HPP
+#define LIBDS_UNIQUE_HPP
+
+#include "libds/bulk.hpp"
+#include "libds/detail/simd.hpp"
+#include "libds/vec.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ds {
+
+namespace detail {
+
+/**
+ * @brief Whether @p Equal is `std::equal_to` on @p T.
+ */
+template <class Equal, class T>
+inline constexpr bool IS_EQUAL_TO =
+    std::is_same_v<Equal, std::equal_to<>> || std::is_same_v<Equal, std::equal_to<T>>;
+
+/**
+ * @brief Whether @p Compare is `std::less` on @p T.
+ */
+template <class Compare, class T>
+inline constexpr bool IS_LESS =
+    std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>;
+
+/**
+ * @brief Whether unique() has a SIMD kernel for @p T.
+ */
+template <class T>
+inline constexpr bool IS_SIMD_UNIQUE =
+    std::is_arithmetic_v<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+#ifdef LIBDS_HAS_X86_DISPATCH
+/**
+ * @brief Remove consecutive equal elements from the @p n elements at @p data,
+ * with AVX2 stream compaction.
+ *
+ * Each vector of elements is compared with itself shifted by one lane, and the
+ * elements that differ from their predecessor are packed to the front with one
+ * permutation, stored unconditionally, and counted in. So there are no branches
+ * on the data, however the duplicates are spread out.
+ *
+ * @param data The elements, at least one.
+ * @param n How many elements there are.
+ * @return std::size_t How many elements are left.
+ */
+template <class T>
+LIBDS_TARGET_AVX2 inline std::size_t
+unique_avx2(T* data, std::size_t n) noexcept
+{
+    constexpr std::size_t LANES = 32 / sizeof(T);
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    std::size_t out = 1;
+    std::size_t i = 1;
+    T last = data[0];
+    __m256i prev{};
+    if constexpr (sizeof(T) == 4) {
+        std::int32_t bits = 0;
+        std::memcpy(&bits, &last, sizeof(T));
+        prev = _mm256_set1_epi32(bits);
+    } else {
+        std::int64_t bits = 0;
+        std::memcpy(&bits, &last, sizeof(T));
+        prev = _mm256_set1_epi64x(bits);
+    }
+
+    for (; i + LANES <= n; i += LANES) {
+        const auto* from = reinterpret_cast<const __m256i*>(data + i);
+        const __m256i cur = _mm256_loadu_si256(from);
+        last = data[i + LANES - 1];
+
+        // The previous element of every lane: [prev[last], cur[0], ..., cur[-2]]
+        int dup = 0;
+        unsigned keep = 0;
+        __m256i order{};
+        if constexpr (sizeof(T) == 4) {
+            const __m256i rotate = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+            const __m256i shifted = _mm256_blend_epi32(
+                _mm256_permutevar8x32_epi32(cur, rotate),
+                _mm256_permutevar8x32_epi32(prev, rotate), 0x01
+            );
+            if constexpr (std::is_floating_point_v<T>) {
+                dup = _mm256_movemask_ps(_mm256_cmp_ps(
+                    _mm256_castsi256_ps(cur), _mm256_castsi256_ps(shifted), _CMP_EQ_OQ
+                ));
+            } else {
+                const __m256i eq = _mm256_cmpeq_epi32(cur, shifted);
+                dup = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+            }
+            keep = ~static_cast<unsigned>(dup) & 0xFFU;
+            order = _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+                reinterpret_cast<const __m128i*>(&COMPRESS_32[keep])
+            ));
+        } else {
+            // 0x93 moves lane 3 to lane 0, and lanes 0 to 2 up by one
+            const __m256i shifted = _mm256_blend_epi32(
+                _mm256_permute4x64_epi64(cur, 0x93),
+                _mm256_permute4x64_epi64(prev, 0x93), 0x03
+            );
+            if constexpr (std::is_floating_point_v<T>) {
+                dup = _mm256_movemask_pd(_mm256_cmp_pd(
+                    _mm256_castsi256_pd(cur), _mm256_castsi256_pd(shifted), _CMP_EQ_OQ
+                ));
+            } else {
+                const __m256i eq = _mm256_cmpeq_epi64(cur, shifted);
+                dup = _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+            }
+            keep = ~static_cast<unsigned>(dup) & 0xFU;
+            order = _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+                reinterpret_cast<const __m128i*>(&COMPRESS_64[keep])
+            ));
+        }
+
+        // Writes past the kept elements only hit elements that were loaded already
+        const __m256i packed = _mm256_permutevar8x32_epi32(cur, order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + out), packed);
+        out += static_cast<std::size_t>(_mm_popcnt_u32(keep));
+        prev = cur;
+    }
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    for (; i < n; i++) {
+        const T elem = data[i];
+        data[out] = elem;
+        out += static_cast<std::size_t>(!std::equal_to<>{}(elem, last));
+        last = elem;
+    }
+    return out;
+}
+#endif
+
+/**
+ * @brief Remove consecutive equivalent elements from the @p n elements at
+ * @p data, keeping the first of each run.
+ *
+ * @param data The elements, at least one.
+ * @param n How many elements there are.
+ * @param eq The equivalence relation.
+ * @return std::size_t How many elements are left.
+ */
+template <class T, class Equal>
+inline std::size_t
+unique_scalar(T* data, std::size_t n, Equal& eq)
+{
+    std::size_t out = 1;
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        // Copy every element, and only count the ones to keep: no branches
+        for (std::size_t i = 1; i < n; i++) {
+            const T elem = data[i];
+            const bool dup = eq(data[out - 1], elem);
+            data[out] = elem;
+            out += static_cast<std::size_t>(!dup);
+        }
+    } else {
+        for (std::size_t i = 1; i < n; i++) {
+            if (eq(data[out - 1], data[i]))
+                continue;
+            if (out != i)
+                data[out] = std::move(data[i]);
+            out++;
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Deleter for scratch buffers from std::malloc().
+ */
+struct free_deleter {
+    void
+    operator()(void* ptr) const noexcept
+    {
+        std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Remove consecutive equivalent elements from @p v, keeping the first of
+ * each run (like `std::unique()` followed by an erase).
+ *
+ * Elements are moved at most once, to their final place. 4 and 8 byte numbers
+ * compared with `std::equal_to` are compacted with AVX2 where the CPU has it;
+ * other trivially copyable elements are compacted without branches. Neither
+ * depends on how many duplicates there are.
+ *
+ * @param v The vector.
+ * @param eq The equivalence relation. Defaults to `std::equal_to<>`.
+ * @return std::size_t How many elements were removed.
+ */
+template <class T, std::size_t A, class Equal = std::equal_to<>>
+inline std::size_t
+unique(vec<T, A>& v, Equal eq = {})
+{
+    const std::size_t n = v.size();
+    if (n < 2)
+        return 0;
+
+#ifdef LIBDS_HAS_X86_DISPATCH
+    if constexpr (detail::IS_SIMD_UNIQUE<T> && detail::IS_EQUAL_TO<Equal, T>) {
+        if (detail::has_avx2()) {
+            const std::size_t kept = detail::unique_avx2(v.data(), n);
+            v.erase(kept, n - kept);
+            return n - kept;
+        }
+    }
+#endif
+
+    const std::size_t kept = detail::unique_scalar(v.data(), n, eq);
+    v.erase(kept, n - kept);
+    return n - kept;
+}
+
+/**
+ * @brief Sort @p v and remove its duplicates, leaving each distinct element
+ * once, in order.
+ *
+ * @param v The vector.
+ * @param cmp The order. Defaults to `std::less<>`.
+ * @return std::size_t How many elements were removed.
+ */
+template <class T, std::size_t A, class Compare = std::less<>>
+inline std::size_t
+sort_unique(vec<T, A>& v, Compare cmp = {})
+{
+    std::sort(v.begin(), v.end(), cmp);
+    if constexpr (std::is_arithmetic_v<T> && detail::IS_LESS<Compare, T>) {
+        return unique(v);
+    } else {
+        // Sorted, so neighbours are equivalent when the first is not less
+        return unique(v, [&](const T& lhs, const T& rhs) { return !cmp(lhs, rhs); });
+    }
+}
+
+/**
+ * @brief Reorder @p v so that the elements satisfying @p pred come first.
+ *
+ * The relative order of the elements is not kept. Only misplaced elements are
+ * moved, once each (plus two moves for the first one), by filling a hole
+ * alternately from either end instead of swapping pairs. If @p pred throws,
+ * every element is still in @p v, in an unspecified order.
+ *
+ * @param v The vector.
+ * @param pred The predicate.
+ * @return std::size_t How many elements satisfy @p pred, i.e. where the
+ * second group starts.
+ */
+template <class T, std::size_t A, class Pred>
+inline std::size_t
+partition(vec<T, A>& v, Pred pred)
+{
+    T* data = v.data();
+    std::size_t lo = 0;
+    std::size_t hi = v.size();
+    while (lo < hi && pred(data[lo]))
+        lo++;
+    if (lo == hi)
+        return lo;
+
+    // [0, lo) satisfy pred, [hi, n) do not, and there is a hole at lo or hi
+    T hole(std::move(data[lo]));
+    std::size_t at = lo;
+    try {
+        for (;;) {
+            do {
+                hi--;
+            } while (hi > lo && !pred(data[hi]));
+            if (hi == lo)
+                break;
+            data[lo] = std::move(data[hi]);
+            at = hi;
+
+            do {
+                lo++;
+            } while (lo < hi && pred(data[lo]));
+            if (lo == hi)
+                break;
+            data[hi] = std::move(data[lo]);
+            at = lo;
+        }
+    } catch (...) {
+        data[at] = std::move(hole);
+        throw;
+    }
+    data[at] = std::move(hole);
+    return lo;
+}
+
+/**
+ * @brief Reorder @p v so that the elements satisfying @p pred come first,
+ * keeping the relative order within both groups.
+ *
+ * One pass moves the matching elements forward in place and the others into a
+ * scratch buffer, which is then copied back behind them; trivially copyable
+ * elements are copied to both places without branching on @p pred. If @p pred
+ * throws, every element is still in @p v, in an unspecified order.
+ *
+ * @param v The vector.
+ * @param pred The predicate.
+ * @return std::size_t How many elements satisfy @p pred, i.e. where the
+ * second group starts.
+ */
+template <class T, std::size_t A, class Pred>
+inline std::size_t
+stable_partition(vec<T, A>& v, Pred pred)
+{
+    T* data = v.data();
+    const std::size_t n = v.size();
+    std::size_t kept = 0;
+    std::size_t rejected = 0;
+
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+        std::unique_ptr<void, detail::free_deleter> raw(std::malloc(n * sizeof(T)));
+        if (raw == nullptr && n > 0)
+            throw std::bad_alloc();
+        T* scratch = static_cast<T*>(raw.get());
+
+        try {
+            for (std::size_t i = 0; i < n; i++) {
+                const T elem = data[i];
+                const bool match = pred(elem);
+                data[kept] = elem;
+                scratch[rejected] = elem;
+                kept += static_cast<std::size_t>(match);
+                rejected += static_cast<std::size_t>(!match);
+            }
+        } catch (...) {
+            std::memcpy(data + kept, scratch, rejected * sizeof(T));
+            throw;
+        }
+        bulk_copy(data + kept, scratch, rejected * sizeof(T));
+    } else {
+        // Reserved up front, so moving into it cannot fail halfway
+        vec<T> scratch(n);
+        auto restore = [&] {
+            for (std::size_t i = 0; i < scratch.size(); i++)
+                data[kept + i] = std::move(scratch[i]);
+        };
+
+        try {
+            for (std::size_t i = 0; i < n; i++) {
+                if (pred(data[i])) {
+                    if (kept != i)
+                        data[kept] = std::move(data[i]);
+                    kept++;
+                } else {
+                    scratch.emplace(scratch.size(), std::move(data[i]));
+                }
+            }
+        } catch (...) {
+            restore();
+            throw;
+        }
+        restore();
+    }
+    return kept;
+}
+
+} // namespace ds
+
+#endif // LIBDS_UNIQUE_HPP
@@ -31,11 +31,36 @@
 #ifndef LIBDS_VEC_HPP
 #define LIBDS_VEC_HPP
 
+#include "libds/bulk.hpp"
+#include "libds/detail/aligned_alloc.hpp"
+#include "libds/detail/parallel.hpp"
+#include "libds/detail/relocate.hpp"
+#include "libds/probes.hpp"
+#include "libds/span.hpp"
+
+#ifdef LIBDS_REGISTRY
+#  include "libds/live.hpp"
+#endif
+
+#ifdef LIBDS_STATS
+#  include "libds/stats.hpp"
+#  define LIBDS_VEC_STATS_(event, count) ::ds::stats::event<T>(count)
+#  define LIBDS_VEC_STATS_FREE_() ::ds::stats::record_free<T>()
+#else
+#  define LIBDS_VEC_STATS_(event, count) static_cast<void>(0)
+#  define LIBDS_VEC_STATS_FREE_() static_cast<void>(0)
+#endif
+
+#include <cstddef>
 #include <cstdlib>
 #include <cstring>
 
+#include <initializer_list>
+#include <memory>
+#include <new>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 /**
@@ -48,11 +73,29 @@ namespace ds {
 /**
  * @brief An auto-resizing vector (i.e., a dynamic array).
  *
+ * The buffer is aligned to @p Alignment bytes. Up to `alignof(std::max_align_t)`
+ * it comes from malloc() and grows with realloc(); larger alignments (e.g. 64,
+ * for a cache line or an AVX-512 register) use an aligned allocation, and grow
+ * by allocating, copying and freeing. data(), begin() and end() tell the
+ * compiler about the alignment, so loops over them can use aligned SIMD loads.
+ *
  * @tparam T The type of data this vector will hold.
+ * @tparam Alignment The alignment of the buffer, a power of two. Defaults to
+ * `alignof(T)`.
  */
-template <class T>
+template <class T, std::size_t Alignment>
 class vec {
+    static_assert(
+        (Alignment & (Alignment - 1)) == 0 && Alignment >= alignof(T),
+        "vec: the alignment must be a power of two, and at least alignof(T)"
+    );
+
  public:
+    /**
+     * @brief The type of the stored elements.
+     */
+    using value_type = T;
+
     /**
      * @brief Unsigned integer type used for indicies.
      */
@@ -73,8 +116,22 @@ class vec {
     size_type capacity_;
     T* data_;
 
+#ifdef LIBDS_REGISTRY
+    live::entry live_{this, &live::OPS_FOR<vec>};
+#endif
+
     static constexpr size_type INITIAL_CAPACITY = 10;
 
+    /**
+     * @brief Whether elements can be moved around with plain memory copies.
+     */
+    static constexpr bool TRIVIALLY_RELOCATABLE = detail::IS_TRIVIALLY_RELOCATABLE<T>;
+
+    /**
+     * @brief Whether the buffer needs more alignment than malloc() guarantees.
+     */
+    static constexpr bool OVER_ALIGNED = detail::IS_OVER_ALIGNED<Alignment>;
+
 #pragma region "Helpers"
 
     /**
@@ -95,6 +152,43 @@ class vec {
         return cap + (cap >> 1);
     }
 
+    /**
+     * @brief Allocate memory, without recording it anywhere.
+     *
+     * @param cap The amount of elements this should be able to hold.
+     * @return A pointer to the (uninitialized) buffer.
+     */
+    [[nodiscard]] static inline T*
+    raw_alloc_(size_type cap)
+    {
+        T* ptr = nullptr;
+        if constexpr (OVER_ALIGNED) {
+            ptr = static_cast<T*>(detail::aligned_malloc(cap * sizeof(T), Alignment));
+        } else {
+            // NOLINTNEXTLINE(cppcoreguidelines-no-malloc)
+            ptr = static_cast<T*>(std::malloc(cap * sizeof(T)));
+        }
+
+        if (ptr == nullptr)
+            throw std::runtime_error("vec: could not allocate memory");
+
+        return ptr;
+    }
+
+    /**
+     * @brief Free memory from raw_alloc_(), without recording it anywhere.
+     *
+     * @param ptr The buffer, or nullptr.
+     */
+    static inline void
+    raw_free_(T* ptr) noexcept
+    {
+        if constexpr (OVER_ALIGNED)
+            detail::aligned_free(ptr);
+        else
+            std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+    }
+
     /**
      * @brief Allocate memory
      *
@@ -107,14 +201,34 @@ class vec {
         if (cap == 0)
             return nullptr;
 
-        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc,modernize-use-auto)
-        auto* ptr = static_cast<T*>(std::malloc(cap * sizeof(T)));
-        if (ptr == nullptr)
-            throw std::runtime_error("vec: could not allocate memory");
+        T* ptr = raw_alloc_(cap);
 
+        LIBDS_VEC_STATS_(record_alloc, cap);
+        LIBDS_PROBE(vec_alloc, 0, cap, sizeof(T), 0);
         return ptr;
     }
 
+    /**
+     * @brief Take ownership of a new buffer that already holds our elements.
+     *
+     * The old buffer must already have been released.
+     *
+     * @param ptr The new buffer.
+     * @param new_cap The capacity of the new buffer.
+     */
+    inline void
+    adopt_(T* ptr, size_type new_cap) noexcept
+    {
+        if (data_ == nullptr)
+            LIBDS_VEC_STATS_(record_alloc, new_cap);
+        else
+            LIBDS_VEC_STATS_(record_realloc, new_cap);
+        LIBDS_PROBE(vec_resize, capacity_, new_cap, sizeof(T), size_ * sizeof(T));
+
+        data_ = ptr;
+        capacity_ = new_cap;
+    }
+
     /**
      * @brief Resize the internal data buffer.
      *
@@ -123,19 +237,25 @@ class vec {
     inline void
     resize_(size_type new_cap)
     {
-        if (new_cap == 0)
+        if (new_cap == 0) {
             free_();
+            capacity_ = 0;
+            return;
+        }
 
-        // NOLINTNEXTLINE(modernize-use-auto)
-        auto* ptr = static_cast<T*>(std::realloc( // NOLINT(cppcoreguidelines-no-malloc)
-            data_, new_cap * sizeof(T)
-        ));
+        if constexpr (TRIVIALLY_RELOCATABLE && !OVER_ALIGNED) {
+            // NOLINTNEXTLINE(cppcoreguidelines-no-malloc,modernize-use-auto)
+            auto* ptr = static_cast<T*>(std::realloc(data_, new_cap * sizeof(T)));
 
-        if (ptr == nullptr)
-            throw std::runtime_error("vec: could not allocate memory");
+            if (ptr == nullptr)
+                throw std::runtime_error("vec: could not allocate memory");
 
-        data_ = ptr;
-        capacity_ = new_cap;
+            adopt_(ptr, new_cap);
+        } else {
+            // realloc() would move the bytes behind the elements' backs, or lose
+            // the alignment
+            move_to_new_(new_cap, size_, 0);
+        }
     }
 
     /**
@@ -148,26 +268,98 @@ class vec {
         for (size_type i = 0; i < size_; i++)
             data_[i].~T();
 
-        std::free(data_); // NOLINT(cppcoreguidelines-no-malloc)
+        if (data_ != nullptr) {
+            LIBDS_VEC_STATS_FREE_();
+            LIBDS_PROBE(vec_free, capacity_, 0, sizeof(T), 0);
+        }
+
+        raw_free_(data_);
         data_ = nullptr;
     }
 
     /**
      * @brief Copy two buffers, templated to this class.
      *
-     * @param dest Where to copy to.
+     * Only valid for trivially copyable types, use relocate_() otherwise. Large
+     * copies bypass the cache (see ds::bulk_copy()).
+     *
+     * @param dest Where to copy to, which must not overlap @p src.
      * @param src Where to copy from.
      * @param size How many elements to copy.
      */
     inline void
-    copy_(T* dest, T* src, size_type size) const noexcept
+    copy_(T* dest, const T* src, size_type size) const noexcept
+    {
+        LIBDS_VEC_STATS_(record_copy, size);
+        bulk_copy(dest, src, size * sizeof(T));
+    }
+
+    /**
+     * @brief Move elements to another (possibly overlapping) place.
+     *
+     * Afterwards, @p dest holds the elements and @p src is uninitialized memory.
+     *
+     * @param dest Where to move the elements to.
+     * @param src Where to move the elements from.
+     * @param size How many elements to move.
+     */
+    inline void
+    relocate_(T* dest, T* src, size_type size) const
     {
-        std::memmove(dest, src, size * sizeof(T));
+        if (dest == src || size == 0)
+            return;
+
+        if constexpr (TRIVIALLY_RELOCATABLE) {
+            // Moves into a new buffer can bypass the cache
+            if (dest + size <= src || src + size <= dest) {
+                copy_(dest, src, size);
+                return;
+            }
+        }
+
+        LIBDS_VEC_STATS_(record_copy, size);
+        detail::relocate(dest, src, size);
+    }
+
+    /**
+     * @brief Move the elements into a new buffer, opening a gap on the way.
+     *
+     * Afterwards the elements before @p start are followed by @p places elements of
+     * uninitialized memory and the rest of the elements. If moving an element
+     * throws, the new buffer is freed again and this vector is left as it was.
+     *
+     * @param new_cap The capacity of the new buffer.
+     * @param start Where to open the gap.
+     * @param places How big the gap should be.
+     */
+    inline void
+    move_to_new_(size_type new_cap, size_type start, size_type places)
+    {
+        T* ptr = raw_alloc_(new_cap);
+
+        if constexpr (TRIVIALLY_RELOCATABLE) {
+            relocate_(ptr, data_, start);
+            relocate_(&ptr[start + places], &data_[start], size_ - start);
+        } else {
+            try {
+                LIBDS_VEC_STATS_(record_copy, size_);
+                detail::relocate_to_new(ptr, data_, size_, start, places);
+            } catch (...) {
+                raw_free_(ptr);
+                throw;
+            }
+        }
+
+        raw_free_(data_);
+        adopt_(ptr, new_cap);
     }
 
     /**
      * @brief Shift all elements from @p start to end() over @p places places.
      *
+     * The gap that is left behind is uninitialized memory, and must be constructed
+     * into (or closed again with unshift_()).
+     *
      * @param start Where to start shifting elements.
      * @param places How many places to shift the elements.
      */
@@ -179,14 +371,129 @@ class vec {
         while (size_ + places > new_cap)
             new_cap = next_capacity_(new_cap);
 
+        LIBDS_PROBE(
+            vec_shift, capacity_, new_cap, sizeof(T), (size_ - start) * sizeof(T)
+        );
+
+        if constexpr (!TRIVIALLY_RELOCATABLE) {
+            // Move everything straight to its final place in the new buffer, instead
+            // of moving the tail twice.
+            if (new_cap != capacity_) {
+                move_to_new_(new_cap, start, places);
+                size_ += places;
+                return;
+            }
+        }
+
         reserve(new_cap);
 
         // Shift elements down
-        copy_(&data_[start + places], &data_[start], size_ - start);
+        relocate_(&data_[start + places], &data_[start], size_ - start);
 
         size_ += places;
     }
 
+    /**
+     * @brief Close a gap opened by shift_() that could not be filled.
+     *
+     * @param start Where the gap starts.
+     * @param places How big the gap is.
+     * @param filled How many elements at the start of the gap were constructed.
+     */
+    inline void
+    unshift_(size_type start, size_type places, size_type filled)
+    {
+        for (size_type i = 0; i < filled; i++)
+            data_[start + i].~T();
+
+        relocate_(&data_[start], &data_[start + places], size_ - start - places);
+        size_ -= places;
+    }
+
+    /**
+     * @brief Copy the elements of @p other onto the end of this vector.
+     *
+     * There must be enough capacity for them already.
+     *
+     * @param other The vector to copy the elements from.
+     */
+    inline void
+    append_copy_(const vec& other)
+    {
+        if constexpr (TRIVIALLY_RELOCATABLE) {
+            copy_(&data_[size_], other.data_, other.size_);
+            size_ += other.size_;
+        } else {
+            LIBDS_VEC_STATS_(record_copy, other.size_);
+            for (size_type i = 0; i < other.size_; i++, size_++)
+                ::new (static_cast<void*>(&data_[size_])) T(other.data_[i]);
+        }
+    }
+
+    /**
+     * @brief Construct elements into a gap opened by shift_().
+     *
+     * If a constructor throws, the gap is closed again and the exception propagates.
+     *
+     * @tparam Construct Callable as `construct(T* where, size_type index)`.
+     * @param start Where the gap starts.
+     * @param places How big the gap is.
+     * @param construct Constructs the element at index @p index of the gap.
+     */
+    template <class Construct>
+    inline void
+    fill_gap_(size_type start, size_type places, Construct construct)
+    {
+        size_type i = 0;
+        try {
+            for (; i < places; i++)
+                construct(&data_[start + i], i);
+        } catch (...) {
+            unshift_(start, places, i);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Copy-construct @p elem into a gap opened by shift_(), split over
+     * @p threads threads.
+     *
+     * Each thread constructs one contiguous run of elements, so each run's pages
+     * are first touched (and, under the default NUMA policy, allocated) on the
+     * node of the thread that will usually work on them. Elements that can throw
+     * while being copied are constructed on the calling thread only. Large fills
+     * of small, trivially copyable elements bypass the cache (see ds::bulk_fill()).
+     *
+     * @param start Where the gap starts.
+     * @param places How big the gap is.
+     * @param elem The element to copy, which must not be inside the gap.
+     * @param threads How many threads to construct with.
+     */
+    inline void
+    fill_gap_parallel_(
+        size_type start, size_type places, const T& elem, size_type threads
+    )
+    {
+        if constexpr (std::is_trivially_copyable_v<T> && 16 % sizeof(T) == 0) {
+            if (places * sizeof(T) >= stream_threshold()) {
+                bulk_fill(&data_[start], &elem, sizeof(T), places, threads);
+                return;
+            }
+        }
+
+        if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+            auto fill = [&](size_type first, size_type last) {
+                for (; first < last; first++)
+                    ::new (static_cast<void*>(&data_[start + first])) T(elem);
+            };
+            detail::parallel_chunks(places, threads, fill);
+        } else {
+            fill_gap_(start, places, [&](T* where, size_type) {
+                ::new (static_cast<void*>(where)) T(elem);
+            });
+        }
+    }
+
 #pragma endregion
 
  public:
@@ -204,14 +511,23 @@ class vec {
     /**
      * @brief Construct a new vec object with specified size, filled with elements.
      *
+     * With more than one thread, each thread fills (and so first-touches) one
+     * contiguous part of the buffer; see resize().
+     *
      * @param size The size of the vec.
      * @param elem The element to fill the vector with
+     * @param threads How many threads to fill the vector with.
      */
-    explicit vec(size_type size, T elem) :
-        size_(size), capacity_(size), data_(alloc_(capacity_))
+    explicit vec(size_type size, T elem, size_type threads = 1) :
+        size_(0), capacity_(size), data_(alloc_(capacity_))
     {
-        for (size_type i = 0; i < size_; i++)
-            data_[i] = elem;
+        try {
+            size_ = size;
+            fill_gap_parallel_(0, size, elem, threads);
+        } catch (...) {
+            free_();
+            throw;
+        }
     }
 
     /**
@@ -220,12 +536,17 @@ class vec {
      * @param init The initializer list with vector elements.
      */
     vec(std::initializer_list<T> init) :
-        size_(init.size()), capacity_(init.size()), data_(alloc_(capacity_))
+        size_(0), capacity_(init.size()), data_(alloc_(capacity_))
     {
         auto init_data = std::data(init);
-        for (size_type i = 0; i < init.size(); i++) {
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-            data_[i] = init_data[i];
+        try {
+            for (; size_ < init.size(); size_++) {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                ::new (static_cast<void*>(&data_[size_])) T(init_data[size_]);
+            }
+        } catch (...) {
+            free_();
+            throw;
         }
     }
 
@@ -235,9 +556,14 @@ class vec {
      * @param other The vector to copy to this one.
      */
     vec(const vec& other) :
-        size_(other.size_), capacity_(other.capacity_), data_(alloc_(capacity_))
+        size_(0), capacity_(other.capacity_), data_(alloc_(capacity_))
     {
-        copy_(data_, other.data_, capacity_);
+        try {
+            append_copy_(other);
+        } catch (...) {
+            free_();
+            throw;
+        }
     }
 
     /**
@@ -264,13 +590,13 @@ class vec {
         if (this == &other)
             return *this;
 
+        clear();
+
         // Check if we can reuse our array
         if (capacity_ < other.size_)
             resize_(other.size_);
 
-        size_ = other.size_;
-
-        copy_(data_, other.data_, capacity_);
+        append_copy_(other);
         return *this;
     }
 
@@ -423,8 +749,7 @@ class vec {
     [[nodiscard]] inline T*
     data() noexcept
     {
-        // We still own the data, by the definition of this fn
-        return static_cast<T*>(data_);
+        return detail::assume_aligned<Alignment>(data_);
     }
 
     /**
@@ -437,8 +762,7 @@ class vec {
     [[nodiscard]] inline const T*
     data() const noexcept
     {
-        // We still own the data, by the definition of this fn
-        return static_cast<T*>(data_);
+        return detail::assume_aligned<Alignment>(data_);
     }
 
 #pragma endregion
@@ -519,8 +843,7 @@ class vec {
     [[nodiscard]] inline iterator
     begin() noexcept
     {
-        // We still own the data, by the definition of this fn
-        return static_cast<T*>(data_);
+        return data();
     }
 
     /**
@@ -531,8 +854,7 @@ class vec {
     [[nodiscard]] inline const_iterator
     begin() const noexcept
     {
-        // We still own the data, by the definition of this fn
-        return static_cast<T*>(data_);
+        return data();
     }
 
     /**
@@ -543,7 +865,7 @@ class vec {
     [[nodiscard]] inline iterator
     end() noexcept
     {
-        return data_ + size_;
+        return data() + size_;
     }
 
     /**
@@ -554,7 +876,122 @@ class vec {
     [[nodiscard]] inline const_iterator
     end() const noexcept
     {
-        return data_ + size_;
+        return data() + size_;
+    }
+
+#pragma endregion
+
+#pragma region "Views"
+
+    /**
+     * @brief View @p count elements starting at @p first, without copying.
+     *
+     * The view is invalidated when this vector reallocates.
+     *
+     * @param first The position of the first viewed element.
+     * @param count How many elements to view.
+     * @exception std::out_of_range The slice does not fit in this vector.
+     * @return span<T> The subview.
+     */
+    [[nodiscard]] inline span<T>
+    slice(size_type first, size_type count)
+    {
+        return span<T>(*this).slice(first, count);
+    }
+
+    /**
+     * @brief View @p count elements starting at @p first, without copying.
+     *
+     * The view is invalidated when this vector reallocates.
+     *
+     * @param first The position of the first viewed element.
+     * @param count How many elements to view.
+     * @exception std::out_of_range The slice does not fit in this vector.
+     * @return span<const T> The subview.
+     */
+    [[nodiscard]] inline span<const T>
+    slice(size_type first, size_type count) const
+    {
+        return span<const T>(*this).slice(first, count);
+    }
+
+    /**
+     * @brief Split this vector into two views at position @p pos.
+     *
+     * @param pos Where to split the vector.
+     * @exception std::out_of_range @p pos is greater than size().
+     * @return std::pair<span<T>, span<T>> Views of `[0, pos)` and `[pos, size())`.
+     */
+    [[nodiscard]] inline std::pair<span<T>, span<T>>
+    split_at(size_type pos)
+    {
+        return span<T>(*this).split_at(pos);
+    }
+
+    /**
+     * @brief Split this vector into two views at position @p pos.
+     *
+     * @param pos Where to split the vector.
+     * @exception std::out_of_range @p pos is greater than size().
+     * @return std::pair<span<const T>, span<const T>> Views of `[0, pos)` and
+     * `[pos, size())`.
+     */
+    [[nodiscard]] inline std::pair<span<const T>, span<const T>>
+    split_at(size_type pos) const
+    {
+        return span<const T>(*this).split_at(pos);
+    }
+
+    /**
+     * @brief Iterate over non-overlapping views of @p size elements.
+     *
+     * @param size How many elements each chunk views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return chunk_range<T> A range of spans.
+     */
+    [[nodiscard]] inline chunk_range<T>
+    chunks(size_type size)
+    {
+        return span<T>(*this).chunks(size);
+    }
+
+    /**
+     * @brief Iterate over non-overlapping views of @p size elements.
+     *
+     * @param size How many elements each chunk views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return chunk_range<const T> A range of spans.
+     */
+    [[nodiscard]] inline chunk_range<const T>
+    chunks(size_type size) const
+    {
+        return span<const T>(*this).chunks(size);
+    }
+
+    /**
+     * @brief Iterate over all overlapping views of @p size elements.
+     *
+     * @param size How many elements each window views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return window_range<T> A range of spans.
+     */
+    [[nodiscard]] inline window_range<T>
+    windows(size_type size)
+    {
+        return span<T>(*this).windows(size);
+    }
+
+    /**
+     * @brief Iterate over all overlapping views of @p size elements.
+     *
+     * @param size How many elements each window views.
+     * @exception std::invalid_argument @p size is zero.
+     * @return window_range<const T> A range of spans.
+     */
+    [[nodiscard]] inline window_range<const T>
+    windows(size_type size) const
+    {
+        return span<const T>(*this).windows(size);
     }
 
 #pragma endregion
@@ -571,9 +1008,45 @@ class vec {
     inline void
     clear() noexcept
     {
+        for (size_type i = 0; i < size_; i++)
+            data_[i].~T();
+
         size_ = 0;
     }
 
+    /**
+     * @brief Construct an element in place at position @p pos.
+     *
+     * The element is constructed from @p args directly in the vector when
+     * appending with spare capacity. Otherwise it is constructed first and then
+     * moved into the gap, so @p args may safely refer to elements of this vector.
+     * Can insert one past the end of the vector (at size());
+     *
+     * @tparam Args The types of the constructor arguments.
+     * @param pos The position to insert the element in (zero indexed).
+     * @param args The arguments to construct the element from.
+     * @return An iterator pointing to the new element.
+     */
+    template <class... Args>
+    inline iterator
+    emplace(size_type pos, Args&&... args)
+    {
+        if (pos == size_ && size_ < capacity_) {
+            ::new (static_cast<void*>(&data_[pos])) T(std::forward<Args>(args)...);
+            size_++;
+
+            return data_ + pos;
+        }
+
+        T elem(std::forward<Args>(args)...);
+        shift_(pos, 1);
+        fill_gap_(pos, 1, [&](T* where, size_type) {
+            ::new (static_cast<void*>(where)) T(std::move(elem));
+        });
+
+        return data_ + pos;
+    }
+
     /**
      * @brief Insert an element @p elem at position @p pos.
      *
@@ -587,10 +1060,7 @@ class vec {
     inline iterator
     insert(size_type pos, const T& elem)
     {
-        shift_(pos, 1);
-        data_[pos] = elem;
-
-        return data_ + pos;
+        return emplace(pos, elem);
     }
 
     /**
@@ -606,10 +1076,7 @@ class vec {
     inline iterator
     insert(size_type pos, T&& elem)
     {
-        shift_(pos, 1);
-        data_[pos] = elem;
-
-        return data_ + pos;
+        return emplace(pos, std::move(elem));
     }
 
     /**
@@ -624,10 +1091,14 @@ class vec {
     inline iterator
     insert(size_type pos, size_type count, const T& elem)
     {
+        // elem may be one of our own elements, which shift_() is about to move
+        const T copy(elem);
         shift_(pos, count);
 
-        for (size_type i = pos; i < pos + count; i++)
-            data_[i] = elem;
+        // Only bulk fills are worth starting threads for
+        const size_type threads =
+            count * sizeof(T) >= stream_threshold() ? bulk_threads() : 1;
+        fill_gap_parallel_(pos, count, copy, threads);
 
         return data_ + pos;
     }
@@ -647,18 +1118,134 @@ class vec {
         shift_(pos, elems.size());
 
         auto* elem_data = std::data(elems);
-        for (size_type i = 0; i < elems.size(); i++)
-            data_[i + pos] = elem_data[i];
+        fill_gap_(pos, elems.size(), [&](T* where, size_type i) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            ::new (static_cast<void*>(where)) T(elem_data[i]);
+        });
 
         return data_ + pos;
     }
 
+    /**
+     * @brief Resize the vector to @p count elements.
+     *
+     * Removes elements from the end, or appends value-initialized ones.
+     *
+     * @param count The new size.
+     */
+    inline void
+    resize(size_type count)
+    {
+        if (count <= size_) {
+            while (size_ > count)
+                pop_back();
+            return;
+        }
+
+        const size_type start = size_;
+        shift_(start, count - start);
+        fill_gap_(start, count - start, [](T* where, size_type) {
+            ::new (static_cast<void*>(where)) T();
+        });
+    }
+
+    /**
+     * @brief Resize the vector to @p count elements.
+     *
+     * Removes elements from the end, or appends copies of @p elem. The copies
+     * can be made by several threads, each filling one contiguous part of the
+     * new elements. Memory is placed on a NUMA node when it is first written, so
+     * a large buffer filled by one thread ends up on one node; filling it with
+     * the threads that will later work on each part puts the pages next to
+     * them instead. Elements whose copy constructor can throw are always copied
+     * on the calling thread.
+     *
+     * @param count The new size.
+     * @param elem The element to append copies of.
+     * @param threads How many threads to copy with. Uses `std::thread`, so link
+     * with `Threads::Threads` when passing more than one.
+     */
+    inline void
+    resize(size_type count, const T& elem, size_type threads = 1)
+    {
+        if (count <= size_) {
+            while (size_ > count)
+                pop_back();
+            return;
+        }
+
+        // elem may be one of our own elements, which shift_() may move
+        const T copy(elem);
+        const size_type start = size_;
+        shift_(start, count - start);
+        fill_gap_parallel_(start, count - start, copy, threads);
+    }
+
+    /**
+     * @brief Resize the vector to @p count elements, for a caller that is about
+     * to overwrite the new ones.
+     *
+     * Like resize(), but appended elements are default-initialized, so trivial
+     * ones are left uninitialized instead of being zeroed first.
+     *
+     * @param count The new size.
+     */
+    inline void
+    resize_for_overwrite(size_type count)
+    {
+        if (count <= size_) {
+            while (size_ > count)
+                pop_back();
+            return;
+        }
+
+        const size_type start = size_;
+        shift_(start, count - start);
+        if constexpr (!std::is_trivially_default_constructible_v<T>) {
+            fill_gap_(start, count - start, [](T* where, size_type) {
+                ::new (static_cast<void*>(where)) T;
+            });
+        }
+    }
+
+    /**
+     * @brief Remove @p count elements starting at position @p pos.
+     *
+     * Does not change the capacity.
+     *
+     * @param pos The position of the first element to remove.
+     * @param count How many elements to remove.
+     * @exception std::out_of_range The elements are not all in this vector.
+     * @return An iterator pointing to the element after the removed ones.
+     */
+    inline iterator
+    erase(size_type pos, size_type count = 1)
+    {
+        if (pos > size_ || count > size_ - pos)
+            throw std::out_of_range("vec: erase out of range!");
+
+        unshift_(pos, count, count);
+        return data_ + pos;
+    }
+
+    /**
+     * @brief Remove the last element.
+     *
+     * The vector must not be empty. Does not change the capacity.
+     */
+    inline void
+    pop_back() noexcept
+    {
+        data_[size_ - 1].~T();
+        size_--;
+    }
+
 #pragma endregion
 
 #pragma region "Equality operators"
 
     inline friend bool
-    operator==(const ds::vec<T>& lhs, const ds::vec<T>& rhs)
+    operator==(const vec& lhs, const vec& rhs)
     {
         // Check if they are the same object
         if (&lhs == &rhs)
@@ -677,7 +1264,7 @@ class vec {
     }
 
     inline friend bool
-    operator!=(const ds::vec<T>& lhs, const ds::vec<T>& rhs)
+    operator!=(const vec& lhs, const vec& rhs)
     {
         return !(lhs == rhs);
     }
@@ -687,4 +1274,7 @@ class vec {
 
 } // namespace ds
 
+#undef LIBDS_VEC_STATS_
+#undef LIBDS_VEC_STATS_FREE_
+
 #endif // LIBDS_VEC_HPP
@@ -0,0 +1,163 @@
+#include "libds/argsort.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+/**
+ * @brief The reference result: a stable sort of the indices.
+ */
+template <class T, class Compare>
+std::vector<std::uint32_t>
+reference(const ds::vec<T>& v, Compare cmp)
+{
+    std::vector<std::uint32_t> idx(v.size());
+    for (std::size_t i = 0; i < idx.size(); i++)
+        idx[i] = static_cast<std::uint32_t>(i);
+    std::stable_sort(idx.begin(), idx.end(), [&](std::uint32_t lhs, std::uint32_t rhs) {
+        return cmp(v[lhs], v[rhs]);
+    });
+    return idx;
+}
+
+template <class I>
+std::vector<std::uint32_t>
+to_std(const ds::vec<I>& idx)
+{
+    return {idx.begin(), idx.end()};
+}
+
+template <class T>
+ds::vec<T>
+random_values(std::size_t n, std::uint64_t range, bool negative)
+{
+    ds::vec<T> out(0);
+    std::uint64_t rng = 88172645463325252ULL;
+    for (std::size_t i = 0; i < n; i++) {
+        rng ^= rng << 13U;
+        rng ^= rng >> 7U;
+        rng ^= rng << 17U;
+        auto val = static_cast<std::int64_t>(rng % range);
+        if (negative && (rng >> 63U) != 0)
+            val = -val;
+        out.insert(i, static_cast<T>(val));
+    }
+    return out;
+}
+} // namespace
+
+TEST_CASE("Argsort with radix-sortable keys", "[argsort]")
+{
+    SECTION("Unsigned integers, with many duplicates")
+    {
+        auto v = random_values<std::uint32_t>(5000, 100, false);
+        CHECK(to_std(ds::argsort(v)) == reference(v, std::less<>()));
+        CHECK(
+            to_std(ds::argsort(v, std::greater<>())) == reference(v, std::greater<>())
+        );
+    }
+
+    SECTION("Signed integers")
+    {
+        auto v = random_values<std::int64_t>(5000, 1ULL << 40U, true);
+        CHECK(to_std(ds::argsort<std::uint64_t>(v)) == reference(v, std::less<>()));
+
+        auto small = random_values<std::int8_t>(1000, 100, true);
+        CHECK(to_std(ds::argsort(small)) == reference(small, std::less<>()));
+    }
+
+    SECTION("Floating point numbers")
+    {
+        auto v = random_values<double>(5000, 1000000, true);
+        for (double& elem : v)
+            elem /= 7;
+        v[3] = std::numeric_limits<double>::infinity();
+        v[4] = -std::numeric_limits<double>::infinity();
+        CHECK(to_std(ds::argsort(v)) == reference(v, std::less<>()));
+
+        auto f = random_values<float>(5000, 1000, true);
+        CHECK(
+            to_std(ds::argsort(f, std::greater<float>()))
+            == reference(f, std::greater<>())
+        );
+    }
+
+    SECTION("Signed zeros are equal")
+    {
+        CHECK(
+            to_std(ds::argsort(ds::vec{0.0, -0.0, 1.0}))
+            == std::vector<std::uint32_t>{0, 1, 2}
+        );
+
+        auto v = random_values<double>(5000, 3, true);
+        for (std::size_t i = 0; i < v.size(); i += 3)
+            v[i] = -0.0;
+        CHECK(to_std(ds::argsort(v)) == reference(v, std::less<>()));
+        CHECK(
+            to_std(ds::argsort(v, std::greater<double>()))
+            == reference(v, std::greater<>())
+        );
+    }
+
+    SECTION("Keys")
+    {
+        ds::vec<std::string> words{"pear", "fig", "banana", "kiwi", "apple"};
+        auto by_length =
+            ds::argsort(words, [](const std::string& w) { return w.size(); });
+        CHECK(to_std(by_length) == std::vector<std::uint32_t>{1, 0, 3, 4, 2});
+    }
+
+    SECTION("Small inputs")
+    {
+        CHECK(ds::argsort(ds::vec<int>(0)).empty());
+        CHECK(to_std(ds::argsort(ds::vec{5})) == std::vector<std::uint32_t>{0});
+        CHECK(
+            to_std(ds::argsort(ds::vec{7, 7, 7})) == std::vector<std::uint32_t>{0, 1, 2}
+        );
+    }
+}
+
+TEST_CASE("Argsort with comparators", "[argsort]")
+{
+    SECTION("Small elements are sorted as pairs")
+    {
+        auto v = random_values<std::int32_t>(3000, 1000, true);
+        auto by_abs = [](std::int32_t lhs, std::int32_t rhs) {
+            return std::abs(lhs) < std::abs(rhs);
+        };
+        CHECK(to_std(ds::argsort(v, by_abs)) == reference(v, by_abs));
+    }
+
+    SECTION("Large elements are sorted through their indices")
+    {
+        ds::vec<std::string> words{"pear", "fig", "banana", "kiwi", "apple", "fig"};
+        CHECK(to_std(ds::argsort(words)) == reference(words, std::less<>()));
+        CHECK(
+            to_std(ds::argsort(words, std::greater<>()))
+            == reference(words, std::greater<>())
+        );
+    }
+
+    SECTION("Non-arithmetic keys")
+    {
+        ds::vec<int> v{3, 1, 2};
+        auto as_text = [](int elem) { return std::to_string(elem * 5); };
+        // "15", "5", "10"
+        CHECK(to_std(ds::argsort(v, as_text)) == std::vector<std::uint32_t>{2, 0, 1});
+    }
+
+    SECTION("Indices that are too narrow")
+    {
+        ds::vec<int> v(256, 0);
+        CHECK_NOTHROW(ds::argsort<std::uint8_t>(v));
+        v.insert(0, 1);
+        CHECK_THROWS_AS(ds::argsort<std::uint8_t>(v), std::length_error);
+    }
+}
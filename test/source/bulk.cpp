@@ -0,0 +1,98 @@
+#include "libds/bulk.hpp"
+#include "libds/vec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+/**
+ * @brief Stream everything while in scope.
+ */
+struct always_stream {
+    std::size_t threshold = ds::stream_threshold();
+    std::size_t threads = ds::bulk_threads();
+
+    explicit always_stream(std::size_t bulk_threads)
+    {
+        ds::set_stream_threshold(0);
+        ds::set_bulk_threads(bulk_threads);
+    }
+
+    always_stream(const always_stream&) = delete;
+    always_stream& operator=(const always_stream&) = delete;
+
+    ~always_stream()
+    {
+        ds::set_stream_threshold(threshold);
+        ds::set_bulk_threads(threads);
+    }
+};
+} // namespace
+
+TEST_CASE("Bulk copies and fills", "[bulk]")
+{
+    std::vector<unsigned char> src(5000);
+    for (std::size_t i = 0; i < src.size(); i++)
+        src[i] = static_cast<unsigned char>(i * 7 + 3);
+
+    SECTION("Copies at every alignment")
+    {
+        const always_stream stream(3);
+        for (std::size_t offset : {0U, 1U, 7U, 15U, 16U, 33U}) {
+            for (std::size_t bytes : {0U, 1U, 63U, 64U, 65U, 1000U, 4000U}) {
+                std::vector<unsigned char> dest(5000, 0xAA);
+                ds::bulk_copy(dest.data() + offset, src.data() + 5, bytes);
+
+                CHECK(std::memcmp(dest.data() + offset, src.data() + 5, bytes) == 0);
+                CHECK(dest[offset + bytes] == 0xAA);
+                if (offset > 0)
+                    CHECK(dest[offset - 1] == 0xAA);
+            }
+        }
+    }
+
+    SECTION("Fills at every alignment and pattern size")
+    {
+        const always_stream stream(3);
+        const unsigned char pattern[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+        for (std::size_t size : {1U, 2U, 4U, 8U, 16U, 3U, 12U}) {
+            for (std::size_t offset : {0U, 1U, 4U, 9U}) {
+                std::vector<unsigned char> dest(5000, 0xAA);
+                ds::bulk_fill(dest.data() + offset, pattern, size, 300);
+
+                bool filled = true;
+                for (std::size_t i = 0; i < size * 300; i++)
+                    filled = filled && dest[offset + i] == pattern[i % size];
+                CHECK(filled);
+                CHECK(dest[offset + size * 300] == 0xAA);
+            }
+        }
+    }
+
+    SECTION("Vectors stream their copies, fills and moves")
+    {
+        const always_stream stream(2);
+
+        ds::vec<std::uint16_t> arr(1001, 0xBEEF);
+        ds::vec<std::uint16_t> copy = arr;
+        copy.insert(0, 500, 0x1234);
+        arr.resize(3000, 0x4321);
+
+        REQUIRE(copy.size() == 1501);
+        CHECK(copy[499] == 0x1234);
+        CHECK(copy[500] == 0xBEEF);
+        CHECK(copy[1500] == 0xBEEF);
+        CHECK(arr[1000] == 0xBEEF);
+        CHECK(arr[1001] == 0x4321);
+        CHECK(arr[2999] == 0x4321);
+
+        ds::vec<std::uint64_t, 64> aligned(100, 0x2525252525252525U);
+        aligned.resize(10000, 0x0123456789ABCDEFU);
+        CHECK(aligned[99] == 0x2525252525252525U);
+        CHECK(aligned[9999] == 0x0123456789ABCDEFU);
+    }
+}
@@ -0,0 +1,184 @@
+#include "libds/compact_vec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+unsigned
+sum(ds::span<const unsigned> view)
+{
+    unsigned total = 0;
+    for (const auto& val : view)
+        total += val;
+    return total;
+}
+
+void
+double_all(ds::span<unsigned> view)
+{
+    for (auto& val : view)
+        val *= 2;
+}
+
+} // namespace
+
+static_assert(sizeof(ds::compact_vec<std::uint64_t>) == sizeof(void*));
+static_assert(sizeof(ds::compact_vec32<std::uint64_t>) == sizeof(void*) + 8);
+
+TEMPLATE_TEST_CASE(
+    "Compact vectors", "[compact_vec]", ds::compact_vec<unsigned>,
+    ds::compact_vec32<unsigned>
+)
+{
+    TestType arr;
+    REQUIRE(arr.empty());
+    REQUIRE(arr.capacity() == 0);
+    REQUIRE(arr.data() == nullptr);
+
+    SECTION("Inserting")
+    {
+        for (unsigned i = 0; i < 100; i++)
+            arr.insert(arr.size(), i);
+        arr.insert(0, 2, 7);
+        arr.insert(50, {8, 9});
+
+        REQUIRE(arr.size() == 104);
+        CHECK(arr.front() == 7);
+        CHECK(arr[2] == 0);
+        CHECK(arr[50] == 8);
+        CHECK(arr[51] == 9);
+        CHECK(arr[52] == 48);
+        CHECK(arr.back() == 99);
+        CHECK_THROWS_AS(arr.at(104), std::out_of_range);
+    }
+
+    SECTION("Capacity")
+    {
+        arr.reserve(20);
+        CHECK(arr.capacity() == 20);
+
+        arr.insert(0, {1, 2, 3});
+        arr.shrink_to_fit();
+        CHECK(arr.capacity() == 3);
+
+        arr.clear();
+        arr.shrink_to_fit();
+        CHECK(arr.data() == nullptr);
+    }
+
+    SECTION("Copying and moving")
+    {
+        arr.insert(0, {1, 2, 3});
+
+        TestType copy(arr);
+        CHECK(copy == arr);
+        CHECK(copy.data() != arr.data());
+
+        TestType moved(std::move(copy));
+        CHECK(moved == arr);
+        CHECK(copy.data() == nullptr); // NOLINT(bugprone-use-after-move)
+
+        copy = moved;
+        moved.pop_back();
+        CHECK(copy == TestType{1, 2, 3});
+        CHECK(moved == TestType{1, 2});
+    }
+
+    SECTION("Views")
+    {
+        arr.insert(0, {1, 2, 3, 4});
+
+        auto [lhs, rhs] = arr.split_at(1);
+        CHECK(lhs.size() == 1);
+        CHECK(rhs[0] == 2);
+        CHECK(arr.slice(1, 2)[1] == 3);
+    }
+
+    SECTION("Passing as a span")
+    {
+        arr.insert(0, {1, 2, 3});
+
+        double_all(arr);
+        CHECK(arr == TestType{2, 4, 6});
+
+        const auto& carr = arr;
+        CHECK(sum(carr) == 12);
+
+        ds::span view = carr;
+        CHECK(view.data() == arr.data());
+        CHECK(view.size() == 3);
+
+        CHECK(sum(TestType()) == 0);
+    }
+}
+
+TEST_CASE("Non-trivial compact elements", "[compact_vec]")
+{
+    ds::compact_vec<std::string> arr(3, "a");
+    arr.insert(1, arr[0] + "b");
+    arr.emplace(0, std::size_t{2}, 'c');
+
+    CHECK(arr == ds::compact_vec<std::string>{"cc", "a", "ab", "a", "a"});
+
+    ds::compact_vec32<std::string> other{"x"};
+    other = ds::compact_vec32<std::string>{"y", "z"};
+    CHECK(other.size() == 2);
+    CHECK(other[1] == "z");
+}
+
+TEST_CASE("Growing a compact_vec with throwing copies", "[compact_vec]")
+{
+    // Has no move constructor, so growing copies, which throws once out of budget
+    struct fragile {
+        int val;
+        int* live;
+        int* budget;
+
+        fragile(int value, int* live_count, int* copy_budget) :
+            val(value), live(live_count), budget(copy_budget)
+        {
+            ++*live;
+        }
+
+        fragile(const fragile& other) :
+            val(other.val), live(other.live), budget(other.budget)
+        {
+            if (*budget == 0)
+                throw std::runtime_error("fragile: out of copies!");
+            --*budget;
+            ++*live;
+        }
+
+        fragile& operator=(const fragile& other) = delete;
+
+        ~fragile() noexcept { --*live; }
+    };
+
+
+    int live = 0;
+    int budget = 2;
+    {
+        ds::compact_vec<fragile> arr;
+        arr.reserve(4);
+        for (int i = 0; i < 4; i++)
+            arr.emplace(arr.size(), i, &live, &budget);
+        const std::size_t cap = arr.capacity();
+
+        CHECK_THROWS_AS(arr.reserve(cap * 2), std::runtime_error);
+        CHECK_THROWS_AS(arr.emplace(0, -1, &live, &budget), std::runtime_error);
+
+        REQUIRE(arr.size() == 4);
+        CHECK(arr.capacity() == cap);
+        CHECK(live == 4);
+        for (std::size_t i = 0; i < arr.size(); i++)
+            CHECK(arr[i].val == static_cast<int>(i));
+    }
+    CHECK(live == 0);
+}
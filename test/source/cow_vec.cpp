@@ -0,0 +1,183 @@
+#include "libds/cow_vec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Sharing buffers", "[cow_vec]")
+{
+    ds::cow_vec<unsigned> arr{1, 2, 3, 4};
+    REQUIRE(arr.is_unique());
+
+    SECTION("Copies share the buffer")
+    {
+        const ds::cow_vec<unsigned> copy(arr);
+
+        CHECK(copy.data() == arr.data());
+        CHECK(arr.use_count() == 2);
+        CHECK_FALSE(arr.is_unique());
+        CHECK(copy == arr);
+    }
+
+    SECTION("The first modification copies")
+    {
+        const ds::cow_vec<unsigned> copy(arr);
+        const auto* data = arr.data();
+
+        arr.mut(0) = 10;
+        CHECK(arr.data() != data);
+        CHECK(copy.data() == data);
+        CHECK(arr.is_unique());
+        CHECK(copy.is_unique());
+
+        // Only once
+        const auto* unique_data = arr.data();
+        arr.mut(1) = 20;
+        CHECK(arr.data() == unique_data);
+
+        CHECK(arr == ds::cow_vec<unsigned>{10, 20, 3, 4});
+        CHECK(copy == ds::cow_vec<unsigned>{1, 2, 3, 4});
+    }
+
+    SECTION("Explicit unsharing")
+    {
+        ds::cow_vec<unsigned> copy(arr);
+
+        auto elems = copy.make_unique();
+        CHECK(elems.data() != arr.data());
+        for (auto& elem : elems)
+            elem *= 2;
+
+        CHECK(copy == ds::cow_vec<unsigned>{2, 4, 6, 8});
+        CHECK(arr == ds::cow_vec<unsigned>{1, 2, 3, 4});
+    }
+
+    SECTION("Insertion into a shared buffer")
+    {
+        const ds::cow_vec<unsigned> copy(arr);
+
+        arr.insert(2, 10);
+        arr.insert(0, 2, 20);
+        arr.insert(arr.size(), {30, 31});
+
+        CHECK(arr == ds::cow_vec<unsigned>{20, 20, 1, 2, 10, 3, 4, 30, 31});
+        CHECK(copy == ds::cow_vec<unsigned>{1, 2, 3, 4});
+    }
+
+    SECTION("Clearing lets go of a shared buffer")
+    {
+        const ds::cow_vec<unsigned> copy(arr);
+
+        arr.clear();
+        CHECK(arr.empty());
+        CHECK(arr.capacity() == 0);
+        CHECK(copy.use_count() == 1);
+    }
+
+    SECTION("Assignment")
+    {
+        ds::cow_vec<unsigned> other{5, 6};
+        other = arr;
+        CHECK(other.data() == arr.data());
+
+        other = ds::cow_vec<unsigned>{7};
+        CHECK(arr.use_count() == 1);
+        CHECK(other == ds::cow_vec<unsigned>{7});
+    }
+}
+
+TEST_CASE("Copy-on-write with non-trivial elements", "[cow_vec]")
+{
+    ds::cow_vec<std::string> arr{"a", "b", "c"};
+    ds::cow_vec<std::string> copy(arr);
+
+    // Inserting one of our own elements
+    arr.insert(0, arr[2]);
+    arr.emplace(1, std::size_t{3}, 'x');
+    arr.mut(2) += "!";
+
+    CHECK(arr == ds::cow_vec<std::string>{"c", "xxx", "a!", "b", "c"});
+    CHECK(copy == ds::cow_vec<std::string>{"a", "b", "c"});
+
+    copy.reserve(100);
+    CHECK(copy.capacity() == 100);
+    copy.shrink_to_fit();
+    CHECK(copy.capacity() == 3);
+
+    const ds::vec<std::string> source{"d", "e"};
+    CHECK(ds::cow_vec<std::string>(source) == ds::cow_vec<std::string>{"d", "e"});
+}
+
+TEST_CASE("Growing a cow_vec with throwing copies", "[cow_vec]")
+{
+    // Has no move constructor, so growing copies, which throws once out of budget
+    struct fragile {
+        int val;
+        int* live;
+        int* budget;
+
+        fragile(int value, int* live_count, int* copy_budget) :
+            val(value), live(live_count), budget(copy_budget)
+        {
+            ++*live;
+        }
+
+        fragile(const fragile& other) :
+            val(other.val), live(other.live), budget(other.budget)
+        {
+            if (*budget == 0)
+                throw std::runtime_error("fragile: out of copies!");
+            --*budget;
+            ++*live;
+        }
+
+        fragile& operator=(const fragile& other) = delete;
+
+        ~fragile() noexcept { --*live; }
+    };
+
+
+    int live = 0;
+    int budget = 2;
+    {
+        ds::cow_vec<fragile> arr(4);
+        for (int i = 0; i < 4; i++)
+            arr.emplace(arr.size(), i, &live, &budget);
+        const std::size_t cap = arr.capacity();
+
+        CHECK_THROWS_AS(arr.reserve(cap * 2), std::runtime_error);
+
+        REQUIRE(arr.size() == 4);
+        CHECK(arr.capacity() == cap);
+        CHECK(live == 4);
+        for (std::size_t i = 0; i < arr.size(); i++)
+            CHECK(arr[i].val == static_cast<int>(i));
+    }
+    CHECK(live == 0);
+}
+
+TEST_CASE("Publishing snapshots to readers", "[cow_vec]")
+{
+    ds::cow_vec<unsigned> arr(1000, 1);
+    std::vector<std::thread> readers;
+    std::vector<unsigned> sums(4);
+
+    for (unsigned i = 0; i < 4; i++) {
+        readers.emplace_back([snapshot = arr, &sum = sums[i]]() {
+            for (const unsigned elem : snapshot)
+                sum += elem;
+        });
+        arr.mut(0)++;
+    }
+    for (auto& reader : readers)
+        reader.join();
+
+    CHECK(sums == std::vector<unsigned>{1000, 1001, 1002, 1003});
+    CHECK(arr.is_unique());
+    CHECK(arr[0] == 5);
+}
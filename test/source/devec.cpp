@@ -0,0 +1,278 @@
+#include "libds/devec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+unsigned
+sum(ds::span<const unsigned> view)
+{
+    unsigned total = 0;
+    for (const auto& val : view)
+        total += val;
+    return total;
+}
+
+void
+double_all(ds::span<unsigned> view)
+{
+    for (auto& val : view)
+        val *= 2;
+}
+
+} // namespace
+
+TEST_CASE("Pushing at both ends", "[devec]")
+{
+    ds::devec<unsigned> arr;
+
+    SECTION("Front only")
+    {
+        for (unsigned i = 0; i < 100; i++)
+            arr.push_front(i);
+
+        REQUIRE(arr.size() == 100);
+        for (unsigned i = 0; i < 100; i++)
+            CHECK(arr[i] == 99 - i);
+    }
+
+    SECTION("Alternating")
+    {
+        for (unsigned i = 1; i <= 50; i++) {
+            arr.push_front(100 - i);
+            arr.push_back(100 + i);
+        }
+
+        REQUIRE(arr.size() == 100);
+        CHECK(arr.front() == 50);
+        CHECK(arr.back() == 150);
+        for (unsigned i = 1; i < arr.size(); i++)
+            CHECK(arr[i] > arr[i - 1]);
+    }
+
+    SECTION("Front capacity is used")
+    {
+        arr.push_front(2);
+        arr.push_front(1);
+        REQUIRE(arr.front_capacity() > 0);
+
+        const auto* data = arr.data();
+        arr.push_front(0);
+
+        CHECK(arr.data() == data - 1);
+        CHECK(arr == ds::devec<unsigned>{0, 1, 2});
+    }
+
+    SECTION("Sliding window")
+    {
+        for (unsigned i = 0; i < 1000; i++) {
+            arr.push_back(i);
+            if (arr.size() > 8)
+                arr.pop_front();
+        }
+
+        CHECK(arr == ds::devec<unsigned>{992, 993, 994, 995, 996, 997, 998, 999});
+        CHECK(arr.capacity() < 32);
+    }
+}
+
+TEST_CASE("Editing in the middle", "[devec]")
+{
+    ds::devec<unsigned> arr{1, 2, 3, 4, 5, 6};
+
+    SECTION("Insertion")
+    {
+        arr.insert(1, 10);
+        arr.insert(6, 20);
+        arr.insert(4, 2, 30);
+        arr.insert(0, {40, 41});
+
+        CHECK(arr == ds::devec<unsigned>{40, 41, 1, 10, 2, 3, 30, 30, 4, 5, 20, 6});
+    }
+
+    SECTION("Erasure shifts the smaller side")
+    {
+        arr.reserve(20);
+        const auto* data = arr.data();
+
+        arr.erase(1);
+        CHECK(arr == ds::devec<unsigned>{1, 3, 4, 5, 6});
+        CHECK(arr.data() == data + 1);
+
+        arr.erase(3, 2);
+        CHECK(arr == ds::devec<unsigned>{1, 3, 4});
+        CHECK(arr.data() == data + 1);
+        CHECK(arr.front_capacity() == 1);
+    }
+
+    SECTION("Erasure out of range")
+    {
+        CHECK_THROWS_AS(arr.erase(6), std::out_of_range);
+        CHECK_THROWS_AS(arr.erase(4, 3), std::out_of_range);
+        CHECK(arr.size() == 6);
+    }
+
+    SECTION("Popping")
+    {
+        arr.pop_front();
+        arr.pop_back();
+
+        CHECK(arr == ds::devec<unsigned>{2, 3, 4, 5});
+    }
+}
+
+TEST_CASE("Capacity at both ends", "[devec]")
+{
+    ds::devec<unsigned> arr{1, 2, 3};
+
+    SECTION("Reserve keeps the front capacity")
+    {
+        arr.push_front(0);
+        const auto front = arr.front_capacity();
+
+        arr.reserve(100);
+
+        CHECK(arr.front_capacity() == front);
+        CHECK(arr.size() + arr.back_capacity() == 100);
+        CHECK(arr == ds::devec<unsigned>{0, 1, 2, 3});
+    }
+
+    SECTION("Shrink")
+    {
+        arr.push_front(0);
+        arr.shrink_to_fit();
+
+        CHECK(arr.capacity() == 4);
+        CHECK(arr.front_capacity() == 0);
+        CHECK(arr == ds::devec<unsigned>{0, 1, 2, 3});
+    }
+
+    SECTION("Clear")
+    {
+        arr.push_front(0);
+        arr.clear();
+
+        CHECK(arr.empty());
+        CHECK(arr.front_capacity() == 0);
+        CHECK(arr.back_capacity() == arr.capacity());
+    }
+}
+
+TEST_CASE("Resizing a devec", "[devec]")
+{
+    ds::devec<unsigned> arr{1, 2, 3};
+    arr.push_front(0);
+
+    arr.resize(6);
+    CHECK(arr == ds::devec<unsigned>{0, 1, 2, 3, 0, 0});
+
+    arr.resize(2);
+    CHECK(arr == ds::devec<unsigned>{0, 1});
+
+    arr.resize(1000, 7, 4);
+    REQUIRE(arr.size() == 1000);
+    CHECK(arr[1] == 1);
+    CHECK(arr[2] == 7);
+    CHECK(arr[999] == 7);
+
+    ds::devec<std::string> strs{"a"};
+    strs.resize(3, strs[0]);
+    CHECK(strs == ds::devec<std::string>{"a", "a", "a"});
+
+    arr.resize_for_overwrite(1002);
+    REQUIRE(arr.size() == 1002);
+    arr[1001] = 8;
+    CHECK(arr[1001] == 8);
+
+    strs.resize_for_overwrite(4);
+    CHECK(strs[3].empty());
+}
+
+TEST_CASE("Non-trivial double-ended elements", "[devec]")
+{
+    const std::string long_str(64, 'x');
+    ds::devec<std::string> arr{"b", "c"};
+
+    arr.push_front("a");
+    arr.emplace_back(long_str);
+    arr.insert(2, arr[0]);
+    arr.emplace(1, std::size_t{3}, 'y');
+
+    REQUIRE(arr == ds::devec<std::string>{"a", "yyy", "b", "a", "c", long_str});
+
+    ds::devec<std::string> copy(arr);
+    arr.erase(0, 3);
+
+    CHECK(arr == ds::devec<std::string>{"a", "c", long_str});
+    CHECK(copy.size() == 6);
+    CHECK(copy.slice(4, 2)[1] == long_str);
+}
+
+TEST_CASE("Growing a devec with throwing copies", "[devec]")
+{
+    // Has no move constructor, so growing copies, which throws once out of budget
+    struct fragile {
+        int val;
+        int* live;
+        int* budget;
+
+        fragile(int value, int* live_count, int* copy_budget) :
+            val(value), live(live_count), budget(copy_budget)
+        {
+            ++*live;
+        }
+
+        fragile(const fragile& other) :
+            val(other.val), live(other.live), budget(other.budget)
+        {
+            if (*budget == 0)
+                throw std::runtime_error("fragile: out of copies!");
+            --*budget;
+            ++*live;
+        }
+
+        fragile& operator=(const fragile& other) = delete;
+
+        ~fragile() noexcept { --*live; }
+    };
+
+    int live = 0;
+    int budget = 2;
+    {
+        ds::devec<fragile> arr(4);
+        for (int i = 0; i < 4; i++)
+            arr.emplace_back(i, &live, &budget);
+        const std::size_t cap = arr.capacity();
+
+        CHECK_THROWS_AS(arr.reserve(cap * 2), std::runtime_error);
+        CHECK_THROWS_AS(arr.emplace_front(-1, &live, &budget), std::runtime_error);
+
+        REQUIRE(arr.size() == 4);
+        CHECK(arr.capacity() == cap);
+        CHECK(live == 4);
+        for (std::size_t i = 0; i < arr.size(); i++)
+            CHECK(arr[i].val == static_cast<int>(i));
+    }
+    CHECK(live == 0);
+}
+
+TEST_CASE("Passing a devec as a span", "[devec]")
+{
+    ds::devec<unsigned> arr{2, 3};
+    arr.push_front(1);
+
+    double_all(arr);
+    CHECK(arr == ds::devec<unsigned>{2, 4, 6});
+
+    const auto& carr = arr;
+    CHECK(sum(carr) == 12);
+
+    ds::span view = carr;
+    CHECK(view.data() == arr.data());
+    CHECK(view.size() == 3);
+}
@@ -0,0 +1,185 @@
+#include "libds/gap_vec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+TEST_CASE("Editing at the gap", "[gap_vec]")
+{
+    ds::gap_vec<unsigned> arr{1, 2, 3, 4, 5};
+
+    REQUIRE(arr.gap_position() == 5);
+    REQUIRE(arr.gap_size() == 0);
+
+    SECTION("Consecutive inserts stay at the gap")
+    {
+        arr.reserve(20);
+        arr.insert(2, 10);
+        REQUIRE(arr.gap_position() == 3);
+
+        const auto gap = arr.gap_size();
+        arr.insert(3, 11);
+        arr.insert(4, 12);
+
+        CHECK(arr.gap_position() == 5);
+        CHECK(arr.gap_size() == gap - 2);
+        CHECK(arr == ds::gap_vec<unsigned>{1, 2, 10, 11, 12, 3, 4, 5});
+    }
+
+    SECTION("Erasing")
+    {
+        arr.erase(1);
+        CHECK(arr.gap_position() == 1);
+
+        arr.erase(1, 2);
+        CHECK(arr == ds::gap_vec<unsigned>{1, 5});
+        CHECK(arr.capacity() == 5);
+
+        CHECK_THROWS_AS(arr.erase(2), std::out_of_range);
+    }
+
+    SECTION("Multiple elements")
+    {
+        arr.insert(0, 2, 0);
+        arr.insert(7, {6, 7});
+
+        CHECK(arr == ds::gap_vec<unsigned>{0, 0, 1, 2, 3, 4, 5, 6, 7});
+    }
+}
+
+TEST_CASE("Moving the gap", "[gap_vec]")
+{
+    ds::gap_vec<unsigned> arr(20);
+    for (unsigned i = 0; i < 10; i++)
+        arr.insert(i, i);
+
+    arr.move_gap(3);
+    CHECK(arr.gap_position() == 3);
+    CHECK(arr.gap_size() == 10);
+
+    for (unsigned i = 0; i < 10; i++)
+        CHECK(arr[i] == i);
+
+    SECTION("Halves")
+    {
+        auto [before, after] = arr.halves();
+
+        CHECK(before.size() == 3);
+        CHECK(after.size() == 7);
+        CHECK(before.back() == 2);
+        CHECK(after.front() == 3);
+    }
+
+    SECTION("Back and forth")
+    {
+        arr.move_gap(8);
+        arr.move_gap(0);
+        arr.move_gap(10);
+
+        CHECK(arr.after_gap().empty());
+        CHECK_THROWS_AS(arr.move_gap(11), std::out_of_range);
+    }
+
+    SECTION("Contiguous")
+    {
+        auto all = arr.make_contiguous();
+
+        CHECK(all.size() == 10);
+        CHECK(arr.gap_position() == 10);
+        CHECK(std::is_sorted(all.begin(), all.end()));
+    }
+
+    SECTION("Iterators skip the gap")
+    {
+        CHECK(arr.end() - arr.begin() == 10);
+        CHECK(std::is_sorted(arr.begin(), arr.end()));
+        CHECK(*(arr.begin() + 3) == 3);
+        CHECK(*(arr.end() - 2) == 8);
+        CHECK((arr.end() - 4)[-2] == 4);
+    }
+
+    SECTION("Growing keeps the gap in place")
+    {
+        arr.reserve(100);
+
+        CHECK(arr.gap_position() == 3);
+        CHECK(arr.gap_size() == 90);
+        CHECK(arr[3] == 3);
+    }
+}
+
+TEST_CASE("Non-trivial gap elements", "[gap_vec]")
+{
+    const std::string long_str(64, 'x');
+    ds::gap_vec<std::string> text{"a", "b", "c"};
+
+    text.insert(1, long_str);
+    text.emplace(0, std::size_t{2}, 'y');
+    text.insert(4, text[1]);
+    text.move_gap(1);
+
+    REQUIRE(text == ds::gap_vec<std::string>{"yy", "a", long_str, "b", "a", "c"});
+
+    ds::gap_vec<std::string> copy(text);
+    CHECK(copy == text);
+    CHECK(copy.gap_position() == 1);
+
+    ds::gap_vec<std::string> assigned;
+    assigned = text;
+    text.clear();
+
+    CHECK(assigned == copy);
+    CHECK(text.empty());
+}
+
+TEST_CASE("Growing a gap_vec with throwing copies", "[gap_vec]")
+{
+    // Has no move constructor, so growing copies, which throws once out of budget
+    struct fragile {
+        int val;
+        int* live;
+        int* budget;
+
+        fragile(int value, int* live_count, int* copy_budget) :
+            val(value), live(live_count), budget(copy_budget)
+        {
+            ++*live;
+        }
+
+        fragile(const fragile& other) :
+            val(other.val), live(other.live), budget(other.budget)
+        {
+            if (*budget == 0)
+                throw std::runtime_error("fragile: out of copies!");
+            --*budget;
+            ++*live;
+        }
+
+        fragile& operator=(const fragile& other) = delete;
+
+        ~fragile() noexcept { --*live; }
+    };
+
+
+    int live = 0;
+    int budget = 2;
+    {
+        ds::gap_vec<fragile> text(4);
+        for (int i = 0; i < 4; i++)
+            text.emplace(text.size(), i, &live, &budget);
+        const std::size_t cap = text.capacity();
+
+        CHECK_THROWS_AS(text.reserve(cap * 2), std::runtime_error);
+
+        REQUIRE(text.size() == 4);
+        CHECK(text.capacity() == cap);
+        CHECK(live == 4);
+        for (std::size_t i = 0; i < text.size(); i++)
+            CHECK(text[i].val == static_cast<int>(i));
+    }
+    CHECK(live == 0);
+}
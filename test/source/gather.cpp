@@ -0,0 +1,153 @@
+#include "libds/gather.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <string>
+
+namespace {
+/**
+ * @brief A pseudo-random permutation of `0, ..., n - 1`.
+ */
+template <class I>
+ds::vec<I>
+shuffled(std::size_t n, std::uint32_t seed)
+{
+    ds::vec<I> perm(n);
+    for (std::size_t i = 0; i < n; i++)
+        perm.insert(i, static_cast<I>(i));
+    for (std::size_t i = n; i > 1; i--) {
+        seed = seed * 1664525U + 1013904223U;
+        std::swap(perm[i - 1], perm[(seed >> 8) % i]);
+    }
+    return perm;
+}
+
+/**
+ * @brief Whether @p lhs and @p rhs have the same bits; gathering only copies them.
+ */
+template <class T>
+bool
+same_bits(const T& lhs, const T& rhs)
+{
+    return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+}
+
+template <class T, class I>
+void
+check_gather(std::size_t threads)
+{
+    const std::size_t n = 1003;
+    ds::vec<T> src(0);
+    for (std::size_t i = 0; i < n; i++)
+        src.insert(i, static_cast<T>(i * 3 + 1));
+
+    const auto idx = shuffled<I>(n, 42);
+    ds::vec<T> dst(0);
+    ds::gather(src, idx, dst, threads);
+
+    REQUIRE(dst.size() == n);
+    bool same = true;
+    for (std::size_t i = 0; i < n; i++)
+        same = same && same_bits(dst[i], src[static_cast<std::size_t>(idx[i])]);
+    CHECK(same);
+
+    ds::vec<T> back(n, T{});
+    ds::scatter(dst, idx, back, threads);
+    REQUIRE(back.size() == n);
+    same = true;
+    for (std::size_t i = 0; i < n; i++)
+        same = same && same_bits(back[i], src[i]);
+    CHECK(same);
+}
+} // namespace
+
+TEST_CASE("Gathering and scattering", "[gather]")
+{
+    SECTION("Every element and index width")
+    {
+        for (std::size_t threads : {1U, 3U}) {
+            check_gather<std::uint32_t, std::uint32_t>(threads);
+            check_gather<float, std::uint64_t>(threads);
+            check_gather<double, std::uint32_t>(threads);
+            check_gather<std::int64_t, std::int64_t>(threads);
+            check_gather<std::uint16_t, std::uint32_t>(threads);
+        }
+    }
+
+    SECTION("Repeated indices and non-trivial elements")
+    {
+        ds::vec<std::string> src{"a", "b", "c"};
+        ds::vec<unsigned> idx{2, 2, 0, 1, 2};
+        ds::vec<std::string> dst(0);
+
+        ds::gather(src, idx, dst, 4);
+        CHECK(dst == ds::vec<std::string>{"c", "c", "a", "b", "c"});
+    }
+
+    SECTION("Size mismatches")
+    {
+        ds::vec<int> src{1, 2, 3};
+        ds::vec<unsigned> idx{0, 1};
+        ds::vec<int> dst(3, 0);
+
+        CHECK_THROWS_AS(
+            ds::gather(ds::span<const int>(src), ds::span<const unsigned>(idx),
+                       ds::span<int>(dst)),
+            std::invalid_argument
+        );
+        CHECK_THROWS_AS(ds::scatter(src, idx, dst), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Applying permutations", "[gather]")
+{
+    SECTION("Matches gathering")
+    {
+        const std::size_t n = 5000;
+        ds::vec<std::string> arr(0);
+        for (std::size_t i = 0; i < n; i++)
+            arr.insert(i, std::to_string(i));
+
+        const auto perm = shuffled<std::uint32_t>(n, 7);
+        ds::vec<std::string> expected(0);
+        ds::gather(arr, perm, expected);
+
+        ds::apply_permutation(arr, perm);
+        CHECK(arr == expected);
+    }
+
+    SECTION("Trivial permutations")
+    {
+        ds::vec<int> arr{1, 2, 3};
+        ds::apply_permutation(arr, ds::vec<unsigned>{0, 1, 2});
+        CHECK(arr == ds::vec{1, 2, 3});
+
+        ds::apply_permutation(arr, ds::vec<unsigned>{2, 1, 0});
+        CHECK(arr == ds::vec{3, 2, 1});
+
+        ds::vec<int> empty(0);
+        ds::apply_permutation(empty, ds::vec<unsigned>(0));
+        CHECK(empty.empty());
+    }
+
+    SECTION("Invalid permutations leave the vector alone")
+    {
+        ds::vec<int> arr{1, 2, 3};
+        CHECK_THROWS_AS(
+            ds::apply_permutation(arr, ds::vec<unsigned>{0, 0, 1}),
+            std::invalid_argument
+        );
+        CHECK_THROWS_AS(
+            ds::apply_permutation(arr, ds::vec<unsigned>{0, 1, 3}),
+            std::invalid_argument
+        );
+        CHECK_THROWS_AS(
+            ds::apply_permutation(arr, ds::vec<unsigned>{0, 1}), std::invalid_argument
+        );
+        CHECK(arr == ds::vec{1, 2, 3});
+    }
+}
@@ -0,0 +1,107 @@
+#include "libds/hash.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+/**
+ * @brief @p n pseudo-random bytes.
+ */
+std::vector<unsigned char>
+random_bytes(std::size_t n)
+{
+    std::vector<unsigned char> out(n);
+    std::uint32_t rng = 12345;
+    for (unsigned char& byte : out) {
+        rng = rng * 1664525U + 1013904223U;
+        byte = static_cast<unsigned char>(rng >> 24);
+    }
+    return out;
+}
+} // namespace
+
+TEST_CASE("Hashing bytes", "[hash]")
+{
+    const auto bytes = random_bytes(5000);
+
+    SECTION("Every length hashes differently, and depends on the seed")
+    {
+        std::unordered_set<std::uint64_t> seen;
+        for (std::size_t len = 0; len <= 1100; len++) {
+            seen.insert(ds::hash_bytes(bytes.data(), len));
+            seen.insert(ds::hash_bytes(bytes.data(), len, 42));
+        }
+        CHECK(seen.size() == 2 * 1101);
+    }
+
+    SECTION("Flipping any bit changes the hash")
+    {
+        for (std::size_t len : {3U, 16U, 17U, 100U, 256U, 257U, 1024U, 1025U, 5000U}) {
+            auto copy = random_bytes(len);
+            std::unordered_set<std::uint64_t> seen{ds::hash_bytes(copy.data(), len)};
+            for (std::size_t bit = 0; bit < len * 8; bit++) {
+                copy[bit / 8] ^= static_cast<unsigned char>(1U << (bit % 8));
+                seen.insert(ds::hash_bytes(copy.data(), len));
+                copy[bit / 8] ^= static_cast<unsigned char>(1U << (bit % 8));
+            }
+            CHECK(seen.size() == len * 8 + 1);
+        }
+    }
+
+    SECTION("The vectorised and scalar long paths agree")
+    {
+        const auto keys = ds::detail::hash_keys(7);
+        std::array<std::uint64_t, 8> fast = ds::detail::HASH_ACC_INIT;
+        std::array<std::uint64_t, 8> slow = ds::detail::HASH_ACC_INIT;
+        ds::detail::accumulate(fast.data(), bytes.data(), 70, 3, keys.data());
+        ds::detail::accumulate_scalar(slow.data(), bytes.data(), 70, 3, keys.data());
+        CHECK(fast == slow);
+    }
+
+    SECTION("Streaming gives the same hash")
+    {
+        for (std::size_t len : {0U, 1U, 64U, 255U, 256U, 257U, 320U, 321U, 1000U, 5000U}) {
+            for (std::size_t piece : {1U, 7U, 64U, 100U, 256U, 300U, 5000U}) {
+                ds::hasher state(99);
+                for (std::size_t at = 0; at < len; at += piece)
+                    state.update(bytes.data() + at, std::min(piece, len - at));
+                CHECK(state.digest() == ds::hash_bytes(bytes.data(), len, 99));
+            }
+        }
+
+        ds::hasher state;
+        for (std::size_t len = 1; len <= 600; len++) {
+            state.update(&bytes[len - 1], 1);
+            REQUIRE(state.digest() == ds::hash_bytes(bytes.data(), len));
+        }
+    }
+}
+
+TEST_CASE("Hashing vectors", "[hash]")
+{
+    const ds::vec<std::uint32_t> ids{1, 2, 3, 4};
+    CHECK(
+        std::hash<ds::vec<std::uint32_t>>{}(ids)
+        == ds::hash_bytes(ids.data(), ids.size() * sizeof(std::uint32_t))
+    );
+
+    ds::hasher state;
+    state.update(ds::span<const std::uint32_t>(ids));
+    CHECK(state.digest() == std::hash<ds::vec<std::uint32_t>>{}(ids));
+
+    const std::hash<ds::vec<double>> hash_doubles;
+    CHECK(hash_doubles(ds::vec{0.0, 1.5}) == hash_doubles(ds::vec{-0.0, 1.5}));
+    CHECK(hash_doubles(ds::vec{0.0, 1.5}) != hash_doubles(ds::vec{1.5, 0.0}));
+
+    std::unordered_set<ds::vec<std::string>> names;
+    names.insert(ds::vec<std::string>{"a", "b"});
+    names.insert(ds::vec<std::string>{"ab"});
+    names.insert(ds::vec<std::string>{"a", "b"});
+    CHECK(names.size() == 2);
+}
@@ -0,0 +1,126 @@
+#include "libds/live.hpp"
+
+#include "libds/vec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef LIBDS_REGISTRY
+#  error "registry tests must be built with LIBDS_REGISTRY"
+#endif
+
+namespace {
+
+struct wide {
+    std::uint64_t a;
+    std::uint64_t b;
+};
+
+const ds::live::type_usage*
+find_type(const ds::live::report& rep, const std::string& name)
+{
+    for (const auto& usage : rep.types) {
+        if (usage.type.find(name) != std::string::npos)
+            return &usage;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST_CASE("Registration", "[live]")
+{
+    auto before = ds::live::collect().instances;
+
+    SECTION("Construction and destruction")
+    {
+        {
+            ds::vec<int> arr(4);
+            ds::vec<int> copy(arr);
+            ds::vec<int> moved(std::move(copy));
+
+            CHECK(ds::live::collect().instances == before + 3);
+        }
+
+        CHECK(ds::live::collect().instances == before);
+    }
+
+    SECTION("Many instances across threads")
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([] {
+                // More than a block's worth per thread
+                std::vector<ds::vec<char>> vecs;
+                vecs.reserve(1000);
+                for (int i = 0; i < 1000; i++)
+                    vecs.emplace_back(1);
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        CHECK(ds::live::collect().instances == before);
+
+        std::vector<ds::vec<char>> vecs;
+        vecs.reserve(600);
+        for (int i = 0; i < 600; i++)
+            vecs.emplace_back(1);
+
+        CHECK(ds::live::collect().instances == before + 600);
+    }
+}
+
+TEST_CASE("Capacity accounting", "[live]")
+{
+    ds::vec<wide> sparse(100);
+    ds::vec<wide> full{wide{1, 2}, wide{3, 4}};
+
+    auto rep = ds::live::collect();
+    const auto* usage = find_type(rep, "wide");
+
+    REQUIRE(usage != nullptr);
+    CHECK(usage->element_size == sizeof(wide));
+    CHECK(usage->instances == 2);
+    CHECK(usage->capacity_bytes == 102 * sizeof(wide));
+    CHECK(usage->used_bytes == 2 * sizeof(wide));
+    CHECK(usage->wasted_bytes() == 100 * sizeof(wide));
+
+    // Biggest waster first
+    CHECK(&rep.types.front() == usage);
+    CHECK(rep.capacity_bytes >= usage->capacity_bytes);
+    CHECK(rep.wasted_bytes() >= usage->wasted_bytes());
+}
+
+TEST_CASE("Shrinking wasteful vectors", "[live]")
+{
+    ds::vec<wide> empty(64);
+    ds::vec<wide> half(4);
+    ds::vec<wide> full{wide{1, 2}};
+    half.insert(0, {wide{1, 2}, wide{3, 4}});
+
+    SECTION("Above a ratio")
+    {
+        auto released = ds::live::shrink_all_above(0.75);
+
+        CHECK(released >= 64 * sizeof(wide));
+        CHECK(empty.capacity() == 0);
+        CHECK(half.capacity() == 4);
+        CHECK(full.capacity() == 1);
+    }
+
+    SECTION("Everything")
+    {
+        ds::live::shrink_all_above(0.0);
+
+        CHECK(empty.capacity() == 0);
+        CHECK(half.capacity() == 2);
+        CHECK(half[1].b == 4);
+        CHECK(full.capacity() == 1);
+    }
+}
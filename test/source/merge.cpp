@@ -0,0 +1,116 @@
+#include "libds/merge.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+using tagged = std::pair<std::uint32_t, std::uint32_t>;
+
+/**
+ * @brief Compare only the keys of tagged elements, so the tags show stability.
+ */
+struct by_key {
+    bool
+    operator()(const tagged& lhs, const tagged& rhs) const noexcept
+    {
+        return lhs.first < rhs.first;
+    }
+};
+
+/**
+ * @brief @p count sorted runs of up to @p max_len elements with keys below
+ * @p keys, each tagged with its run and position.
+ */
+std::vector<ds::vec<tagged>>
+random_runs(std::size_t count, std::size_t max_len, std::uint32_t keys)
+{
+    std::vector<ds::vec<tagged>> runs;
+    std::uint32_t rng = 12345;
+    for (std::uint32_t run = 0; run < count; run++) {
+        rng = rng * 1664525U + 1013904223U;
+        const std::size_t len = (rng >> 8) % (max_len + 1);
+        ds::vec<tagged> elems(0);
+        for (std::size_t i = 0; i < len; i++) {
+            rng = rng * 1664525U + 1013904223U;
+            elems.insert(i, tagged{(rng >> 8) % keys, run});
+        }
+        std::sort(elems.begin(), elems.end(), by_key{});
+        runs.push_back(std::move(elems));
+    }
+    return runs;
+}
+
+void
+check_merge(const std::vector<ds::vec<tagged>>& runs, std::size_t threads)
+{
+    std::vector<tagged> expected;
+    std::vector<ds::span<const tagged>> views;
+    for (const auto& run : runs) {
+        expected.insert(expected.end(), run.begin(), run.end());
+        views.emplace_back(run);
+    }
+    std::stable_sort(expected.begin(), expected.end(), by_key{});
+
+    ds::vec<tagged> out{tagged{}};
+    ds::merge_k(
+        ds::span<const ds::span<const tagged>>(views.data(), views.size()), out,
+        by_key{}, threads
+    );
+    CHECK(std::vector<tagged>(out.begin(), out.end()) == expected);
+}
+} // namespace
+
+TEST_CASE("Merging sorted runs", "[merge]")
+{
+    SECTION("Any number of runs, with ties and empty runs")
+    {
+        for (std::size_t count : {1U, 2U, 3U, 5U, 8U, 33U}) {
+            check_merge(random_runs(count, 50, 10), 1);
+            check_merge(random_runs(count, 500, 1000), 1);
+        }
+        check_merge({}, 1);
+        check_merge(random_runs(4, 0, 1), 1);
+    }
+
+    SECTION("Long streaks from one run")
+    {
+        ds::vec<int> low(0);
+        ds::vec<int> high(0);
+        ds::vec<int> mixed(0);
+        for (int i = 0; i < 1000; i++) {
+            low.insert(low.size(), i);
+            high.insert(high.size(), 2000 + i);
+            mixed.insert(mixed.size(), i * 3);
+        }
+
+        ds::vec<int> out(0);
+        ds::merge_k({high, low, mixed}, out);
+        std::vector<int> expected(low.begin(), low.end());
+        expected.insert(expected.end(), high.begin(), high.end());
+        expected.insert(expected.end(), mixed.begin(), mixed.end());
+        std::sort(expected.begin(), expected.end());
+        CHECK(std::vector<int>(out.begin(), out.end()) == expected);
+    }
+
+    SECTION("Non-trivial elements and a custom order")
+    {
+        const ds::vec<std::string> a{"pear", "fig", "apple"};
+        const ds::vec<std::string> b{"plum", "kiwi"};
+        ds::vec<std::string> out(0);
+        ds::merge_k({a, b}, out, std::greater<>{});
+        CHECK(out == ds::vec<std::string>{"plum", "pear", "kiwi", "fig", "apple"});
+    }
+
+    SECTION("In parallel")
+    {
+        check_merge(random_runs(16, 20000, 100), 4);
+        check_merge(random_runs(3, 60000, 1 << 30), 3);
+        check_merge(random_runs(100, 2000, 1), 4);
+        check_merge(random_runs(2, 100, 10), 4);
+    }
+}
@@ -0,0 +1,145 @@
+#include "libds/numa.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+struct bind_call {
+    std::uintptr_t addr;
+    std::size_t bytes;
+    ds::numa_policy policy;
+    bool move;
+};
+
+struct recording_binder {
+    std::vector<bind_call>* calls;
+
+    bool
+    bind(void* addr, std::size_t bytes, const ds::numa_policy& policy, bool move)
+        const noexcept
+    {
+        calls->push_back({reinterpret_cast<std::uintptr_t>(addr), bytes, policy, move});
+        return true;
+    }
+};
+
+constexpr std::size_t PAGE = 4096;
+} // namespace
+
+TEST_CASE("NUMA policies", "[numa]")
+{
+    CHECK(ds::numa_policy::local().mode == ds::numa_mode::local);
+    CHECK(ds::numa_policy::interleave().nodes == ~std::uint64_t{0});
+    CHECK(ds::numa_policy::interleave(0b101).nodes == 0b101);
+    CHECK(ds::numa_policy::bind(3).mode == ds::numa_mode::bind);
+    CHECK(ds::numa_policy::bind(3).nodes == 0b1000);
+    CHECK(ds::numa_policy::bind(63).nodes == std::uint64_t{1} << 63U);
+    CHECK_THROWS_AS(ds::numa_policy::bind(64), std::out_of_range);
+
+    SECTION("Binding a vector covers its whole pages")
+    {
+        std::vector<bind_call> calls;
+        ds::vec<double, PAGE> arr(PAGE); // 8 pages
+
+        CHECK(ds::numa_bind(arr, ds::numa_policy::bind(0), recording_binder{&calls}));
+        REQUIRE(calls.size() == 1);
+        CHECK(calls[0].addr == reinterpret_cast<std::uintptr_t>(arr.data()));
+        CHECK(calls[0].bytes == PAGE * sizeof(double));
+        CHECK(calls[0].policy.mode == ds::numa_mode::bind);
+        CHECK(calls[0].move);
+    }
+
+    SECTION("Partial pages are left alone")
+    {
+        std::vector<bind_call> calls;
+        ds::vec<char, PAGE> arr(PAGE + 100);
+        ds::vec<char, PAGE> small(100);
+
+        ds::numa_bind(arr, ds::numa_policy::local(), recording_binder{&calls});
+        ds::numa_bind(small, ds::numa_policy::local(), recording_binder{&calls});
+        REQUIRE(calls.size() == 1);
+        CHECK(calls[0].bytes == PAGE);
+    }
+
+    SECTION("Making a vector binds before writing")
+    {
+        std::vector<bind_call> calls;
+        bool applied = false;
+        auto arr = ds::make_numa_vec<int, PAGE>(
+            10 * PAGE, 7, ds::numa_policy::interleave(), 4, recording_binder{&calls},
+            &applied
+        );
+
+        CHECK(applied);
+        REQUIRE(calls.size() == 1);
+        CHECK(calls[0].addr == reinterpret_cast<std::uintptr_t>(arr.data()));
+        CHECK(calls[0].bytes == 10 * PAGE * sizeof(int));
+        CHECK(calls[0].policy.mode == ds::numa_mode::interleave);
+        CHECK_FALSE(calls[0].move);
+
+        REQUIRE(arr.size() == 10 * PAGE);
+        bool all_seven = true;
+        for (int elem : arr)
+            all_seven = all_seven && elem == 7;
+        CHECK(all_seven);
+    }
+
+    SECTION("Without NUMA support the vector is still made")
+    {
+        bool applied = true;
+        auto arr = ds::make_numa_vec(
+            PAGE, 15, ds::numa_policy::bind(0), 2, ds::null_binder{}, &applied
+        );
+        CHECK_FALSE(applied);
+        CHECK(arr.size() == PAGE);
+        CHECK(arr.back() == 15);
+
+        // Single-node machines and kernels without NUMA may refuse, but must not
+        // crash
+        ds::vec<double, PAGE> page_aligned(PAGE);
+        CHECK_NOTHROW(ds::numa_bind(page_aligned, ds::numa_policy::local()));
+    }
+}
+
+TEST_CASE("Parallel first-touch", "[numa]")
+{
+    SECTION("Trivial elements")
+    {
+        ds::vec<unsigned> arr(10001, 3U, 4);
+        REQUIRE(arr.size() == 10001);
+        CHECK(arr[0] == 3);
+        CHECK(arr[5000] == 3);
+        CHECK(arr[10000] == 3);
+
+        arr.resize(20000, 4U, 3);
+        REQUIRE(arr.size() == 20000);
+        CHECK(arr[10000] == 3);
+        CHECK(arr[10001] == 4);
+        CHECK(arr[19999] == 4);
+
+        arr.resize(5);
+        CHECK(arr.size() == 5);
+        arr.resize(7);
+        CHECK(arr[6] == 0);
+    }
+
+    SECTION("Copying an element of the vector itself")
+    {
+        ds::vec<unsigned> arr{1, 2, 3};
+        arr.resize(1000, arr[1], 4);
+        CHECK(arr[999] == 2);
+    }
+
+    SECTION("Elements that may throw are copied on one thread")
+    {
+        ds::vec<std::string> arr(3, "a string that does not fit inline", 4);
+        arr.resize(100, "another string that does not fit inline", 4);
+        CHECK(arr[2] == "a string that does not fit inline");
+        CHECK(arr[99] == "another string that does not fit inline");
+    }
+}
@@ -0,0 +1,75 @@
+#include "libds/perf_scope.hpp"
+
+#include "libds/vec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace {
+
+unsigned
+busy_work()
+{
+    ds::vec<unsigned> arr(0);
+    for (unsigned i = 0; i < 10000; i++)
+        arr.insert(arr.size(), i);
+
+    unsigned sum = 0;
+    for (const auto& val : arr)
+        sum += val;
+    return sum;
+}
+
+} // namespace
+
+TEST_CASE("Event names", "[perf_scope]")
+{
+    CHECK(std::string(ds::perf_event_name(ds::perf_event::cycles)) == "cycles");
+    CHECK(
+        std::string(ds::perf_event_name(ds::perf_event::dtlb_misses))
+        == "dtlb_misses"
+    );
+}
+
+TEST_CASE("Recording a scope", "[perf_scope]")
+{
+    ds::perf_counts counts;
+    bool available = false;
+    {
+        ds::perf_scope scope(counts);
+        available = scope.available();
+        CHECK(busy_work() != 0);
+    }
+
+    if (!available) {
+        // Degrades to recording nothing
+        for (std::size_t i = 0; i < ds::PERF_EVENT_COUNT; i++) {
+            CHECK_FALSE(counts.valid[i]);
+            CHECK(counts.values[i] == 0);
+        }
+        return;
+    }
+
+    if (counts.has(ds::perf_event::instructions))
+        CHECK(counts[ds::perf_event::instructions] > 10000);
+    if (counts.has(ds::perf_event::cycles))
+        CHECK(counts[ds::perf_event::cycles] > 0);
+}
+
+TEST_CASE("Reading without stopping", "[perf_scope]")
+{
+    ds::perf_scope scope;
+
+    auto first = scope.read();
+    CHECK(busy_work() != 0);
+    auto second = scope.read();
+
+    if (first.has(ds::perf_event::instructions)) {
+        CHECK(
+            second[ds::perf_event::instructions]
+            >= first[ds::perf_event::instructions]
+        );
+    }
+}
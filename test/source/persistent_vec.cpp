@@ -0,0 +1,222 @@
+#include "libds/persistent_vec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+template <class T>
+bool
+matches(const ds::persistent_vec<T>& arr, const std::vector<T>& ref)
+{
+    if (arr.size() != ref.size())
+        return false;
+
+    std::vector<T> scanned;
+    arr.for_each_segment([&](ds::span<const T> segment) {
+        scanned.insert(scanned.end(), segment.begin(), segment.end());
+    });
+    for (std::size_t i = 0; i < ref.size(); i++) {
+        if (arr[i] != ref[i])
+            return false;
+    }
+    return scanned == ref;
+}
+
+} // namespace
+
+TEST_CASE("Versions share structure", "[persistent_vec]")
+{
+    ds::persistent_vec<unsigned> empty;
+    REQUIRE(empty.empty());
+
+    std::vector<ds::persistent_vec<unsigned>> versions{empty};
+    for (unsigned i = 0; i < 5000; i++)
+        versions.push_back(versions.back().push_back(i));
+
+    for (unsigned i = 0; i <= 5000; i += 250) {
+        REQUIRE(versions[i].size() == i);
+        if (i > 0)
+            CHECK(versions[i].back() == i - 1);
+    }
+
+    SECTION("Setting copies only one path")
+    {
+        const auto& full = versions.back();
+        const auto changed = full.set(1234, 0).set(4999, 1);
+
+        CHECK(full[1234] == 1234);
+        CHECK(full[4999] == 4999);
+        CHECK(changed[1234] == 0);
+        CHECK(changed[4999] == 1);
+        CHECK(changed[1235] == 1235);
+        CHECK(changed != full);
+        CHECK_THROWS_AS(full.set(5000, 0), std::out_of_range);
+    }
+
+    SECTION("Popping")
+    {
+        auto arr = versions.back();
+        for (unsigned i = 0; i < 100; i++)
+            arr = arr.pop_back();
+
+        CHECK(arr == versions[4900]);
+        CHECK(versions.back().size() == 5000);
+    }
+}
+
+TEST_CASE("Concatenation and slicing", "[persistent_vec]")
+{
+    std::vector<unsigned> ref;
+    ds::persistent_vec<unsigned> arr;
+    for (unsigned i = 0; i < 3000; i++) {
+        ref.push_back(i);
+        arr = arr.push_back(i);
+    }
+
+    SECTION("Concatenation")
+    {
+        const auto twice = arr.concat(arr);
+        std::vector<unsigned> expected(ref);
+        expected.insert(expected.end(), ref.begin(), ref.end());
+
+        CHECK(matches(twice, expected));
+        CHECK(matches(arr, ref));
+        CHECK(arr.concat({}) == arr);
+        CHECK(ds::persistent_vec<unsigned>{}.concat(arr) == arr);
+    }
+
+    SECTION("Slicing")
+    {
+        const auto middle = arr.slice(1000, 1234);
+        CHECK(matches(middle, std::vector<unsigned>(&ref[1000], &ref[2234])));
+        const std::vector<unsigned> end(&ref[2990], &ref[3000]);
+        CHECK(matches(arr.slice(2990, 10), end));
+        CHECK(arr.slice(0, 0).empty());
+        CHECK(arr.slice(3, 0).empty());
+        CHECK(arr.slice(1500, 0).empty());
+        CHECK(arr.slice(arr.size(), 0).empty());
+        CHECK(arr.slice(0, 3000) == arr);
+        CHECK_THROWS_AS(arr.slice(2000, 1001), std::out_of_range);
+
+        // Slices can still grow
+        const auto grown = middle.push_back(7);
+        CHECK(grown.size() == 1235);
+        CHECK(grown.back() == 7);
+        CHECK(grown[1233] == 2233);
+    }
+
+    SECTION("Matches std::vector")
+    {
+        std::vector<ds::persistent_vec<unsigned>> versions{arr};
+        std::vector<std::vector<unsigned>> refs{ref};
+        std::uint32_t rng = 1;
+
+        for (unsigned step = 0; step < 400; step++) {
+            rng = rng * 1664525U + 1013904223U;
+            const auto& base = versions[(rng >> 8) % versions.size()];
+            auto expected = refs[(rng >> 8) % refs.size()];
+            const std::size_t size = expected.size();
+            const auto pos = static_cast<std::size_t>(rng >> 4) % (size + 1);
+            const auto off = static_cast<std::ptrdiff_t>(pos);
+
+            ds::persistent_vec<unsigned> next;
+            switch (rng % 5) {
+                case 0:
+                    next = base.concat(base.slice(0, pos));
+                    expected.insert(
+                        expected.end(), expected.begin(), expected.begin() + off
+                    );
+                    break;
+                case 1:
+                    next = base.slice(pos, (size - pos) / 2);
+                    expected.resize(pos + (size - pos) / 2);
+                    expected.erase(expected.begin(), expected.begin() + off);
+                    break;
+                case 2:
+                    if (pos == size)
+                        continue;
+                    next = base.set(pos, step);
+                    expected[pos] = step;
+                    break;
+                case 3:
+                    next = base.slice(pos, size - pos).concat(base.slice(0, pos));
+                    std::rotate(
+                        expected.begin(), expected.begin() + off, expected.end()
+                    );
+                    break;
+                default:
+                    next = base;
+                    for (unsigned i = 0; i < pos % 100; i++) {
+                        next = next.push_back(i);
+                        expected.push_back(i);
+                    }
+                    break;
+            }
+
+            REQUIRE(matches(next, expected));
+            versions.push_back(next);
+            refs.push_back(expected);
+        }
+
+        // No version was changed by the ones derived from it
+        for (std::size_t i = 0; i < versions.size(); i++)
+            REQUIRE(matches(versions[i], refs[i]));
+    }
+}
+
+TEST_CASE("Transient batches", "[persistent_vec]")
+{
+    const ds::persistent_vec<unsigned> base(100, 1);
+    auto batch = base.transient();
+
+    for (unsigned i = 0; i < 1000; i++)
+        batch.push_back(i);
+    batch.set(0, 5);
+    batch.pop_back();
+
+    const auto first = batch.persistent();
+    batch.set(1, 6);
+    batch.push_back(7);
+
+    CHECK(base == ds::persistent_vec<unsigned>(100, 1));
+    REQUIRE(first.size() == 1099);
+    CHECK(first[0] == 5);
+    CHECK(first[1] == 1);
+    CHECK(first.back() == 998);
+
+    const auto second = batch.persistent();
+    CHECK(second.size() == 1100);
+    CHECK(second[1] == 6);
+    CHECK(second.back() == 7);
+    CHECK_THROWS_AS(batch.set(1100, 0), std::out_of_range);
+}
+
+TEST_CASE("Non-trivial persistent elements", "[persistent_vec]")
+{
+    ds::persistent_vec<std::string> arr{"a", "b"};
+    for (unsigned i = 0; i < 100; i++)
+        arr = arr.push_back(std::string(i, 'x'));
+
+    const auto sliced = arr.slice(30, 40);
+    const auto joined = sliced.concat(arr).set(0, "c");
+
+    CHECK(arr[0] == "a");
+    CHECK(sliced[0] == std::string(28, 'x'));
+    CHECK(joined.size() == 142);
+    CHECK(joined[0] == "c");
+    CHECK(joined[41] == "b");
+    CHECK(joined.back() == std::string(99, 'x'));
+
+    const ds::vec<std::string> source{"d", "e"};
+    CHECK(
+        ds::persistent_vec<std::string>(source)
+        == ds::persistent_vec<std::string>{"d", "e"}
+    );
+}
@@ -0,0 +1,105 @@
+#include "libds/ragged_vec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+
+#include <list>
+#include <string>
+#include <vector>
+
+TEST_CASE("Ragged rows", "[ragged_vec]")
+{
+    ds::ragged_vec<unsigned> arr{{1, 2, 3}, {}, {4}};
+
+    REQUIRE(arr.size() == 3);
+    CHECK(arr.value_count() == 4);
+    CHECK(arr.row_size(0) == 3);
+    CHECK(arr[1].empty());
+    CHECK(arr[2][0] == 4);
+    CHECK_THROWS_AS(arr.row(3), std::out_of_range);
+
+    SECTION("Pushing rows from ranges")
+    {
+        const std::vector<unsigned> vector{5, 6};
+        const std::list<unsigned> list{7, 8, 9};
+
+        arr.push_row(vector);
+        arr.push_row(list);
+        auto row = arr.push_row({10});
+        row[0] = 11;
+
+        const ds::ragged_vec<unsigned> expected{
+            {1, 2, 3}, {}, {4}, {5, 6}, {7, 8, 9}, {11}
+        };
+        CHECK(arr == expected);
+        CHECK(arr.ends()[5] == arr.value_count());
+    }
+
+    SECTION("Pushing its own rows")
+    {
+        for (int i = 0; i < 4; i++)
+            arr.push_row(arr[0]);
+        arr.push_row(arr[2]);
+
+        const ds::ragged_vec<unsigned> expected{
+            {1, 2, 3}, {}, {4}, {1, 2, 3}, {1, 2, 3}, {1, 2, 3}, {1, 2, 3}, {4}
+        };
+        CHECK(arr == expected);
+    }
+
+    SECTION("Rows are views of one buffer")
+    {
+        arr[0][1] = 20;
+        CHECK(arr.values()[1] == 20);
+        CHECK(arr[2].data() == arr.values().data() + 3);
+    }
+
+    SECTION("Clearing")
+    {
+        arr.clear();
+        CHECK(arr.empty());
+        CHECK(arr.value_count() == 0);
+    }
+}
+
+TEST_CASE("Joining ragged parts", "[ragged_vec]")
+{
+    constexpr std::size_t PARTS = 4;
+    std::vector<ds::ragged_vec<std::size_t>> parts(PARTS);
+    ds::ragged_vec<std::size_t> expected;
+
+    for (std::size_t part = 0; part < PARTS; part++) {
+        for (std::size_t i = 0; i < 100; i++) {
+            const std::vector<std::size_t> row(i % 7, part * 1000 + i);
+            parts[part].push_row(row);
+            expected.push_row(row);
+        }
+    }
+    parts.emplace_back();
+
+    const ds::span<const ds::ragged_vec<std::size_t>> view(parts.data(), parts.size());
+    CHECK(ds::ragged_vec<std::size_t>::join(view) == expected);
+    CHECK(ds::ragged_vec<std::size_t>::join(view, 3) == expected);
+    CHECK(ds::ragged_vec<std::size_t>::join({}, 2).empty());
+}
+
+TEST_CASE("Non-trivial ragged elements", "[ragged_vec]")
+{
+    ds::ragged_vec<std::string> docs;
+    docs.push_row({"the", "quick", "fox"});
+    docs.push_row(std::vector<std::string>{"jumps"});
+
+    const std::vector<ds::ragged_vec<std::string>> parts{docs, docs};
+    const auto joined = ds::ragged_vec<std::string>::join(
+        ds::span<const ds::ragged_vec<std::string>>(parts.data(), parts.size()), 2
+    );
+
+    REQUIRE(joined.size() == 4);
+    CHECK(joined[2][1] == "quick");
+    CHECK(joined[3][0] == "jumps");
+
+    docs.push_row(docs[0]);
+    REQUIRE(docs.size() == 3);
+    CHECK(docs[2][2] == "fox");
+}
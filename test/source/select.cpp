@@ -0,0 +1,168 @@
+#include "libds/select.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+/**
+ * @brief @p n values out of @p distinct different ones.
+ */
+template <class T>
+ds::vec<T>
+random_values(std::size_t n, std::uint32_t distinct)
+{
+    ds::vec<T> out(n);
+    std::uint32_t rng = 12345;
+    for (std::size_t i = 0; i < n; i++) {
+        rng = rng * 1664525U + 1013904223U;
+        const std::uint32_t val = (rng >> 4) % distinct;
+        if constexpr (std::is_same_v<T, std::string>)
+            out.insert(i, std::to_string(val));
+        else if constexpr (std::is_signed_v<T>)
+            out.insert(i, static_cast<T>(val) - static_cast<T>(distinct / 2));
+        else
+            out.insert(i, static_cast<T>(val));
+    }
+    return out;
+}
+
+/**
+ * @brief Whether neither of @p lhs and @p rhs orders before the other.
+ *
+ * Selecting only moves elements, so floating-point ones must match exactly.
+ */
+template <class T>
+bool
+same_value(const T& lhs, const T& rhs)
+{
+    return !(lhs < rhs) && !(rhs < lhs);
+}
+
+template <class T, class Compare = std::less<>>
+void
+check_nth(const ds::vec<T>& input, std::size_t nth, Compare cmp = {})
+{
+    ds::vec<T> v = input;
+    ds::nth_element(v, nth, cmp);
+
+    std::vector<T> sorted(input.begin(), input.end());
+    std::sort(sorted.begin(), sorted.end(), cmp);
+    REQUIRE(same_value(v[nth], sorted[nth]));
+    CHECK(std::none_of(v.begin(), v.begin() + nth, [&](const T& elem) {
+        return cmp(v[nth], elem);
+    }));
+    CHECK(std::none_of(v.begin() + nth, v.end(), [&](const T& elem) {
+        return cmp(elem, v[nth]);
+    }));
+    std::sort(v.begin(), v.end(), cmp);
+    CHECK(std::vector<T>(v.begin(), v.end()) == sorted);
+}
+
+template <class T, class Compare = std::less<>>
+void
+check_partial_sort(const ds::vec<T>& input, std::size_t k, Compare cmp = {})
+{
+    ds::vec<T> v = input;
+    ds::partial_sort(v, k, cmp);
+
+    std::vector<T> sorted(input.begin(), input.end());
+    std::sort(sorted.begin(), sorted.end(), cmp);
+    k = std::min(k, sorted.size());
+    CHECK(std::equal(v.begin(), v.begin() + k, sorted.begin()));
+    std::sort(v.begin(), v.end(), cmp);
+    CHECK(std::vector<T>(v.begin(), v.end()) == sorted);
+}
+
+template <class T, class Compare = std::greater<>>
+void
+check_top_k(
+    const ds::vec<T>& v, std::size_t k, Compare cmp = {}, std::size_t threads = 1
+)
+{
+    const ds::vec<T> before = v;
+    const ds::vec<T> top = ds::top_k(v, k, cmp, threads);
+
+    std::vector<T> sorted(v.begin(), v.end());
+    std::sort(sorted.begin(), sorted.end(), cmp);
+    sorted.resize(std::min(k, sorted.size()));
+    CHECK(std::vector<T>(top.begin(), top.end()) == sorted);
+    CHECK(std::equal(v.begin(), v.end(), before.begin(), before.end(), same_value<T>));
+}
+} // namespace
+
+TEST_CASE("Selecting the nth element", "[select]")
+{
+    SECTION("Every element type, with and without duplicates")
+    {
+        for (std::size_t n : {1U, 2U, 100U, 5000U, 100000U}) {
+            for (std::uint32_t distinct : {1U, 10U, 1000000U}) {
+                for (std::size_t nth : {std::size_t{0}, n / 3, n - 1}) {
+                    check_nth(random_values<std::uint32_t>(n, distinct), nth);
+                    check_nth(random_values<std::int64_t>(n, distinct), nth);
+                    check_nth(random_values<double>(n, distinct), nth);
+                }
+            }
+        }
+        check_nth(random_values<std::string>(20000, 5000), 12345);
+    }
+
+    SECTION("Sorted input and a custom order")
+    {
+        ds::vec<int> v(0);
+        for (int i = 0; i < 50000; i++)
+            v.insert(v.size(), i);
+        check_nth(v, 30000);
+        check_nth(v, 30000, std::greater<>{});
+    }
+
+    SECTION("Out of range")
+    {
+        ds::vec<int> v{1, 2, 3};
+        CHECK_THROWS_AS(ds::nth_element(v, 3), std::out_of_range);
+    }
+}
+
+TEST_CASE("Partial sorting", "[select]")
+{
+    for (std::size_t k : {0U, 1U, 5U, 100U, 5000U, 20000U, 30000U}) {
+        check_partial_sort(random_values<std::uint32_t>(20000, 1000000), k);
+        check_partial_sort(random_values<std::int32_t>(20000, 50), k);
+        check_partial_sort(random_values<float>(20000, 1000), k, std::greater<>{});
+        check_partial_sort(random_values<std::string>(3000, 1000), k);
+    }
+}
+
+TEST_CASE("Top-k selection", "[select]")
+{
+    SECTION("Small and large k, every element type")
+    {
+        for (std::size_t k : {0U, 1U, 10U, 100U, 3000U, 50000U, 60000U}) {
+            check_top_k(random_values<std::uint32_t>(50000, 1000000), k);
+            check_top_k(random_values<std::uint64_t>(50000, 1000000), k);
+            check_top_k(random_values<std::int32_t>(50000, 100), k);
+            check_top_k(random_values<std::int64_t>(50000, 1000000), k, std::less<>{});
+            check_top_k(random_values<double>(50000, 1000000), k);
+            check_top_k(random_values<float>(50000, 1000000), k, std::less<>{});
+        }
+        check_top_k(random_values<std::string>(5000, 1000), 20);
+        CHECK(ds::top_k(random_values<std::uint32_t>(100, 10), 0).empty());
+    }
+
+    SECTION("In parallel")
+    {
+        const auto v = random_values<std::uint32_t>(300000, 1000000);
+        check_top_k(v, 100, std::greater<>{}, 4);
+        check_top_k(v, 1, std::less<>{}, 3);
+        check_top_k(v, 0, std::greater<>{}, 4);
+        CHECK(ds::top_k(v, 0, std::greater<>{}, 4).empty());
+        check_top_k(random_values<double>(300000, 100), 1000, std::greater<>{}, 4);
+    }
+}
@@ -0,0 +1,150 @@
+#include "libds/set_ops.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+/**
+ * @brief A sorted set of about @p n values, each of [0, @p n * @p spread)
+ * picked with probability 1 / @p spread.
+ */
+template <class T, class Compare = std::less<>>
+ds::vec<T>
+random_set(std::size_t n, std::uint32_t spread, std::uint32_t seed, Compare cmp = {})
+{
+    ds::vec<T> out(0);
+    std::uint32_t rng = seed;
+    for (std::size_t val = 0; val < n * spread; val++) {
+        rng = rng * 1664525U + 1013904223U;
+        if ((rng >> 8) % spread != 0)
+            continue;
+        if constexpr (std::is_same_v<T, std::string>)
+            out.insert(out.size(), std::to_string(val));
+        else
+            out.insert(out.size(), static_cast<T>(val) - static_cast<T>(n));
+    }
+    std::sort(out.begin(), out.end(), cmp);
+    return out;
+}
+
+template <class T, class Compare = std::less<>>
+void
+check_sets(const ds::vec<T>& a, const ds::vec<T>& b, Compare cmp = {})
+{
+    std::vector<T> expected;
+    ds::vec<T> out{T{}};
+
+    std::set_intersection(
+        a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected), cmp
+    );
+    ds::set_intersection(a, b, out, cmp);
+    CHECK(std::vector<T>(out.begin(), out.end()) == expected);
+    CHECK(ds::intersection_size(a, b, cmp) == expected.size());
+
+    expected.clear();
+    std::set_union(
+        a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected), cmp
+    );
+    ds::set_union(a, b, out, cmp);
+    CHECK(std::vector<T>(out.begin(), out.end()) == expected);
+
+    expected.clear();
+    std::set_difference(
+        a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected), cmp
+    );
+    ds::set_difference(a, b, out, cmp);
+    CHECK(std::vector<T>(out.begin(), out.end()) == expected);
+}
+
+template <class T>
+void
+check_sizes()
+{
+    for (std::size_t n : {0U, 1U, 7U, 8U, 9U, 100U, 3000U}) {
+        for (std::size_t m : {0U, 1U, 8U, 17U, 100U, 3000U}) {
+            for (std::uint32_t spread : {1U, 2U, 5U}) {
+                const auto a = random_set<T>(n, spread, 1);
+                const auto b = random_set<T>(m, spread, 2);
+                check_sets(a, b);
+                check_sets(b, a);
+            }
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("Two-way set operations", "[set_ops]")
+{
+    SECTION("Every element type, similar and skewed sizes")
+    {
+        check_sizes<std::uint32_t>();
+        check_sizes<std::int32_t>();
+        check_sizes<std::uint64_t>();
+        check_sizes<std::string>();
+    }
+
+    SECTION("Identical and disjoint sets")
+    {
+        const auto a = random_set<std::uint32_t>(1000, 2, 1);
+        check_sets(a, a);
+
+        ds::vec<std::uint32_t> odd(0);
+        ds::vec<std::uint32_t> even(0);
+        for (std::uint32_t i = 0; i < 1000; i++)
+            (i % 2 == 0 ? even : odd).insert(i / 2, i);
+        check_sets(odd, even);
+    }
+
+    SECTION("Custom order")
+    {
+        const std::greater<> cmp;
+        const auto a = random_set<std::int32_t>(500, 3, 1, cmp);
+        const auto b = random_set<std::int32_t>(500, 3, 2, cmp);
+        check_sets(a, b, cmp);
+    }
+}
+
+TEST_CASE("Multi-way intersection", "[set_ops]")
+{
+    const auto a = random_set<std::uint32_t>(5000, 2, 1);
+    const auto b = random_set<std::uint32_t>(3000, 3, 2);
+    const auto c = random_set<std::uint32_t>(200, 50, 3);
+    const auto d = random_set<std::uint32_t>(4000, 2, 4);
+
+    std::vector<std::uint32_t> expected(a.begin(), a.end());
+    for (const auto* set : {&b, &c, &d}) {
+        std::vector<std::uint32_t> next;
+        std::set_intersection(
+            expected.begin(), expected.end(), set->begin(), set->end(),
+            std::back_inserter(next)
+        );
+        expected = next;
+    }
+    REQUIRE(!expected.empty());
+
+    ds::vec<std::uint32_t> out(0);
+    ds::set_intersection({a, b, c, d}, out);
+    CHECK(std::vector<std::uint32_t>(out.begin(), out.end()) == expected);
+
+    const std::vector<ds::span<const std::uint32_t>> lists{d, c, a, b};
+    ds::set_intersection(
+        ds::span<const ds::span<const std::uint32_t>>(lists.data(), lists.size()), out
+    );
+    CHECK(std::vector<std::uint32_t>(out.begin(), out.end()) == expected);
+
+    ds::set_intersection({a}, out);
+    CHECK(out == a);
+
+    ds::set_intersection({a, ds::vec<std::uint32_t>(0), b}, out);
+    CHECK(out.empty());
+
+    ds::set_intersection<std::uint32_t>({}, out);
+    CHECK(out.empty());
+}
@@ -0,0 +1,182 @@
+#include "libds/span.hpp"
+
+#include "libds/vec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+
+namespace {
+
+unsigned
+sum(ds::span<const unsigned> view)
+{
+    unsigned total = 0;
+    for (const auto& val : view)
+        total += val;
+    return total;
+}
+
+} // namespace
+
+TEST_CASE("Construction", "[span]")
+{
+    ds::vec<unsigned> arr{1, 2, 3, 4, 5};
+
+    SECTION("Empty")
+    {
+        ds::span<unsigned> view;
+
+        CHECK(view.empty());
+        CHECK(view.data() == nullptr);
+        CHECK(view.begin() == view.end());
+    }
+
+    SECTION("From a vector")
+    {
+        ds::span view = arr;
+
+        CHECK(view.size() == 5);
+        CHECK(view.size_bytes() == 5 * sizeof(unsigned));
+        CHECK(view.data() == arr.data());
+
+        // Writes go through to the vector
+        view[0] = 10;
+        CHECK(arr[0] == 10);
+    }
+
+    SECTION("From a const vector")
+    {
+        const auto& carr = arr;
+        ds::span view = carr;
+
+        CHECK(view.size() == 5);
+        CHECK(view.data() == arr.data());
+    }
+
+    SECTION("Implicit conversions")
+    {
+        CHECK(sum(arr) == 15);
+
+        ds::span<unsigned> view = arr;
+        CHECK(sum(view) == 15);
+    }
+}
+
+TEST_CASE("Span accessors", "[span]")
+{
+    ds::vec<unsigned> arr{1, 2, 3, 4, 5};
+    ds::span<unsigned> view = arr;
+
+    for (std::size_t i = 0; i < view.size(); i++)
+        CHECK(view.at(i) == i + 1);
+
+    CHECK_THROWS_AS(view.at(5), std::out_of_range);
+    CHECK(view.front() == 1);
+    CHECK(view.back() == 5);
+}
+
+TEST_CASE("Subviews", "[span]")
+{
+    ds::vec<unsigned> arr{1, 2, 3, 4, 5};
+
+    SECTION("Slice")
+    {
+        auto view = arr.slice(1, 3);
+
+        REQUIRE(view.size() == 3);
+        CHECK(view.data() == arr.data() + 1);
+        CHECK(view[0] == 2);
+        CHECK(view[2] == 4);
+
+        CHECK(arr.slice(5, 0).empty());
+        CHECK_THROWS_AS(arr.slice(4, 2), std::out_of_range);
+        CHECK_THROWS_AS(arr.slice(6, 0), std::out_of_range);
+    }
+
+    SECTION("First/last")
+    {
+        ds::span<unsigned> view = arr;
+
+        CHECK(sum(view.first(2)) == 3);
+        CHECK(sum(view.last(2)) == 9);
+        CHECK_THROWS_AS(view.first(6), std::out_of_range);
+        CHECK_THROWS_AS(view.last(6), std::out_of_range);
+    }
+
+    SECTION("Split")
+    {
+        auto [left, right] = arr.split_at(2);
+
+        CHECK(left.size() == 2);
+        CHECK(right.size() == 3);
+        CHECK(left.data() == arr.data());
+        CHECK(right.data() == arr.data() + 2);
+
+        CHECK(arr.split_at(0).first.empty());
+        CHECK(arr.split_at(5).second.empty());
+        CHECK_THROWS_AS(arr.split_at(6), std::out_of_range);
+    }
+}
+
+TEST_CASE("Chunks", "[span]")
+{
+    ds::vec<unsigned> arr{1, 2, 3, 4, 5};
+
+    SECTION("Uneven")
+    {
+        auto chunks = arr.chunks(2);
+        ds::vec<unsigned> sums(0);
+
+        REQUIRE(chunks.size() == 3);
+        for (auto chunk : chunks)
+            sums.insert(sums.size(), sum(chunk));
+
+        CHECK(sums == ds::vec<unsigned>{3, 7, 5});
+    }
+
+    SECTION("Writable")
+    {
+        for (auto chunk : arr.chunks(3))
+            chunk.front() = 0;
+
+        CHECK(arr == ds::vec<unsigned>{0, 2, 3, 0, 5});
+    }
+
+    SECTION("Edge cases")
+    {
+        CHECK(arr.chunks(5).size() == 1);
+        CHECK(arr.chunks(10).size() == 1);
+        CHECK(ds::vec<unsigned>(0).chunks(3).size() == 0);
+        CHECK(ds::vec<unsigned>(0).chunks(3).begin()
+              == ds::vec<unsigned>(0).chunks(3).end());
+        CHECK_THROWS_AS(arr.chunks(0), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Windows", "[span]")
+{
+    const ds::vec<unsigned> arr{1, 2, 3, 4, 5};
+
+    SECTION("Sliding")
+    {
+        auto windows = arr.windows(3);
+        ds::vec<unsigned> sums(0);
+
+        REQUIRE(windows.size() == 3);
+        for (auto window : windows) {
+            CHECK(window.size() == 3);
+            sums.insert(sums.size(), sum(window));
+        }
+
+        CHECK(sums == ds::vec<unsigned>{6, 9, 12});
+    }
+
+    SECTION("Edge cases")
+    {
+        CHECK(arr.windows(5).size() == 1);
+        CHECK(arr.windows(6).size() == 0);
+        CHECK(arr.windows(6).begin() == arr.windows(6).end());
+        CHECK_THROWS_AS(arr.windows(0), std::invalid_argument);
+    }
+}
@@ -0,0 +1,126 @@
+#include "libds/stats.hpp"
+
+#include "libds/vec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+
+#include <sstream>
+#include <string>
+
+#ifndef LIBDS_STATS
+#  error "stats tests must be built with LIBDS_STATS"
+#endif
+
+namespace {
+
+struct tracked {
+    std::uint64_t value;
+};
+
+struct scoped {
+    std::uint32_t value;
+};
+
+void
+grow_in_scope()
+{
+    LIBDS_STATS_SCOPE();
+
+    ds::vec<scoped> arr(2);
+    for (std::uint32_t i = 0; i < 3; i++)
+        arr.insert(arr.size(), scoped{i});
+}
+
+} // namespace
+
+TEST_CASE("Per-type counters", "[stats]")
+{
+    ds::stats::reset();
+    auto& rec = ds::stats::for_type<tracked>();
+
+    REQUIRE(rec.element_size() == sizeof(tracked));
+    REQUIRE(rec.name().find("tracked") != std::string::npos);
+
+    SECTION("Allocation and free")
+    {
+        {
+            ds::vec<tracked> arr(4);
+            CHECK(rec.snapshot().allocations == 1);
+            CHECK(rec.snapshot().bytes_allocated == 4 * sizeof(tracked));
+            CHECK(rec.snapshot().frees == 0);
+        }
+
+        CHECK(rec.snapshot().frees == 1);
+        CHECK(rec.snapshot().peak_capacity == 4);
+    }
+
+    SECTION("Growth and shifting")
+    {
+        ds::vec<tracked> arr(2);
+        arr.insert(0, tracked{1});
+        arr.insert(0, tracked{2});
+
+        // Fits, shifts one element
+        auto snap = rec.snapshot();
+        CHECK(snap.reallocations == 0);
+        CHECK(snap.bytes_copied == sizeof(tracked));
+
+        // Grows 2 -> 3
+        arr.insert(0, tracked{3});
+        snap = rec.snapshot();
+        CHECK(snap.reallocations == 1);
+        CHECK(snap.peak_capacity == 3);
+        CHECK(snap.bytes_copied == 3 * sizeof(tracked));
+    }
+
+    SECTION("Reset")
+    {
+        ds::vec<tracked> arr(4);
+        ds::stats::reset();
+
+        CHECK(rec.snapshot().allocations == 0);
+        CHECK(rec.snapshot().peak_capacity == 0);
+    }
+}
+
+TEST_CASE("Per-site counters", "[stats]")
+{
+    ds::stats::reset();
+    grow_in_scope();
+
+    const ds::stats::site_stats* site = nullptr;
+    ds::stats::registry::for_each_site([&](const ds::stats::site_stats& rec) {
+        if (std::string(rec.function()) == "grow_in_scope")
+            site = &rec;
+    });
+
+    REQUIRE(site != nullptr);
+    CHECK(ds::stats::registry::current_site() == nullptr);
+
+    auto snap = site->snapshot();
+    CHECK(snap.allocations == 1);
+    CHECK(snap.reallocations == 1);
+    CHECK(snap.frees == 1);
+    CHECK(snap.peak_capacity == 3);
+}
+
+TEST_CASE("Reports", "[stats]")
+{
+    ds::stats::reset();
+    ds::vec<tracked> arr(4);
+    grow_in_scope();
+
+    auto json = ds::stats::to_json();
+
+    CHECK(json.rfind("{\"types\":[", 0) == 0);
+    CHECK(json.find("tracked") != std::string::npos);
+    CHECK(json.find("\"element_size\":8") != std::string::npos);
+    CHECK(json.find("\"function\":\"grow_in_scope\"") != std::string::npos);
+    CHECK(json.back() == '}');
+
+    std::ostringstream text;
+    ds::stats::dump(text);
+    CHECK(text.str().find("allocs=1") != std::string::npos);
+}
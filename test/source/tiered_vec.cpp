@@ -0,0 +1,139 @@
+#include "libds/tiered_vec.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+TEST_CASE("Tiered indexing", "[tiered_vec]")
+{
+    ds::tiered_vec<unsigned> arr;
+    for (unsigned i = 0; i < 1000; i++)
+        arr.push_back(i);
+
+    REQUIRE(arr.size() == 1000);
+    CHECK(arr.block_size() == 64);
+    CHECK(arr.capacity() >= 1000);
+
+    for (unsigned i = 0; i < 1000; i++)
+        CHECK(arr[i] == i);
+
+    CHECK(arr.front() == 0);
+    CHECK(arr.back() == 999);
+    CHECK_THROWS_AS(arr.at(1000), std::out_of_range);
+    CHECK(arr.end() - arr.begin() == 1000);
+}
+
+TEST_CASE("Tiered insertion and erasure", "[tiered_vec]")
+{
+    ds::tiered_vec<unsigned> arr{1, 2, 3};
+
+    SECTION("Small")
+    {
+        arr.insert(0, 0);
+        arr.insert(4, 4);
+        arr.insert(2, 10);
+
+        CHECK(arr == ds::tiered_vec<unsigned>{0, 1, 10, 2, 3, 4});
+
+        arr.erase(2);
+        arr.erase(0);
+        arr.pop_back();
+
+        CHECK(arr == ds::tiered_vec<unsigned>{1, 2, 3});
+        CHECK_THROWS_AS(arr.erase(3), std::out_of_range);
+    }
+
+    SECTION("Matches std::vector")
+    {
+        std::vector<unsigned> ref{1, 2, 3};
+        std::uint32_t rng = 1;
+
+        // Enough elements for the blocks to grow a few times
+        for (unsigned i = 0; i < 40000; i++) {
+            rng = rng * 1664525U + 1013904223U;
+            const auto pos = static_cast<std::size_t>(rng >> 8) % (ref.size() + 1);
+
+            if (rng % 4 == 0 && pos < ref.size()) {
+                arr.erase(pos);
+                ref.erase(ref.begin() + static_cast<std::ptrdiff_t>(pos));
+            } else {
+                arr.insert(pos, i);
+                ref.insert(ref.begin() + static_cast<std::ptrdiff_t>(pos), i);
+            }
+        }
+
+        REQUIRE(arr.size() == ref.size());
+        CHECK(arr.block_size() > 64);
+
+        bool same = true;
+        for (std::size_t i = 0; i < ref.size(); i++)
+            same = same && arr[i] == ref[i];
+        CHECK(same);
+    }
+}
+
+TEST_CASE("Tiered segments", "[tiered_vec]")
+{
+    ds::tiered_vec<unsigned> arr;
+    for (unsigned i = 0; i < 300; i++)
+        arr.push_back(i);
+
+    // Wrap some of the ring buffers around
+    for (unsigned i = 0; i < 10; i++)
+        arr.insert(0, 0);
+
+    std::size_t segments = 0;
+    std::size_t total = 0;
+    unsigned sum = 0;
+
+    const auto& carr = arr;
+    carr.for_each_segment([&](ds::span<const unsigned> segment) {
+        segments++;
+        total += segment.size();
+        for (auto val : segment)
+            sum += val;
+    });
+
+    CHECK(total == 310);
+    CHECK(sum == 299 * 300 / 2);
+    CHECK(segments <= 2 * (310 / arr.block_size() + 1));
+
+    arr.for_each_segment([](ds::span<unsigned> segment) {
+        for (auto& val : segment)
+            val = 1;
+    });
+    CHECK(arr[123] == 1);
+}
+
+TEST_CASE("Non-trivial tiered elements", "[tiered_vec]")
+{
+    const std::string long_str(64, 'x');
+    ds::tiered_vec<std::string> arr;
+    for (unsigned i = 0; i < 200; i++)
+        arr.push_back(std::to_string(i));
+
+    arr.insert(0, long_str);
+    arr.insert(100, arr[0]);
+    arr.emplace(50, std::size_t{3}, 'y');
+    arr.erase(1);
+
+    REQUIRE(arr.size() == 202);
+    CHECK(arr[0] == long_str);
+    CHECK(arr[1] == "1");
+    CHECK(arr[49] == "yyy");
+    CHECK(arr[100] == long_str);
+    CHECK(arr.back() == "199");
+
+    ds::tiered_vec<std::string> copy(arr);
+    arr.clear();
+
+    CHECK(arr.empty());
+    CHECK(copy.size() == 202);
+    CHECK(copy[100] == long_str);
+
+    arr = copy;
+    CHECK(arr == copy);
+}
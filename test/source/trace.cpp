@@ -0,0 +1,148 @@
+#include "libds/trace.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::vector<ds::trace_record>
+read_all(const std::string& bytes)
+{
+    std::istringstream in(bytes);
+    ds::trace_reader reader(in);
+
+    std::vector<ds::trace_record> res;
+    ds::trace_record rec;
+    while (reader.next(rec))
+        res.push_back(rec);
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("Round trip", "[trace]")
+{
+    std::ostringstream out;
+    std::vector<ds::trace_record> recs = {
+        {ds::trace_op::create, 0, 10, 4},
+        {ds::trace_op::insert, 0, 300, 1},
+        {ds::trace_op::reserve, 0, std::uint64_t{1} << 40U, 0},
+        {ds::trace_op::copy, 1, 0, 0},
+        {ds::trace_op::erase, 1, 20, 5},
+        {ds::trace_op::resize, 1, 70, 0},
+        {ds::trace_op::shrink, 1, 0, 0},
+        {ds::trace_op::destroy, 0, 0, 0},
+    };
+
+    {
+        ds::trace_writer writer(out);
+        for (const auto& rec : recs)
+            writer.write(rec);
+    }
+
+    CHECK(read_all(out.str()) == recs);
+
+    // Magic, version, and short records
+    CHECK(out.str().size() < 9 + recs.size() * 8);
+}
+
+TEST_CASE("Corrupt traces", "[trace]")
+{
+    SECTION("Bad magic")
+    {
+        CHECK_THROWS_AS(read_all("NOTATRACE"), std::runtime_error);
+        CHECK_THROWS_AS(read_all(""), std::runtime_error);
+    }
+
+    SECTION("Truncated record")
+    {
+        std::ostringstream out;
+        {
+            ds::trace_writer writer(out);
+            writer.write({ds::trace_op::insert, 0, 1000, 1});
+        }
+
+        auto bytes = out.str();
+        bytes.pop_back();
+        CHECK_THROWS_AS(read_all(bytes), std::runtime_error);
+    }
+
+    SECTION("Unknown operation")
+    {
+        std::ostringstream out;
+        {
+            ds::trace_writer writer(out);
+        }
+
+        CHECK_THROWS_AS(read_all(out.str() + '\x7f'), std::runtime_error);
+    }
+}
+
+TEST_CASE("Recording a vector", "[trace]")
+{
+    std::ostringstream out;
+    std::uint64_t first = 0;
+    std::uint64_t second = 0;
+
+    {
+        ds::trace_writer writer(out);
+
+        ds::traced_vec<std::uint32_t> arr(writer, 4);
+        first = arr.trace_id();
+
+        arr.insert(0, 1);
+        arr.insert(arr.size(), 3, 2);
+        arr.insert(1, {7, 8});
+        arr.reserve(32);
+
+        CHECK(arr.get() == ds::vec<std::uint32_t>{1, 7, 8, 2, 2, 2});
+
+        arr.emplace(0, 9U);
+        arr.erase(1, 2);
+        arr.pop_back();
+        CHECK_THROWS_AS(arr.erase(10), std::out_of_range);
+        arr.resize(6);
+        arr.resize(7, 5U);
+        arr.resize_for_overwrite(7);
+
+        CHECK(arr.get() == ds::vec<std::uint32_t>{9, 8, 2, 2, 0, 0, 5});
+
+        ds::traced_vec<std::uint32_t> copy(arr);
+        second = copy.trace_id();
+
+        copy.clear();
+        copy.shrink_to_fit();
+        arr = std::move(copy);
+    }
+
+    using op = ds::trace_op;
+    std::vector<ds::trace_record> expected = {
+        {op::create, first, 4, sizeof(std::uint32_t)},
+        {op::insert, first, 0, 1},
+        {op::insert, first, 1, 3},
+        {op::insert, first, 1, 2},
+        {op::reserve, first, 32, 0},
+        {op::insert, first, 0, 1},
+        {op::erase, first, 1, 2},
+        {op::erase, first, 4, 1},
+        {op::resize, first, 6, 0},
+        {op::resize, first, 7, 0},
+        {op::resize, first, 7, 0},
+        {op::copy, second, first, 0},
+        {op::clear, second, 0, 0},
+        {op::shrink, second, 0, 0},
+        {op::move_assign, first, second, 0},
+        {op::destroy, second, 0, 0},
+        {op::destroy, first, 0, 0},
+    };
+
+    CHECK(first != second);
+    CHECK(read_all(out.str()) == expected);
+}
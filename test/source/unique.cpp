@@ -0,0 +1,163 @@
+#include "libds/unique.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+/**
+ * @brief @p n values with runs of duplicates, @p dup_percent percent of them
+ * repeating their predecessor.
+ */
+template <class T>
+ds::vec<T>
+with_runs(std::size_t n, std::uint32_t dup_percent)
+{
+    ds::vec<T> out(0);
+    std::uint32_t rng = 12345;
+    T val = T{};
+    for (std::size_t i = 0; i < n; i++) {
+        rng = rng * 1664525U + 1013904223U;
+        if ((rng >> 8) % 100 >= dup_percent) {
+            if constexpr (std::is_same_v<T, std::string>)
+                val = std::to_string((rng >> 4) % 50);
+            else
+                val = static_cast<T>((rng >> 4) % 50);
+        }
+        out.insert(i, val);
+    }
+    return out;
+}
+
+template <class T>
+void
+check_unique(std::size_t n, std::uint32_t dup_percent)
+{
+    auto v = with_runs<T>(n, dup_percent);
+    std::vector<T> expected(v.begin(), v.end());
+    expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+    const std::size_t removed = ds::unique(v);
+    CHECK(removed == n - expected.size());
+    CHECK(std::vector<T>(v.begin(), v.end()) == expected);
+}
+
+template <class T>
+std::vector<T>
+sorted(const ds::vec<T>& v)
+{
+    std::vector<T> out(v.begin(), v.end());
+    std::sort(out.begin(), out.end());
+    return out;
+}
+} // namespace
+
+TEST_CASE("Removing duplicates", "[unique]")
+{
+    SECTION("Every element width, at every duplicate ratio")
+    {
+        for (std::uint32_t dups : {0U, 10U, 50U, 90U, 100U}) {
+            for (std::size_t n : {0U, 1U, 2U, 7U, 8U, 9U, 1000U}) {
+                check_unique<std::uint32_t>(n, dups);
+                check_unique<std::int64_t>(n, dups);
+                check_unique<float>(n, dups);
+                check_unique<double>(n, dups);
+                check_unique<std::uint16_t>(n, dups);
+                check_unique<std::string>(n, dups);
+            }
+        }
+    }
+
+    SECTION("Custom equivalence")
+    {
+        ds::vec<int> v{1, 3, 5, 2, 4, 7, 7, 8};
+        auto same_parity = [](int lhs, int rhs) { return (lhs - rhs) % 2 == 0; };
+        CHECK(ds::unique(v, same_parity) == 4);
+        CHECK(v == ds::vec{1, 2, 7, 8});
+    }
+
+    SECTION("Sorting first")
+    {
+        ds::vec<std::uint32_t> v{5, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+        CHECK(ds::sort_unique(v) == 4);
+        CHECK(v == ds::vec<std::uint32_t>{1, 2, 3, 4, 5, 6, 9});
+
+        ds::vec<std::string> words{"b", "a", "c", "a", "b"};
+        CHECK(ds::sort_unique(words, std::greater<>()) == 2);
+        CHECK(words == ds::vec<std::string>{"c", "b", "a"});
+    }
+}
+
+TEST_CASE("Partitioning", "[unique]")
+{
+    auto even = [](std::uint32_t elem) { return elem % 2 == 0; };
+
+    SECTION("Unstable")
+    {
+        for (std::uint32_t dups : {0U, 50U, 100U}) {
+            auto v = with_runs<std::uint32_t>(1001, dups);
+            const auto before = sorted(v);
+
+            const std::size_t split = ds::partition(v, even);
+            CHECK(std::all_of(v.begin(), v.begin() + split, even));
+            CHECK(std::none_of(v.begin() + split, v.end(), even));
+            CHECK(sorted(v) == before);
+        }
+
+        ds::vec<std::uint32_t> none{1, 3};
+        CHECK(ds::partition(none, even) == 0);
+        ds::vec<std::uint32_t> all{2, 4};
+        CHECK(ds::partition(all, even) == 2);
+    }
+
+    SECTION("Stable")
+    {
+        auto v = with_runs<std::uint32_t>(1001, 30);
+        std::vector<std::uint32_t> expected(v.begin(), v.end());
+        auto split = std::stable_partition(expected.begin(), expected.end(), even);
+
+        CHECK(ds::stable_partition(v, even) == std::size_t(split - expected.begin()));
+        CHECK(std::vector<std::uint32_t>(v.begin(), v.end()) == expected);
+
+        ds::vec<std::string> words{"a", "bb", "cc", "d", "ee", "f"};
+        auto is_long = [](const std::string& word) { return word.size() > 1; };
+        CHECK(ds::stable_partition(words, is_long) == 3);
+        CHECK(words == ds::vec<std::string>{"bb", "cc", "ee", "a", "d", "f"});
+    }
+
+    SECTION("Throwing predicates lose no elements")
+    {
+        std::size_t calls = 0;
+        auto throws_late = [&](std::uint32_t elem) {
+            if (++calls == 500)
+                throw std::runtime_error("predicate failed");
+            return elem % 2 == 0;
+        };
+
+        auto v = with_runs<std::uint32_t>(1001, 30);
+        const auto before = sorted(v);
+        CHECK_THROWS_AS(ds::partition(v, throws_late), std::runtime_error);
+        CHECK(sorted(v) == before);
+
+        calls = 0;
+        CHECK_THROWS_AS(ds::stable_partition(v, throws_late), std::runtime_error);
+        CHECK(sorted(v) == before);
+
+        ds::vec<std::string> words{"a", "bb", "cc", "d", "ee", "f"};
+        calls = 0;
+        auto throws_third = [&](const std::string& word) {
+            if (++calls == 3)
+                throw std::runtime_error("predicate failed");
+            return word.size() > 1;
+        };
+        CHECK_THROWS_AS(ds::stable_partition(words, throws_third), std::runtime_error);
+        CHECK(
+            sorted(words) == std::vector<std::string>{"a", "bb", "cc", "d", "ee", "f"}
+        );
+    }
+}
@@ -2,8 +2,66 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
 // NOLINTBEGIN(modernize-loop-convert)
 
+namespace {
+
+/**
+ * @brief An element that knows its own address, so being moved around as plain
+ * bytes shows.
+ */
+struct self_aware {
+    const self_aware* self = this;
+    int val = 0;
+
+    static inline int copies = 0;
+
+    explicit self_aware(int value = 0) noexcept : val(value) {}
+
+    self_aware(const self_aware& other) noexcept : val(other.val) { copies++; }
+
+    self_aware(self_aware&& other) noexcept : val(other.val) {}
+
+    self_aware&
+    operator=(const self_aware& other) noexcept
+    {
+        self = this;
+        val = other.val;
+        return *this;
+    }
+
+    self_aware&
+    operator=(self_aware&& other) noexcept
+    {
+        self = this;
+        val = other.val;
+        return *this;
+    }
+
+    ~self_aware() noexcept = default;
+
+    [[nodiscard]] bool
+    in_place() const noexcept
+    {
+        return self == this;
+    }
+};
+
+bool
+all_in_place(const ds::vec<self_aware>& arr)
+{
+    return std::all_of(arr.begin(), arr.end(), [](const self_aware& elem) {
+        return elem.in_place();
+    });
+}
+
+} // namespace
+
 TEST_CASE("Accessors", "[vec]")
 {
     ds::vec<unsigned> arr{1, 2, 3, 4, 5};
@@ -335,6 +393,48 @@ TEST_CASE("Clearing", "[vec]")
     CHECK(arr.begin() == arr.end());
 }
 
+TEST_CASE("Popping", "[vec]")
+{
+    ds::vec arr{1, 2, 3};
+
+    arr.pop_back();
+    CHECK(arr == ds::vec{1, 2});
+    CHECK(arr.capacity() == 3);
+}
+
+TEST_CASE("Erasing", "[vec]")
+{
+    ds::vec<std::string> arr{"a", "b", "c", "d", "e"};
+
+    CHECK(*arr.erase(1) == "c");
+    CHECK(arr == ds::vec<std::string>{"a", "c", "d", "e"});
+
+    auto* after = arr.erase(1, 3);
+    CHECK(after == arr.end());
+    CHECK(arr == ds::vec<std::string>{"a"});
+    CHECK(arr.capacity() == 5);
+
+    arr.erase(1, 0);
+    CHECK_THROWS_AS(arr.erase(1), std::out_of_range);
+    CHECK_THROWS_AS(arr.erase(0, 2), std::out_of_range);
+    CHECK(arr == ds::vec<std::string>{"a"});
+}
+
+TEST_CASE("Resizing for overwrite", "[vec]")
+{
+    ds::vec<int> ints{1, 2};
+    ints.resize_for_overwrite(5);
+    CHECK(ints.size() == 5);
+    CHECK(ints[1] == 2);
+    ints[4] = 7;
+    ints.resize_for_overwrite(1);
+    CHECK(ints == ds::vec{1});
+
+    ds::vec<std::string> strings{"a"};
+    strings.resize_for_overwrite(3);
+    CHECK(strings == ds::vec<std::string>{"a", "", ""});
+}
+
 TEST_CASE("Insertion", "[vec]")
 {
     ds::vec<unsigned> arr{1, 2, 3};
@@ -386,6 +486,223 @@ TEST_CASE("Insertion", "[vec]")
     }
 }
 
+TEST_CASE("Relocating non-trivial elements", "[vec]")
+{
+    ds::vec<self_aware> arr{self_aware(1), self_aware(2), self_aware(3)};
+    REQUIRE(all_in_place(arr));
+
+    SECTION("Growing")
+    {
+        arr.reserve(64);
+
+        REQUIRE(arr.size() == 3);
+        CHECK(all_in_place(arr));
+        CHECK(arr[2].val == 3);
+    }
+
+    SECTION("Shifting")
+    {
+        arr.insert(0, self_aware(0));
+        arr.insert(2, 3, self_aware(9));
+
+        REQUIRE(arr.size() == 7);
+        CHECK(all_in_place(arr));
+        CHECK(arr[0].val == 0);
+        CHECK(arr[4].val == 9);
+        CHECK(arr[6].val == 3);
+    }
+
+    SECTION("Copying a vector with spare capacity")
+    {
+        arr.reserve(16);
+        self_aware::copies = 0;
+
+        const ds::vec<self_aware> copy(arr);
+        CHECK(self_aware::copies == 3);
+        REQUIRE(copy.size() == 3);
+        CHECK(all_in_place(copy));
+        CHECK(copy[1].val == 2);
+
+        ds::vec<self_aware> assigned(32);
+        assigned = arr;
+        CHECK(self_aware::copies == 6);
+        REQUIRE(assigned.size() == 3);
+        CHECK(all_in_place(assigned));
+    }
+}
+
+TEST_CASE("Emplacement", "[vec]")
+{
+    struct counted {
+        int val;
+        int* copies;
+        int* moves;
+
+        counted(int value, int* copy_count, int* move_count) :
+            val(value), copies(copy_count), moves(move_count)
+        {}
+
+        counted(const counted& other) :
+            val(other.val), copies(other.copies), moves(other.moves)
+        {
+            ++*copies;
+        }
+
+        counted(counted&& other) noexcept :
+            val(other.val), copies(other.copies), moves(other.moves)
+        {
+            ++*moves;
+        }
+
+        counted& operator=(const counted& other) = delete;
+        counted& operator=(counted&& other) = delete;
+
+        ~counted() noexcept = default;
+    };
+
+    int copies = 0;
+    int moves = 0;
+    ds::vec<counted> arr(2);
+
+    SECTION("At the end")
+    {
+        arr.emplace(0, 1, &copies, &moves);
+        arr.emplace(1, 2, &copies, &moves);
+
+        CHECK(arr.size() == 2);
+        CHECK(arr[0].val == 1);
+        CHECK(arr[1].val == 2);
+        CHECK(copies == 0);
+        CHECK(moves == 0);
+    }
+
+    SECTION("In the middle")
+    {
+        arr.emplace(0, 1, &copies, &moves);
+        arr.emplace(1, 3, &copies, &moves);
+        arr.emplace(1, 2, &copies, &moves);
+
+        REQUIRE(arr.size() == 3);
+        CHECK(arr[0].val == 1);
+        CHECK(arr[1].val == 2);
+        CHECK(arr[2].val == 3);
+        CHECK(copies == 0);
+    }
+
+    SECTION("Insert moves")
+    {
+        counted elem(5, &copies, &moves);
+        arr.insert(0, std::move(elem));
+        arr.insert(0, counted(4, &copies, &moves));
+
+        REQUIRE(arr.size() == 2);
+        CHECK(arr[0].val == 4);
+        CHECK(arr[1].val == 5);
+        CHECK(copies == 0);
+    }
+
+    SECTION("Insert copies")
+    {
+        const counted elem(5, &copies, &moves);
+        arr.insert(0, elem);
+
+        CHECK(arr.size() == 1);
+        CHECK(copies == 1);
+    }
+}
+
+TEST_CASE("Non-trivial elements", "[vec]")
+{
+    // Long enough to not fit in the small string buffer
+    const std::string long_str(64, 'x');
+    ds::vec<std::string> arr{"a", "b", "c"};
+
+    SECTION("Insertion")
+    {
+        arr.insert(0, long_str);
+        arr.insert(2, std::string(32, 'y'));
+        arr.insert(arr.size(), 2, "z");
+        arr.insert(1, {"d", "e"});
+
+        CHECK(
+            arr
+            == ds::vec<std::string>{
+                long_str, "d", "e", "a", std::string(32, 'y'), "b", "c", "z", "z"}
+        );
+    }
+
+    SECTION("Inserting own elements")
+    {
+        arr.insert(0, arr[2]);
+        arr.insert(0, 3, arr[3]);
+        arr.emplace(arr.size(), arr[0]);
+
+        CHECK(arr == ds::vec<std::string>{"c", "c", "c", "c", "a", "b", "c", "c"});
+    }
+
+    SECTION("Copying")
+    {
+        arr.insert(1, long_str);
+
+        ds::vec<std::string> copy(arr);
+        CHECK(copy == arr);
+
+        ds::vec<std::string> assigned{long_str, long_str};
+        assigned = arr;
+        CHECK(assigned == arr);
+
+        arr.clear();
+        CHECK(copy == ds::vec<std::string>{"a", long_str, "b", "c"});
+    }
+}
+
+TEST_CASE("Growing with throwing copies", "[vec]")
+{
+    // Has no move constructor, so growing copies, which throws once out of budget
+    struct fragile {
+        int val;
+        int* live;
+        int* budget;
+
+        fragile(int value, int* live_count, int* copy_budget) :
+            val(value), live(live_count), budget(copy_budget)
+        {
+            ++*live;
+        }
+
+        fragile(const fragile& other) :
+            val(other.val), live(other.live), budget(other.budget)
+        {
+            if (*budget == 0)
+                throw std::runtime_error("fragile: out of copies!");
+            --*budget;
+            ++*live;
+        }
+
+        fragile& operator=(const fragile& other) = delete;
+
+        ~fragile() noexcept { --*live; }
+    };
+
+    int live = 0;
+    int budget = 2;
+    {
+        ds::vec<fragile> arr(4);
+        for (int i = 0; i < 4; i++)
+            arr.emplace(arr.size(), i, &live, &budget);
+
+        CHECK_THROWS_AS(arr.reserve(8), std::runtime_error);
+        CHECK_THROWS_AS(arr.emplace(0, 4, &live, &budget), std::runtime_error);
+
+        REQUIRE(arr.size() == 4);
+        CHECK(arr.capacity() == 4);
+        CHECK(live == 4);
+        for (std::size_t i = 0; i < arr.size(); i++)
+            CHECK(arr[i].val == static_cast<int>(i));
+    }
+    CHECK(live == 0);
+}
+
 TEST_CASE("Equality operators", "[vec]")
 {
     // NOLINTBEGIN(readability-container-size-empty)
@@ -425,3 +742,62 @@ TEST_CASE("Equality operators", "[vec]")
         CHECK_FALSE(arr != arr);
     }
 }
+
+namespace {
+template <std::size_t Alignment, class T>
+bool
+is_aligned(const T* ptr)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr) % Alignment == 0;
+}
+
+struct alignas(64) slot {
+    int value;
+};
+} // namespace
+
+TEST_CASE("Over-aligned storage", "[vec]")
+{
+    SECTION("Trivial elements")
+    {
+        ds::vec<int, 64> arr(0);
+        for (int i = 0; i < 1000; i++) {
+            arr.insert(arr.size(), i);
+            REQUIRE(is_aligned<64>(arr.data()));
+        }
+        arr.insert(0, 100, -1);
+        CHECK(is_aligned<64>(arr.data()));
+        CHECK(arr.size() == 1100);
+        CHECK(arr[99] == -1);
+        CHECK(arr[100] == 0);
+        CHECK(arr[1099] == 999);
+
+        ds::vec<int, 64> copy = arr;
+        CHECK(is_aligned<64>(copy.data()));
+        CHECK(copy == arr);
+
+        arr.shrink_to_fit();
+        CHECK(is_aligned<64>(arr.data()));
+        CHECK(arr == copy);
+    }
+
+    SECTION("Non-trivial elements")
+    {
+        ds::vec<std::string, 64> arr(0);
+        for (int i = 0; i < 100; i++) {
+            arr.insert(arr.size(), std::to_string(i) + " is long enough to allocate");
+            REQUIRE(is_aligned<64>(arr.data()));
+        }
+        CHECK(arr[42] == "42 is long enough to allocate");
+    }
+
+    SECTION("Over-aligned element type")
+    {
+        ds::vec<slot> arr(0);
+        for (int i = 0; i < 100; i++) {
+            arr.insert(arr.size(), slot{i});
+            REQUIRE(is_aligned<64>(arr.data()));
+        }
+        CHECK(arr[99].value == 99);
+    }
+}